@@ -0,0 +1,22 @@
+from benchmark import Benchmark
+
+modules = ['numpy']
+
+for n, m in [(100000, 8), (100000, 512), (100000, 4096)]:
+    setup = 'x = numpy.random.rand(%d); y = numpy.random.rand(%d)' % (n, m)
+    b = Benchmark(modules,
+                  title='Correlating %d points with %d taps.' % (n, m),
+                  runs=3, reps=10)
+    b['numpy'] = ('numpy.correlate(x, y, "same")', setup)
+    b.run()
+
+for n, m in [(512, 3), (512, 15)]:
+    setup = 'from numpy.core.multiarray import correlate2d; ' \
+            + 'x = numpy.random.rand(%d, %d); ' % (n, n) \
+            + 'y = numpy.random.rand(%d, %d)' % (m, m)
+    b = Benchmark(modules,
+                  title='Correlating a %dx%d image with a %dx%d kernel.'
+                        % (n, n, m, m),
+                  runs=3, reps=10)
+    b['numpy'] = ('correlate2d(x, y, 1)', setup)
+    b.run()
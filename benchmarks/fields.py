@@ -0,0 +1,27 @@
+from benchmark import Benchmark
+
+modules = ['numpy']
+
+NF = 64
+names = ['f%d' % i for i in range(NF)]
+setup = 'names = %r; ' % names \
+        + 'dt = numpy.dtype([(n, float) for n in names]); ' \
+        + 'a = numpy.zeros(10, dtype=dt)'
+
+b = Benchmark(modules,
+              title='Looking up all fields of a %d-field record array.' % NF,
+              runs=3, reps=10000)
+b['numpy'] = ('for n in names: a[n]', setup)
+b.run()
+
+b = Benchmark(modules,
+              title='Creating a %d-field dtype.' % NF,
+              runs=3, reps=1000)
+b['numpy'] = ('numpy.dtype([(n, float) for n in names])', setup)
+b.run()
+
+b = Benchmark(modules,
+              title='Copying the fields of a %d-field dtype.' % NF,
+              runs=3, reps=10000)
+b['numpy'] = ('dt.newbyteorder()', setup)
+b.run()
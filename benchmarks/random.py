@@ -0,0 +1,17 @@
+from benchmark import Benchmark
+
+modules = ['numpy']
+
+# Bulk generation of uniform, normal and exponential variates.  With a
+# size argument these fill the whole array in one call into randomkit.
+for name in ['random_sample', 'standard_normal', 'standard_exponential']:
+    b = Benchmark(modules,
+                  title='numpy.random.%s of 1000000 values.' % name,
+                  runs=3, reps=10)
+    b['numpy'] = ('numpy.random.%s(1000000)' % name, '')
+    b.run()
+
+b = Benchmark(modules, title='numpy.random.normal(2, 3, 1000000).',
+              runs=3, reps=10)
+b['numpy'] = ('numpy.random.normal(2, 3, 1000000)', '')
+b.run()
@@ -0,0 +1,36 @@
+from benchmark import Benchmark
+
+modules = ['numpy']
+
+# Per-call overhead of binary ufuncs on small arrays.  Contiguous
+# operands of the same shape and type take the direct path in the core;
+# the mixed-type and broadcast cases go through the general loop setup
+# and are included for comparison.
+for N in [1, 10, 100, 1000]:
+    b = Benchmark(modules,
+                  title='Adding two contiguous float arrays of size %d.' % N,
+                  runs=3, reps=100000)
+    b['numpy'] = ('numpy.add(a, b, c)',
+                  'a = numpy.ones(%d); b = numpy.ones(%d); '
+                  'c = numpy.empty(%d)' % (N, N, N))
+    b.run()
+
+    b = Benchmark(modules,
+                  title='Adding two int arrays of size %d, new output.' % N,
+                  runs=3, reps=100000)
+    b['numpy'] = ('a + b',
+                  'a = numpy.ones(%d, int); b = numpy.ones(%d, int)' % (N, N))
+    b.run()
+
+    b = Benchmark(modules,
+                  title='Adding a float and an int array of size %d.' % N,
+                  runs=3, reps=100000)
+    b['numpy'] = ('a + b',
+                  'a = numpy.ones(%d); b = numpy.ones(%d, int)' % (N, N))
+    b.run()
+
+    b = Benchmark(modules,
+                  title='Adding a float array of size %d and a scalar.' % N,
+                  runs=3, reps=100000)
+    b['numpy'] = ('a + 1.0', 'a = numpy.ones(%d)' % N)
+    b.run()
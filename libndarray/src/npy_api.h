@@ -150,6 +150,8 @@ NDARRAY_API NpyArray *NpyArray_Correlate2(NpyArray *ap1, NpyArray *ap2,
                                           int typenum, int mode);
 NDARRAY_API NpyArray *NpyArray_Correlate(NpyArray *ap1, NpyArray *ap2,
                                          int typenum, int mode);
+NDARRAY_API NpyArray *NpyArray_Correlate2D(NpyArray *ap1, NpyArray *ap2,
+                                           int typenum, int mode);
 NDARRAY_API unsigned char NpyArray_EquivTypenums(int typenum1, int typenum2);
 NDARRAY_API int NpyArray_GetEndianness(void);
 
@@ -196,6 +198,7 @@ NDARRAY_API NpyArray *NpyArray_CheckAxis(NpyArray *arr, int *axis, int flags);
 NDARRAY_API int NpyArray_CompareUCS4(npy_ucs4 *s1, npy_ucs4 *s2, size_t len);
 NDARRAY_API int NpyArray_CompareString(char *s1, char *s2, size_t len);
 NDARRAY_API int NpyArray_ElementStrides(NpyArray *arr);
+NDARRAY_API NPY_OVERLAP NpyArray_Overlap(NpyArray *a, NpyArray *b);
 NDARRAY_API npy_bool NpyArray_CheckStrides(int elsize, int nd, npy_intp numbytes,
                                            npy_intp offset,
                                            npy_intp *dims, npy_intp *newstrides);
@@ -298,6 +301,16 @@ NpyArray_DatetimeToDatetimeStruct(npy_datetime val, NPY_DATETIMEUNIT fr,
 NDARRAY_API void
 NpyArray_TimedeltaToTimedeltaStruct(npy_timedelta val, NPY_DATETIMEUNIT fr,
                                     npy_timedeltastruct *result);
+NDARRAY_API int
+NpyArray_DatetimeToFields(char *data, npy_intp stride, npy_intp n,
+                          NPY_DATETIMEUNIT fr, npy_datetimefields *out);
+NDARRAY_API int
+NpyArray_FieldsToDatetime(npy_datetimefields *in, npy_intp n,
+                          NPY_DATETIMEUNIT fr, char *data, npy_intp stride);
+NDARRAY_API int
+NpyArray_DatetimeRescale(npy_datetime *src, npy_datetime *dst, npy_intp n,
+                         NpyArray_DateTimeInfo *from,
+                         NpyArray_DateTimeInfo *to, int timedelta);
 
 NDARRAY_API NpyArray_DateTimeInfo*
 NpyArray_DateTimeInfoNew(const char* units, int num, int den, int events);
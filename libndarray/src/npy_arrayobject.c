@@ -105,6 +105,90 @@ NpyArray_CheckStrides(int elsize, int nd, npy_intp numbytes, npy_intp offset,
     return NPY_TRUE;
 }
 
+
+/* The bytes [*lo, *hi) that arr, which must not be empty, can touch */
+static void
+array_extent(NpyArray *arr, char **lo, char **hi)
+{
+    int i;
+
+    *lo = *hi = NpyArray_BYTES(arr);
+    for (i = 0; i < NpyArray_NDIM(arr); i++) {
+        npy_intp span = NpyArray_STRIDE(arr, i)*(NpyArray_DIM(arr, i) - 1);
+
+        if (span < 0) {
+            *lo += span;
+        }
+        else {
+            *hi += span;
+        }
+    }
+    *hi += NpyArray_ITEMSIZE(arr);
+}
+
+/*
+ * Tells how the memory of a and b overlaps:
+ *
+ *   NPY_OVERLAP_NONE     no byte is in both
+ *   NPY_OVERLAP_SAME     the same elements in the same order: equal data
+ *                        pointers, item sizes, shapes and strides (other
+ *                        than along length one axes)
+ *   NPY_OVERLAP_PARTIAL  anything else, such as a[1:] and a[:-1]
+ *
+ * Arrays whose extents do not intersect do not overlap, and neither do
+ * one dimensional arrays with equal strides that interleave, as a[::2] and
+ * a[1::2] do.  Other arrays whose extents intersect are taken to overlap
+ * partially, whether or not they share an element.
+ */
+NDARRAY_API NPY_OVERLAP
+NpyArray_Overlap(NpyArray *a, NpyArray *b)
+{
+    char *alo, *ahi, *blo, *bhi;
+    npy_intp s, d;
+    int i;
+
+    if (NpyArray_SIZE(a) == 0 || NpyArray_SIZE(b) == 0) {
+        return NPY_OVERLAP_NONE;
+    }
+    array_extent(a, &alo, &ahi);
+    array_extent(b, &blo, &bhi);
+    if (ahi <= blo || bhi <= alo) {
+        return NPY_OVERLAP_NONE;
+    }
+
+    if (NpyArray_BYTES(a) == NpyArray_BYTES(b) &&
+        NpyArray_ITEMSIZE(a) == NpyArray_ITEMSIZE(b) &&
+        NpyArray_NDIM(a) == NpyArray_NDIM(b) &&
+        NpyArray_CompareLists(NpyArray_DIMS(a), NpyArray_DIMS(b),
+                              NpyArray_NDIM(a))) {
+        for (i = 0; i < NpyArray_NDIM(a); i++) {
+            if (NpyArray_DIM(a, i) > 1 &&
+                NpyArray_STRIDE(a, i) != NpyArray_STRIDE(b, i)) {
+                break;
+            }
+        }
+        if (i == NpyArray_NDIM(a)) {
+            return NPY_OVERLAP_SAME;
+        }
+    }
+
+    if (NpyArray_NDIM(a) == 1 && NpyArray_NDIM(b) == 1 &&
+        NpyArray_STRIDE(a, 0) == NpyArray_STRIDE(b, 0) &&
+        NpyArray_STRIDE(a, 0) != 0) {
+        /* the items of b start d bytes into each stride of a */
+        s = NpyArray_STRIDE(a, 0) < 0 ? -NpyArray_STRIDE(a, 0) :
+                                        NpyArray_STRIDE(a, 0);
+        d = (NpyArray_BYTES(b) - NpyArray_BYTES(a)) % s;
+        if (d < 0) {
+            d += s;
+        }
+        if (d >= NpyArray_ITEMSIZE(a) && s - d >= NpyArray_ITEMSIZE(b)) {
+            return NPY_OVERLAP_NONE;
+        }
+    }
+    return NPY_OVERLAP_PARTIAL;
+}
+
 NDARRAY_API void
 NpyArray_ForceUpdate(NpyArray* self)
 {
@@ -3,6 +3,8 @@
  *
  */
 
+#include <stdlib.h>
+#include <string.h>
 #include "npy_config.h"
 #include "npy_api.h"
 #include "npy_arrayobject.h"
@@ -10,115 +12,254 @@
 
 
 
-NDARRAY_API NpyArray *
-NpyArray_ArgMax(NpyArray *op, int axis, NpyArray *out)
+/*
+ * The index array for an arg function along axis of ap: out made into a
+ * C contiguous intp array, or a new one.  *copyret tells whether the
+ * result has to be copied back into out.
+ */
+static NpyArray *
+_arg_result(NpyArray *ap, int axis, NpyArray *out, int *copyret)
 {
-    NpyArray *ap = NULL, *rp = NULL;
-    NpyArray_ArgFunc *arg_func;
-    char *ip;
-    npy_intp *rptr;
-    npy_intp i, n, m;
-    int elsize;
-    int copyret = 0;
-    NPY_BEGIN_THREADS_DEF;
+    npy_intp dims[NPY_MAXDIMS];
+    NpyArray *rp;
+    int i, j;
 
-    if ((ap=NpyArray_CheckAxis(op, &axis, 0)) == NULL) {
+    for (i = 0, j = 0; i < ap->nd; i++) {
+        if (i != axis) {
+            dims[j++] = ap->dimensions[i];
+        }
+    }
+    *copyret = 0;
+    if (!out) {
+        return NpyArray_New(NULL, ap->nd-1, dims, NPY_INTP,
+                            NULL, NULL, 0, 0, Npy_INTERFACE(ap));
+    }
+    if (NpyArray_SIZE(out) != NpyArray_MultiplyList(dims, ap->nd - 1)) {
+        NpyErr_SetString(NpyExc_TypeError,
+                         "invalid shape for output array.");
         return NULL;
     }
+    rp = NpyArray_FromArray(out, NpyArray_DescrFromType(NPY_INTP),
+                            NPY_CARRAY | NPY_UPDATEIFCOPY);
+    if (rp != NULL && rp != out) {
+        *copyret = 1;
+    }
+    return rp;
+}
 
-    /*
-     * We need to permute the array so that axis is placed at the end.
-     * And all other dimensions are shifted left.
-     */
-    if (axis != ap->nd-1) {
-        NpyArray_Dims newaxes;
-        npy_intp dims[NPY_MAXDIMS];
-        int i;
-
-        newaxes.ptr = dims;
-        newaxes.len = ap->nd;
-        for (i = 0; i < axis; i++) dims[i] = i;
-        for (i = axis; i < ap->nd - 1; i++) dims[i] = i + 1;
-        dims[ap->nd - 1] = axis;
-        op = NpyArray_Transpose(ap, &newaxes);
-        Npy_DECREF(ap);
-        if (op == NULL) {
-            return NULL;
+static NpyArray *
+_arg_finish(NpyArray *rp, int copyret)
+{
+    NpyArray *obj;
+
+    if (copyret) {
+        obj = rp->base_arr;
+        Npy_INCREF(obj);
+        NpyArray_ForceUpdate(rp);
+        Npy_DECREF(rp);
+        rp = obj;
+    }
+    return rp;
+}
+
+
+/*
+ * Runs the arg functions funcs[0..nfuncs) over every line of op along
+ * axis, storing the indices they find into the C contiguous intp arrays
+ * rps.  Lines that are aligned, in native byte order and contiguous are
+ * passed as they are; others are gathered one at a time into a buffer,
+ * so that no transposed copy of the whole array is made.
+ *
+ * With more than one function, long contiguous lines are taken a chunk
+ * at a time so that the data is read from memory only once.  Each chunk
+ * is copied in behind the best element found so far, which lets every
+ * function go on from where it was exactly as on the whole line.
+ */
+#define NPY_ARGCHUNK 4096
+
+static int
+_arg_lines(NpyArray *op, int axis, NpyArray_ArgFunc **funcs, int nfuncs,
+           NpyArray **rps)
+{
+    NpyArrayIterObject *it;
+    npy_intp N = op->dimensions[axis];
+    npy_intp astride = op->strides[axis];
+    int elsize = op->descr->elsize;
+    int swap = !NpyArray_ISNOTSWAPPED(op);
+    int needcopy, chunked, k;
+    npy_intp *rptr[2];
+    npy_intp start, m, ind;
+    char *line, *buffer = NULL;
+    NPY_BEGIN_THREADS_DEF;
+
+    it = NpyArray_IterAllButAxis(op, &axis);
+    if (it == NULL) {
+        return -1;
+    }
+    needcopy = !NpyArray_ISALIGNED(op) || astride != (npy_intp)elsize ||
+        swap;
+    chunked = !needcopy && nfuncs > 1 && N > NPY_ARGCHUNK;
+    if (needcopy || chunked) {
+        buffer = NpyDataMem_NEW((needcopy ? N : NPY_ARGCHUNK + 1)*elsize);
+        if (buffer == NULL) {
+            Npy_DECREF(it);
+            NpyErr_MEMORY;
+            return -1;
         }
     }
-    else {
-        op = ap;
+    for (k = 0; k < nfuncs; k++) {
+        rptr[k] = (npy_intp *)rps[k]->data;
+    }
+
+    NPY_BEGIN_THREADS_DESCR(op->descr);
+    while (it->index < it->size) {
+        line = it->dataptr;
+        if (needcopy) {
+            /* copyswapn knows the parts of complex and unicode items */
+            if (swap) {
+                op->descr->f->copyswapn(buffer, (npy_intp)elsize, line,
+                                        astride, N, swap, op);
+            }
+            else {
+                _unaligned_strided_byte_copy(buffer, (npy_intp)elsize, line,
+                                             astride, N, elsize);
+            }
+            line = buffer;
+        }
+        if (!chunked) {
+            for (k = 0; k < nfuncs; k++) {
+                funcs[k](line, N, rptr[k], op);
+            }
+        }
+        else {
+            for (k = 0; k < nfuncs; k++) {
+                funcs[k](line, NPY_ARGCHUNK, rptr[k], op);
+            }
+            for (start = NPY_ARGCHUNK; start < N; start += NPY_ARGCHUNK) {
+                m = (N - start < NPY_ARGCHUNK) ? N - start : NPY_ARGCHUNK;
+                memcpy(buffer + elsize, line + start*elsize, m*elsize);
+                for (k = 0; k < nfuncs; k++) {
+                    memcpy(buffer, line + (*rptr[k])*elsize, elsize);
+                    funcs[k](buffer, m + 1, &ind, op);
+                    if (ind > 0) {
+                        *rptr[k] = start + ind - 1;
+                    }
+                }
+            }
+        }
+        for (k = 0; k < nfuncs; k++) {
+            rptr[k]++;
+        }
+        NpyArray_ITER_NEXT(it);
     }
+    NPY_END_THREADS_DESCR(op->descr);
+
+    if (buffer != NULL) {
+        NpyDataMem_FREE(buffer);
+    }
+    Npy_DECREF(it);
+    return 0;
+}
+
+
+static NpyArray *
+_arg_func(NpyArray *op, int axis, NpyArray *out, int min)
+{
+    NpyArray *ap, *rp;
+    NpyArray_ArgFunc *arg_func;
+    int copyret;
 
-    /* Will get native-byte order contiguous copy. */
-    ap = NpyArray_ContiguousFromArray(op, op->descr->type_num);
-    Npy_DECREF(op);
-    if (ap == NULL) {
+    if ((ap = NpyArray_CheckAxis(op, &axis, 0)) == NULL) {
         return NULL;
     }
-    arg_func = ap->descr->f->argmax;
+    arg_func = min ? ap->descr->f->argmin : ap->descr->f->argmax;
     if (arg_func == NULL) {
         NpyErr_SetString(NpyExc_TypeError, "data type not ordered");
         goto fail;
     }
-    elsize = ap->descr->elsize;
-    m = ap->dimensions[ap->nd-1];
-    if (m == 0) {
+    if (ap->dimensions[axis] == 0) {
         NpyErr_SetString(NpyExc_ValueError,
                          "attempt to get argmax/argmin "\
                          "of an empty sequence");
         goto fail;
     }
 
-    if (!out) {
-        rp = NpyArray_New(NULL, ap->nd-1,
-                          ap->dimensions, NPY_INTP,
-                          NULL, NULL, 0, 0, Npy_INTERFACE(ap));
-        if (rp == NULL) {
-            goto fail;
-        }
-    }
-    else {
-        if (NpyArray_SIZE(out) !=
-            NpyArray_MultiplyList(ap->dimensions, ap->nd - 1)) {
-            NpyErr_SetString(NpyExc_TypeError,
-                            "invalid shape for output array.");
-        }
-        rp = NpyArray_FromArray(out,
-                          NpyArray_DescrFromType(NPY_INTP),
-                          NPY_CARRAY | NPY_UPDATEIFCOPY);
-        if (rp == NULL) {
-            goto fail;
-        }
-        if (rp != out) {
-            copyret = 1;
-        }
+    rp = _arg_result(ap, axis, out, &copyret);
+    if (rp == NULL) {
+        goto fail;
     }
-
-    NPY_BEGIN_THREADS_DESCR(ap->descr);
-    n = NpyArray_SIZE(ap)/m;
-    rptr = (npy_intp *)rp->data;
-    for (ip = ap->data, i = 0; i < n; i++, ip += elsize*m) {
-        arg_func(ip, m, rptr, ap);
-        rptr += 1;
+    if (_arg_lines(ap, axis, &arg_func, 1, &rp) < 0) {
+        Npy_DECREF(rp);
+        goto fail;
     }
-    NPY_END_THREADS_DESCR(ap->descr);
+    Npy_DECREF(ap);
+    return _arg_finish(rp, copyret);
 
+fail:
     Npy_DECREF(ap);
-    if (copyret) {
-        NpyArray *obj;
-        obj = rp->base_arr;
-        Npy_INCREF(obj);
-        NpyArray_ForceUpdate(rp);
-        Npy_DECREF(rp);
-        rp = obj;
+    return NULL;
+}
+
+
+NDARRAY_API NpyArray *
+NpyArray_ArgMax(NpyArray *op, int axis, NpyArray *out)
+{
+    return _arg_func(op, axis, out, 0);
+}
+
+
+NDARRAY_API NpyArray *
+NpyArray_ArgMin(NpyArray *op, int axis, NpyArray *out)
+{
+    return _arg_func(op, axis, out, 1);
+}
+
+
+/*
+ * argmin and argmax of op along axis in a single pass over the data.
+ * Returns 0 and new references in *imin and *imax, or -1 on error.
+ */
+NDARRAY_API int
+NpyArray_ArgMinMax(NpyArray *op, int axis, NpyArray **imin, NpyArray **imax)
+{
+    NpyArray *ap;
+    NpyArray *rps[2] = {NULL, NULL};
+    NpyArray_ArgFunc *funcs[2];
+    int copyret;
+
+    *imin = *imax = NULL;
+    if ((ap = NpyArray_CheckAxis(op, &axis, 0)) == NULL) {
+        return -1;
     }
-    return rp;
+    funcs[0] = ap->descr->f->argmax;
+    funcs[1] = ap->descr->f->argmin;
+    if (funcs[0] == NULL || funcs[1] == NULL) {
+        NpyErr_SetString(NpyExc_TypeError, "data type not ordered");
+        goto fail;
+    }
+    if (ap->dimensions[axis] == 0) {
+        NpyErr_SetString(NpyExc_ValueError,
+                         "attempt to get argmax/argmin "\
+                         "of an empty sequence");
+        goto fail;
+    }
+    if ((rps[0] = _arg_result(ap, axis, NULL, &copyret)) == NULL ||
+        (rps[1] = _arg_result(ap, axis, NULL, &copyret)) == NULL) {
+        goto fail;
+    }
+    if (_arg_lines(ap, axis, funcs, 2, rps) < 0) {
+        goto fail;
+    }
+    Npy_DECREF(ap);
+    *imax = rps[0];
+    *imin = rps[1];
+    return 0;
 
 fail:
+    Npy_XDECREF(rps[0]);
+    Npy_XDECREF(rps[1]);
     Npy_DECREF(ap);
-    Npy_XDECREF(rp);
-    return NULL;
+    return -1;
 }
 
 
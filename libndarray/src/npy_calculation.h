@@ -10,6 +10,12 @@ NDARRAY_API struct NpyArray
 NDARRAY_API struct NpyArray 
 *NpyArray_ArgMax(NpyArray *op, int axis, NpyArray *out);
 
+NDARRAY_API struct NpyArray 
+*NpyArray_ArgMin(NpyArray *op, int axis, NpyArray *out);
+
+NDARRAY_API int
+NpyArray_ArgMinMax(NpyArray *op, int axis, NpyArray **imin, NpyArray **imax);
+
 NDARRAY_API struct NpyArray *
 NpyArray_Max(struct NpyArray *self, int axis, struct NpyArray *out);
 
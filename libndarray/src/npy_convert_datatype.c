@@ -304,7 +304,9 @@ NpyArray_CastToType(NpyArray *mp, NpyArray_Descr *at, int fortran)
     if (((mpd == at) ||
          ((mpd->type_num == at->type_num) &&
           NpyArray_EquivByteorders(mpd->byteorder, at->byteorder) &&
-          ((mpd->elsize == at->elsize) || (at->elsize==0)))) &&
+          ((mpd->elsize == at->elsize) || (at->elsize==0)) &&
+          (!NpyTypeNum_ISDATETIME(at->type_num) ||
+           NpyArray_EquivTypes(mpd, at)))) &&
         NpyArray_ISBEHAVED_RO(mp)) {
         Npy_DECREF(at);
         Npy_INCREF(mp);
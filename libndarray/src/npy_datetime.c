@@ -3,6 +3,8 @@
  *
  */
 
+#include <string.h>
+
 #include "npy_config.h"
 #include "npy_api.h"
 
@@ -49,12 +51,6 @@ typedef struct {
     }
 
 
-/* Table with day offsets for each month (0-based, without and with leap) */
-static int month_offset[2][13] = {
-    { 0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334, 365 },
-    { 0, 31, 60, 91, 121, 152, 182, 213, 244, 274, 305, 335, 366 }
-};
-
 /* Table of number of days in a month (0-based, without and with leap) */
 static int days_in_month[2][12] = {
     { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 },
@@ -88,19 +84,49 @@ day_of_week(npy_longlong absdate)
 }
 
 /*
- * Return the year offset, that is the absolute date of the day
- * 31.12.(year-1) since 31.12.1969 in the proleptic Gregorian calendar.
+ * Floor division of a value by a positive divisor, returning the
+ * quotient and storing the non-negative remainder in *rem.  Written
+ * without branches so the bulk conversion loops below stay straight-line.
  */
-static npy_longlong
-year_offset(npy_longlong year)
+#define _FLOORDIV(val, div, rem)                                    \
+    (*(rem) = (val) % (div),                                        \
+     *(rem) += (*(rem) < 0) * (div),                                \
+     ((val) - *(rem)) / (div))
+
+/*
+ * Civil calendar arithmetic on the proleptic Gregorian calendar using
+ * March-based years in 400-year eras (146097 days each).  These replace
+ * the iterative year search from mx.DateTime with closed-form integer
+ * expressions.  719468 is the number of days from 0000-03-01 to
+ * 1970-01-01.
+ */
+static NPY_INLINE npy_longlong
+days_from_civil(npy_longlong year, int month, int day)
 {
-    /* Note that 477 == 1969/4 - 1969/100 + 1969/400 */
-    year--;
-    if (year >= 0 || -1/4 == -1)
-        return (year-1969)*365 + year/4 - year/100 + year/400 - 477;
-    else
-        return (year-1969)*365 + (year-3)/4 -
-                      (year-99)/100 + (year-399)/400 - 477;
+    npy_longlong era, yoe, doy, doe, rem;
+
+    year -= (month <= 2);
+    era = _FLOORDIV(year, 400, &rem);
+    yoe = rem;
+    doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+static NPY_INLINE void
+civil_from_days(npy_longlong days, npy_longlong *year, int *month, int *day)
+{
+    npy_longlong era, doe, yoe, doy, mp, rem;
+
+    days += 719468;
+    era = _FLOORDIV(days, 146097, &rem);
+    doe = rem;
+    yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    mp = (5 * doy + 2) / 153;
+    *day = (int)(doy - (153 * mp + 2) / 5 + 1);
+    *month = (int)(mp < 10 ? mp + 3 : mp - 9);
+    *year = yoe + era * 400 + (*month <= 2);
 }
 
 /*
@@ -116,7 +142,7 @@ days_from_ymd(int year, int month, int day)
 
     /* Calculate the absolute date */
     int leap;
-    npy_longlong yearoffset, absdate;
+    npy_longlong absdate;
 
     /* Is it a leap year ? */
     leap = is_leapyear(year);
@@ -131,21 +157,8 @@ days_from_ymd(int year, int month, int day)
     _AssertWithArg(day >= 1 && day <= days_in_month[leap][month - 1],
                    NpyExc_ValueError, "day out of range: %i", day);
 
-    /*
-     * Number of days between Dec 31, (year - 1) and Dec 31, 1969
-     *    (can be negative).
-     */
-    yearoffset = year_offset(year);
-
-    if (NpyErr_Occurred()) {
-        goto onError;
-    }
-
-    /*
-     * Calculate the number of days using yearoffset
-     * Jan 1, 1970 is day 0 and thus Dec. 31, 1969 is day -1
-     */
-    absdate = day-1 + month_offset[leap][month - 1] + yearoffset;
+    /* Jan 1, 1970 is day 0 and thus Dec. 31, 1969 is day -1 */
+    absdate = days_from_civil(year, month, day);
 
     return absdate;
 
@@ -176,53 +189,10 @@ static ymdstruct
 days_to_ymdstruct(npy_datetime dlong)
 {
     ymdstruct ymd;
-    long year;
-    npy_longlong yearoffset;
-    int leap, dayoffset;
-    int month = 1, day = 1;
-    int *monthoffset;
+    npy_longlong year;
 
-    dlong += 1;
-
-    /* Approximate year */
-    year = 1970 + dlong / 365.2425;
-
-    /* Apply corrections to reach the correct year */
-    while (1) {
-        /* Calculate the year offset */
-        yearoffset = year_offset(year);
-
-        /*
-         * Backward correction: absdate must be greater than the
-         * yearoffset
-         */
-        if (yearoffset >= dlong) {
-            year--;
-            continue;
-        }
-
-        dayoffset = dlong - yearoffset;
-        leap = is_leapyear(year);
-
-        /* Forward correction: non leap years only have 365 days */
-        if (dayoffset > 365 && !leap) {
-            year++;
-            continue;
-        }
-        break;
-    }
-
-    /* Now iterate to find the month */
-    monthoffset = month_offset[leap];
-    for (month = 1; month < 13; month++) {
-        if (monthoffset[month] >= dayoffset)
-            break;
-    }
-    day = dayoffset - month_offset[leap][month-1];
-
-    ymd.year  = year;
-    ymd.month = month;
-    ymd.day   = day;
+    civil_from_days(dlong, &year, &ymd.month, &ymd.day);
+    ymd.year = year;
 
     return ymd;
 }
@@ -600,7 +570,7 @@ NpyArray_DatetimeToDatetimeStruct(npy_datetime val, NPY_DATETIMEUNIT fr,
             ymd = days_to_ymdstruct((val - 86399) / 86400);
             sec = 86399 + (val + 1) % 86400;
         }
-        hms = seconds_to_hmsstruct(val);
+        hms = seconds_to_hmsstruct(sec);
         year   = ymd.year;
         month  = ymd.month;
         day    = ymd.day;
@@ -615,7 +585,7 @@ NpyArray_DatetimeToDatetimeStruct(npy_datetime val, NPY_DATETIMEUNIT fr,
         }
         else {
             ymd = days_to_ymdstruct((val - 86399999) / 86400000);
-            tmp  = 86399999 + (val + 1) % 86399999;
+            tmp  = 86399999 + (val + 1) % 86400000;
         }
         hms = seconds_to_hmsstruct(tmp / 1000);
         us  = (tmp % 1000)*1000;
@@ -649,12 +619,10 @@ NpyArray_DatetimeToDatetimeStruct(npy_datetime val, NPY_DATETIMEUNIT fr,
         sec     = hms.sec;
     }
     else if (fr == NPY_FR_ns) {
-        npy_int64 num1, num2, num3;
+        npy_int64 num1, num2;
         num1 = 86400000;
-        num1 *= 1000000000;
+        num1 *= 1000000;
         num2 = num1 - 1;
-        num3 = 1000000;
-        num3 *= 1000000;
         if (val >= 0) {
             ymd = days_to_ymdstruct(val / num1);
             tmp = val % num1;
@@ -784,6 +752,263 @@ NpyArray_DatetimeToDatetimeStruct(npy_datetime val, NPY_DATETIMEUNIT fr,
     return;
 }
 
+/*
+ * Bulk conversion between datetime values and calendar fields.
+ *
+ * The linear units from days down to nanoseconds are handled by the
+ * straight-line loops below, expanded once per unit with constant scale
+ * factors so that the divisions reduce to multiplications and the
+ * per-element unit dispatch and year search of the scalar routines are
+ * avoided.  The remaining units go through the scalar struct conversion.
+ * None of these routines keep any state, so disjoint slices of one
+ * array may be converted concurrently by the caller.
+ *
+ * Parameters of the loops: PER_DAY is the number of units in a day.
+ * For units of a second or coarser SEC_MUL is the number of seconds in
+ * one unit; otherwise SEC_MUL is 0, PER_SEC is the number of units in a
+ * second and the sub-second part is split as us = frac / US_DIV * US_MUL
+ * and ps = frac % US_DIV * PS_MUL.
+ */
+#define _DATETIME_TO_FIELDS_LOOP(PER_DAY, SEC_MUL, PER_SEC,               \
+                                 US_DIV, US_MUL, PS_MUL)                  \
+    for (i = 0; i < n; i++, data += stride) {                             \
+        npy_int64 val_ = *(npy_datetime *)data;                           \
+        npy_int64 days_, rem_, secs_, frac_;                              \
+        npy_longlong year_;                                               \
+        int month_, day_;                                                 \
+                                                                          \
+        days_ = _FLOORDIV(val_, (npy_int64)(PER_DAY), &rem_);             \
+        civil_from_days(days_, &year_, &month_, &day_);                   \
+        if (SEC_MUL) {                                                    \
+            secs_ = rem_ * (SEC_MUL);                                     \
+            frac_ = 0;                                                    \
+        }                                                                 \
+        else {                                                            \
+            secs_ = rem_ / (PER_SEC);                                     \
+            frac_ = rem_ % (PER_SEC);                                     \
+        }                                                                 \
+        if (out->year != NULL) {                                          \
+            out->year[i] = year_;                                         \
+        }                                                                 \
+        if (out->month != NULL) {                                         \
+            out->month[i] = month_;                                       \
+        }                                                                 \
+        if (out->day != NULL) {                                           \
+            out->day[i] = day_;                                           \
+        }                                                                 \
+        if (out->hour != NULL) {                                          \
+            out->hour[i] = (int)(secs_ / 3600);                           \
+        }                                                                 \
+        if (out->min != NULL) {                                           \
+            out->min[i] = (int)((secs_ % 3600) / 60);                     \
+        }                                                                 \
+        if (out->sec != NULL) {                                           \
+            out->sec[i] = (int)(secs_ % 60);                              \
+        }                                                                 \
+        if (out->us != NULL) {                                            \
+            out->us[i] = (int)((frac_ / (US_DIV)) * (US_MUL));            \
+        }                                                                 \
+        if (out->ps != NULL) {                                            \
+            out->ps[i] = (int)((frac_ % (US_DIV)) * (PS_MUL));            \
+        }                                                                 \
+        if (out->as != NULL) {                                            \
+            out->as[i] = 0;                                               \
+        }                                                                 \
+    }
+
+#define _FIELDS_TO_DATETIME_LOOP(PER_DAY, SEC_MUL, PER_SEC,               \
+                                 US_DIV, US_MUL, PS_MUL)                  \
+    for (i = 0; i < n; i++, data += stride) {                             \
+        npy_longlong year_;                                               \
+        npy_int64 secs_, val_;                                            \
+        int month_, day_, leap_;                                          \
+                                                                          \
+        year_ = (in->year != NULL) ? in->year[i] : 1970;                  \
+        month_ = (in->month != NULL) ? in->month[i] : 1;                  \
+        day_ = (in->day != NULL) ? in->day[i] : 1;                        \
+                                                                          \
+        /* Same relative month/day conventions as days_from_ymd */        \
+        if (month_ < 0) {                                                 \
+            month_ += 13;                                                 \
+        }                                                                 \
+        if (month_ < 1 || month_ > 12) {                                  \
+            goto month_error;                                             \
+        }                                                                 \
+        leap_ = is_leapyear(year_);                                       \
+        if (day_ < 0) {                                                   \
+            day_ += days_in_month[leap_][month_ - 1] + 1;                 \
+        }                                                                 \
+        if (day_ < 1 || day_ > days_in_month[leap_][month_ - 1]) {        \
+            goto day_error;                                               \
+        }                                                                 \
+                                                                          \
+        secs_ = 0;                                                        \
+        if (in->hour != NULL) {                                           \
+            secs_ += in->hour[i] * (npy_int64)3600;                       \
+        }                                                                 \
+        if (in->min != NULL) {                                            \
+            secs_ += in->min[i] * (npy_int64)60;                          \
+        }                                                                 \
+        if (in->sec != NULL) {                                            \
+            secs_ += in->sec[i];                                          \
+        }                                                                 \
+        val_ = days_from_civil(year_, month_, day_) * (npy_int64)(PER_DAY); \
+        if (SEC_MUL) {                                                    \
+            val_ += secs_ / ((SEC_MUL) ? (SEC_MUL) : 1);                  \
+        }                                                                 \
+        else {                                                            \
+            val_ += secs_ * (PER_SEC);                                    \
+            if (in->us != NULL) {                                         \
+                val_ += (in->us[i] / (US_MUL)) * (US_DIV);                \
+            }                                                             \
+            if (in->ps != NULL && (PS_MUL)) {                             \
+                val_ += in->ps[i] / ((PS_MUL) ? (PS_MUL) : 1);            \
+            }                                                             \
+        }                                                                 \
+        *(npy_datetime *)data = val_;                                     \
+    }
+
+/*
+ * Fill the calendar field arrays in out from n datetime values spaced
+ * stride bytes apart.  Field pointers which are NULL are skipped.
+ * Returns 0 on success, -1 with an error set otherwise.
+ */
+NDARRAY_API int
+NpyArray_DatetimeToFields(char *data, npy_intp stride, npy_intp n,
+                          NPY_DATETIMEUNIT fr, npy_datetimefields *out)
+{
+    npy_datetimestruct dts;
+    npy_intp i;
+
+    switch (fr) {
+    case NPY_FR_D:
+        _DATETIME_TO_FIELDS_LOOP(1, 86400, 1, 1, 0, 0);
+        return 0;
+    case NPY_FR_h:
+        _DATETIME_TO_FIELDS_LOOP(24, 3600, 1, 1, 0, 0);
+        return 0;
+    case NPY_FR_m:
+        _DATETIME_TO_FIELDS_LOOP(1440, 60, 1, 1, 0, 0);
+        return 0;
+    case NPY_FR_s:
+        _DATETIME_TO_FIELDS_LOOP(86400, 1, 1, 1, 0, 0);
+        return 0;
+    case NPY_FR_ms:
+        _DATETIME_TO_FIELDS_LOOP(86400000, 0, 1000, 1, 1000, 0);
+        return 0;
+    case NPY_FR_us:
+        _DATETIME_TO_FIELDS_LOOP(86400000000LL, 0, 1000000, 1, 1, 0);
+        return 0;
+    case NPY_FR_ns:
+        _DATETIME_TO_FIELDS_LOOP(86400000000000LL, 0, 1000000000,
+                                 1000, 1, 1000);
+        return 0;
+    default:
+        break;
+    }
+
+    for (i = 0; i < n; i++, data += stride) {
+        NpyArray_DatetimeToDatetimeStruct(*(npy_datetime *)data, fr, &dts);
+        if (out->year != NULL) {
+            out->year[i] = dts.year;
+        }
+        if (out->month != NULL) {
+            out->month[i] = dts.month;
+        }
+        if (out->day != NULL) {
+            out->day[i] = dts.day;
+        }
+        if (out->hour != NULL) {
+            out->hour[i] = dts.hour;
+        }
+        if (out->min != NULL) {
+            out->min[i] = dts.min;
+        }
+        if (out->sec != NULL) {
+            out->sec[i] = dts.sec;
+        }
+        if (out->us != NULL) {
+            out->us[i] = dts.us;
+        }
+        if (out->ps != NULL) {
+            out->ps[i] = dts.ps;
+        }
+        if (out->as != NULL) {
+            out->as[i] = dts.as;
+        }
+    }
+    return NpyErr_Occurred() ? -1 : 0;
+}
+
+/*
+ * Inverse of NpyArray_DatetimeToFields: combine the n entries of the
+ * field arrays in into datetime values written stride bytes apart.
+ * NULL fields take their default (1970-01-01T00:00).  Returns 0 on
+ * success, -1 with an error set on an out-of-range month or day.
+ */
+NDARRAY_API int
+NpyArray_FieldsToDatetime(npy_datetimefields *in, npy_intp n,
+                          NPY_DATETIMEUNIT fr, char *data, npy_intp stride)
+{
+    npy_datetimestruct dts;
+    npy_intp i;
+
+    switch (fr) {
+    case NPY_FR_D:
+        _FIELDS_TO_DATETIME_LOOP(1, 86400, 1, 1, 1, 0);
+        return 0;
+    case NPY_FR_h:
+        _FIELDS_TO_DATETIME_LOOP(24, 3600, 1, 1, 1, 0);
+        return 0;
+    case NPY_FR_m:
+        _FIELDS_TO_DATETIME_LOOP(1440, 60, 1, 1, 1, 0);
+        return 0;
+    case NPY_FR_s:
+        _FIELDS_TO_DATETIME_LOOP(86400, 1, 1, 1, 1, 0);
+        return 0;
+    case NPY_FR_ms:
+        _FIELDS_TO_DATETIME_LOOP(86400000, 0, 1000, 1, 1000, 0);
+        return 0;
+    case NPY_FR_us:
+        _FIELDS_TO_DATETIME_LOOP(86400000000LL, 0, 1000000, 1, 1, 0);
+        return 0;
+    case NPY_FR_ns:
+        _FIELDS_TO_DATETIME_LOOP(86400000000000LL, 0, 1000000000,
+                                 1000, 1, 1000);
+        return 0;
+    default:
+        break;
+    }
+
+    for (i = 0; i < n; i++, data += stride) {
+        dts.year = (in->year != NULL) ? in->year[i] : 1970;
+        dts.month = (in->month != NULL) ? in->month[i] : 1;
+        dts.day = (in->day != NULL) ? in->day[i] : 1;
+        dts.hour = (in->hour != NULL) ? in->hour[i] : 0;
+        dts.min = (in->min != NULL) ? in->min[i] : 0;
+        dts.sec = (in->sec != NULL) ? in->sec[i] : 0;
+        dts.us = (in->us != NULL) ? in->us[i] : 0;
+        dts.ps = (in->ps != NULL) ? in->ps[i] : 0;
+        dts.as = (in->as != NULL) ? in->as[i] : 0;
+        *(npy_datetime *)data = NpyArray_DatetimeStructToDatetime(fr, &dts);
+        if (NpyErr_Occurred()) {
+            return -1;
+        }
+    }
+    return 0;
+
+month_error:
+    NpyErr_SetString(NpyExc_ValueError, "month out of range (1-12)");
+    return -1;
+
+day_error:
+    NpyErr_SetString(NpyExc_ValueError, "day out of range");
+    return -1;
+}
+
+#undef _DATETIME_TO_FIELDS_LOOP
+#undef _FIELDS_TO_DATETIME_LOOP
+
 /*
  * FIXME: Overflow is not handled at all
  *   To convert from Years, Months, and Business Days, multiplication by
@@ -927,3 +1152,180 @@ NpyArray_TimedeltaToTimedeltaStruct(npy_timedelta val, NPY_DATETIMEUNIT fr,
     }
     return;
 }
+
+
+/*
+ * Conversion of datetime and timedelta values between resolutions.
+ *
+ * Between the linear units (weeks down to attoseconds) a change of
+ * resolution is an integer multiply or a floor division, so these are
+ * done directly on the values.  Years, months and business days have
+ * no fixed length and are converted through the struct representation.
+ */
+
+/* Number of units of the next finer linear unit in one unit */
+static npy_int64 _datetime_unit_steps[NPY_DATETIME_NUMUNITS] = {
+    0, 0, 7, 0, 24, 60, 60, 1000, 1000, 1000, 1000, 1000, 1000, 1
+};
+
+#define _IS_LINEAR_UNIT(unit) ((unit) != NPY_FR_Y && (unit) != NPY_FR_M \
+                               && (unit) != NPY_FR_B)
+
+/*
+ * Number of units of fine in one unit of coarse, both linear with
+ * coarse <= fine.  Returns -1 if the factor does not fit in 64 bits.
+ */
+static int
+_datetime_unit_factor(NPY_DATETIMEUNIT coarse, NPY_DATETIMEUNIT fine,
+                      npy_int64 *factor)
+{
+    npy_int64 f = 1;
+    int unit;
+
+    for (unit = coarse; unit < fine; unit++) {
+        /* Weeks step straight to days */
+        if (unit == NPY_FR_B) {
+            continue;
+        }
+        if (f > NPY_MAX_INT64 / _datetime_unit_steps[unit]) {
+            return -1;
+        }
+        f *= _datetime_unit_steps[unit];
+    }
+    *factor = f;
+    return 0;
+}
+
+static npy_int64
+_datetime_gcd(npy_int64 a, npy_int64 b)
+{
+    npy_int64 t;
+
+    while (b != 0) {
+        t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+/*
+ * Rescale n datetime (or, if timedelta is true, timedelta) values from
+ * the resolution described by from to the one described by to.  The
+ * result is the floor of the exact value in the new unit.  src and dst
+ * may be the same buffer.  Units with a denominator other than 1 are
+ * not supported.  Returns 0 on success, or -1 with an error set if a
+ * value does not fit in the new unit.
+ */
+NDARRAY_API int
+NpyArray_DatetimeRescale(npy_datetime *src, npy_datetime *dst, npy_intp n,
+                         NpyArray_DateTimeInfo *from,
+                         NpyArray_DateTimeInfo *to, int timedelta)
+{
+    npy_int64 factor, mul, div, g, lo, hi, rem;
+    npy_intp i;
+    int overflow = 0;
+
+    if (from->den != 1 || to->den != 1) {
+        NpyErr_SetString(NpyExc_ValueError,
+                         "cannot rescale datetime units with a denominator");
+        return -1;
+    }
+    if (!_IS_LINEAR_UNIT(from->base) || !_IS_LINEAR_UNIT(to->base)) {
+        npy_datetimestruct dts;
+        npy_timedeltastruct tds;
+        npy_int64 val;
+
+        lo = NPY_MIN_INT64 / from->num;
+        hi = NPY_MAX_INT64 / from->num;
+        for (i = 0; i < n; i++) {
+            if (src[i] < lo || src[i] > hi) {
+                overflow = 1;
+                dst[i] = 0;
+                continue;
+            }
+            if (timedelta) {
+                NpyArray_TimedeltaToTimedeltaStruct(src[i] * from->num,
+                                                    from->base, &tds);
+                val = NpyArray_TimedeltaStructToTimedelta(to->base, &tds);
+            }
+            else {
+                NpyArray_DatetimeToDatetimeStruct(src[i] * from->num,
+                                                  from->base, &dts);
+                val = NpyArray_DatetimeStructToDatetime(to->base, &dts);
+            }
+            dst[i] = _FLOORDIV(val, (npy_int64)to->num, &rem);
+        }
+        if (NpyErr_Occurred()) {
+            return -1;
+        }
+        goto finish;
+    }
+
+    if (from->base <= to->base) {
+        if (_datetime_unit_factor(from->base, to->base, &factor) < 0 ||
+                factor > NPY_MAX_INT64 / from->num) {
+            /* Only zero is representable in the new unit */
+            for (i = 0; i < n; i++) {
+                overflow |= (src[i] != 0);
+                dst[i] = 0;
+            }
+            goto finish;
+        }
+        mul = factor * from->num;
+        div = to->num;
+    }
+    else {
+        if (_datetime_unit_factor(to->base, from->base, &factor) < 0 ||
+                factor > NPY_MAX_INT64 / to->num) {
+            /* Every value rounds to the epoch or just before it */
+            for (i = 0; i < n; i++) {
+                dst[i] = (src[i] < 0) ? -1 : 0;
+            }
+            return 0;
+        }
+        mul = from->num;
+        div = factor * to->num;
+    }
+    g = _datetime_gcd(mul, div);
+    mul /= g;
+    div /= g;
+    lo = NPY_MIN_INT64 / mul;
+    hi = NPY_MAX_INT64 / mul;
+
+    if (div == 1 && mul == 1) {
+        if (src != dst) {
+            memmove(dst, src, n * sizeof(npy_datetime));
+        }
+    }
+    else if (div == 1) {
+        for (i = 0; i < n; i++) {
+            overflow |= (src[i] < lo) | (src[i] > hi);
+            dst[i] = src[i] * mul;
+        }
+    }
+    else if (mul == 1) {
+        for (i = 0; i < n; i++) {
+            dst[i] = _FLOORDIV(src[i], div, &rem);
+        }
+    }
+    else {
+        npy_int64 val;
+
+        for (i = 0; i < n; i++) {
+            overflow |= (src[i] < lo) | (src[i] > hi);
+            val = src[i] * mul;
+            dst[i] = _FLOORDIV(val, div, &rem);
+        }
+    }
+
+finish:
+    if (overflow) {
+        NpyErr_SetString(NpyExc_ValueError,
+                         "datetime value out of range for the target unit");
+        return -1;
+    }
+    return 0;
+}
+
+#undef _IS_LINEAR_UNIT
@@ -97,6 +97,16 @@ typedef struct {
     int sec, us, ps, as;
 } npy_timedeltastruct;
 
+/*
+ * Structure-of-arrays form of npy_datetimestruct used by the bulk
+ * conversion routines.  Each member points to an array of field values;
+ * NULL members are skipped on output and take their default on input.
+ */
+typedef struct {
+    npy_longlong *year;
+    int *month, *day, *hour, *min, *sec, *us, *ps, *as;
+} npy_datetimefields;
+
 
 
 
@@ -214,6 +224,13 @@ typedef enum {
 } NPY_CLIPMODE;
 
 
+typedef enum {
+    NPY_OVERLAP_NONE=0,
+    NPY_OVERLAP_SAME=1,
+    NPY_OVERLAP_PARTIAL=2
+} NPY_OVERLAP;
+
+
 typedef enum {
     NPY_FR_Y,
     NPY_FR_M,
@@ -167,11 +167,16 @@ struct NpyArray_ArrFuncs {
     NpyArray_FastPutmaskFunc *fastputmask;
     NpyArray_FastTakeFunc *fasttake;
 
+    /*
+     * Function to select smallest
+     * Can be NULL
+     */
+    NpyArray_ArgFunc *argmin;
+
     /*
      * A little room to grow --- should use generic function
      * interface for most additions
      */
-    void *pad1;
     void *pad2;
     void *pad3;
     void *pad4;
@@ -10,7 +10,15 @@
  \*--------------------------------------------------------------------------*/
 
 /* Adapted for use in NumPy to replace usage of CPython PyDict functions.
-   The bulk of the edits are for NumPy style guidelines and function naming. */
+   The bulk of the edits are for NumPy style guidelines and function naming.
+
+   The original separately-chained buckets have since been replaced by
+   open addressing with Robin Hood probing: the key/value pairs live
+   inline in a single power-of-two sized array together with their full
+   hash value, so lookups touch one contiguous run of memory, need no
+   per-entry allocation and only call the key comparison function when
+   the cached hashes match.  Entries are removed by shifting the rest of
+   the probe sequence back, so no tombstones are needed. */
 
 
 #include <stdio.h>
@@ -24,20 +32,17 @@
 
 static int pointercmp(const void *pointer1, const void *pointer2);
 static unsigned long pointerHashFunction(const void *pointer);
-static int isProbablePrime(long number);
-static long calculateIdealNumOfBuckets(struct NpyDict_struct *hashTable);
 
 struct NpyDict_KVPair_struct {
-    const void *key;
+    const void *key;            /* NULL marks an empty slot */
     void *value;
-    struct NpyDict_KVPair_struct *next;
+    unsigned long hash;         /* mixed hash of key */
 };
 
 struct NpyDict_struct {
-    long numOfBuckets;
+    long numOfBuckets;          /* always a power of two */
     long numOfElements;
-    NpyDict_KVPair **bucketArray;
-    float idealRatio, lowerRehashThreshold, upperRehashThreshold;
+    NpyDict_KVPair *bucketArray;
     int (*keycmp)(const void *key1, const void *key2);
     int (*valuecmp)(const void *value1, const void *value2);
     unsigned long (*hashFunction)(const void *key);
@@ -45,6 +50,157 @@ struct NpyDict_struct {
     void (*valueDeallocator)(void *value);
 };
 
+/* Smallest table allocated */
+#define NPY_DICT_MINSIZE 8
+
+/* The table grows once it is more than 7/8 full */
+#define NPY_DICT_ISFULL(numOfElements, numOfBuckets) \
+    (8 * (numOfElements) > 7 * (numOfBuckets))
+
+/* Distance of the entry in slot i from the slot its hash maps to */
+#define NPY_DICT_DIST(hashTable, pair, i) \
+    (((i) - (long)((pair)->hash & ((hashTable)->numOfBuckets - 1))) & \
+     ((hashTable)->numOfBuckets - 1))
+
+
+/*
+ * The user supplied hash functions are often weak in the low bits (the
+ * default one is a shifted pointer), which is all the table mask looks
+ * at, so the bits are mixed first.  This is the finalizer of MurmurHash3.
+ */
+static NPY_INLINE unsigned long
+mixHash(unsigned long h)
+{
+    h ^= h >> 16;
+    h *= 0x85ebca6bUL;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35UL;
+    h ^= h >> 16;
+    return h;
+}
+
+static long
+roundUpToPowerOfTwo(long n)
+{
+    long size = NPY_DICT_MINSIZE;
+
+    while (size < n) {
+        size <<= 1;
+    }
+    return size;
+}
+
+/*
+ * Returns the slot holding key, or NULL.  Because entries are kept in
+ * Robin Hood order the search can stop as soon as it reaches an entry
+ * closer to its home slot than the probe distance so far.
+ */
+static NpyDict_KVPair *
+findPair(const NpyDict *hashTable, const void *key, unsigned long hash)
+{
+    long mask = hashTable->numOfBuckets - 1;
+    long i = hash & mask;
+    long dist = 0;
+    NpyDict_KVPair *pair;
+
+    for (;;) {
+        pair = &hashTable->bucketArray[i];
+        if (pair->key == NULL || NPY_DICT_DIST(hashTable, pair, i) < dist) {
+            return NULL;
+        }
+        if (pair->hash == hash && hashTable->keycmp(key, pair->key) == 0) {
+            return pair;
+        }
+        i = (i + 1) & mask;
+        dist++;
+    }
+}
+
+/*
+ * Inserts a key known not to be in the table, which must have a free
+ * slot.  Richer entries are displaced along the probe sequence.
+ */
+static void
+insertPair(NpyDict *hashTable, const void *key, void *value,
+           unsigned long hash)
+{
+    long mask = hashTable->numOfBuckets - 1;
+    long i = hash & mask;
+    long dist = 0, pairDist;
+    NpyDict_KVPair entry, tmp, *pair;
+
+    entry.key = key;
+    entry.value = value;
+    entry.hash = hash;
+    for (;;) {
+        pair = &hashTable->bucketArray[i];
+        if (pair->key == NULL) {
+            *pair = entry;
+            hashTable->numOfElements++;
+            return;
+        }
+        pairDist = NPY_DICT_DIST(hashTable, pair, i);
+        if (pairDist < dist) {
+            tmp = *pair;
+            *pair = entry;
+            entry = tmp;
+            dist = pairDist;
+        }
+        i = (i + 1) & mask;
+        dist++;
+    }
+}
+
+/*
+ * Removes the entry in the given slot without deallocating anything,
+ * shifting the following entries of the probe sequence back by one.
+ */
+static void
+erasePair(NpyDict *hashTable, NpyDict_KVPair *pair)
+{
+    long mask = hashTable->numOfBuckets - 1;
+    long i = pair - hashTable->bucketArray;
+    long next;
+
+    for (;;) {
+        next = (i + 1) & mask;
+        pair = &hashTable->bucketArray[next];
+        if (pair->key == NULL || NPY_DICT_DIST(hashTable, pair, next) == 0) {
+            break;
+        }
+        hashTable->bucketArray[i] = *pair;
+        i = next;
+    }
+    hashTable->bucketArray[i].key = NULL;
+    hashTable->bucketArray[i].value = NULL;
+    hashTable->numOfElements--;
+}
+
+static int
+resizeTable(NpyDict *hashTable, long numOfBuckets)
+{
+    NpyDict_KVPair *oldArray = hashTable->bucketArray;
+    long oldNumOfBuckets = hashTable->numOfBuckets;
+    long i;
+
+    hashTable->bucketArray = (NpyDict_KVPair *)
+        calloc(numOfBuckets, sizeof(NpyDict_KVPair));
+    if (hashTable->bucketArray == NULL) {
+        hashTable->bucketArray = oldArray;
+        return -1;
+    }
+    hashTable->numOfBuckets = numOfBuckets;
+    hashTable->numOfElements = 0;
+    for (i = 0; i < oldNumOfBuckets; i++) {
+        if (oldArray[i].key != NULL) {
+            insertPair(hashTable, oldArray[i].key, oldArray[i].value,
+                       oldArray[i].hash);
+        }
+    }
+    free(oldArray);
+    return 0;
+}
+
 
 /*--------------------------------------------------------------------------*\
  *  NAME:
@@ -56,19 +212,10 @@ struct NpyDict_struct {
  *  EFFICIENCY:
  *      O(1)
  *  ARGUMENTS:
- *      numOfBuckets - the number of buckets to start the NpyDict out with.
- *                     Must be greater than zero, and should be prime.
- *                     Ideally, the number of buckets should between 1/5
- *                     and 1 times the expected number of elements in the
- *                     NpyDict.  Values much more or less than this will
- *                     result in wasted memory or decreased performance
- *                     respectively.  The number of buckets in a NpyDict
- *                     can be re-calculated to an appropriate number by
- *                     calling the NpyDictRehash() function once the
- *                     NpyDict has been populated.  The number of buckets
- *                     in a NpyDict may also be re-calculated
- *                     automatically if the ratio of elements to buckets
- *                     passes the thresholds set by NpyDictSetIdealRatio().
+ *      numOfBuckets - a hint for the number of elements the NpyDict will
+ *                     hold.  Must be greater than zero.  The table is
+ *                     allocated with the next power of two slots (at
+ *                     least 8) and grows automatically as needed.
  *  RETURNS:
  *      NpyDict    - a new NpyDict, or NULL on error
  \*--------------------------------------------------------------------------*/
@@ -77,7 +224,6 @@ NpyDict *
 NpyDict_CreateTable(long numOfBuckets)
 {
     NpyDict *hashTable;
-    int i;
 
     assert(numOfBuckets > 0);
 
@@ -85,8 +231,9 @@ NpyDict_CreateTable(long numOfBuckets)
     if (hashTable == NULL)
         return NULL;
 
-    hashTable->bucketArray = (NpyDict_KVPair **)
-    malloc(numOfBuckets * sizeof(NpyDict_KVPair *));
+    numOfBuckets = roundUpToPowerOfTwo(numOfBuckets);
+    hashTable->bucketArray = (NpyDict_KVPair *)
+        calloc(numOfBuckets, sizeof(NpyDict_KVPair));
     if (hashTable->bucketArray == NULL) {
         free(hashTable);
         return NULL;
@@ -95,13 +242,6 @@ NpyDict_CreateTable(long numOfBuckets)
     hashTable->numOfBuckets = numOfBuckets;
     hashTable->numOfElements = 0;
 
-    for (i=0; i<numOfBuckets; i++)
-        hashTable->bucketArray[i] = NULL;
-
-    hashTable->idealRatio = 3.0;
-    hashTable->lowerRehashThreshold = 0.0;
-    hashTable->upperRehashThreshold = 15.0;
-
     hashTable->keycmp = pointercmp;
     hashTable->valuecmp = pointercmp;
     hashTable->hashFunction = pointerHashFunction;
@@ -127,18 +267,15 @@ NpyDict_CreateTable(long numOfBuckets)
 void
 NpyDict_Destroy(NpyDict *hashTable)
 {
-    int i;
+    long i;
 
     for (i=0; i<hashTable->numOfBuckets; i++) {
-        NpyDict_KVPair *pair = hashTable->bucketArray[i];
-        while (pair != NULL) {
-            NpyDict_KVPair *nextPair = pair->next;
+        NpyDict_KVPair *pair = &hashTable->bucketArray[i];
+        if (pair->key != NULL) {
             if (hashTable->keyDeallocator != NULL)
                 hashTable->keyDeallocator((void *) pair->key);
             if (hashTable->valueDeallocator != NULL)
                 hashTable->valueDeallocator(pair->value);
-            free(pair);
-            pair = nextPair;
         }
     }
 
@@ -165,25 +302,31 @@ NpyDict_Destroy(NpyDict *hashTable)
 NpyDict *
 NpyDict_Copy(const NpyDict *orig, void *(*copyKey)(void *), void *(*copyValue)(void *))
 {
-    int i;
+    long i;
     NpyDict *copy;
 
     copy = (NpyDict *)malloc(sizeof(NpyDict));
+    if (copy == NULL) {
+        return NULL;
+    }
     memcpy(copy, orig, sizeof(NpyDict));
-    copy->bucketArray = (NpyDict_KVPair **)malloc(copy->numOfBuckets * sizeof(NpyDict_KVPair *));
-
-    /* Duplicate each table entry. */
-    for (i = 0; i < copy->numOfBuckets; i++) {
-        NpyDict_KVPair *pair = orig->bucketArray[i];
-
-        copy->bucketArray[i] = NULL;
-        while (pair != NULL) {
-            NpyDict_KVPair *newEntry = (NpyDict_KVPair *)malloc(sizeof(NpyDict_KVPair));
-            newEntry->key = copyKey((void *)pair->key);
-            newEntry->value = copyValue((void *)pair->value);
-            newEntry->next = copy->bucketArray[i];
-            copy->bucketArray[i] = newEntry;
-            pair = pair->next;
+    copy->numOfElements = 0;
+    copy->bucketArray = (NpyDict_KVPair *)
+        calloc(copy->numOfBuckets, sizeof(NpyDict_KVPair));
+    if (copy->bucketArray == NULL) {
+        free(copy);
+        return NULL;
+    }
+
+    /* Duplicate each table entry.  The copied keys are hashed again
+       since the hash function may depend on their address. */
+    for (i = 0; i < orig->numOfBuckets; i++) {
+        NpyDict_KVPair *pair = &orig->bucketArray[i];
+
+        if (pair->key != NULL) {
+            const void *key = copyKey((void *)pair->key);
+            insertPair(copy, key, copyValue(pair->value),
+                       mixHash(copy->hashFunction(key)));
         }
     }
     return copy;
@@ -200,7 +343,7 @@ NpyDict_Copy(const NpyDict *orig, void *(*copyKey)(void *), void *(*copyValue)(v
  *      specified key.  Uses the comparison function specified by
  *      NpyDictSetKeyComparisonFunction().
  *  EFFICIENCY:
- *      O(1), assuming a good hash function and element-to-bucket ratio
+ *      O(1), assuming a good hash function
  *  ARGUMENTS:
  *      NpyDict    - the NpyDict to search
  *      key          - the key to search for
@@ -238,15 +381,12 @@ NpyDict_ContainsKey(const NpyDict *hashTable, const void *key)
 int
 NpyDict_ContainsValue(const NpyDict *hashTable, const void *value)
 {
-    int i;
+    long i;
 
     for (i=0; i<hashTable->numOfBuckets; i++) {
-        NpyDict_KVPair *pair = hashTable->bucketArray[i];
-        while (pair != NULL) {
-            if (hashTable->valuecmp(value, pair->value) == 0)
-                return 1;
-            pair = pair->next;
-        }
+        NpyDict_KVPair *pair = &hashTable->bucketArray[i];
+        if (pair->key != NULL && hashTable->valuecmp(value, pair->value) == 0)
+            return 1;
     }
 
     return 0;
@@ -259,11 +399,10 @@ NpyDict_ContainsValue(const NpyDict *hashTable, const void *value)
  *      Adds the specified key/value pair to the specified HashTable.  If
  *      the key already exists in the HashTable (determined by the comparison
  *      function specified by HashTableSetKeyComparisonFunction()), its value
- *      is replaced by the new value.  May trigger an auto-rehash (see
- *      HashTableSetIdealRatio()).  It is illegal to specify NULL as the
- *      key or value.
+ *      is replaced by the new value.  May grow the table.  It is illegal to
+ *      specify NULL as the key or value.
  *  EFFICIENCY:
- *      O(1), assuming a good hash function and element-to-bucket ratio
+ *      O(1), assuming a good hash function
  *  ARGUMENTS:
  *      hashTable    - the HashTable to add to
  *      key          - the key to add or whose value to replace
@@ -275,17 +414,14 @@ NpyDict_ContainsValue(const NpyDict *hashTable, const void *value)
 int
 NpyDict_Put(NpyDict *hashTable, const void *key, void *value)
 {
-    long hashValue;
+    unsigned long hash;
     NpyDict_KVPair *pair;
 
     assert(key != NULL);
     assert(value != NULL);
 
-    hashValue = hashTable->hashFunction(key) % hashTable->numOfBuckets;
-    pair = hashTable->bucketArray[hashValue];
-
-    while (pair != NULL && hashTable->keycmp(key, pair->key) != 0)
-        pair = pair->next;
+    hash = mixHash(hashTable->hashFunction(key));
+    pair = findPair(hashTable, key, hash);
 
     if (pair) {
         if (pair->key != key) {
@@ -300,26 +436,16 @@ NpyDict_Put(NpyDict *hashTable, const void *key, void *value)
         }
     }
     else {
-        NpyDict_KVPair *newPair = (NpyDict_KVPair *) malloc(sizeof(NpyDict_KVPair));
-        if (newPair == NULL) {
+        /* Grow to a quarter full so tables filled one key at a time
+           are only resized a few times. */
+        if (NPY_DICT_ISFULL(hashTable->numOfElements + 1,
+                            hashTable->numOfBuckets) &&
+            resizeTable(hashTable, roundUpToPowerOfTwo(
+                            4 * (hashTable->numOfElements + 1))) < 0) {
             return -1;
         }
-        else {
-            newPair->key = key;
-            newPair->value = value;
-            newPair->next = hashTable->bucketArray[hashValue];
-            hashTable->bucketArray[hashValue] = newPair;
-            hashTable->numOfElements++;
-
-            if (hashTable->upperRehashThreshold > hashTable->idealRatio) {
-                float elementToBucketRatio = (float) hashTable->numOfElements /
-                (float) hashTable->numOfBuckets;
-                if (elementToBucketRatio > hashTable->upperRehashThreshold)
-                    NpyDict_Rehash(hashTable, 0);
-            }
-        }
+        insertPair(hashTable, key, value, hash);
     }
-
     return 0;
 }
 
@@ -331,7 +457,7 @@ NpyDict_Put(NpyDict *hashTable, const void *key, void *value)
  *      Uses the comparison function specified by
  *      HashTableSetKeyComparisonFunction().
  *  EFFICIENCY:
- *      O(1), assuming a good hash function and element-to-bucket ratio
+ *      O(1), assuming a good hash function
  *  ARGUMENTS:
  *      hashTable    - the HashTable to search
  *      key          - the key whose value is desired
@@ -343,28 +469,24 @@ NpyDict_Put(NpyDict *hashTable, const void *key, void *value)
 void *
 NpyDict_Get(const NpyDict *hashTable, const void *key)
 {
-    long hashValue = hashTable->hashFunction(key) % hashTable->numOfBuckets;
-    NpyDict_KVPair *pair = hashTable->bucketArray[hashValue];
-
-    while (pair != NULL && hashTable->keycmp(key, pair->key) != 0)
-        pair = pair->next;
+    NpyDict_KVPair *pair;
 
+    pair = findPair(hashTable, key, mixHash(hashTable->hashFunction(key)));
     return (pair == NULL)? NULL : pair->value;
 }
 
 
-
 /*--------------------------------------------------------------------------*\
  *  NAME:
  *      NpyDict_Rekey() - efficiently changes a key
  *  DESCRIPTION:
  *      Removes the original key and re-inserts the value under the new key.
- *      This is the same as get/remove/put but avoids a bunch of memory
- *      allocations/deallocations.
+ *      This is the same as get/remove/put but avoids deallocating and
+ *      re-creating the value.
  *      NOTE: Same as remove, the original key is deallocated!
  *      NOTE: If the newKey already exists, the existing value is removed first.
  *  EFFICIENCY:
- *      O(1), assuming a good hash function and element-to-bucket ratio
+ *      O(1), assuming a good hash function
  *  ARGUMENTS:
  *      hashTable    - the HashTable to re-key
  *      origKey      - the current key value
@@ -375,57 +497,41 @@ NpyDict_Get(const NpyDict *hashTable, const void *key)
 
 void NpyDict_Rekey(NpyDict *hashTable, const void *oldKey, const void *newKey)
 {
-    long hashValue = hashTable->hashFunction(oldKey) % hashTable->numOfBuckets;
-    NpyDict_KVPair *pair = hashTable->bucketArray[hashValue];
-    NpyDict_KVPair *previousPair = NULL;
-    NpyDict_KVPair *pairToIns = NULL;
-
-    while (pair != NULL && hashTable->keycmp(oldKey, pair->key) != 0) {
-        previousPair = pair;
-        pair = pair->next;
-    }
+    NpyDict_KVPair *pair;
+    void *value;
 
+    pair = findPair(hashTable, oldKey,
+                    mixHash(hashTable->hashFunction(oldKey)));
     if (pair != NULL) {
         if (hashTable->keyDeallocator != NULL)
             hashTable->keyDeallocator((void *) pair->key);
-        if (previousPair != NULL)
-            previousPair->next = pair->next;
-        else
-            hashTable->bucketArray[hashValue] = pair->next;
-
-        pairToIns = pair;
-
-        /* Re-insert pair using the new key. */
-        hashValue = hashTable->hashFunction(newKey) % hashTable->numOfBuckets;
-        pair = hashTable->bucketArray[hashValue];
-
-        while (pair != NULL && hashTable->keycmp(newKey, pair->key) != 0)
-            pair = pair->next;
+        value = pair->value;
+        erasePair(hashTable, pair);
 
+        /* Re-insert the value using the new key.  The table had room for
+           the old entry so this never needs to grow it. */
+        pair = findPair(hashTable, newKey,
+                        mixHash(hashTable->hashFunction(newKey)));
         if (pair) {
             if (pair->key != newKey) {
                 if (hashTable->keyDeallocator != NULL)
                     hashTable->keyDeallocator((void *) pair->key);
                 pair->key = newKey;
             }
-            if (pair->value != pairToIns->value) {
+            if (pair->value != value) {
                 if (hashTable->valueDeallocator != NULL)
                     hashTable->valueDeallocator(pair->value);
-                pair->value = pairToIns->value;
+                pair->value = value;
             }
-            free(pairToIns);
         }
         else {
-            pairToIns->key = newKey;
-            /* value is already set - doesn't change */
-            pairToIns->next = hashTable->bucketArray[hashValue];
-            hashTable->bucketArray[hashValue] = pairToIns;
+            insertPair(hashTable, newKey, value,
+                       mixHash(hashTable->hashFunction(newKey)));
         }
     }
 }
 
 
-
 /*--------------------------------------------------------------------------*\
  *  NAME:
  *      NpyDict_ForceValue() - re-sets the value for a key & skips any value
@@ -437,22 +543,18 @@ void NpyDict_Rekey(NpyDict *hashTable, const void *oldKey, const void *newKey)
  *
  *      If the key doesn't already exist, nothing is modified.
  *  EFFICIENCY:
- *      O(1), assuming a good hash function and element-to-bucket ratio
+ *      O(1), assuming a good hash function
  *  ARGUMENTS:
  *      hashTable    - the HashTable to search
  *      key          - the key whose value is desired
  *      value        - the new value
  \*--------------------------------------------------------------------------*/
-
 void
 NpyDict_ForceValue(NpyDict *hashTable, const void *key, void *value)
 {
-    long hashValue = hashTable->hashFunction(key) % hashTable->numOfBuckets;
-    NpyDict_KVPair *pair = hashTable->bucketArray[hashValue];
-
-    while (pair != NULL && hashTable->keycmp(key, pair->key) != 0)
-        pair = pair->next;
+    NpyDict_KVPair *pair;
 
+    pair = findPair(hashTable, key, mixHash(hashTable->hashFunction(key)));
     if (NULL != pair) pair->value = value;
 }
 
@@ -462,10 +564,9 @@ NpyDict_ForceValue(NpyDict *hashTable, const void *key, void *value)
  *      NpyDict_Remove() - removes a key/value pair from a HashTable
  *  DESCRIPTION:
  *      Removes the key/value pair identified by the specified key from the
- *      specified HashTable if the key exists in the HashTable.  May trigger
- *      an auto-rehash (see HashTableSetIdealRatio()).
+ *      specified HashTable if the key exists in the HashTable.
  *  EFFICIENCY:
- *      O(1), assuming a good hash function and element-to-bucket ratio
+ *      O(1), assuming a good hash function
  *  ARGUMENTS:
  *      hashTable    - the HashTable to remove the key/value pair from
  *      key          - the key specifying the key/value pair to be removed
@@ -476,33 +577,15 @@ NpyDict_ForceValue(NpyDict *hashTable, const void *key, void *value)
 void
 NpyDict_Remove(NpyDict *hashTable, const void *key)
 {
-    long hashValue = hashTable->hashFunction(key) % hashTable->numOfBuckets;
-    NpyDict_KVPair *pair = hashTable->bucketArray[hashValue];
-    NpyDict_KVPair *previousPair = NULL;
-
-    while (pair != NULL && hashTable->keycmp(key, pair->key) != 0) {
-        previousPair = pair;
-        pair = pair->next;
-    }
+    NpyDict_KVPair *pair;
 
+    pair = findPair(hashTable, key, mixHash(hashTable->hashFunction(key)));
     if (pair != NULL) {
         if (hashTable->keyDeallocator != NULL)
             hashTable->keyDeallocator((void *) pair->key);
         if (hashTable->valueDeallocator != NULL)
             hashTable->valueDeallocator(pair->value);
-        if (previousPair != NULL)
-            previousPair->next = pair->next;
-        else
-            hashTable->bucketArray[hashValue] = pair->next;
-        free(pair);
-        hashTable->numOfElements--;
-
-        if (hashTable->lowerRehashThreshold > 0.0) {
-            float elementToBucketRatio = (float) hashTable->numOfElements /
-            (float) hashTable->numOfBuckets;
-            if (elementToBucketRatio < hashTable->lowerRehashThreshold)
-                NpyDict_Rehash(hashTable, 0);
-        }
+        erasePair(hashTable, pair);
     }
 }
 
@@ -510,8 +593,8 @@ NpyDict_Remove(NpyDict *hashTable, const void *key)
  *  NAME:
  *      NpyDict_RemoveAll() - removes all key/value pairs from a HashTable
  *  DESCRIPTION:
- *      Removes all key/value pairs from the specified HashTable.  May trigger
- *      an auto-rehash (see HashTableSetIdealRatio()).
+ *      Removes all key/value pairs from the specified HashTable and
+ *      shrinks it to the minimum size.
  *  EFFICIENCY:
  *      O(n)
  *  ARGUMENTS:
@@ -523,28 +606,24 @@ NpyDict_Remove(NpyDict *hashTable, const void *key)
 void
 NpyDict_RemoveAll(NpyDict *hashTable)
 {
-    int i;
+    long i;
 
     for (i=0; i<hashTable->numOfBuckets; i++) {
-        NpyDict_KVPair *pair = hashTable->bucketArray[i];
-        while (pair != NULL) {
-            NpyDict_KVPair *nextPair = pair->next;
+        NpyDict_KVPair *pair = &hashTable->bucketArray[i];
+        if (pair->key != NULL) {
             if (hashTable->keyDeallocator != NULL)
                 hashTable->keyDeallocator((void *) pair->key);
             if (hashTable->valueDeallocator != NULL)
                 hashTable->valueDeallocator(pair->value);
-            free(pair);
-            pair = nextPair;
+            pair->key = NULL;
+            pair->value = NULL;
         }
-        hashTable->bucketArray[i] = NULL;
     }
-
     hashTable->numOfElements = 0;
-    NpyDict_Rehash(hashTable, 5);
+    NpyDict_Rehash(hashTable, NPY_DICT_MINSIZE);
 }
 
 
-
 /*--------------------------------------------------------------------------*\
  *  NAME:
  *      NpyDict_IterInit() - initializes an iterator
@@ -568,8 +647,6 @@ NpyDict_IterInit(NpyDict_Iter *iter)
 }
 
 
-
-
 /*--------------------------------------------------------------------------*\
  *  NAME:
  *      NpyDict_IterNext() - advances to the next element and returns it
@@ -593,18 +670,19 @@ NpyDict_IterInit(NpyDict_Iter *iter)
  *      bool         - true if a key/value pair is returned, false if the
  *                     end has been reached.
  \*--------------------------------------------------------------------------*/
+
 int
 NpyDict_IterNext(NpyDict *hashTable, NpyDict_Iter *iter, void **key, void **value)
 {
-    /* Advance to the next element in this bucket if there is one. Otherwise
-       find another bucket. */
-    if (NULL != iter->element) {
-        iter->element = iter->element->next;
-    }
-    while (NULL == iter->element && iter->bucket < hashTable->numOfBuckets-1) {
-        iter->element = hashTable->bucketArray[++iter->bucket];
+    /* Advance to the next occupied slot. */
+    iter->element = NULL;
+    while (iter->bucket < hashTable->numOfBuckets-1) {
+        NpyDict_KVPair *pair = &hashTable->bucketArray[++iter->bucket];
+        if (pair->key != NULL) {
+            iter->element = pair;
+            break;
+        }
     }
-
     if (NULL == iter->element) {
         *key = NULL;
         *value = NULL;
@@ -616,7 +694,6 @@ NpyDict_IterNext(NpyDict *hashTable, NpyDict_Iter *iter, void **key, void **valu
 }
 
 
-
 /*--------------------------------------------------------------------------*\
  *  NAME:
  *      NpyDict_IsEmpty() - determines if a HashTable is empty
@@ -661,17 +738,16 @@ NpyDict_Size(const NpyDict *hashTable)
 
 /*--------------------------------------------------------------------------*\
  *  NAME:
- *      NpyDict_GetNumBuckets() - returns the number of buckets in a HashTable
+ *      NpyDict_GetNumBuckets() - returns the number of slots in a HashTable
  *  DESCRIPTION:
- *      Returns the number of buckets that are in the specified HashTable.
- *      This may change dynamically throughout the life of a HashTable if
- *      automatic or manual rehashing is performed.
+ *      Returns the number of slots that are in the specified HashTable.
+ *      This changes as the HashTable grows or when it is rehashed.
  *  EFFICIENCY:
  *      O(1)
  *  ARGUMENTS:
- *      hashTable    - the HashTable whose number of buckets is requested
+ *      hashTable    - the HashTable whose number of slots is requested
  *  RETURNS:
- *      long         - the number of buckets that are in the specified
+ *      long         - the number of slots that are in the specified
  *                     HashTable
  \*--------------------------------------------------------------------------*/
 
@@ -689,7 +765,8 @@ NpyDict_GetNumBuckets(const NpyDict *hashTable)
  *      Specifies the function used to compare keys in the specified
  *      HashTable.  The specified function should return zero if the two
  *      keys are considered equal, and non-zero otherwise.  The default
- *      function is one that simply compares pointers.
+ *      function is one that simply compares pointers.  It is only called
+ *      for keys whose hash values are equal.
  *  ARGUMENTS:
  *      hashTable    - the HashTable whose key comparison function is being
  *                     specified
@@ -741,13 +818,14 @@ NpyDict_SetValueComparisonFunction(NpyDict *hashTable,
  *              - specifies the hash function used by a HashTable
  *  DESCRIPTION:
  *      Specifies the function used to determine the hash value for a key
- *      in the specified HashTable (before modulation).  An ideal hash
- *      function is one which is easy to compute and approximates a
- *      "random" function.  The default function is one that works
- *      relatively well for pointers.  If the HashTable keys are to be
- *      strings (which is probably the case), then this default function
- *      will not suffice, in which case consider using the provided
- *      HashTableStringHashFunction() function.
+ *      in the specified HashTable (before modulation).  The value is
+ *      mixed before use, so the function need not spread its bits
+ *      evenly, but equal keys must hash equally.  The default function
+ *      is one that works relatively well for pointers.  If the HashTable
+ *      keys are to be strings (which is probably the case), then this
+ *      default function will not suffice, in which case consider using
+ *      the provided HashTableStringHashFunction() function.  Must be set
+ *      before any keys are added.
  *  ARGUMENTS:
  *      hashTable    - the HashTable whose hash function is being specified
  *      hashFunction - a function which returns an appropriate hash code
@@ -761,31 +839,26 @@ NpyDict_SetHashFunction(NpyDict *hashTable,
                         unsigned long (*hashFunction)(const void *key))
 {
     assert(hashFunction != NULL);
+    assert(hashTable->numOfElements == 0);
     hashTable->hashFunction = hashFunction;
 }
 
+
 /*--------------------------------------------------------------------------*\
  *  NAME:
  *      NpyDict_Rehash() - reorganizes a HashTable to be more efficient
  *  DESCRIPTION:
  *      Reorganizes a HashTable to be more efficient.  If a number of
- *      buckets is specified, the HashTable is rehashed to that number of
- *      buckets.  If 0 is specified, the HashTable is rehashed to a number
- *      of buckets which is automatically calculated to be a prime number
- *      that achieves (as closely as possible) the ideal element-to-bucket
- *      ratio specified by the HashTableSetIdealRatio() function.
+ *      slots is specified, the HashTable is resized to the next power of
+ *      two at least that large (but large enough for its elements).  If
+ *      0 is specified, it is resized to the smallest size which keeps it
+ *      at most half full.
  *  EFFICIENCY:
  *      O(n)
  *  ARGUMENTS:
  *      hashTable    - the HashTable to be reorganized
- *      numOfBuckets - the number of buckets to rehash the HashTable to.
- *                     Should be prime.  Ideally, the number of buckets
- *                     should be between 1/5 and 1 times the expected
- *                     number of elements in the HashTable.  Values much
- *                     more or less than this will result in wasted memory
- *                     or decreased performance respectively.  If 0 is
- *                     specified, an appropriate number of buckets is
- *                     automatically calculated.
+ *      numOfBuckets - the number of slots to resize the HashTable to, or
+ *                     0 to calculate an appropriate size automatically.
  *  RETURNS:
  *      <nothing>
  \*--------------------------------------------------------------------------*/
@@ -793,81 +866,42 @@ NpyDict_SetHashFunction(NpyDict *hashTable,
 void
 NpyDict_Rehash(NpyDict *hashTable, long numOfBuckets)
 {
-    NpyDict_KVPair **newBucketArray;
-    int i;
-
     assert(numOfBuckets >= 0);
-    if (numOfBuckets == 0)
-        numOfBuckets = calculateIdealNumOfBuckets(hashTable);
 
-    if (numOfBuckets == hashTable->numOfBuckets)
-        return; /* already the right size! */
-
-    newBucketArray = (NpyDict_KVPair **)
-    malloc(numOfBuckets * sizeof(NpyDict_KVPair *));
-    if (newBucketArray == NULL) {
-        /* Couldn't allocate memory for the new array.  This isn't a fatal
-         * error; we just can't perform the rehash. */
-        return;
+    if (numOfBuckets == 0) {
+        numOfBuckets = 2 * hashTable->numOfElements;
     }
-
-    for (i=0; i<numOfBuckets; i++)
-        newBucketArray[i] = NULL;
-
-    for (i=0; i<hashTable->numOfBuckets; i++) {
-        NpyDict_KVPair *pair = hashTable->bucketArray[i];
-        while (pair != NULL) {
-            NpyDict_KVPair *nextPair = pair->next;
-            long hashValue = hashTable->hashFunction(pair->key) % numOfBuckets;
-            pair->next = newBucketArray[hashValue];
-            newBucketArray[hashValue] = pair;
-            pair = nextPair;
-        }
+    numOfBuckets = roundUpToPowerOfTwo(numOfBuckets);
+    while (NPY_DICT_ISFULL(hashTable->numOfElements, numOfBuckets)) {
+        numOfBuckets <<= 1;
     }
+    if (numOfBuckets == hashTable->numOfBuckets)
+        return; /* already the right size! */
 
-    free(hashTable->bucketArray);
-    hashTable->bucketArray = newBucketArray;
-    hashTable->numOfBuckets = numOfBuckets;
+    /* Failing to allocate the new array isn't a fatal error; we just
+       can't perform the rehash. */
+    resizeTable(hashTable, numOfBuckets);
 }
 
+
 /*--------------------------------------------------------------------------*\
  *  NAME:
  *      NpyDict_SetIdealRatio()
  *              - sets the ideal element-to-bucket ratio of a HashTable
  *  DESCRIPTION:
- *      Sets the ideal element-to-bucket ratio, as well as the lower and
- *      upper auto-rehash thresholds, of the specified HashTable.  Note
- *      that this function doesn't actually perform a rehash.
- *
- *      The default values for these properties are 3.0, 0.0 and 15.0
- *      respectively.  This is likely fine for most situations, so there
- *      is probably no need to call this function.
+ *      Retained for compatibility with the chained implementation.  The
+ *      open-addressing table always grows once it is 7/8 full and only
+ *      shrinks on NpyDict_RemoveAll() or an explicit NpyDict_Rehash(),
+ *      so the ratios are checked but otherwise ignored.
  *  ARGUMENTS:
  *      hashTable    - a HashTable
- *      idealRatio   - the ideal element-to-bucket ratio.  When a rehash
- *                     occurs (either manually via a call to the
- *                     NpyDict_Rehash() function or automatically due the
- *                     the triggering of one of the thresholds below), the
- *                     number of buckets in the HashTable will be
- *                     recalculated to be a prime number that achieves (as
- *                     closely as possible) this ideal ratio.  Must be a
- *                     positive number.
+ *      idealRatio   - the ideal element-to-bucket ratio
  *      lowerRehashThreshold
  *                   - the element-to-bucket ratio that is considered
- *                     unacceptably low (i.e., too few elements per bucket).
- *                     If the actual ratio falls below this number, a
- *                     rehash will automatically be performed.  Must be
- *                     lower than the value of idealRatio.  If no ratio
- *                     is considered unacceptably low, a value of 0.0 can
- *                     be specified.
+ *                     unacceptably low
  *      upperRehashThreshold
  *                   - the element-to-bucket ratio that is considered
- *                     unacceptably high (i.e., too many elements per bucket).
- *                     If the actual ratio rises above this number, a
- *                     rehash will automatically be performed.  Must be
- *                     higher than idealRatio.  However, if no ratio
- *                     is considered unacceptably high, a value of 0.0 can
- *                     be specified.
+ *                     unacceptably high
  *  RETURNS:
  *      <nothing>
  \*--------------------------------------------------------------------------*/
@@ -879,10 +913,6 @@ NpyDict_SetIdealRatio(NpyDict *hashTable, float idealRatio,
     assert(idealRatio > 0.0);
     assert(lowerRehashThreshold < idealRatio);
     assert(upperRehashThreshold == 0.0 || upperRehashThreshold > idealRatio);
-
-    hashTable->idealRatio = idealRatio;
-    hashTable->lowerRehashThreshold = lowerRehashThreshold;
-    hashTable->upperRehashThreshold = upperRehashThreshold;
 }
 
 /*--------------------------------------------------------------------------*\
@@ -956,27 +986,3 @@ static int pointercmp(const void *pointer1, const void *pointer2) {
 static unsigned long pointerHashFunction(const void *pointer) {
     return ((unsigned long) pointer) >> 4;
 }
-
-static int isProbablePrime(long oddNumber) {
-    long i;
-
-    for (i=3; i<51; i+=2)
-        if (oddNumber == i)
-            return 1;
-        else if (oddNumber%i == 0)
-            return 0;
-
-    return 1; /* maybe */
-}
-
-static long calculateIdealNumOfBuckets(NpyDict *hashTable) {
-    long idealNumOfBuckets = hashTable->numOfElements / hashTable->idealRatio;
-    if (idealNumOfBuckets < 5)
-        idealNumOfBuckets = 5;
-    else
-        idealNumOfBuckets |= 0x01; /* make it an odd number */
-    while (!isProbablePrime(idealNumOfBuckets))
-        idealNumOfBuckets += 2;
-
-    return idealNumOfBuckets;
-}
@@ -1328,3 +1328,320 @@ NDARRAY_API NpyTypeObject NpyArrayNeighborhoodIter_Type = {
     (npy_destructor)neighiter_dealloc,
     NULL
 };
+
+
+/*========================= Stencils ===================================*/
+
+/* interior points per kernel call */
+#define STENCIL_TILE 256
+
+/* ptr of the point at coordinates c of an array with the given strides */
+static char *
+stencil_ptr(char *data, int nd, npy_intp *strides, npy_intp *c)
+{
+    int i;
+
+    for (i = 0; i < nd; i++) {
+        data += c[i] * strides[i];
+    }
+    return data;
+}
+
+/*
+ * Advance c, over the first nd - 1 axes, through the box [lo, hi).
+ * Returns 0 when all rows are done.
+ */
+static int
+stencil_next_row(int nd, npy_intp *c, npy_intp *lo, npy_intp *hi)
+{
+    int i;
+
+    for (i = nd - 2; i >= 0; i--) {
+        if (++c[i] < hi[i]) {
+            return 1;
+        }
+        c[i] = lo[i];
+    }
+    return 0;
+}
+
+/*
+ * Border points [c0, c1) along the last axis of the row at c, with the
+ * neighbors found by the neighborhood iterator.
+ */
+static void
+stencil_border(NpyArrayNeighborhoodIterObject *niter, NpyArray *out,
+               npy_intp *c, npy_intp c0, npy_intp c1, char **ptrs,
+               NpyArray_StencilFunc *kernel, void *data)
+{
+    NpyArrayIterObject *x = niter->_internal_iter;
+    int nd = x->ao->nd;
+    npy_intp k, i;
+
+    for (i = 0; i < nd; i++) {
+        x->coordinates[i] = c[i];
+    }
+    for (x->coordinates[nd - 1] = c0; x->coordinates[nd - 1] < c1;
+         x->coordinates[nd - 1]++) {
+        NpyArrayNeighborhoodIter_Reset(niter);
+        for (k = 0; k < niter->size; k++) {
+            ptrs[k] = niter->dataptr;
+            NpyArrayNeighborhoodIter_Next(niter);
+        }
+        kernel(ptrs, niter->size, 0,
+               stencil_ptr(out->data, nd, out->strides, x->coordinates),
+               0, 1, data);
+    }
+}
+
+/*
+ * The interior, where every neighbor is at a fixed offset from the point,
+ * is done without the neighborhood iterator, in strips STENCIL_TILE
+ * points wide down all the rows, so that the rows a strip reads stay in
+ * cache.  Only the border goes through the padding logic.  With threads
+ * set the GIL is released around the kernel calls, once the arguments
+ * are checked and the iterators made, and taken back before they are
+ * freed.
+ */
+static int
+stencil_apply(NpyArray *in, NpyArray *out, npy_intp *bounds, int mode,
+              void *fill, NpyArray_StencilFunc *kernel, void *data,
+              int threads)
+{
+    NpyArrayIterObject *x = NULL;
+    NpyArrayNeighborhoodIterObject *niter = NULL;
+    npy_intp lo[NPY_MAXDIMS], hi[NPY_MAXDIMS], c[NPY_MAXDIMS];
+    npy_intp all_lo[NPY_MAXDIMS], nc[NPY_MAXDIMS];
+    npy_intp *offsets = NULL, n, k, s0, cnt, stride, ostride;
+    char **ptrs = NULL, *ip, *op;
+    int nd = in->nd, i, interior = 1, empty = 0, inside, ret = -1;
+    NPY_BEGIN_THREADS_DEF
+
+    if (nd < 1 || out->nd != nd) {
+        NpyErr_SetString(NpyExc_ValueError,
+                         "stencil input and output must have the same, "
+                         "nonzero, number of dimensions");
+        return -1;
+    }
+    for (i = 0; i < nd; i++) {
+        if (out->dimensions[i] != in->dimensions[i]) {
+            NpyErr_SetString(NpyExc_ValueError,
+                             "stencil input and output shapes differ");
+            return -1;
+        }
+        if (bounds[2*i] > bounds[2*i + 1]) {
+            NpyErr_SetString(NpyExc_ValueError, "invalid stencil bounds");
+            return -1;
+        }
+        /* points whose neighbors are all inside the array */
+        n = in->dimensions[i];
+        lo[i] = MAX(0, -bounds[2*i]);
+        hi[i] = n - MAX(0, bounds[2*i + 1]);
+        if (hi[i] > n) {
+            hi[i] = n;
+        }
+        if (hi[i] <= lo[i]) {
+            interior = 0;
+        }
+        if (n == 0) {
+            empty = 1;
+        }
+    }
+    if (mode == NPY_NEIGHBORHOOD_ITER_CONSTANT_PADDING && fill == NULL) {
+        NpyErr_SetString(NpyExc_ValueError,
+                         "constant padding needs a fill value");
+        return -1;
+    }
+    if (empty) {
+        return 0;
+    }
+
+    x = NpyArray_IterNew(in);
+    if (x == NULL) {
+        return -1;
+    }
+    niter = NpyArray_NeighborhoodIterNew(x, bounds, mode, fill, NULL);
+    if (niter == NULL) {
+        goto finish;
+    }
+    offsets = (npy_intp *)NpyArray_malloc(niter->size * sizeof(npy_intp));
+    ptrs = (char **)NpyArray_malloc(niter->size * sizeof(char *));
+    if (offsets == NULL || ptrs == NULL) {
+        NpyErr_MEMORY;
+        goto finish;
+    }
+
+    /* byte offsets of the neighbors, in iterator order */
+    for (i = 0; i < nd; i++) {
+        nc[i] = bounds[2*i];
+    }
+    for (k = 0; k < niter->size; k++) {
+        offsets[k] = 0;
+        for (i = 0; i < nd; i++) {
+            offsets[k] += nc[i] * in->strides[i];
+        }
+        for (i = nd - 1; i >= 0; i--) {
+            if (++nc[i] <= bounds[2*i + 1]) {
+                break;
+            }
+            nc[i] = bounds[2*i];
+        }
+    }
+
+    stride = in->strides[nd - 1];
+    ostride = out->strides[nd - 1];
+    if (threads) {
+        NPY_BEGIN_THREADS;
+    }
+    if (interior) {
+        for (s0 = lo[nd - 1]; s0 < hi[nd - 1]; s0 += STENCIL_TILE) {
+            cnt = hi[nd - 1] - s0;
+            if (cnt > STENCIL_TILE) {
+                cnt = STENCIL_TILE;
+            }
+            for (i = 0; i < nd; i++) {
+                c[i] = lo[i];
+            }
+            c[nd - 1] = s0;
+            do {
+                ip = stencil_ptr(in->data, nd, in->strides, c);
+                op = stencil_ptr(out->data, nd, out->strides, c);
+                for (k = 0; k < niter->size; k++) {
+                    ptrs[k] = ip + offsets[k];
+                }
+                kernel(ptrs, niter->size, stride, op, ostride, cnt, data);
+            } while (stencil_next_row(nd, c, lo, hi));
+        }
+    }
+
+    /* the border: rows outside the interior, and the ends of the others */
+    for (i = 0; i < nd; i++) {
+        all_lo[i] = c[i] = 0;
+        nc[i] = in->dimensions[i];
+    }
+    do {
+        inside = interior;
+        for (i = 0; i < nd - 1 && inside; i++) {
+            inside = (c[i] >= lo[i] && c[i] < hi[i]);
+        }
+        if (inside) {
+            stencil_border(niter, out, c, 0, lo[nd - 1], ptrs, kernel, data);
+            stencil_border(niter, out, c, hi[nd - 1], nc[nd - 1], ptrs,
+                           kernel, data);
+        }
+        else {
+            stencil_border(niter, out, c, 0, nc[nd - 1], ptrs, kernel, data);
+        }
+    } while (stencil_next_row(nd, c, all_lo, nc));
+    NPY_END_THREADS;
+    ret = 0;
+
+ finish:
+    NpyArray_free(offsets);
+    NpyArray_free(ptrs);
+    Npy_XDECREF(niter);
+    Npy_DECREF(x);
+    if (NpyErr_Occurred()) {
+        ret = -1;
+    }
+    return ret;
+}
+#undef STENCIL_TILE
+
+/*
+ * Apply a stencil, see npy_iterators.h.  bounds is as for
+ * NpyArray_NeighborhoodIterNew; fill belongs to the caller.  The kernel
+ * runs with the GIL held.
+ */
+NDARRAY_API int
+NpyArray_ApplyStencil(NpyArray *in, NpyArray *out, npy_intp *bounds,
+                      int mode, void *fill, NpyArray_StencilFunc *kernel,
+                      void *data)
+{
+    return stencil_apply(in, out, bounds, mode, fill, kernel, data, 0);
+}
+
+/*
+ * Weighted sum kernels: out = sum_k weights[k]*neighbor[k], summed in
+ * double.  Zero weights are skipped.
+ */
+#define STENCIL_WEIGHTED(name, type)                                    \
+static void                                                             \
+name(char **nb, npy_intp nn, npy_intp stride, char *out,                \
+     npy_intp ostride, npy_intp count, void *data)                      \
+{                                                                       \
+    const double *w = (const double *)data;                             \
+    double acc[64], wk;                                                 \
+    npy_intp k, t, t0, m;                                               \
+    char *p;                                                            \
+                                                                        \
+    for (t0 = 0; t0 < count; t0 += 64) {                                \
+        m = (count - t0 < 64) ? count - t0 : 64;                        \
+        for (t = 0; t < m; t++) {                                       \
+            acc[t] = 0.;                                                \
+        }                                                               \
+        for (k = 0; k < nn; k++) {                                      \
+            wk = w[k];                                                  \
+            if (wk == 0.) {                                             \
+                continue;                                               \
+            }                                                           \
+            p = nb[k] + t0*stride;                                      \
+            if (stride == sizeof(type)) {                               \
+                const type *q = (const type *)p;                        \
+                for (t = 0; t < m; t++) {                               \
+                    acc[t] += wk * q[t];                                \
+                }                                                       \
+            }                                                           \
+            else {                                                      \
+                for (t = 0; t < m; t++, p += stride) {                  \
+                    acc[t] += wk * *(type *)p;                          \
+                }                                                       \
+            }                                                           \
+        }                                                               \
+        p = out + t0*ostride;                                           \
+        for (t = 0; t < m; t++, p += ostride) {                         \
+            *(type *)p = (type)acc[t];                                  \
+        }                                                               \
+    }                                                                   \
+}
+
+STENCIL_WEIGHTED(stencil_weighted_float, npy_float)
+STENCIL_WEIGHTED(stencil_weighted_double, npy_double)
+#undef STENCIL_WEIGHTED
+
+/*
+ * out = the sum of the neighbors of each point of in, weighted by
+ * weights in neighborhood iterator order.  in and out must both be
+ * aligned, native float or double arrays of the same type.  Zero and one
+ * padding are accepted as well as the modes of the neighborhood
+ * iterator.  The GIL is released while the sums are computed.
+ */
+NDARRAY_API int
+NpyArray_WeightedStencil(NpyArray *in, NpyArray *out, npy_intp *bounds,
+                         int mode, void *fill, double *weights)
+{
+    NpyArray_StencilFunc *kernel;
+    npy_double dfill;
+    npy_float ffill;
+    int type = NpyArray_TYPE(in);
+
+    if (NpyArray_TYPE(out) != type ||
+        (type != NPY_FLOAT && type != NPY_DOUBLE) ||
+        !NpyArray_ISBEHAVED_RO(in) || !NpyArray_ISBEHAVED(out)) {
+        NpyErr_SetString(NpyExc_TypeError,
+                         "weighted stencils need aligned, native float or "
+                         "double arrays of the same type");
+        return -1;
+    }
+    kernel = (type == NPY_FLOAT) ? &stencil_weighted_float
+                                 : &stencil_weighted_double;
+    if (mode == NPY_NEIGHBORHOOD_ITER_ZERO_PADDING ||
+        mode == NPY_NEIGHBORHOOD_ITER_ONE_PADDING) {
+        dfill = (mode == NPY_NEIGHBORHOOD_ITER_ONE_PADDING) ? 1. : 0.;
+        ffill = (npy_float)dfill;
+        fill = (type == NPY_FLOAT) ? (void *)&ffill : (void *)&dfill;
+        mode = NPY_NEIGHBORHOOD_ITER_CONSTANT_PADDING;
+    }
+
+    return stencil_apply(in, out, bounds, mode, fill, kernel, weights, 1);
+}
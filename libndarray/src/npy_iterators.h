@@ -383,6 +383,30 @@ NDARRAY_API NpyArrayNeighborhoodIterObject*
 NpyArray_NeighborhoodIterNew(NpyArrayIterObject *x, npy_intp *bounds,
                              int mode, void *fill,  npy_free_func fillfree);
 
+/*
+ * Stencils: NpyArray_ApplyStencil calls kernel for every point of in, with
+ * pointers to the point's neighbors, in neighborhood iterator order, and
+ * to the same point of out.  Interior points, whose neighbors are all
+ * inside in, are passed in runs along the last axis: point t of a run has
+ * neighbor k at neighbors[k] + t*stride and its output at out + t*ostride.
+ * Border points are passed one at a time (count 1), padded according to
+ * mode and fill as for the neighborhood iterator.
+ */
+typedef void (NpyArray_StencilFunc)(char **neighbors, npy_intp nneighbors,
+                                    npy_intp stride, char *out,
+                                    npy_intp ostride, npy_intp count,
+                                    void *data);
+
+NDARRAY_API int
+NpyArray_ApplyStencil(struct NpyArray *in, struct NpyArray *out,
+                      npy_intp *bounds, int mode, void *fill,
+                      NpyArray_StencilFunc *kernel, void *data);
+
+NDARRAY_API int
+NpyArray_WeightedStencil(struct NpyArray *in, struct NpyArray *out,
+                         npy_intp *bounds, int mode, void *fill,
+                         double *weights);
+
 /* General: those work for any mode */
 static NPY_INLINE int
 NpyArrayNeighborhoodIter_Reset(NpyArrayNeighborhoodIterObject* iter);
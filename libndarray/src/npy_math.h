@@ -3,6 +3,7 @@
 
 #include <math.h>
 #include "npy_common.h"
+#include "npy_defs.h"
 
 /*
  * NAN and INFINITY like macros (same behavior as glibc for NAN, same as C99
@@ -271,6 +272,27 @@ NDARRAY_API npy_longdouble npy_logaddexp2l(npy_longdouble x, npy_longdouble y);
 #define npy_radiansf npy_deg2radf
 #define npy_radiansl npy_deg2radl
 
+/*
+ * Array functions: y[i] = f(x[i]) for n contiguous items, y may be x
+ */
+NDARRAY_API void npy_vexp(const double *x, double *y, npy_intp n);
+NDARRAY_API void npy_vlog(const double *x, double *y, npy_intp n);
+NDARRAY_API void npy_vexpm1(const double *x, double *y, npy_intp n);
+NDARRAY_API void npy_vlog1p(const double *x, double *y, npy_intp n);
+NDARRAY_API void npy_vsin(const double *x, double *y, npy_intp n);
+NDARRAY_API void npy_vcos(const double *x, double *y, npy_intp n);
+NDARRAY_API void npy_vtanh(const double *x, double *y, npy_intp n);
+NDARRAY_API void npy_vsqrt(const double *x, double *y, npy_intp n);
+
+NDARRAY_API void npy_vexpf(const float *x, float *y, npy_intp n);
+NDARRAY_API void npy_vlogf(const float *x, float *y, npy_intp n);
+NDARRAY_API void npy_vexpm1f(const float *x, float *y, npy_intp n);
+NDARRAY_API void npy_vlog1pf(const float *x, float *y, npy_intp n);
+NDARRAY_API void npy_vsinf(const float *x, float *y, npy_intp n);
+NDARRAY_API void npy_vcosf(const float *x, float *y, npy_intp n);
+NDARRAY_API void npy_vtanhf(const float *x, float *y, npy_intp n);
+NDARRAY_API void npy_vsqrtf(const float *x, float *y, npy_intp n);
+
 /*
  * Complex declarations
  */
@@ -398,4 +420,27 @@ NDARRAY_API npy_clongdouble npy_csqrtl(npy_clongdouble z);
 
 NDARRAY_API npy_clongdouble npy_ccosl(npy_clongdouble z);
 NDARRAY_API npy_clongdouble npy_csinl(npy_clongdouble z);
+
+/*
+ * Complex array functions on n contiguous items, r may be a or b
+ */
+NDARRAY_API void npy_vcadd(const npy_cdouble *a, const npy_cdouble *b,
+                           npy_cdouble *r, npy_intp n);
+NDARRAY_API void npy_vcsub(const npy_cdouble *a, const npy_cdouble *b,
+                           npy_cdouble *r, npy_intp n);
+NDARRAY_API void npy_vcmul(const npy_cdouble *a, const npy_cdouble *b,
+                           npy_cdouble *r, npy_intp n);
+NDARRAY_API void npy_vcconj(const npy_cdouble *a, npy_cdouble *r, npy_intp n);
+NDARRAY_API void npy_vcabs(const npy_cdouble *a, double *y, npy_intp n);
+NDARRAY_API void npy_vcabs2(const npy_cdouble *a, double *y, npy_intp n);
+
+NDARRAY_API void npy_vcaddf(const npy_cfloat *a, const npy_cfloat *b,
+                            npy_cfloat *r, npy_intp n);
+NDARRAY_API void npy_vcsubf(const npy_cfloat *a, const npy_cfloat *b,
+                            npy_cfloat *r, npy_intp n);
+NDARRAY_API void npy_vcmulf(const npy_cfloat *a, const npy_cfloat *b,
+                            npy_cfloat *r, npy_intp n);
+NDARRAY_API void npy_vcconjf(const npy_cfloat *a, npy_cfloat *r, npy_intp n);
+NDARRAY_API void npy_vcabsf(const npy_cfloat *a, float *y, npy_intp n);
+NDARRAY_API void npy_vcabs2f(const npy_cfloat *a, float *y, npy_intp n);
 #endif
@@ -14,6 +14,7 @@
 #include "npy_dict.h"
 #include "npy_internal.h"
 #include "npy_iterators.h"
+#include "npy_math.h"
 #include "npy_os.h"
 #include "npy_calculation.h"
 
@@ -661,6 +662,534 @@ NpyArray_CopyAndTranspose(NpyArray *arr)
 }
 
 
+/*
+ * Fast paths for correlating float and double arrays, real or complex,
+ * in one or two dimensions.  The inputs are read as C-ordered double
+ * arrays, with complex numbers as (re, im) pairs, copying them where
+ * they are not, so float results are summed in double as well.  Each
+ * output is
+ *
+ *     out[p, q] = sum_{i, j} h[i, j] * x[p + off0 + i, q + off1 + j]
+ *
+ * leaving out the terms with x out of range.  Short kernels are summed
+ * directly; long ones are convolved, reversed, with x by FFT using
+ * overlap-add, whichever the operation count favours.  1-d arrays are
+ * treated as a single row.
+ */
+
+/* outputs per block of the direct sum */
+#define CORR_BLOCK 256
+
+/* cost of one FFT butterfly stage per point, in direct multiply-adds */
+#define CORR_FFT_COST 6
+
+typedef struct {
+    npy_intp nx[2], nh[2], nout[2], off[2];
+    int cplx;
+} corr_shape;
+
+static int
+corr_fast_type(NpyArray *ap, int typenum)
+{
+    return NpyArray_TYPE(ap) == typenum && NpyArray_ISALIGNED(ap) &&
+        NpyArray_ISNOTSWAPPED(ap) &&
+        (typenum == NPY_FLOAT || typenum == NPY_DOUBLE ||
+         typenum == NPY_CFLOAT || typenum == NPY_CDOUBLE);
+}
+
+/*
+ * The data of a 1-d or 2-d array as a C-ordered double array, conjugated
+ * if conj is set.  Contiguous double arrays are used in place; anything
+ * else is copied into a new array, which the caller frees.
+ */
+static double *
+corr_load(NpyArray *ap, int conj)
+{
+    int single = (NpyArray_TYPE(ap) == NPY_FLOAT ||
+                  NpyArray_TYPE(ap) == NPY_CFLOAT);
+    int m = NpyArray_ISCOMPLEX(ap) ? 2 : 1, k;
+    npy_intp rows = (ap->nd == 2) ? NpyArray_DIM(ap, 0) : 1;
+    npy_intp cols = NpyArray_DIM(ap, ap->nd - 1);
+    npy_intp rs = (ap->nd == 2) ? NpyArray_STRIDE(ap, 0) : 0;
+    npy_intp cs = NpyArray_STRIDE(ap, ap->nd - 1);
+    npy_intp i, j;
+    double *buf, *p;
+    char *ip;
+
+    if (!single && !conj && NpyArray_ISCONTIGUOUS(ap)) {
+        return (double *)NpyArray_DATA(ap);
+    }
+    buf = (double *)NpyArray_malloc((rows*cols*m + 1) * sizeof(double));
+    if (buf == NULL) {
+        NpyErr_MEMORY;
+        return NULL;
+    }
+    p = buf;
+    for (i = 0; i < rows; i++) {
+        ip = NpyArray_BYTES(ap) + i*rs;
+        for (j = 0; j < cols; j++, ip += cs) {
+            for (k = 0; k < m; k++) {
+                *p++ = single ? ((float *)ip)[k] : ((double *)ip)[k];
+            }
+            if (conj && m == 2) {
+                p[-1] = -p[-1];
+            }
+        }
+    }
+    return buf;
+}
+
+/*
+ * Copy the result into ret, a C-contiguous float array.
+ */
+static void
+corr_store_single(const double *buf, NpyArray *ret)
+{
+    npy_intp i, n;
+    float *op = (float *)NpyArray_DATA(ret);
+
+    n = NpyArray_SIZE(ret) * (NpyArray_ISCOMPLEX(ret) ? 2 : 1);
+    for (i = 0; i < n; i++) {
+        op[i] = (float)buf[i];
+    }
+}
+
+/*
+ * One row of the direct sum: out[o] += sum_j h[j]*x[o + off + j].  The
+ * outputs are done CORR_BLOCK at a time, so that the block and the part
+ * of x it reads stay in cache while every tap is applied to it.  Taps
+ * are taken four at a time, or one at a time near the ends of x.
+ */
+static void
+corr_direct_row(const double *x, npy_intp nx, const double *h, npy_intp nh,
+                double *out, npy_intp nout, npy_intp off)
+{
+    npy_intp o0, o1, o, j, b, lo, hi;
+    double h0, h1, h2, h3;
+
+    for (o0 = 0; o0 < nout; o0 += CORR_BLOCK) {
+        o1 = NpyArray_MIN(o0 + CORR_BLOCK, nout);
+        j = 0;
+        while (j < nh) {
+            b = off + j;
+            if (j + 4 <= nh && o0 + b >= 0 && o1 + b + 3 <= nx) {
+                h0 = h[j];
+                h1 = h[j + 1];
+                h2 = h[j + 2];
+                h3 = h[j + 3];
+                for (o = o0; o < o1; o++) {
+                    out[o] += h0*x[o + b] + h1*x[o + b + 1] +
+                              h2*x[o + b + 2] + h3*x[o + b + 3];
+                }
+                j += 4;
+            }
+            else {
+                lo = NpyArray_MAX(o0, -b);
+                hi = NpyArray_MIN(o1, nx - b);
+                h0 = h[j];
+                for (o = lo; o < hi; o++) {
+                    out[o] += h0*x[o + b];
+                }
+                j++;
+            }
+        }
+    }
+}
+
+static void
+corr_direct_row_complex(const double *x, npy_intp nx, const double *h,
+                        npy_intp nh, double *out, npy_intp nout, npy_intp off)
+{
+    npy_intp o0, o1, o, j, b, lo, hi;
+    double hr, hi_, xr, xi;
+
+    for (o0 = 0; o0 < nout; o0 += CORR_BLOCK) {
+        o1 = NpyArray_MIN(o0 + CORR_BLOCK, nout);
+        for (j = 0; j < nh; j++) {
+            b = off + j;
+            lo = NpyArray_MAX(o0, -b);
+            hi = NpyArray_MIN(o1, nx - b);
+            hr = h[2*j];
+            hi_ = h[2*j + 1];
+            for (o = lo; o < hi; o++) {
+                xr = x[2*(o + b)];
+                xi = x[2*(o + b) + 1];
+                out[2*o] += hr*xr - hi_*xi;
+                out[2*o + 1] += hr*xi + hi_*xr;
+            }
+        }
+    }
+}
+
+static void
+corr_direct(const double *x, const double *h, double *out,
+            const corr_shape *s)
+{
+    npy_intp p, i, r, m = s->cplx ? 2 : 1;
+
+    for (p = 0; p < s->nout[0]; p++) {
+        for (i = 0; i < s->nh[0]; i++) {
+            r = p + s->off[0] + i;
+            if (r < 0 || r >= s->nx[0]) {
+                continue;
+            }
+            if (s->cplx) {
+                corr_direct_row_complex(x + r*s->nx[1]*m, s->nx[1],
+                                        h + i*s->nh[1]*m, s->nh[1],
+                                        out + p*s->nout[1]*m, s->nout[1],
+                                        s->off[1]);
+            }
+            else {
+                corr_direct_row(x + r*s->nx[1], s->nx[1],
+                                h + i*s->nh[1], s->nh[1],
+                                out + p*s->nout[1], s->nout[1], s->off[1]);
+            }
+        }
+    }
+}
+
+/*
+ * In-place radix-2 FFT of n complex numbers, n a power of two.  w holds
+ * exp(-2*pi*i*k/wn) for k < wn/2, for some power of two wn >= n.  With
+ * sign = 1 the unscaled inverse transform is computed.
+ */
+static void
+corr_fft(double *a, npy_intp n, const double *w, npy_intp wn, int sign)
+{
+    npy_intp i, j, k, bit, len, half, step;
+    double tr, ti, wr, wi, *p, *q;
+
+    for (i = 1, j = 0; i < n; i++) {
+        for (bit = n >> 1; j & bit; bit >>= 1) {
+            j ^= bit;
+        }
+        j |= bit;
+        if (i < j) {
+            tr = a[2*i];
+            ti = a[2*i + 1];
+            a[2*i] = a[2*j];
+            a[2*i + 1] = a[2*j + 1];
+            a[2*j] = tr;
+            a[2*j + 1] = ti;
+        }
+    }
+    for (len = 2; len <= n; len <<= 1) {
+        half = len >> 1;
+        step = wn / len;
+        for (i = 0; i < n; i += len) {
+            p = a + 2*i;
+            q = p + 2*half;
+            for (k = 0; k < half; k++, p += 2, q += 2) {
+                wr = w[2*k*step];
+                wi = -sign * w[2*k*step + 1];
+                tr = wr*q[0] - wi*q[1];
+                ti = wr*q[1] + wi*q[0];
+                q[0] = p[0] - tr;
+                q[1] = p[1] - ti;
+                p[0] += tr;
+                p[1] += ti;
+            }
+        }
+    }
+}
+
+/*
+ * 2-d FFT of an n0 by n1 C-ordered array, rows then columns.  tmp holds
+ * one column.
+ */
+static void
+corr_fft2(double *a, npy_intp n0, npy_intp n1, const double *w, npy_intp wn,
+          int sign, double *tmp)
+{
+    npy_intp i, j;
+
+    for (i = 0; i < n0; i++) {
+        corr_fft(a + 2*i*n1, n1, w, wn, sign);
+    }
+    if (n0 == 1) {
+        return;
+    }
+    for (j = 0; j < n1; j++) {
+        for (i = 0; i < n0; i++) {
+            tmp[2*i] = a[2*(i*n1 + j)];
+            tmp[2*i + 1] = a[2*(i*n1 + j) + 1];
+        }
+        corr_fft(tmp, n0, w, wn, sign);
+        for (i = 0; i < n0; i++) {
+            a[2*(i*n1 + j)] = tmp[2*i];
+            a[2*(i*n1 + j) + 1] = tmp[2*i + 1];
+        }
+    }
+}
+
+static npy_intp
+corr_pow2(npy_intp n)
+{
+    npy_intp m = 1;
+
+    while (m < n) {
+        m <<= 1;
+    }
+    return m;
+}
+
+static double
+corr_log2(npy_intp n)
+{
+    double l = 0.;
+
+    while (n > 1) {
+        n >>= 1;
+        l += 1.;
+    }
+    return l;
+}
+
+/*
+ * Transform size for overlap-add along one axis: a few times the kernel
+ * length, so that most of each transform is new output, but no longer
+ * than the whole convolution.
+ */
+static npy_intp
+corr_fft_size(npy_intp nx, npy_intp nh)
+{
+    if (nh == 1 && nx == 1) {
+        return 1;
+    }
+    return corr_pow2(NpyArray_MIN(NpyArray_MAX(8*nh, 64), nx + nh - 1));
+}
+
+/*
+ * Operation count of the FFT method, in direct multiply-adds.
+ */
+static double
+corr_fft_cost(const corr_shape *s, npy_intp n0, npy_intp n1)
+{
+    npy_intp t0 = (s->nx[0] + n0 - s->nh[0]) / (n0 - s->nh[0] + 1);
+    npy_intp t1 = (s->nx[1] + n1 - s->nh[1]) / (n1 - s->nh[1] + 1);
+    double tiles = (double)t0 * t1;
+
+    if (!s->cplx) {
+        tiles = (tiles + 1) / 2;
+    }
+    return (2*tiles + 1) * n0 * n1 * corr_log2(n0*n1) * CORR_FFT_COST;
+}
+
+/*
+ * Add tile t of x into part (0 for real, 1 for imaginary, -1 for both
+ * of complex data) of buf, or, with add set, part of buf into the
+ * outputs that tile t contributes to.
+ */
+static void
+corr_tile(double *x, double *buf, npy_intp t, int part, int add,
+          const corr_shape *s, npy_intp n0, npy_intp n1)
+{
+    npy_intp l0 = n0 - s->nh[0] + 1, l1 = n1 - s->nh[1] + 1;
+    npy_intp t1 = (s->nx[1] + l1 - 1) / l1;
+    npy_intp s0 = (t / t1) * l0, s1 = (t % t1) * l1;
+    npy_intp i, j, lo0, hi0, lo1, hi1, d0, d1, k, m = s->cplx ? 2 : 1;
+    double *bp, *xp;
+
+    if (!add) {
+        /* x[s0 + i, s1 + j] goes to buf[i, j] */
+        d0 = s0;
+        d1 = s1;
+        lo0 = lo1 = 0;
+        hi0 = NpyArray_MIN(l0, s->nx[0] - s0);
+        hi1 = NpyArray_MIN(l1, s->nx[1] - s1);
+    }
+    else {
+        /*
+         * buf[i, j] is the convolution at (s0 + i, s1 + j), which is
+         * out[s0 + i - off0 - nh0 + 1, ...]
+         */
+        d0 = s0 - s->off[0] - s->nh[0] + 1;
+        d1 = s1 - s->off[1] - s->nh[1] + 1;
+        lo0 = NpyArray_MAX(0, -d0);
+        lo1 = NpyArray_MAX(0, -d1);
+        hi0 = NpyArray_MIN(n0, s->nout[0] - d0);
+        hi1 = NpyArray_MIN(n1, s->nout[1] - d1);
+    }
+    for (i = lo0; i < hi0; i++) {
+        bp = buf + 2*(i*n1 + lo1);
+        if (!add) {
+            xp = x + ((d0 + i)*s->nx[1] + d1 + lo1)*m;
+        }
+        else {
+            xp = x + ((d0 + i)*s->nout[1] + d1 + lo1)*m;
+        }
+        for (j = lo1; j < hi1; j++, bp += 2, xp += m) {
+            for (k = 0; k < m; k++) {
+                if (add) {
+                    xp[k] += bp[part < 0 ? k : part];
+                }
+                else {
+                    bp[part < 0 ? k : part] = xp[k];
+                }
+            }
+        }
+    }
+}
+
+/*
+ * The FFT method.  Tiles of x just small enough that their convolution
+ * with h fits in an n0 by n1 transform are convolved one by one, and the
+ * results added up.  h is real for real data, so then two tiles share a
+ * transform, as its real and imaginary parts.
+ */
+static void
+corr_fft_sum(double *x, double *h, double *out, const corr_shape *s,
+             npy_intp n0, npy_intp n1, double *w, double *hf, double *buf,
+             double *tmp)
+{
+    npy_intp wn = NpyArray_MAX(n0, n1), n = n0*n1;
+    npy_intp l0 = n0 - s->nh[0] + 1, l1 = n1 - s->nh[1] + 1;
+    npy_intp ntiles, t, i, j, k, r;
+    double scale = 1.0 / n, re, im;
+
+    ntiles = ((s->nx[0] + l0 - 1) / l0) * ((s->nx[1] + l1 - 1) / l1);
+    for (k = 0; k < wn/2; k++) {
+        w[2*k] = npy_cos(2*NPY_PI*k / wn);
+        w[2*k + 1] = -npy_sin(2*NPY_PI*k / wn);
+    }
+
+    /* the reversed kernel, scaled for the inverse transform */
+    memset(hf, 0, 2*n*sizeof(double));
+    for (i = 0; i < s->nh[0]; i++) {
+        for (j = 0; j < s->nh[1]; j++) {
+            r = (s->nh[0] - 1 - i)*s->nh[1] + (s->nh[1] - 1 - j);
+            if (s->cplx) {
+                hf[2*(i*n1 + j)] = h[2*r] * scale;
+                hf[2*(i*n1 + j) + 1] = h[2*r + 1] * scale;
+            }
+            else {
+                hf[2*(i*n1 + j)] = h[r] * scale;
+            }
+        }
+    }
+    corr_fft2(hf, n0, n1, w, wn, -1, tmp);
+
+    for (t = 0; t < ntiles; t += s->cplx ? 1 : 2) {
+        memset(buf, 0, 2*n*sizeof(double));
+        if (s->cplx) {
+            corr_tile(x, buf, t, -1, 0, s, n0, n1);
+        }
+        else {
+            corr_tile(x, buf, t, 0, 0, s, n0, n1);
+            if (t + 1 < ntiles) {
+                corr_tile(x, buf, t + 1, 1, 0, s, n0, n1);
+            }
+        }
+        corr_fft2(buf, n0, n1, w, wn, -1, tmp);
+        for (k = 0; k < n; k++) {
+            re = buf[2*k]*hf[2*k] - buf[2*k + 1]*hf[2*k + 1];
+            im = buf[2*k]*hf[2*k + 1] + buf[2*k + 1]*hf[2*k];
+            buf[2*k] = re;
+            buf[2*k + 1] = im;
+        }
+        corr_fft2(buf, n0, n1, w, wn, 1, tmp);
+        if (s->cplx) {
+            corr_tile(out, buf, t, -1, 1, s, n0, n1);
+        }
+        else {
+            corr_tile(out, buf, t, 0, 1, s, n0, n1);
+            if (t + 1 < ntiles) {
+                corr_tile(out, buf, t + 1, 1, 1, s, n0, n1);
+            }
+        }
+    }
+}
+
+/*
+ * Correlate ap1 with ap2 into ret, which is C-contiguous, choosing
+ * between the direct sum and FFTs.  conj conjugates ap2 first.  Returns
+ * 0 on success, -1 with an error set on failure.
+ */
+static int
+corr_compute(NpyArray *ap1, NpyArray *ap2, NpyArray *ret,
+             const corr_shape *s, int conj)
+{
+    double *x = NULL, *h = NULL, *out = NULL;
+    double *w = NULL, *hf = NULL, *buf = NULL, *tmp = NULL;
+    npy_intp nout, n0, n1, m = s->cplx ? 2 : 1;
+    double direct;
+    int use_fft = 0, single;
+    NPY_BEGIN_THREADS_DEF
+
+    nout = s->nout[0] * s->nout[1];
+    if (nout == 0) {
+        return 0;
+    }
+    if (s->nx[0] * s->nx[1] == 0 || s->nh[0] * s->nh[1] == 0) {
+        /* Empty sums; the FFT sizes would not fit the kernel */
+        memset(NpyArray_DATA(ret), 0, nout * NpyArray_ITEMSIZE(ret));
+        return 0;
+    }
+    n0 = corr_fft_size(s->nx[0], s->nh[0]);
+    n1 = corr_fft_size(s->nx[1], s->nh[1]);
+    direct = (double)nout * s->nh[0] * s->nh[1] * (s->cplx ? 4 : 1);
+    if (direct > corr_fft_cost(s, n0, n1)) {
+        use_fft = 1;
+    }
+
+    single = (NpyArray_TYPE(ret) == NPY_FLOAT ||
+              NpyArray_TYPE(ret) == NPY_CFLOAT);
+    x = corr_load(ap1, 0);
+    h = corr_load(ap2, conj);
+    if (single) {
+        out = (double *)NpyArray_malloc(nout * m * sizeof(double));
+    }
+    else {
+        out = (double *)NpyArray_DATA(ret);
+    }
+    if (use_fft) {
+        w = (double *)NpyArray_malloc(NpyArray_MAX(n0, n1) * sizeof(double));
+        hf = (double *)NpyArray_malloc(2 * n0 * n1 * sizeof(double));
+        buf = (double *)NpyArray_malloc(2 * n0 * n1 * sizeof(double));
+        tmp = (double *)NpyArray_malloc(2 * n0 * sizeof(double));
+        if (w == NULL || hf == NULL || buf == NULL || tmp == NULL) {
+            use_fft = 0;
+        }
+    }
+    if (x == NULL || h == NULL) {
+        goto finish;
+    }
+    if (out == NULL) {
+        NpyErr_MEMORY;
+        goto finish;
+    }
+
+    NPY_BEGIN_THREADS;
+    memset(out, 0, nout * m * sizeof(double));
+    if (use_fft) {
+        corr_fft_sum(x, h, out, s, n0, n1, w, hf, buf, tmp);
+    }
+    else {
+        corr_direct(x, h, out, s);
+    }
+    if (single) {
+        corr_store_single(out, ret);
+    }
+    NPY_END_THREADS;
+
+ finish:
+    if (x != (double *)NpyArray_DATA(ap1)) {
+        NpyArray_free(x);
+    }
+    if (h != (double *)NpyArray_DATA(ap2)) {
+        NpyArray_free(h);
+    }
+    if (out != (double *)NpyArray_DATA(ret)) {
+        NpyArray_free(out);
+    }
+    NpyArray_free(w);
+    NpyArray_free(hf);
+    NpyArray_free(buf);
+    NpyArray_free(tmp);
+    return NpyErr_Occurred() ? -1 : 0;
+}
+
+
 /*
  * Implementation which is common between
  * NpyArray_Correlate and NpyArray_Correlate2
@@ -675,6 +1204,7 @@ _npyarray_correlate(NpyArray *ap1, NpyArray *ap2,
     npy_intp length, i, n1, n2, n, n_left, n_right, is1, is2, os;
     char *ip1, *ip2, *op;
     NpyArray_DotFunc *dot;
+    corr_shape shape;
     NPY_BEGIN_THREADS_DEF
 
     n1 = NpyArray_DIM(ap1, 0);
@@ -721,6 +1251,19 @@ _npyarray_correlate(NpyArray *ap1, NpyArray *ap2,
     if (ret == NULL) {
         return NULL;
     }
+    if (corr_fast_type(ap1, typenum) && corr_fast_type(ap2, typenum)) {
+        shape.nx[0] = shape.nh[0] = shape.nout[0] = 1;
+        shape.off[0] = 0;
+        shape.nx[1] = n1;
+        shape.nh[1] = n2;
+        shape.nout[1] = length;
+        shape.off[1] = -n_left;
+        shape.cplx = NpyTypeNum_ISCOMPLEX(typenum);
+        if (corr_compute(ap1, ap2, ret, &shape, 0) < 0) {
+            goto clean_ret;
+        }
+        return ret;
+    }
     dot = NpyArray_DESCR(ret)->f->dotfunc;
     if (dot == NULL) {
         NpyErr_SetString(NpyExc_ValueError,
@@ -875,6 +1418,78 @@ NpyArray_Correlate(NpyArray *ap1, NpyArray *ap2, int typenum, int mode)
 }
 
 
+/*
+ * correlate2d(a1, a2, typenum, mode)
+ *
+ * Two dimensional correlation, conjugating a2 for complex inputs as
+ * NpyArray_Correlate2 does.  mode selects the output size along each
+ * axis as for NpyArray_Correlate, except that the arrays are never
+ * swapped: in mode 0, a2 may not be larger than a1 along either axis.
+ * Only float and double arrays, real or complex, are supported.
+ */
+NDARRAY_API NpyArray *
+NpyArray_Correlate2D(NpyArray *ap1, NpyArray *ap2, int typenum, int mode)
+{
+    NpyArray *ret;
+    npy_intp dims[2], n1, n2;
+    corr_shape shape;
+    int i;
+
+    if (NpyArray_NDIM(ap1) != 2 || NpyArray_NDIM(ap2) != 2) {
+        NpyErr_SetString(NpyExc_ValueError,
+                         "correlate2d needs two 2-d arrays");
+        return NULL;
+    }
+    if (!corr_fast_type(ap1, typenum) || !corr_fast_type(ap2, typenum)) {
+        NpyErr_SetString(NpyExc_TypeError,
+                         "correlate2d needs aligned, native byte order "
+                         "float or complex arrays of the given type");
+        return NULL;
+    }
+    for (i = 0; i < 2; i++) {
+        n1 = NpyArray_DIM(ap1, i);
+        n2 = NpyArray_DIM(ap2, i);
+        shape.nx[i] = n1;
+        shape.nh[i] = n2;
+        switch(mode) {
+        case 0:
+            if (n2 > n1) {
+                NpyErr_SetString(NpyExc_ValueError,
+                                 "in mode 0 the second array may not be "
+                                 "larger than the first");
+                return NULL;
+            }
+            dims[i] = n1 - n2 + 1;
+            shape.off[i] = 0;
+            break;
+        case 1:
+            dims[i] = n1;
+            shape.off[i] = -(n2 / 2);
+            break;
+        case 2:
+            dims[i] = NpyArray_MAX(n1 + n2 - 1, 0);
+            shape.off[i] = -(n2 - 1);
+            break;
+        default:
+            NpyErr_SetString(NpyExc_ValueError, "mode must be 0, 1, or 2");
+            return NULL;
+        }
+        shape.nout[i] = dims[i];
+    }
+    shape.cplx = NpyTypeNum_ISCOMPLEX(typenum);
+
+    ret = new_array_for_sum(ap1, ap2, 2, dims, typenum);
+    if (ret == NULL) {
+        return NULL;
+    }
+    if (corr_compute(ap1, ap2, ret, &shape, shape.cplx) < 0) {
+        Npy_DECREF(ret);
+        return NULL;
+    }
+    return ret;
+}
+
+
 /*
  * compare the field dictionary for two types
  * return 1 if the same or 0 if not
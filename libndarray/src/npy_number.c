@@ -179,7 +179,6 @@ NpyArray_GenericBinaryFunction(NpyArray *m1, NpyArray *m2, NpyUFuncObject *op,
 
     mps[0] = m1;
     mps[1] = m2;
-    Npy_XINCREF(out);
     mps[2] = out;
 
     for (i = 0; i < 3; i++) {
@@ -210,6 +209,77 @@ finish:
 }
 
 
+/*
+ * Whether the temporary m1 can take the result of op(m1, m2) in place of
+ * a new array.  That is so if nothing else can see m1 -- the caller holds
+ * the only reference, no wrapper object exists and it is not a view nor
+ * viewed -- and the result would have the type and shape of m1 anyway.
+ */
+static npy_bool
+can_elide_temp(NpyArray *m1, NpyArray *m2, NpyUFuncObject *op)
+{
+    int type_num = NpyArray_TYPE(m1);
+    int i, j;
+
+    if (m1->nob_refcnt != 1 || m1->nob_interface != NULL ||
+        !NpyArray_CHKFLAGS(m1, NPY_OWNDATA) || !NpyArray_ISBEHAVED(m1) ||
+        NpyArray_CHKFLAGS(m1, NPY_UPDATEIFCOPY) ||
+        NpyArray_TYPE(m2) != type_num ||
+        NpyArray_NDIM(m2) > NpyArray_NDIM(m1) ||
+        op->nin != 2 || op->nout != 1 || op->core_enabled ||
+        op->userloops != NULL) {
+        return NPY_FALSE;
+    }
+
+    /* m2 has to broadcast to the shape of m1 without growing it */
+    for (i = NpyArray_NDIM(m2) - 1, j = NpyArray_NDIM(m1) - 1; i >= 0;
+         i--, j--) {
+        if (NpyArray_DIM(m2, i) != 1 &&
+            NpyArray_DIM(m2, i) != NpyArray_DIM(m1, j)) {
+            return NPY_FALSE;
+        }
+    }
+    if (NpyArray_Overlap(m1, m2) == NPY_OVERLAP_PARTIAL) {
+        return NPY_FALSE;
+    }
+
+    for (i = 0; i < op->ntypes; i++) {
+        if (op->types[3*i] == type_num && op->types[3*i + 1] == type_num &&
+            op->types[3*i + 2] == type_num) {
+            return NPY_TRUE;
+        }
+    }
+    return NPY_FALSE;
+}
+
+
+/*
+ * Like NpyArray_GenericBinaryFunction without an output array, but for a
+ * first operand that is a temporary, such as an intermediate result of an
+ * expression like a*b + c, and whose reference it steals.  When no one
+ * else can see m1 the result is written into it instead of a new array,
+ * so chains of operations don't allocate a new array at each step.
+ */
+NDARRAY_API NpyArray *
+NpyArray_GenericBinaryFunctionTemp(NpyArray *m1, NpyArray *m2,
+                                   NpyUFuncObject *op)
+{
+    NpyArray *result;
+
+    assert(NULL != op && NPY_VALID_MAGIC == op->nob_magic_number);
+    assert(NULL != m1 && NPY_VALID_MAGIC == m1->nob_magic_number);
+    assert(NULL != m2 && NPY_VALID_MAGIC == m2->nob_magic_number);
+
+    if (can_elide_temp(m1, m2, op)) {
+        result = NpyArray_GenericBinaryFunction(m1, m2, op, m1);
+    }
+    else {
+        result = NpyArray_GenericBinaryFunction(m1, m2, op, NULL);
+    }
+    Npy_DECREF(m1);
+    return result;
+}
+
 NDARRAY_API NpyArray *
 NpyArray_GenericUnaryFunction(NpyArray *m1, NpyUFuncObject *op, NpyArray* out)
 {
@@ -49,6 +49,10 @@ _create_reduce_copy(NpyUFuncReduceObject *loop, NpyArray **arr, int rtype);
 static int
 _create_copies(NpyUFuncLoopObject *loop, int *arg_types, NpyArray **mps);
 static int
+_overlapping_input(NpyUFuncObject *self, NpyArray **mps);
+static int
+_copy_overlapping_inputs(NpyUFuncObject *self, NpyArray **mps);
+static int
 _compute_dimension_size(NpyUFuncLoopObject *loop, NpyArray **mps, int i);
 static npy_intp*
 _compute_output_dims(NpyUFuncLoopObject *loop, int iarg,
@@ -119,6 +123,122 @@ fpe_state_f fp_error_state = &default_fp_error_state;
 fpe_handler_f fp_error_handler = &default_fp_error_handler;
 
 
+/*
+ * Fast path for calls where every input is a contiguous, aligned,
+ * native byte order array of the same shape and exactly the type the
+ * selected loop takes, and every output is either missing or just as
+ * well-behaved.  These calls need no broadcasting, buffering or casting,
+ * so the inner loop is called directly without building a loop object
+ * or iterators.  This dominates the cost of ufuncs on small arrays.
+ *
+ * Returns 1 if the call was completed, 0 if the general path has to be
+ * used and -1 on error.  If the outputs have already been passed to
+ * *prepare_outputs when falling back, it is set to NULL so the general
+ * path doesn't prepare them again.
+ */
+static int
+_simple_ufunc_call(NpyUFuncObject *self, NpyArray **mps,
+                   npy_prepare_outputs_func *prepare_outputs,
+                   void *prepare_out_args)
+{
+    int arg_types[NPY_MAXARGS];
+    NPY_SCALARKIND scalars[NPY_MAXARGS];
+    char *dataptr[NPY_MAXARGS];
+    npy_intp steps[NPY_MAXARGS];
+    NpyUFuncGenericFunction function;
+    void *funcdata;
+    NpyArray *ap;
+    int nd = NpyArray_NDIM(mps[0]);
+    npy_intp *dims = NpyArray_DIMS(mps[0]);
+    npy_intp size = NpyArray_SIZE(mps[0]);
+    int bufsize, errormask, first = 1;
+    void *errobj;
+    int i;
+
+    if (self->core_enabled || size == 0) {
+        return 0;
+    }
+    for (i = 0; i < self->nargs; i++) {
+        ap = mps[i];
+        if (ap == NULL && i >= self->nin) {
+            continue;
+        }
+        arg_types[i] = NpyArray_TYPE(ap);
+        if (!NpyTypeNum_ISNUMBER(arg_types[i]) ||
+            !NpyArray_ISCARRAY_RO(ap) || NpyArray_NDIM(ap) != nd ||
+            !NpyArray_CompareLists(NpyArray_DIMS(ap), dims, nd)) {
+            return 0;
+        }
+        if (i >= self->nin && !NpyArray_ISWRITEABLE(ap)) {
+            return 0;
+        }
+        scalars[i] = NPY_NOSCALAR;
+    }
+
+    /* All shapes match, so no operand is treated as a scalar. */
+    if (select_types(self, arg_types, &function, &funcdata,
+                     scalars, 0, NULL) < 0) {
+        return -1;
+    }
+    for (i = 0; i < self->nargs; i++) {
+        if (mps[i] != NULL && arg_types[i] != NpyArray_TYPE(mps[i])) {
+            return 0;
+        }
+    }
+
+    for (i = self->nin; i < self->nargs; i++) {
+        if (mps[i] == NULL) {
+            mps[i] = NpyArray_New(NULL, nd, dims, arg_types[i],
+                                  NULL, NULL, 0, 0, NULL);
+            if (mps[i] == NULL) {
+                return -1;
+            }
+        }
+    }
+    if (*prepare_outputs != NULL) {
+        if ((*prepare_outputs)(self, mps, prepare_out_args) < 0) {
+            return -1;
+        }
+        *prepare_outputs = NULL;
+        /* The outputs may have been replaced by arbitrary arrays. */
+        for (i = self->nin; i < self->nargs; i++) {
+            ap = mps[i];
+            if (NpyArray_TYPE(ap) != arg_types[i] ||
+                !NpyArray_ISCARRAY(ap) || NpyArray_NDIM(ap) != nd ||
+                !NpyArray_CompareLists(NpyArray_DIMS(ap), dims, nd)) {
+                return 0;
+            }
+        }
+    }
+
+    /*
+     * An output that is one of the inputs is fine, one that is shifted
+     * against an input needs the copy the general path makes.
+     */
+    if (_overlapping_input(self, mps) >= 0) {
+        return 0;
+    }
+
+    for (i = 0; i < self->nargs; i++) {
+        dataptr[i] = NpyArray_BYTES(mps[i]);
+        steps[i] = (size == 1) ? 0 : NpyArray_ITEMSIZE(mps[i]);
+    }
+    if (_does_loop_use_arrays(funcdata)) {
+        funcdata = (void *)mps;
+    }
+
+    fp_error_state(&bufsize, &errormask, &errobj);
+    function(dataptr, &size, steps, funcdata);
+    if (errormask &&
+        NpyUFunc_checkfperr(self->name, errormask, errobj, &first)) {
+        NpyInterface_DECREF(errobj);
+        return -1;
+    }
+    NpyInterface_DECREF(errobj);
+    return 1;
+}
+
+
 int NpyUFunc_GenericFunction(NpyUFuncObject *self, int nargs, NpyArray **mps,
                              int ntypenums, int *rtypenums,
                              int originalArgWasObjArray,
@@ -132,6 +252,14 @@ int NpyUFunc_GenericFunction(NpyUFuncObject *self, int nargs, NpyArray **mps,
 
     assert(NPY_VALID_MAGIC == self->nob_magic_number);
 
+    if (rtypenums == NULL) {
+        res = _simple_ufunc_call(self, mps, &prepare_outputs,
+                                 prepare_out_args);
+        if (res != 0) {
+            return (res < 0) ? -1 : 0;
+        }
+    }
+
     /* Build the loop. */
     loop = construct_loop(self);
     if (loop == NULL) {
@@ -801,6 +929,104 @@ fail:
 
 
 
+/*
+ * Rows shorter than this are accumulated a line at a time; calling the
+ * loop once per row costs more than the strided access it saves.
+ */
+#define NPY_ACCUMULATE_MINROW 8
+
+/*
+ * Accumulating along any axis but the last visits each line with a large
+ * stride.  When the axes after the accumulation axis are contiguous in
+ * both arr and ret, a row holding one element of every line is
+ * contiguous too, and the lines can all be advanced together:
+ *
+ *     ret[..., k, :] = op(ret[..., k-1, :], arr[..., k, :])
+ *
+ * which reads memory in order and runs the inner loop on contiguous
+ * data.  Returns the number of elements in such a row, or 0 if the
+ * layout doesn't allow this or the rows are too short to pay.
+ */
+static npy_intp
+_accumulate_row_size(NpyArray *arr, NpyArray *ret, int axis)
+{
+    npy_intp rowsize = 1;
+    int i;
+
+    if (NpyArray_NDIM(ret) != NpyArray_NDIM(arr) ||
+        !NpyArray_CompareLists(NpyArray_DIMS(ret), NpyArray_DIMS(arr),
+                               NpyArray_NDIM(arr))) {
+        return 0;
+    }
+    for (i = NpyArray_NDIM(arr) - 1; i > axis; i--) {
+        if (NpyArray_DIM(arr, i) != 1 &&
+            (NpyArray_STRIDE(arr, i) != rowsize*NpyArray_ITEMSIZE(arr) ||
+             NpyArray_STRIDE(ret, i) != rowsize*NpyArray_ITEMSIZE(ret))) {
+            return 0;
+        }
+        rowsize *= NpyArray_DIM(arr, i);
+    }
+    return (rowsize >= NPY_ACCUMULATE_MINROW) ? rowsize : 0;
+}
+
+
+/*
+ * The NOBUFFER_UFUNCLOOP accumulation a row of rowsize elements at a time
+ * (see _accumulate_row_size).  The axes before axis are walked with a
+ * plain index counter.
+ */
+static int
+_accumulate_rows(NpyUFuncReduceObject *loop, NpyArray *arr, int axis,
+                 npy_intp rowsize)
+{
+    NpyArray *ret = loop->ret;
+    npy_intp coord[NPY_MAXDIMS];
+    npy_intp steps[3];
+    npy_intp instride = NpyArray_STRIDE(arr, axis);
+    npy_intp outstride = NpyArray_STRIDE(ret, axis);
+    npy_intp nouter = 1;
+    npy_intp j, k;
+    char *args[3];
+    char *inptr = NpyArray_BYTES(arr);
+    char *outptr = NpyArray_BYTES(ret);
+    int i;
+
+    for (i = 0; i < axis; i++) {
+        coord[i] = 0;
+        nouter *= NpyArray_DIM(arr, i);
+    }
+    steps[0] = steps[2] = NpyArray_ITEMSIZE(ret);
+    steps[1] = NpyArray_ITEMSIZE(arr);
+
+    for (j = 0; j < nouter; j++) {
+        /* Copy the first row, then combine each row with the previous */
+        memmove(outptr, inptr, rowsize*NpyArray_ITEMSIZE(ret));
+        for (k = 1; k <= loop->N; k++) {
+            args[0] = outptr + (k - 1)*outstride;
+            args[1] = inptr + k*instride;
+            args[2] = outptr + k*outstride;
+            loop->function(args, &rowsize, steps, loop->funcdata);
+        }
+        NPY_UFUNC_CHECK_ERROR(loop);
+
+        for (i = axis - 1; i >= 0; i--) {
+            inptr += NpyArray_STRIDE(arr, i);
+            outptr += NpyArray_STRIDE(ret, i);
+            if (++coord[i] < NpyArray_DIM(arr, i)) {
+                break;
+            }
+            inptr -= NpyArray_STRIDE(arr, i)*NpyArray_DIM(arr, i);
+            outptr -= NpyArray_STRIDE(ret, i)*NpyArray_DIM(arr, i);
+            coord[i] = 0;
+        }
+    }
+    return 0;
+
+fail:
+    return -1;
+}
+
+
 NpyArray *
 NpyUFunc_Accumulate(NpyUFuncObject *self, NpyArray *arr, NpyArray *out,
                     int axis, int otype)
@@ -849,6 +1075,13 @@ NpyUFunc_Accumulate(NpyUFuncObject *self, NpyArray *arr, NpyArray *out,
         case NOBUFFER_UFUNCLOOP:
             /* Accumulate */
             /* fprintf(stderr, "NOBUFFER..%d\n", loop->size); */
+            if (!(loop->obj & NPY_UFUNC_OBJ_ISOBJECT) &&
+                (n = _accumulate_row_size(arr, loop->ret, axis)) > 0) {
+                if (_accumulate_rows(loop, arr, axis, n) < 0) {
+                    goto fail;
+                }
+                break;
+            }
             while (loop->index < loop->size) {
                 /* Copy first element to output */
                 if (loop->obj & NPY_UFUNC_OBJ_ISOBJECT) {
@@ -1390,6 +1623,8 @@ NpyUFunc_RegisterLoopForType(NpyUFuncObject *ufunc,
     funcdata->data = data;
     funcdata->next = NULL;
 
+    NpyUFunc_ClearTypeCache(ufunc);
+
     /* Get entry for this user-defined type*/
     current = (NpyUFunc_Loop1d *)NpyDict_Get(ufunc->userloops,
                                              (void *)(npy_intp)usertype);
@@ -1477,6 +1712,7 @@ NpyUFunc_FromFuncAndDataAndSignature(NpyUFuncGenericFunction *func,
     self->check_return = check_return;
     self->ptr = NULL;
     self->userloops=NULL;
+    self->typecache = NULL;
 
     if (name == NULL) {
         self->name = "?";
@@ -1532,6 +1768,26 @@ NpyUFunc_SetUsesArraysAsData(void **data, size_t i)
 }
 
 
+/*
+ * A loop object is allocated for every ufunc call, so a few freed ones
+ * are kept for reuse.
+ */
+#define NPY_UFUNC_LOOP_FREELIST_SIZE 4
+static NpyUFuncLoopObject *loop_freelist[NPY_UFUNC_LOOP_FREELIST_SIZE];
+static int loop_freelist_len = 0;
+
+static void
+release_loop(NpyUFuncLoopObject *loop)
+{
+    if (loop_freelist_len < NPY_UFUNC_LOOP_FREELIST_SIZE) {
+        loop_freelist[loop_freelist_len++] = loop;
+    }
+    else {
+        free(loop);
+    }
+}
+
+
 static NpyUFuncLoopObject *
 construct_loop(NpyUFuncObject *self)
 {
@@ -1543,7 +1799,10 @@ construct_loop(NpyUFuncObject *self)
         NpyErr_SetString(NpyExc_ValueError, "function not supported");
         return NULL;
     }
-    if ((loop = malloc(sizeof(NpyUFuncLoopObject))) == NULL) {
+    if (loop_freelist_len > 0) {
+        loop = loop_freelist[--loop_freelist_len];
+    }
+    else if ((loop = malloc(sizeof(NpyUFuncLoopObject))) == NULL) {
         NpyErr_MEMORY;
         return loop;
     }
@@ -1554,7 +1813,7 @@ construct_loop(NpyUFuncObject *self)
 
     loop->iter = NpyArray_MultiIterNew();
     if (loop->iter == NULL) {
-        free(loop);
+        release_loop(loop);
         return NULL;
     }
 
@@ -1688,6 +1947,14 @@ construct_arrays(NpyUFuncLoopObject *loop, size_t nargs, NpyArray **mps,
         return -1;
     }
 
+    /*
+     * Inputs that partially overlap an output would be read after the
+     * loop has written over them, so they are copied first.
+     */
+    if (_copy_overlapping_inputs(self, mps) < 0) {
+        return -1;
+    }
+
     /*
      * Only use loop dimensions when constructing Iterator:
      * temporarily replace mps[i] (will be recovered below).
@@ -2441,9 +2708,66 @@ static char *_types_msg =  "function not supported for these types, "   \
     "and can't coerce safely to supported types";
 
 
+/*
+ * Forgets every loop memoized by select_types.  Must be called whenever
+ * the ufunc's loops (functions, data, types or userloops) are changed.
+ */
+void
+NpyUFunc_ClearTypeCache(NpyUFuncObject *self)
+{
+    if (self->typecache != NULL) {
+        memset(self->typecache, 0,
+               NPY_UFUNC_TYPECACHE_SIZE * sizeof(NpyUFunc_TypeCacheEntry));
+    }
+}
+
+
+/*
+ * Returns the type cache entry that a call with the given input types
+ * and scalar kinds maps to, allocating the cache on first use.  Returns
+ * NULL if the call can't be cached (too many arguments or user-defined
+ * input types) or the cache can't be allocated.
+ */
+static NpyUFunc_TypeCacheEntry *
+_typecache_slot(NpyUFuncObject *self, int *arg_types,
+                NPY_SCALARKIND *scalars)
+{
+    npy_uint32 h = 0;
+    int i;
+
+    if (self->nargs > NPY_UFUNC_TYPECACHE_MAXARGS) {
+        return NULL;
+    }
+    for (i = 0; i < self->nin; i++) {
+        if (NpyTypeNum_ISUSERDEF(arg_types[i])) {
+            return NULL;
+        }
+    }
+    if (self->typecache == NULL) {
+        self->typecache = calloc(NPY_UFUNC_TYPECACHE_SIZE,
+                                 sizeof(NpyUFunc_TypeCacheEntry));
+        if (self->typecache == NULL) {
+            return NULL;
+        }
+    }
+    for (i = 0; i < self->nin; i++) {
+        h = (h ^ (npy_uint32)arg_types[i]) * 1000003U;
+        h = (h ^ (npy_uint32)(scalars[i] + 1)) * 1000003U;
+    }
+    /* Fibonacci hashing: the top bits of the product are well mixed */
+    h *= 2654435761U;
+    return &self->typecache[h >> (32 - NPY_UFUNC_TYPECACHE_BITS)];
+}
+
+
 /*
  * Called to determine coercion
  * Can change arg_types.
+ *
+ * Loops found by scanning the built-in signatures are memoized in the
+ * ufunc's type cache.  Explicitly requested signatures are not cached,
+ * and neither are user-defined types since the casts they can use may
+ * be registered at any time.
  */
 static int
 select_types(NpyUFuncObject *self, int *arg_types,
@@ -2455,6 +2779,7 @@ select_types(NpyUFuncObject *self, int *arg_types,
     char start_type;
     int userdef = -1;
     int userdef_ind = -1;
+    NpyUFunc_TypeCacheEntry *cached;
 
     if (self->userloops) {
         for(i = 0; i < self->nin; i++) {
@@ -2505,6 +2830,24 @@ select_types(NpyUFuncObject *self, int *arg_types,
         return ret;
     }
 
+    cached = _typecache_slot(self, arg_types, scalars);
+    if (cached != NULL && cached->used) {
+        for (j = 0; j < self->nin; j++) {
+            if (cached->intypes[j] != arg_types[j] ||
+                cached->scalars[j] != scalars[j]) {
+                break;
+            }
+        }
+        if (j == self->nin) {
+            for (j = 0; j < self->nargs; j++) {
+                arg_types[j] = cached->types[j];
+            }
+            *function = cached->function;
+            *data = cached->data;
+            return 0;
+        }
+    }
+
     start_type = arg_types[0];
     /*
      * If the first argument is a scalar we need to place
@@ -2533,6 +2876,12 @@ select_types(NpyUFuncObject *self, int *arg_types,
         NpyErr_SetString(NpyExc_TypeError, _types_msg);
         return -1;
     }
+    if (cached != NULL) {
+        for (j = 0; j < self->nin; j++) {
+            cached->intypes[j] = arg_types[j];
+            cached->scalars[j] = scalars[j];
+        }
+    }
     for (j = 0; j < self->nargs; j++) {
         arg_types[j] = self->types[i*self->nargs+j];
     }
@@ -2544,6 +2893,14 @@ select_types(NpyUFuncObject *self, int *arg_types,
     }
     *function = self->functions[i];
 
+    if (cached != NULL) {
+        for (j = 0; j < self->nargs; j++) {
+            cached->types[j] = arg_types[j];
+        }
+        cached->function = *function;
+        cached->data = *data;
+        cached->used = 1;
+    }
     return 0;
 }
 
@@ -2565,6 +2922,7 @@ npy_ufunc_frompyfunc(int nin, int nout, char *fname, size_t fname_len,
     NpyObject_Init(self, &NpyUFunc_Type);
 
     self->userloops = NULL;
+    self->typecache = NULL;
     self->nin = nin;
     self->nout = nout;
     self->nargs = nin + nout;
@@ -2736,6 +3094,9 @@ npy_ufunc_dealloc(NpyUFuncObject *self)
     if (NULL != self->userloops) {
         NpyDict_Destroy(self->userloops);
     }
+    if (NULL != self->typecache) {
+        free(self->typecache);
+    }
     self->nob_magic_number = NPY_INVALID_MAGIC;
     free(self);
 }
@@ -2760,7 +3121,7 @@ ufuncloop_dealloc(NpyUFuncLoopObject *self)
         Npy_DECREF(self->ufunc);
     }
     self->nob_magic_number = NPY_INVALID_MAGIC;
-    free(self);
+    release_loop(self);
 }
 
 
@@ -2833,6 +3194,57 @@ _create_copies(NpyUFuncLoopObject *loop, int *arg_types, NpyArray **mps)
 
 
 
+/*
+ * Returns the index of the first input that partially overlaps one of the
+ * outputs given in mps, or -1 if there is none.  Inputs that are the very
+ * same elements as an output are safe for the element-wise loops, which
+ * read each element before writing it, and don't count.  The loops of
+ * generalized ufuncs work on whole sub-arrays, so for them they do.
+ */
+static int
+_overlapping_input(NpyUFuncObject *self, NpyArray **mps)
+{
+    NPY_OVERLAP overlap;
+    int i, j;
+
+    for (i = 0; i < self->nin; i++) {
+        for (j = self->nin; j < self->nargs; j++) {
+            if (mps[j] == NULL) {
+                continue;
+            }
+            overlap = NpyArray_Overlap(mps[i], mps[j]);
+            if (overlap == NPY_OVERLAP_PARTIAL ||
+                (overlap == NPY_OVERLAP_SAME && self->core_enabled)) {
+                return i;
+            }
+        }
+    }
+    return -1;
+}
+
+
+/*
+ * Replaces every input that partially overlaps an output by a copy of
+ * it, so that a[1:] += a[:-1] gives the same result as with a separate
+ * output array.
+ */
+static int
+_copy_overlapping_inputs(NpyUFuncObject *self, NpyArray **mps)
+{
+    NpyArray *new;
+    int i;
+
+    while ((i = _overlapping_input(self, mps)) >= 0) {
+        new = NpyArray_NewCopy(mps[i], NPY_ANYORDER);
+        if (new == NULL) {
+            return -1;
+        }
+        Npy_DECREF(mps[i]);
+        mps[i] = new;
+    }
+    return 0;
+}
+
 /* Check and set core_dim_sizes and core_strides for the i-th argument. */
 static int
 _compute_dimension_size(NpyUFuncLoopObject *loop, NpyArray **mps, int i)
@@ -3381,10 +3793,10 @@ compare_ints(const void *a, const void *b)
     return 0;
 }
 
-static int
+static unsigned long
 hash_int(const void *a)
 {
-    return (int)a;  /* Size change is safe - just a hash function */
+    return (unsigned long)(npy_intp)a;
 }
 
 /* This frees the linked-list structure when the CObject is destroyed (removed
@@ -3406,7 +3818,7 @@ NpyDict *npy_create_userloops_table()
     NpyDict *new = NpyDict_CreateTable(7);  /* 7 is a guess at enough */
     NpyDict_SetKeyComparisonFunction(
         new, (int (*)(const void *, const void *))compare_ints);
-    NpyDict_SetHashFunction(new, (int (*)(const void *))hash_int);
+    NpyDict_SetHashFunction(new, hash_int);
     NpyDict_SetDeallocationFunctions(new, NULL,
                                      (void (*)(void *))free_loop1d_list);
     return new;
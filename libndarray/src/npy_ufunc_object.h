@@ -35,6 +35,25 @@ typedef struct {
 
 struct NpyDict_struct;
 
+/*
+ * Type resolution cache.  select_types memoizes the loop it picks for
+ * each combination of input types and scalar kinds in a small
+ * direct-mapped table hanging off the ufunc.
+ */
+#define NPY_UFUNC_TYPECACHE_BITS 4
+#define NPY_UFUNC_TYPECACHE_SIZE (1 << NPY_UFUNC_TYPECACHE_BITS)
+/* Only ufuncs with at most this many arguments are cached */
+#define NPY_UFUNC_TYPECACHE_MAXARGS 4
+
+typedef struct {
+    int used;
+    int intypes[NPY_UFUNC_TYPECACHE_MAXARGS];
+    NPY_SCALARKIND scalars[NPY_UFUNC_TYPECACHE_MAXARGS];
+    int types[NPY_UFUNC_TYPECACHE_MAXARGS];    /* selected signature */
+    NpyUFuncGenericFunction function;
+    void *data;
+} NpyUFunc_TypeCacheEntry;
+
 struct NpyUFuncObject {
     NpyObject_HEAD
 
@@ -62,6 +81,9 @@ struct NpyUFuncObject {
     int *core_offsets;     /* positions of 1st core dimensions of each
                             argument in core_dim_ixs */
     char *core_signature;  /* signature string for printing purpose */
+
+    /* Allocated on first use; NPY_UFUNC_TYPECACHE_SIZE entries */
+    NpyUFunc_TypeCacheEntry *typecache;
 };
 
 typedef struct NpyUFuncObject NpyUFuncObject;
@@ -250,6 +272,10 @@ NDARRAY_API NpyArray *
 NpyArray_GenericBinaryFunction(NpyArray *m1, NpyArray *m2, NpyUFuncObject *op, 
                                NpyArray *out);
 
+NDARRAY_API NpyArray *
+NpyArray_GenericBinaryFunctionTemp(NpyArray *m1, NpyArray *m2,
+                                   NpyUFuncObject *op);
+
 NDARRAY_API NpyArray *
 NpyArray_GenericUnaryFunction(NpyArray *m1, NpyUFuncObject *op, NpyArray *out);
 
@@ -281,6 +307,8 @@ NpyUFunc_Reduceat(NpyUFuncObject *self, NpyArray *arr, NpyArray *ind,
 
 int
 NpyUFunc_SetUsesArraysAsData(void **data, size_t i);
+void
+NpyUFunc_ClearTypeCache(NpyUFuncObject *self);
 int
 NpyUFunc_RegisterLoopForType(NpyUFuncObject *ufunc,
                              int usertype,
@@ -3866,7 +3866,7 @@ add_newdoc('numpy.lib._compiled_base', 'add_docstring',
 
 add_newdoc('numpy.lib._compiled_base', 'packbits',
     """
-    packbits(myarray, axis=None)
+    packbits(myarray, axis=None, bitorder='big')
 
     Packs the elements of a binary-valued array into bits in a uint8 array.
 
@@ -3875,10 +3875,15 @@ add_newdoc('numpy.lib._compiled_base', 'packbits',
     Parameters
     ----------
     myarray : array_like
-        An integer type array whose elements should be packed to bits.
+        An integer or boolean array whose elements should be packed to bits.
     axis : int, optional
         The dimension over which bit-packing is done.
         ``None`` implies packing the flattened array.
+    bitorder : {'big', 'little'}, optional
+        The order of the packed bits.  'big' puts the first element of
+        each group of 8 in the most significant bit, as in
+        ``[1, 1, 0, 0, 0, 0, 0, 0] => 192``; 'little' puts it in the
+        least significant bit, as in ``[1, 1, 0, 0, 0, 0, 0, 0] => 3``.
 
     Returns
     -------
@@ -3910,7 +3915,7 @@ add_newdoc('numpy.lib._compiled_base', 'packbits',
 
 add_newdoc('numpy.lib._compiled_base', 'unpackbits',
     """
-    unpackbits(myarray, axis=None)
+    unpackbits(myarray, axis=None, bitorder='big')
 
     Unpacks elements of a uint8 array into a binary-valued output array.
 
@@ -3925,6 +3930,9 @@ add_newdoc('numpy.lib._compiled_base', 'unpackbits',
        Input array.
     axis : int, optional
        Unpacks along this axis.
+    bitorder : {'big', 'little'}, optional
+       The order of the returned bits: most significant bit first for
+       'big', least significant first for 'little'.  See `packbits`.
 
     Returns
     -------
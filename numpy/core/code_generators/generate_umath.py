@@ -315,7 +315,8 @@ defdict = {
     Ufunc(2, 1, One,
           docstrings.get('numpy.core.umath.power'),
           TD(ints),
-          TD(inexact, f='pow'),
+          TD('fd'),
+          TD('g' + cmplx, f='pow'),
           TD(O, f='npy_ObjectPower'),
           ),
 'absolute' :
@@ -526,13 +527,15 @@ defdict = {
 'cos' :
     Ufunc(1, 1, None,
           docstrings.get('numpy.core.umath.cos'),
-          TD(inexact, f='cos'),
+          TD('fd'),
+          TD('g' + cmplx, f='cos'),
           TD(P, f='cos'),
           ),
 'sin' :
     Ufunc(1, 1, None,
           docstrings.get('numpy.core.umath.sin'),
-          TD(inexact, f='sin'),
+          TD('fd'),
+          TD('g' + cmplx, f='sin'),
           TD(P, f='sin'),
           ),
 'tan' :
@@ -556,13 +559,15 @@ defdict = {
 'tanh' :
     Ufunc(1, 1, None,
           docstrings.get('numpy.core.umath.tanh'),
-          TD(inexact, f='tanh'),
+          TD('fd'),
+          TD('g' + cmplx, f='tanh'),
           TD(P, f='tanh'),
           ),
 'exp' :
     Ufunc(1, 1, None,
           docstrings.get('numpy.core.umath.exp'),
-          TD(inexact, f='exp'),
+          TD('fd'),
+          TD('g' + cmplx, f='exp'),
           TD(P, f='exp'),
           ),
 'exp2' :
@@ -574,13 +579,15 @@ defdict = {
 'expm1' :
     Ufunc(1, 1, None,
           docstrings.get('numpy.core.umath.expm1'),
-          TD(inexact, f='expm1'),
+          TD('fd'),
+          TD('g' + cmplx, f='expm1'),
           TD(P, f='expm1'),
           ),
 'log' :
     Ufunc(1, 1, None,
           docstrings.get('numpy.core.umath.log'),
-          TD(inexact, f='log'),
+          TD('fd'),
+          TD('g' + cmplx, f='log'),
           TD(P, f='log'),
           ),
 'log2' :
@@ -598,13 +605,15 @@ defdict = {
 'log1p' :
     Ufunc(1, 1, None,
           docstrings.get('numpy.core.umath.log1p'),
-          TD(inexact, f='log1p'),
+          TD('fd'),
+          TD('g' + cmplx, f='log1p'),
           TD(P, f='log1p'),
           ),
 'sqrt' :
     Ufunc(1, 1, None,
           docstrings.get('numpy.core.umath.sqrt'),
-          TD(inexact, f='sqrt'),
+          TD('fd'),
+          TD('g' + cmplx, f='sqrt'),
           TD(P, f='sqrt'),
           ),
 'ceil' :
@@ -486,6 +486,8 @@ def configuration(parent_package='', top_path=None):
                                   generate_numpyconfig_h,
                                   generate_numpy_api,
                                   generate_ufunc_api],
+                         library_dirs=[ndarray_lib_dir()],
+                         libraries=['ndarray'],
                          )
 
     # Configure blasdot
@@ -515,7 +517,9 @@ def configuration(parent_package='', top_path=None):
 
     config.add_extension('multiarray_tests',
                     sources = [join('src', 'multiarray',
-                                    'multiarray_tests.c.src')])
+                                    'multiarray_tests.c.src')],
+                    library_dirs=[ndarray_lib_dir()],
+                    libraries=['ndarray'])
 
     config.add_data_dir('tests')
     config.add_data_dir('tests/data')
@@ -67,6 +67,10 @@ PyArray_ArgMin(PyArrayObject *ap, int axis, PyArrayObject *out)
 {
     PyObject *obj, *new, *ret;
 
+    if (PyArray_DESCR(ap)->f->argmin != NULL) {
+        RETURN_PYARRAY(NpyArray_ArgMin(PyArray_ARRAY(ap), axis,
+                                       PyArray_ARRAY(out)));
+    }
     if (PyArray_ISFLEXIBLE(ap)) {
         PyErr_SetString(PyExc_TypeError,
                         "argmax is unsupported for this type");
@@ -1235,6 +1235,50 @@ array_correlate2(PyObject *NPY_UNUSED(dummy), PyObject *args, PyObject *kwds)
     return PyArray_Correlate2(a0, shape, mode);
 }
 
+static PyObject*
+array_correlate2d(PyObject *NPY_UNUSED(dummy), PyObject *args, PyObject *kwds)
+{
+    PyObject *op1, *op2, *ret = NULL;
+    PyArrayObject *ap1, *ap2;
+    int mode = 0, typenum;
+    static char *kwlist[] = {"a", "v", "mode", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "OO|i", kwlist,
+                &op1, &op2, &mode)) {
+        return NULL;
+    }
+    /* Only float and double, real or complex, are implemented */
+    typenum = PyArray_ObjectType(op1, 0);
+    typenum = PyArray_ObjectType(op2, typenum);
+    if (NpyTypeNum_ISCOMPLEX(typenum)) {
+        typenum = (typenum == PyArray_CFLOAT) ? PyArray_CFLOAT
+                                              : PyArray_CDOUBLE;
+    }
+    else {
+        typenum = (typenum == PyArray_FLOAT) ? PyArray_FLOAT
+                                             : PyArray_DOUBLE;
+    }
+    ap1 = (PyArrayObject *)PyArray_FromAny(op1,
+                                           PyArray_DescrFromType(typenum),
+                                           2, 2, DEFAULT, NULL);
+    if (ap1 == NULL) {
+        return NULL;
+    }
+    ap2 = (PyArrayObject *)PyArray_FromAny(op2,
+                                           PyArray_DescrFromType(typenum),
+                                           2, 2, DEFAULT, NULL);
+    if (ap2 == NULL) {
+        Py_DECREF(ap1);
+        return NULL;
+    }
+    ASSIGN_TO_PYARRAY(ret,
+                      NpyArray_Correlate2D(PyArray_ARRAY(ap1),
+                                           PyArray_ARRAY(ap2), typenum, mode));
+    Py_DECREF(ap1);
+    Py_DECREF(ap2);
+    return ret;
+}
+
 static PyObject *
 array_arange(PyObject *NPY_UNUSED(ignored), PyObject *args, PyObject *kws) {
     PyObject *o_start = NULL, *o_stop = NULL, *o_step = NULL;
@@ -2115,6 +2159,9 @@ static struct PyMethodDef array_module_methods[] = {
     {"correlate2",
         (PyCFunction)array_correlate2,
         METH_VARARGS | METH_KEYWORDS, NULL},
+    {"correlate2d",
+        (PyCFunction)array_correlate2d,
+        METH_VARARGS | METH_KEYWORDS, NULL},
     {"frombuffer",
         (PyCFunction)array_frombuffer,
         METH_VARARGS | METH_KEYWORDS, NULL},
@@ -1385,6 +1385,7 @@ NpyUFunc_ReplaceLoopBySignature(NpyUFuncObject *func,
             *oldfunc = func->functions[i];
         }
         func->functions[i] = newfunc;
+        NpyUFunc_ClearTypeCache(func);
         res = 0;
         break;
     }
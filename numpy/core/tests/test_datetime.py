@@ -1,6 +1,8 @@
 from os import path
 import numpy as np
 from numpy.testing import *
+from numpy.core.multiarray_tests import test_datetime_fields, \
+     test_fields_datetime
 import datetime
 
 class TestDateTime(TestCase):
@@ -258,7 +260,6 @@ class TestDateTimeAstype(TestCase):
         datetimes = np.array([0, 100, 70], dtype="datetime64[D]")
         assert_equal(datetimes.astype('datetime64[M]'), np.array([0, 3, 2], dtype="datetime64[M]"))
 
-    @dec.knownfailureif(True, "datetime converions fail.")
     def test_datetime_astype_weeks(self):
         datetimes = np.array([0, 22, 15], dtype="datetime64[D]")
         assert_equal(datetimes.astype('datetime64[W]'), np.array([0, 3, 2], dtype="datetime64[W]"))
@@ -285,35 +286,30 @@ class TestDateTimeAstype(TestCase):
         datetimes = np.array([0, 190, 153], dtype="datetime64[m]")
         assert_equal(datetimes.astype('datetime64[h]'), np.array([0, 3, 2], dtype="datetime64[h]"))
 
-    @dec.knownfailureif(True, "datetime converions fail.")
     def test_datetime_astype_minutes(self):
         datetimes = np.array([0, 3, 2], dtype="datetime64[h]")
         assert_equal(datetimes.astype('datetime64[m]'), np.array([0, 180, 120], dtype="datetime64[m]"))
         datetimes = np.array([0, 190, 153], dtype="datetime64[s]")
         assert_equal(datetimes.astype('datetime64[m]'), np.array([0, 3, 2], dtype="datetime64[m]"))
 
-    @dec.knownfailureif(True, "datetime converions fail.")
     def test_datetime_astype_seconds(self):
         datetimes = np.array([0, 3, 2], dtype="datetime64[m]")
         assert_equal(datetimes.astype('datetime64[s]'), np.array([0, 180, 120], dtype="datetime64[s]"))
         datetimes = np.array([0, 3200, 2430], dtype="datetime64[ms]")
         assert_equal(datetimes.astype('datetime64[s]'), np.array([0, 3, 2], dtype="datetime64[s]"))
 
-    @dec.knownfailureif(True, "datetime converions fail.")
     def test_datetime_astype_milliseconds(self):
         datetimes = np.array([0, 3, 2], dtype="datetime64[s]")
         assert_equal(datetimes.astype('datetime64[ms]'), np.array([0, 3000, 2000], dtype="datetime64[ms]"))
         datetimes = np.array([0, 3200, 2430], dtype="datetime64[us]")
         assert_equal(datetimes.astype('datetime64[ms]'), np.array([0, 3, 2], dtype="datetime64[ms]"))
 
-    @dec.knownfailureif(True, "datetime converions fail.")
     def test_datetime_astype_microseconds(self):
         datetimes = np.array([0, 3, 2], dtype="datetime64[ms]")
         assert_equal(datetimes.astype('datetime64[us]'), np.array([0, 3000, 2000], dtype="datetime64[us]"))
         datetimes = np.array([0, 3200, 2430], dtype="datetime64[ns]")
         assert_equal(datetimes.astype('datetime64[us]'), np.array([0, 3, 2], dtype="datetime64[us]"))
 
-    @dec.knownfailureif(True, "datetime converions fail.")
     def test_datetime_astype_nanoseconds(self):
         datetimes = np.array([0, 3, 2], dtype="datetime64[us]")
         assert_equal(datetimes.astype('datetime64[ns]'), np.array([0, 3000, 2000], dtype="datetime64[ns]"))
@@ -334,11 +330,83 @@ class TestDateTimeAstype(TestCase):
         datetimes = np.array([0, 3200, 2430], dtype="datetime64[ps]")
         assert_equal(datetimes.astype('datetime64[fs]'), np.array([0, 3, 2], dtype="datetime64[fs]"))
 
-    @dec.knownfailureif(True, "datetime converions fail.")
     def test_datetime_astype_attoseconds(self):
         datetimes = np.array([0, 3, 2], dtype="datetime64[fs]")
         assert_equal(datetimes.astype('datetime64[as]'), np.array([0, 3000, 2000], dtype="datetime64[as]"))
 
+    def test_datetime_astype_floor(self):
+        datetimes = np.array([-1, -60, -61, 59], dtype="datetime64[s]")
+        assert_equal(datetimes.astype('datetime64[m]'), np.array([-1, -1, -2, 0], dtype="datetime64[m]"))
+
+    def test_datetime_astype_overflow(self):
+        datetimes = np.array([0, 2**62], dtype="datetime64[s]")
+        self.assertRaises(ValueError, datetimes.astype, 'datetime64[ms]')
+
+    def test_datetime_astype_overflow_calendar_units(self):
+        for dt in ['datetime64[4M]', 'datetime64[3Y]', 'timedelta64[4M]']:
+            a = np.array([0, 2**62], dtype=dt)
+            self.assertRaises(ValueError, a.astype, dt[:-3] + '[D]')
+
+
+class TestDateTimeFields(TestCase):
+    def test_scalar_seconds(self):
+        # The time of day, not the whole value, is split into h/m/s
+        a = np.array([86400 + 3661, 10**9], dtype='M8[s]')
+        assert_equal(a.tolist(), [datetime.datetime(1970, 1, 2, 1, 1, 1),
+                                  datetime.datetime(2001, 9, 9, 1, 46, 40)])
+
+    def test_scalar_milliseconds(self):
+        a = np.array([-1, -86400000 - 1, -86400000*400 - 1], dtype='M8[ms]')
+        assert_equal(a.tolist(),
+                     [datetime.datetime(1969, 12, 31, 23, 59, 59, 999000),
+                      datetime.datetime(1969, 12, 30, 23, 59, 59, 999000),
+                      datetime.datetime(1968, 11, 26, 23, 59, 59, 999000)])
+
+    def test_scalar_nanoseconds(self):
+        a = np.array([(86400 + 3661)*10**9 + 5000, -86400*10**9 - 1000],
+                     dtype='M8[ns]')
+        assert_equal(a.tolist(),
+                     [datetime.datetime(1970, 1, 2, 1, 1, 1, 5),
+                      datetime.datetime(1969, 12, 30, 23, 59, 59, 999999)])
+
+    def test_bulk_against_scalar(self):
+        rng = np.random.RandomState(7)
+        spans = {'Y': 3000, 'M': 30000, 'W': 100000, 'D': 10**6,
+                 'h': 2*10**7, 'm': 10**9, 's': 6*10**10, 'ms': 6*10**13,
+                 'us': 6*10**16, 'ns': 9*10**18}
+        for unit, span in spans.items():
+            v = ((rng.random_sample(203) - 0.5) * span).astype(np.int64)
+            v[-3:] = [0, -1, 1]
+            a = v.view('M8[%s]' % unit)
+            f = test_datetime_fields(a)
+            got = [datetime.datetime(*[int(x[i]) for x in f[:7]])
+                   for i in range(len(a))]
+            assert_equal(got, a.tolist(), err_msg=unit)
+            # and strided
+            f2 = test_datetime_fields(a[::-3])
+            for x, x2 in zip(f, f2):
+                assert_equal(x[::-3], x2, err_msg=unit)
+
+    def test_roundtrip(self):
+        for unit in ['D', 'h', 'm', 's', 'ms', 'us', 'ns', 'ps', 'Y', 'M']:
+            a = np.array([0, 1, -1, 12345, -98765, 2**40, -2**40],
+                         dtype=np.int64).view('M8[%s]' % unit)
+            if unit in ['Y', 'M', 'D', 'h']:
+                a = a[:5]
+            f = test_datetime_fields(a)
+            assert_equal(test_fields_datetime(f, a).view(np.int64),
+                         a.view(np.int64), err_msg=unit)
+
+    def test_defaults_and_errors(self):
+        a = np.array([0], dtype='M8[s]')
+        f = [None]*9
+        f[5] = [30]
+        assert_equal(test_fields_datetime(f, a).view(np.int64), [30])
+        f = [[2000], [13], [1]] + [None]*6
+        assert_raises(ValueError, test_fields_datetime, f, a)
+        f = [[2001], [2], [29]] + [None]*6
+        assert_raises(ValueError, test_fields_datetime, f, a)
+
 
 if __name__ == "__main__":
     run_module_suite()
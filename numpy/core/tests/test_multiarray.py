@@ -6,6 +6,7 @@ import numpy as np
 from numpy.testing import *
 from numpy.core import *
 from numpy.core.multiarray_tests import test_neighborhood_iterator, test_neighborhood_iterator_oob
+from numpy.core.multiarray_tests import test_stencil
 
 from numpy.compat import asbytes, getexception, strchar
 
@@ -750,6 +751,68 @@ class TestArgmax(TestCase):
             axes.remove(i)
             assert all(amax == aargmax.choose(*a.transpose(i,*axes)))
 
+    def test_byteswapped(self):
+        for dt in ['D', 'F']:
+            a = np.array([1+5j, 3+0j], dtype=dt)
+            b = a.astype(a.dtype.newbyteorder())
+            assert_equal(b.argmax(), 1)
+            assert_equal(b.argmin(), 0)
+            assert_equal(b[::-1].argmax(), 0)
+        a = np.array([u'b', u'\u0101', u'a', u'\u0100c'])
+        b = a.astype(a.dtype.newbyteorder())
+        assert_equal(b.argmax(), 1)
+        assert_equal(b.argmin(), 2)
+        assert_equal(b[::2].argmax(), 0)
+
+    def test_argminmax(self):
+        # long enough for ArgMinMax to go a chunk at a time, with the
+        # extremes in the first chunks and repeated in later ones
+        from numpy.core.multiarray_tests import test_argminmax
+        for t in [np.int8, np.int32, np.int64, np.float32, np.float64]:
+            a = (np.arange(20000) % 7 + 1).astype(t)
+            a[100] = 0
+            a[5000] = 9
+            a[15000] = 0
+            a[19999] = 9
+            imin, imax = test_argminmax(a, 0)
+            assert_equal(imin, 100)
+            assert_equal(imax, 5000)
+            b = np.vstack([a, a[::-1]])
+            imin, imax = test_argminmax(b, 1)
+            assert_equal(imin, [100, 4999])
+            assert_equal(imax, [5000, 0])
+            assert_equal(imin, b.argmin(1))
+            assert_equal(imax, b.argmax(1))
+
+class TestArgmin(TestCase):
+    def test_all(self):
+        a = np.random.normal(0,1,(4,5,6,7,8))
+        for i in xrange(a.ndim):
+            amin = a.min(i)
+            aargmin = a.argmin(i)
+            axes = range(a.ndim)
+            axes.remove(i)
+            assert all(amin == aargmin.choose(*a.transpose(i,*axes)))
+
+    def test_first_index(self):
+        # Long enough to take the blocked path, with the extremes repeated.
+        for t in [np.int8, np.uint8, np.int16, np.int32, np.int64,
+                  np.float32, np.float64]:
+            a = (np.arange(1000) % 7 + 1).astype(t)
+            assert_equal(a.argmin(), 0)
+            assert_equal(a.argmax(), 6)
+            a[500] = 0
+            a[700] = 9
+            assert_equal(a.argmin(), 500)
+            assert_equal(a.argmax(), 700)
+            assert_equal(a[::-1].argmin(), 499)
+            assert_equal(a[::2].argmax(), 350)
+
+    def test_unsigned(self):
+        a = np.array([1, 255, 0, 128] * 100, dtype=np.uint8)
+        assert_equal(a.argmin(), 2)
+        assert_equal(a.argmax(), 1)
+
 class TestMinMax(TestCase):
     def test_scalar(self):
         assert_raises(ValueError, np.amax, 1, 1)
@@ -1557,6 +1620,49 @@ class TestStackedNeighborhoodIter(TestCase):
                 [-1, 2], NEIGH_MODE['circular'])
         assert_array_equal(l, r)
 
+class TestStencil(TestCase):
+    def _check(self, x, bounds, fill, mode):
+        # Compare with the weighted sums of the iterator's neighborhoods
+        shape = [bounds[2*i+1] - bounds[2*i] + 1 for i in range(x.ndim)]
+        w = np.random.rand(*shape)
+        w.flat[::3] = 0
+        l = test_neighborhood_iterator(x, bounds, fill, mode)
+        r = np.array([(n*w).sum() for n in l]).reshape(x.shape)
+        assert_array_almost_equal(test_stencil(x, bounds, w, fill, mode), r)
+
+    def test_1d(self):
+        x = np.random.rand(600)
+        for mode in NEIGH_MODE.values():
+            self._check(x, [-2, 3], 0.5, mode)
+            self._check(x, [1, 4], 0.5, mode)
+
+    def test_2d(self):
+        x = np.random.rand(30, 300)
+        for mode in NEIGH_MODE.values():
+            self._check(x, [-1, 1, -2, 1], 0.5, mode)
+            self._check(x.T, [-3, 0, 0, 2], 0.5, mode)
+
+    def test_small(self):
+        # No interior: every point is on the border
+        x = np.random.rand(3, 2)
+        for mode in NEIGH_MODE.values():
+            self._check(x, [-2, 2, -2, 2], 0.5, mode)
+
+    def test_errors(self):
+        x = np.random.rand(5, 6)
+        mode = NEIGH_MODE['zero']
+        assert_raises(ValueError, test_stencil, x, [1, 0, 0, 0], [],
+                      0.0, mode)
+        assert_raises(ValueError, test_stencil, x, [0, 0, 0, 0], [1.],
+                      0.0, NEIGH_MODE['constant'] + 10)
+        # An empty axis does not skip the checks of the later ones
+        assert_raises(ValueError, test_stencil, np.zeros((0, 6)),
+                      [0, 0, 1, 0], [], 0.0, mode)
+        assert_equal(test_stencil(np.zeros((0, 6)), [0, 0, -1, 1],
+                                  [1., 1., 1.], 0.0, mode).shape, (0, 6))
+        # Still usable after the failures
+        self._check(x, [-1, 1, -1, 1], 0.5, mode)
+
 class TestWarnings(object):
     def setUp(self):
         warnings.resetwarnings()
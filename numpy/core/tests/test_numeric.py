@@ -948,6 +948,96 @@ class TestCorrelateNew(_TestCorrelate):
         z = np.correlate(y, x, 'full', old_behavior=self.old_behavior)
         assert_array_almost_equal(z, r_z)
 
+class TestCorrelateLong(TestCase):
+    # Long kernels are correlated by FFT, short ones directly.
+    def _direct(self, x, y):
+        n = len(y)
+        xp = np.concatenate((np.zeros(n - 1, x.dtype), x,
+                             np.zeros(n - 1, x.dtype)))
+        return np.array([np.dot(xp[i:i + n], y.conj())
+                         for i in range(len(x) + n - 1)])
+
+    def _correlate(self, x, y, mode):
+        # the signal processing definition, which conjugates y
+        return np.correlate(x, y, mode, old_behavior=False)
+
+    def test_float(self):
+        for n1, n2 in [(1000, 7), (1000, 300), (300, 1000), (5000, 2000)]:
+            x = rand(n1)
+            y = rand(n2)
+            z = self._correlate(x, y, 'full')
+            if n1 >= n2:
+                assert_array_almost_equal(z, self._direct(x, y))
+            else:
+                assert_array_almost_equal(z, self._direct(y, x)[::-1])
+            assert_array_almost_equal(self._correlate(x, y, 'valid'),
+                                      z[min(n1, n2) - 1:max(n1, n2)])
+
+    def test_complex(self):
+        for n1, n2 in [(1000, 7), (3000, 500)]:
+            x = rand(n1) + 1j*rand(n1)
+            y = rand(n2) + 1j*rand(n2)
+            assert_array_almost_equal(self._correlate(x, y, 'full'),
+                                      self._direct(x, y))
+
+    def test_single(self):
+        x = rand(3000).astype(np.float32)
+        y = rand(500).astype(np.float32)
+        z = self._correlate(x, y, 'full')
+        assert_equal(z.dtype, np.float32)
+        assert_array_almost_equal(z, self._direct(x.astype(float),
+                                                  y.astype(float)), 3)
+
+
+class TestCorrelate2D(TestCase):
+    def _direct(self, x, y):
+        n, m = y.shape
+        xp = np.zeros((x.shape[0] + 2*n - 2, x.shape[1] + 2*m - 2), x.dtype)
+        xp[n - 1:n - 1 + x.shape[0], m - 1:m - 1 + x.shape[1]] = x
+        z = np.empty((x.shape[0] + n - 1, x.shape[1] + m - 1), x.dtype)
+        for i in range(z.shape[0]):
+            for j in range(z.shape[1]):
+                z[i, j] = (xp[i:i + n, j:j + m] * y.conj()).sum()
+        return z
+
+    def test_modes(self):
+        from numpy.core.multiarray import correlate2d
+        for shape, kshape in [((20, 30), (3, 5)), ((64, 64), (25, 20))]:
+            x = rand(*shape)
+            y = rand(*kshape)
+            z = self._direct(x, y)
+            n, m = kshape
+            assert_array_almost_equal(correlate2d(x, y, 2), z)
+            assert_array_almost_equal(correlate2d(x, y, 0),
+                                      z[n - 1:shape[0], m - 1:shape[1]])
+            assert_array_almost_equal(correlate2d(x, y, 1),
+                                      z[n - 1 - n//2:n - 1 - n//2 + shape[0],
+                                        m - 1 - m//2:m - 1 - m//2 + shape[1]])
+            self.assertRaises(ValueError, correlate2d, y, x, 0)
+
+    def test_complex(self):
+        from numpy.core.multiarray import correlate2d
+        x = rand(30, 40) + 1j*rand(30, 40)
+        y = rand(20, 20) + 1j*rand(20, 20)
+        assert_array_almost_equal(correlate2d(x, y, 2), self._direct(x, y))
+
+    def test_empty(self):
+        from numpy.core.multiarray import correlate2d
+        for dt in [np.float64, np.complex128]:
+            for shape, kshape in [((0, 5), (3, 3)), ((4, 0), (3, 3)),
+                                  ((4, 5), (0, 3)), ((4, 5), (3, 0)),
+                                  ((0, 0), (0, 0))]:
+                x = np.ones(shape, dt)
+                y = np.ones(kshape, dt)
+                z = correlate2d(x, y, 2)
+                assert_equal(z.shape, (max(shape[0] + kshape[0] - 1, 0),
+                                       max(shape[1] + kshape[1] - 1, 0)))
+                assert_array_equal(z, 0)
+                z = correlate2d(x, y, 1)
+                assert_equal(z.shape, shape)
+                assert_array_equal(z, 0)
+
+
 class TestArgwhere:
     def test_2D(self):
         x = np.arange(6).reshape((2, 3))
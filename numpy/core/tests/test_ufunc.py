@@ -563,5 +563,51 @@ class TestUfunc(TestCase):
 
         assert_equal(ref, True, err_msg="reference check")
 
+class TestTypeCache(TestCase):
+    def _operands(self):
+        ops = []
+        for t in '?bBhHiIlLqQfdgFDG':
+            ops.append(np.ones(3, dtype=t))
+        ops.extend([True, 1, 1.0, 1j])
+        return ops
+
+    def test_repeated_calls(self):
+        # The second and third rounds are resolved from the type cache,
+        # in a different order so that the entries collide differently.
+        ops = self._operands()
+        first = {}
+        for i, x in enumerate(ops):
+            for j, y in enumerate(ops):
+                r = np.add(x, y)
+                first[i, j] = (np.asarray(r).dtype, np.asarray(r).tolist())
+        for order in (-1, 1):
+            for i, x in list(enumerate(ops))[::order]:
+                for j, y in list(enumerate(ops))[::-order]:
+                    r = np.add(x, y)
+                    assert_equal((np.asarray(r).dtype,
+                                  np.asarray(r).tolist()), first[i, j])
+
+    def test_scalar_kinds(self):
+        # Same type numbers, different scalar kinds: must not share an entry
+        f = np.ones(3, dtype=np.float32)
+        d = np.ones(3, dtype=np.float64)
+        for k in range(3):
+            assert_equal(np.add(f, 1.0).dtype, np.float32)
+            assert_equal(np.add(f, d).dtype, np.float64)
+            assert_equal(np.add(f, d[0]).dtype, np.float32)
+            assert_equal(np.add(f[0], d).dtype, np.float64)
+
+    def test_replaced_loop(self):
+        a = np.arange(5.)
+        assert_array_equal(np.add(a, a), 2 * a)
+        umt.replace_double_loop(np.add, 1)
+        try:
+            assert_array_equal(np.add(a, a), -np.ones(5))
+            assert_array_equal(np.add(a, 1.0), -np.ones(5))
+        finally:
+            umt.replace_double_loop(np.add, 0)
+        assert_array_equal(np.add(a, a), 2 * a)
+        assert_array_equal(np.add(a, 1.0), a + 1)
+
 if __name__ == "__main__":
     run_module_suite()
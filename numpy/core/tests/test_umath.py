@@ -59,6 +59,16 @@ class TestPower(TestCase):
         assert_almost_equal(x**(-1), [1., 0.5, 1./3])
         assert_almost_equal(x**(0.5), [1., ncu.sqrt(2), ncu.sqrt(3)])
 
+    def test_power_float_scalar_exponent(self):
+        for dt in ['f', 'd']:
+            # x**0.5 would take the sqrt ufunc; call power for its loop
+            x = np.array([-np.inf, -0.0, 0.0, 2.0, np.inf], dtype=dt)
+            r = np.power(x, 0.5)
+            assert_equal(r, np.array([np.inf, 0.0, 0.0, np.sqrt(2), np.inf], dt))
+            assert_(not np.signbit(r).any())
+            assert_equal(np.power(x, -1), [-0.0, -np.inf, np.inf, 0.5, 0.0])
+            assert_equal(np.power(x, 2.5)[3:], np.array([2.0**2.5, np.inf], dt))
+
     def test_power_complex(self):
         x = np.array([1+2j, 2+3j, 3+4j])
         assert_equal(x**0, [1., 1., 1.])
@@ -236,6 +246,243 @@ class TestExpm1(TestCase):
         assert_almost_equal(ncu.expm1(1e-6), ncu.exp(1e-6)-1)
 
 
+class TestFloatMathLoops(TestCase):
+    funcs = [np.exp, np.log, np.expm1, np.log1p, np.sin, np.cos, np.tanh,
+             np.sqrt]
+
+    def test_against_libm(self):
+        import math
+        x = np.concatenate([np.linspace(-40, 40, 4001),
+                            np.logspace(-12, 1.9, 500)])
+        for f in self.funcs:
+            ref = getattr(math, f.__name__)
+            if f in (np.log, np.sqrt):
+                xx = np.abs(x[x != 0])
+            elif f is np.log1p:
+                xx = x[x > -1]
+            else:
+                xx = x
+            for dt in ['f', 'd']:
+                y = f(xx.astype(dt))
+                assert_equal(y.dtype, np.dtype(dt))
+                r = np.array([ref(v) for v in xx.astype(dt).astype(float)])
+                assert_array_max_ulp(y, r.astype(dt), 2)
+
+    def test_strided(self):
+        x = np.linspace(0.01, 30, 3001)
+        for f in self.funcs:
+            for dt in ['f', 'd']:
+                xx = x.astype(dt)
+                assert_array_equal(f(xx[::3]), f(xx)[::3])
+                out = np.zeros(2*len(xx), dtype=dt)
+                f(xx, out[::2])
+                assert_array_equal(out[::2], f(xx))
+
+    def test_special_values(self):
+        inf, nan = np.inf, np.nan
+        x = [nan, inf, -inf, 0.0, -0.0, 1e-30, 800.0, -800.0, -1.0]
+        expected = {np.exp: [nan, inf, 0.0, 1.0, 1.0, 1.0, inf, 0.0,
+                             np.exp(-1.0)],
+                    np.log: [nan, inf, nan, -inf, -inf, np.log(1e-30),
+                             np.log(800.0), nan, nan],
+                    np.sin: [nan, nan, nan, 0.0, -0.0, 1e-30, np.sin(800.0),
+                             -np.sin(800.0), -np.sin(1.0)],
+                    np.tanh: [nan, 1.0, -1.0, 0.0, -0.0, 1e-30, 1.0, -1.0,
+                              -np.tanh(1.0)]}
+        err = np.seterr(all='ignore')
+        try:
+            for f, y in expected.items():
+                r = f(np.array(x))
+                assert_array_equal(r, y)
+                y = np.array(y)
+                ok = ~np.isnan(y)
+                assert_array_equal(np.signbit(r[ok]), np.signbit(y[ok]))
+        finally:
+            np.seterr(**err)
+
+
+class TestComplexArithmeticLoops(TestCase):
+    def _data(self, dt, n=1001):
+        x = np.linspace(-3, 3, n)
+        z = (x + 1j*x[::-1]**3).astype(dt)
+        w = (x[::-1] - 1j*np.sin(x)).astype(dt)
+        return z, w
+
+    def test_against_scalar(self):
+        for dt in ['F', 'D']:
+            z, w = self._data(dt)
+            for f in [np.add, np.subtract, np.multiply]:
+                r = f(z, w)
+                assert_equal(r.dtype, np.dtype(dt))
+                assert_array_equal(r, [f(a, b) for a, b in zip(z, w)])
+            assert_array_equal(np.conjugate(z), z.real - 1j*z.imag)
+            assert_equal(np.absolute(z).dtype, z.real.dtype)
+            assert_array_max_ulp(np.absolute(z),
+                                 np.hypot(z.real, z.imag), 2)
+
+    def test_product_with_conjugate_is_real(self):
+        for dt in ['F', 'D']:
+            z, w = self._data(dt)
+            assert_array_equal((z*z.conj()).imag, 0)
+
+    def test_strided(self):
+        for dt in ['F', 'D']:
+            z, w = self._data(dt)
+            assert_array_equal(np.multiply(z[::3], w[::3]), (z*w)[::3])
+            assert_array_equal(np.absolute(z[::3]), np.absolute(z)[::3])
+            out = np.zeros(2*len(z), dtype=dt)
+            np.add(z, w, out[::2])
+            assert_array_equal(out[::2], z + w)
+
+    def test_absolute_range(self):
+        for dt, big, small in [('D', 1e300, 1e-300), ('F', 1e30, 1e-30)]:
+            z = np.array([3 + 4j, big*(3 + 4j), small*(3 + 4j),
+                          complex(np.inf, np.nan), complex(np.nan, -np.inf),
+                          complex(np.nan, 1), 0, -0.0j], dtype=dt)
+            r = np.absolute(z)
+            ref = [5, 5*big, 5*small, np.inf, np.inf, np.nan, 0, 0]
+            assert_array_max_ulp(r[:3], np.array(ref[:3], dtype=r.dtype), 2)
+            assert_array_equal(r[3:], ref[3:])
+
+    def test_absolute_independent_of_position(self):
+        for dt in ['F', 'D']:
+            z, w = self._data(dt, n=100)
+            z[::7] = complex(np.inf, 1)
+            z[3::11] = complex(np.nan, 0)
+            z[5::13] *= 1e-200 if dt == 'D' else 1e-30
+            r = np.absolute(z)
+            for i in range(len(z)):
+                assert_array_equal(np.absolute(z[i:i+1]), r[i:i+1])
+                assert_array_equal(np.absolute(z[i:]), r[i:])
+
+    def test_absolute_no_spurious_fp_error(self):
+        for dt, big, small in [('D', 1e200, 1e-200), ('F', 1e30, 1e-30)]:
+            for v in [big, small]:
+                z = np.ones(16, dtype=dt)
+                z[5] = v + v*1j
+                olderr = np.seterr(over='raise', under='raise')
+                try:
+                    r = np.absolute(z)
+                finally:
+                    np.seterr(**olderr)
+                assert_array_max_ulp(r, np.hypot(z.real, z.imag), 1)
+
+
+class TestScalarOperandLoops(TestCase):
+    ops = [np.add, np.subtract, np.multiply, np.equal, np.not_equal,
+           np.less, np.less_equal, np.greater, np.greater_equal]
+
+    def test_against_elementwise(self):
+        for dt in ['b', 'B', 'h', 'i', 'l', 'q', 'Q', 'f', 'd', 'g']:
+            x = (np.arange(37) % 11).astype(dt)
+            s = x.dtype.type(5)
+            for f in self.ops:
+                r1 = f(x, s)
+                r2 = f(s, x)
+                assert_array_equal(r1, [f(a, s) for a in x])
+                assert_array_equal(r2, [f(s, a) for a in x])
+                assert_array_equal(f(x, x[::-1]),
+                                   [f(a, b) for a, b in zip(x, x[::-1])])
+
+    def test_nan(self):
+        for dt in ['f', 'd']:
+            x = np.array([0, np.nan, 1, -np.inf] * 5, dtype=dt)
+            assert_array_equal(x < 0.5, [True, False, False, True] * 5)
+            assert_array_equal(np.nan != x, True)
+            assert_array_equal(x*2.0, [0, np.nan, 2, -np.inf] * 5)
+
+    def test_inplace(self):
+        for dt in ['i', 'd']:
+            x = np.arange(100, dtype=dt)
+            x += 3
+            x *= 2
+            assert_array_equal(x, 2*(np.arange(100) + 3))
+
+
+class TestOverlappingOperands(TestCase):
+    def test_shifted(self):
+        for n in [5, 100, 20000]:
+            x = np.arange(n, dtype='d')
+            y = x.copy()
+            x[1:] += x[:-1]
+            assert_array_equal(x[1:], y[1:] + y[:-1])
+            x = y.copy()
+            x[:-1] *= x[1:]
+            assert_array_equal(x[:-1], y[:-1] * y[1:])
+
+    def test_reversed(self):
+        x = np.arange(1000)
+        np.add(x, x[::-1], x[::-1])
+        assert_array_equal(x[::-1], 999)
+
+    def test_cast(self):
+        x = np.arange(10, dtype='i')
+        y = x.copy()
+        np.add(x[:-1], x[1:], x.view('f')[1:])
+        assert_array_equal(x.view('f')[1:], (y[:-1] + y[1:]).astype('f'))
+
+    def test_interleaved(self):
+        x = np.arange(10.)
+        x[::2] += x[1::2]
+        assert_array_equal(x[::2], [1, 5, 9, 13, 17])
+        assert_array_equal(x[1::2], [1, 3, 5, 7, 9])
+
+    def test_zero_stride(self):
+        # large enough not to be copied for being discontiguous
+        buf = np.zeros(16, dtype=np.uint8)
+        out = np.ndarray((10000,), 'f8', buf, 0, (0,))
+        x = np.ndarray((10000,), 'f8', buf, 4, (0,))
+        x[0] = 1.0
+        y = x.copy()
+        np.add(x, 1.0, out)
+        assert_array_equal(out, y + 1.0)
+
+    def test_binary_temp(self):
+        from numpy.core.multiarray_tests import test_binary_temp
+        a = np.arange(5.)
+        b = np.ones(5)
+        r, reused, m = test_binary_temp(a, b, False)
+        assert_(reused)
+        assert_array_equal(r, a + b)
+        r, reused, m = test_binary_temp(a, b, True)
+        assert_(not reused)
+        assert_array_equal(r, a + b)
+        assert_array_equal(m, a)
+        # a result of another type or shape needs a new array
+        r, reused, m = test_binary_temp(a, b.astype('D'), False)
+        assert_(not reused)
+        assert_array_equal(r, a + b)
+        r, reused, m = test_binary_temp(a[:1], b, False)
+        assert_(not reused)
+        assert_array_equal(r, a[0] + b)
+
+
+class TestAccumulate(TestCase):
+    def _accumulate(self, f, x, axis):
+        r = x.copy()
+        x = np.rollaxis(x, axis)
+        y = np.rollaxis(r, axis)
+        for k in range(1, len(x)):
+            y[k] = f(y[k-1], x[k])
+        return r
+
+    def test_against_loop(self):
+        for dt in ['i', 'l', 'f', 'd']:
+            x = ((np.arange(2*30*9) * 37) % 5 - 2).astype(dt)
+            x = x.reshape(2, 30, 9)
+            for f in [np.add, np.multiply, np.maximum, np.minimum]:
+                for axis in range(3):
+                    for a in [x, x.T, x[:, ::2]]:
+                        assert_array_equal(f.accumulate(a, axis=axis, dtype=dt),
+                                           self._accumulate(f, a, axis))
+
+    def test_nan(self):
+        x = np.array([[1, 2], [np.nan, 0], [3, 1]] * 10)
+        assert_(np.isnan(np.maximum.accumulate(x)[1:, 0]).all())
+        assert_array_equal(np.maximum.accumulate(x)[:, 1], 2)
+        assert_array_equal(np.fmax.accumulate(x)[:, 0], [1, 1] + [3]*28)
+
+
 class TestHypot(TestCase, object):
     def test_simple(self):
         assert_almost_equal(ncu.hypot(1, 1), ncu.sqrt(2))
@@ -8,12 +8,42 @@ Algorithmically based on Fortran-77 FFTPACK by Paul N. Swarztrauber (Version 4,
 
 #include <math.h>
 #include <stdio.h>
+#include <stdlib.h>
+#ifndef FFTPACK_FLOAT
 #define DOUBLE
+#endif
 
 #ifdef DOUBLE
 #define Treal double
 #else
 #define Treal float
+/* fftpack_float.c builds this file again in single precision */
+#define cfftf cfftf_float
+#define cfftb cfftb_float
+#define cffti cffti_float
+#define rfftf rfftf_float
+#define rfftb rfftb_float
+#define rffti rffti_float
+#define npy_cfft_wsave_size npy_cfft_wsave_size_float
+#define npy_cfft_scratch_size npy_cfft_scratch_size_float
+#define npy_cffti npy_cffti_float
+#define npy_cfftf npy_cfftf_float
+#define npy_cfftb npy_cfftb_float
+#define npy_rfft_wsave_size npy_rfft_wsave_size_float
+#define npy_rfft_scratch_size npy_rfft_scratch_size_float
+#define npy_rffti npy_rffti_float
+#define npy_rfftf npy_rfftf_float
+#define npy_rfftb npy_rfftb_float
+#endif
+
+/*
+ * The radix 2 and 4 complex passes use SSE2 in double precision, where
+ * the compiler targets it; it is part of x86-64.
+ */
+#if defined(DOUBLE) && (defined(__SSE2__) || defined(_M_X64) || \
+        (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define FFTPACK_SSE2
+#include <emmintrin.h>
 #endif
 
 
@@ -31,6 +61,7 @@ extern "C" {
    passf2, passf3, passf4, passf5, passf. Complex FFT passes fwd and bwd.
 ---------------------------------------------------------------------- */
 
+#ifndef FFTPACK_SSE2
 static void passf2(int ido, int l1, const Treal cc[], Treal ch[], const Treal wa1[], int isign)
   /* isign==+1 for backward transform */
   {
@@ -60,6 +91,7 @@ static void passf2(int ido, int l1, const Treal cc[], Treal ch[], const Treal wa
       }
     }
   } /* passf2 */
+#endif
 
 
 static void passf3(int ido, int l1, const Treal cc[], Treal ch[],
@@ -116,6 +148,7 @@ static void passf3(int ido, int l1, const Treal cc[], Treal ch[],
   } /* passf3 */
 
 
+#ifndef FFTPACK_SSE2
 static void passf4(int ido, int l1, const Treal cc[], Treal ch[],
       const Treal wa1[], const Treal wa2[], const Treal wa3[], int isign)
   /* isign == -1 for forward transform and +1 for backward transform */
@@ -175,6 +208,79 @@ static void passf4(int ido, int l1, const Treal cc[], Treal ch[],
     }
   } /* passf4 */
 
+#else
+
+/*
+ * passf2 and passf4 with one complex number per SSE2 register.  sgn is
+ * (-isign, isign), so that a swapped pair (im, re) times sgn is isign*i
+ * times the number.
+ */
+static __m128d cmul_sse2(__m128d c, const Treal w[], __m128d sgn)
+  {
+    __m128d wr = _mm_set1_pd(w[0]), wi = _mm_set1_pd(w[1]);
+    return _mm_add_pd(_mm_mul_pd(c, wr),
+        _mm_mul_pd(_mm_mul_pd(_mm_shuffle_pd(c, c, 1), wi), sgn));
+  }
+
+
+static void passf2(int ido, int l1, const Treal cc[], Treal ch[], const Treal wa1[], int isign)
+  /* isign==+1 for backward transform */
+  {
+    const __m128d sgn = _mm_set_pd(isign, -isign);
+    int i, k, ah, ac;
+    __m128d c0, c1;
+    for (k=0; k<l1; k++) {
+      for (i=0; i<ido-1; i+=2) {
+        ah = i + k*ido;
+        ac = i + 2*k*ido;
+        c0 = _mm_loadu_pd(cc + ac);
+        c1 = _mm_loadu_pd(cc + ac + ido);
+        _mm_storeu_pd(ch + ah, _mm_add_pd(c0, c1));
+        c1 = _mm_sub_pd(c0, c1);
+        if (ido > 2) c1 = cmul_sse2(c1, wa1 + i, sgn);
+        _mm_storeu_pd(ch + ah + l1*ido, c1);
+      }
+    }
+  } /* passf2 */
+
+
+static void passf4(int ido, int l1, const Treal cc[], Treal ch[],
+      const Treal wa1[], const Treal wa2[], const Treal wa3[], int isign)
+  /* isign == -1 for forward transform and +1 for backward transform */
+  {
+    const __m128d sgn = _mm_set_pd(isign, -isign);
+    int i, k, ac, ah;
+    __m128d c0, c1, c2, c3, t1, t2, t3, u;
+    for (k=0; k<l1; k++) {
+      for (i=0; i<ido-1; i+=2) {
+        ac = i + 4*k*ido;
+        ah = i + k*ido;
+        c0 = _mm_loadu_pd(cc + ac);
+        c1 = _mm_loadu_pd(cc + ac + ido);
+        c2 = _mm_loadu_pd(cc + ac + 2*ido);
+        c3 = _mm_loadu_pd(cc + ac + 3*ido);
+        t1 = _mm_sub_pd(c0, c2);
+        t2 = _mm_add_pd(c0, c2);
+        t3 = _mm_add_pd(c1, c3);
+        u = _mm_sub_pd(c1, c3);
+        u = _mm_mul_pd(_mm_shuffle_pd(u, u, 1), sgn);
+        _mm_storeu_pd(ch + ah, _mm_add_pd(t2, t3));
+        t2 = _mm_sub_pd(t2, t3);
+        t3 = _mm_add_pd(t1, u);
+        t1 = _mm_sub_pd(t1, u);
+        if (ido > 2) {
+          t3 = cmul_sse2(t3, wa1 + i, sgn);
+          t2 = cmul_sse2(t2, wa2 + i, sgn);
+          t1 = cmul_sse2(t1, wa3 + i, sgn);
+        }
+        _mm_storeu_pd(ch + ah + l1*ido, t3);
+        _mm_storeu_pd(ch + ah + 2*l1*ido, t2);
+        _mm_storeu_pd(ch + ah + 3*l1*ido, t1);
+      }
+    }
+  } /* passf4 */
+#endif
+
 
 static void passf5(int ido, int l1, const Treal cc[], Treal ch[],
       const Treal wa1[], const Treal wa2[], const Treal wa3[], const Treal wa4[], int isign)
@@ -1258,8 +1364,8 @@ startloop:
 
 static void cffti1(int n, Treal wa[], int ifac[MAXFAC+2])
   {
-    static const Treal twopi = 6.28318530717959;
-    Treal arg, argh, argld, fi;
+    static const double twopi = 6.28318530717959;
+    double arg, argh, argld, fi;
     int idot, i, j;
     int i1, k1, l1, l2;
     int ld, ii, nf, ip;
@@ -1270,7 +1376,7 @@ static void cffti1(int n, Treal wa[], int ifac[MAXFAC+2])
 
     factorize(n,ifac,ntryh);
     nf = ifac[1];
-    argh = twopi/(Treal)n;
+    argh = twopi/(double)n;
     i = 1;
     l1 = 1;
     for (k1=1; k1<=nf; k1++) {
@@ -1378,7 +1484,7 @@ static void rfftf1(int n, Treal c[], Treal ch[], const Treal wa[], const int ifa
   } /* rfftf1 */
 
 
-void rfftb1(int n, Treal c[], Treal ch[], const Treal wa[], const int ifac[MAXFAC+2])
+static void rfftb1(int n, Treal c[], Treal ch[], const Treal wa[], const int ifac[MAXFAC+2])
   {
     int i;
     int k1, l1, l2, na, nf, ip, iw, ix2, ix3, ix4, ido, idl1;
@@ -1450,8 +1556,8 @@ void rfftb(int n, Treal r[], Treal wsave[])
 
 static void rffti1(int n, Treal wa[], int ifac[MAXFAC+2])
   {
-    static const Treal twopi = 6.28318530717959;
-    Treal arg, argh, argld, fi;
+    static const double twopi = 6.28318530717959;
+    double arg, argh, argld, fi;
     int i, j;
     int k1, l1, l2;
     int ld, ii, nf, ip, is;
@@ -1474,7 +1580,7 @@ static void rffti1(int n, Treal wa[], int ifac[MAXFAC+2])
       for (j = 1; j <= ipm; ++j) {
         ld += l1;
         i = is;
-        argld = (Treal) ld*argh;
+        argld = (double) ld*argh;
         fi = 0;
         for (ii = 3; ii <= ido; ii += 2) {
           i += 2;
@@ -1496,6 +1602,266 @@ void rffti(int n, Treal wsave[])
     rffti1(n, wsave+n, (int*)(wsave+2*n));
   } /* rffti */
 
+  /* ----------------------------------------------------------------------
+npy_cffti, npy_cfftf, npy_cfftb, npy_rffti, npy_rfftf, npy_rfftb.  FFTs of
+any length, with a work array that is only read by the transforms and
+scratch passed separately, so that one work array can be shared.
+---------------------------------------------------------------------- */
+
+/*
+ * The passes above cost O(n p) for a prime factor p of n.  Lengths with a
+ * prime factor above BLUESTEIN_MIN_PRIME use Bluestein's algorithm
+ * instead, which writes the transform as a convolution with a chirp and
+ * evaluates it with three transforms of a length m >= 2n - 1 that has
+ * only the factors 2, 3 and 5.
+ */
+#define BLUESTEIN_MIN_PRIME 100
+
+/* The first element of the work array tells which method is used */
+#define WS_DIRECT 0
+#define WS_BLUESTEIN 1
+
+static int largest_prime_factor(int n)
+  {
+    int p = 1, f;
+    while (n % 2 == 0) {
+      n /= 2;
+      p = 2;
+    }
+    for (f = 3; f <= n / f; f += 2) {
+      while (n % f == 0) {
+        n /= f;
+        p = f;
+      }
+    }
+    return n > 1 ? n : p;
+  }
+
+
+static int use_bluestein(int n)
+  {
+    return largest_prime_factor(n) > BLUESTEIN_MIN_PRIME;
+  }
+
+
+/* Smallest m >= n with no prime factors other than 2, 3 and 5 */
+static int good_size(int n)
+  {
+    int m, r;
+    for (m = n; ; m++) {
+      r = m;
+      while (r % 2 == 0) r /= 2;
+      while (r % 3 == 0) r /= 3;
+      while (r % 5 == 0) r /= 5;
+      if (r == 1) return m;
+    }
+  }
+
+
+/*
+ * Bluestein work array, after the method and an unused element: the
+ * chirp w[k] = exp(-i pi k^2 / n) for k < n, the transform of length m
+ * of the filter conj(w[|k|]) divided by m, and the cffti1 tables for
+ * length m.
+ */
+static int bluestein_size(int n)
+  {
+    int m = good_size(2*n - 1);
+    return 2 + 2*n + 2*m + 2*m + 15;
+  }
+
+
+static int bluestein_init(int n, Treal wsave[])
+  {
+    static const double pi = 3.14159265358979323846;
+    int m = good_size(2*n - 1), k;
+    Treal *w = wsave + 2, *bf = w + 2*n, *wa = bf + 2*m;
+    int *ifac = (int*)(wa + 2*m);
+    Treal *ch;
+    double r = 0, arg;
+
+    ch = (Treal *)malloc(2*m*sizeof(Treal));
+    if (ch == NULL) return -1;
+    wsave[0] = WS_BLUESTEIN;
+    wsave[1] = 0;
+    /* k^2 mod 2n is computed exactly by recurrence */
+    for (k=0; k<n; k++) {
+      arg = pi*r/n;
+      w[2*k] = cos(arg);
+      w[2*k+1] = -sin(arg);
+      r += 2*k + 1;
+      while (r >= 2*n) r -= 2*n;
+    }
+    cffti1(m, wa, ifac);
+    for (k=0; k<2*m; k++) bf[k] = 0;
+    bf[0] = w[0];
+    bf[1] = -w[1];
+    for (k=1; k<n; k++) {
+      bf[2*k] = bf[2*(m-k)] = w[2*k];
+      bf[2*k+1] = bf[2*(m-k)+1] = -w[2*k+1];
+    }
+    cfftf1(m, bf, ch, wa, ifac, -1);
+    for (k=0; k<2*m; k++) bf[k] /= m;
+    free(ch);
+    return 0;
+  }
+
+
+/*
+ * X[k] = w[k] sum_j x[j] w[j] conj(w[k-j]) for the forward transform,
+ * and the same with w conjugated for the backward one.  The filter is
+ * symmetric, so its transform for the backward direction is the
+ * conjugate of the stored one.  scratch holds 4m Treals.
+ */
+static void bluestein(int n, Treal c[], const Treal wsave[], Treal scratch[],
+                      int isign)
+  {
+    int m = good_size(2*n - 1), k;
+    const Treal *w = wsave + 2, *bf = w + 2*n, *wa = bf + 2*m;
+    const int *ifac = (const int*)(wa + 2*m);
+    Treal *y = scratch, *ch = scratch + 2*m;
+    Treal sg = (Treal)-isign, re, im;
+
+    for (k=0; k<n; k++) {
+      y[2*k] = c[2*k]*w[2*k] - sg*c[2*k+1]*w[2*k+1];
+      y[2*k+1] = c[2*k+1]*w[2*k] + sg*c[2*k]*w[2*k+1];
+    }
+    for (k=2*n; k<2*m; k++) y[k] = 0;
+    cfftf1(m, y, ch, wa, ifac, -1);
+    for (k=0; k<m; k++) {
+      re = y[2*k]*bf[2*k] - sg*y[2*k+1]*bf[2*k+1];
+      im = y[2*k+1]*bf[2*k] + sg*y[2*k]*bf[2*k+1];
+      y[2*k] = re;
+      y[2*k+1] = im;
+    }
+    cfftf1(m, y, ch, wa, ifac, +1);
+    for (k=0; k<n; k++) {
+      c[2*k] = y[2*k]*w[2*k] - sg*y[2*k+1]*w[2*k+1];
+      c[2*k+1] = y[2*k+1]*w[2*k] + sg*y[2*k]*w[2*k+1];
+    }
+  }
+
+
+int npy_cfft_wsave_size(int n)
+  {
+    if (n == 1) return 1;
+    if (use_bluestein(n)) return bluestein_size(n);
+    return 1 + 2*n + 15;
+  } /* npy_cfft_wsave_size */
+
+
+int npy_cfft_scratch_size(int n)
+  {
+    if (n > 1 && use_bluestein(n)) return 4*good_size(2*n - 1);
+    return 2*n;
+  } /* npy_cfft_scratch_size */
+
+
+int npy_cffti(int n, Treal wsave[])
+  {
+    wsave[0] = WS_DIRECT;
+    if (n == 1) return 0;
+    if (use_bluestein(n)) return bluestein_init(n, wsave);
+    cffti1(n, wsave+1, (int*)(wsave+1+2*n));
+    return 0;
+  } /* npy_cffti */
+
+
+void npy_cfftf(int n, Treal c[], const Treal wsave[], Treal scratch[])
+  {
+    if (n == 1) return;
+    if (wsave[0] == WS_BLUESTEIN) {
+      bluestein(n, c, wsave, scratch, -1);
+      return;
+    }
+    cfftf1(n, c, scratch, wsave+1, (const int*)(wsave+1+2*n), -1);
+  } /* npy_cfftf */
+
+
+void npy_cfftb(int n, Treal c[], const Treal wsave[], Treal scratch[])
+  {
+    if (n == 1) return;
+    if (wsave[0] == WS_BLUESTEIN) {
+      bluestein(n, c, wsave, scratch, +1);
+      return;
+    }
+    cfftf1(n, c, scratch, wsave+1, (const int*)(wsave+1+2*n), +1);
+  } /* npy_cfftb */
+
+
+/*
+ * Real transforms of Bluestein lengths go through a complex transform of
+ * the same length, with the complex work array.
+ */
+int npy_rfft_wsave_size(int n)
+  {
+    if (n == 1) return 1;
+    if (use_bluestein(n)) return bluestein_size(n);
+    return 1 + n + 15;
+  } /* npy_rfft_wsave_size */
+
+
+int npy_rfft_scratch_size(int n)
+  {
+    if (n > 1 && use_bluestein(n)) return 2*n + 4*good_size(2*n - 1);
+    return n;
+  } /* npy_rfft_scratch_size */
+
+
+int npy_rffti(int n, Treal wsave[])
+  {
+    wsave[0] = WS_DIRECT;
+    if (n == 1) return 0;
+    if (use_bluestein(n)) return bluestein_init(n, wsave);
+    rffti1(n, wsave+1, (int*)(wsave+1+n));
+    return 0;
+  } /* npy_rffti */
+
+
+void npy_rfftf(int n, Treal r[], const Treal wsave[], Treal scratch[])
+  {
+    Treal *z = scratch;
+    int k;
+    if (n == 1) return;
+    if (wsave[0] != WS_BLUESTEIN) {
+      rfftf1(n, r, scratch, wsave+1, (const int*)(wsave+1+n));
+      return;
+    }
+    for (k=0; k<n; k++) {
+      z[2*k] = r[k];
+      z[2*k+1] = 0;
+    }
+    bluestein(n, z, wsave, scratch + 2*n, -1);
+    /* Same layout as rfftf: r0, r1, i1, r2, i2, ... */
+    r[0] = z[0];
+    for (k=1; k<n; k++) r[k] = z[k+1];
+  } /* npy_rfftf */
+
+
+void npy_rfftb(int n, Treal r[], const Treal wsave[], Treal scratch[])
+  {
+    Treal *z = scratch;
+    int k;
+    if (n == 1) return;
+    if (wsave[0] != WS_BLUESTEIN) {
+      rfftb1(n, r, scratch, wsave+1, (const int*)(wsave+1+n));
+      return;
+    }
+    z[0] = r[0];
+    z[1] = 0;
+    for (k=1; 2*k<n; k++) {
+      z[2*k] = z[2*(n-k)] = r[2*k-1];
+      z[2*k+1] = r[2*k];
+      z[2*(n-k)+1] = -r[2*k];
+    }
+    if (n % 2 == 0) {
+      z[n] = r[n-1];
+      z[n+1] = 0;
+    }
+    bluestein(n, z, wsave, scratch + 2*n, +1);
+    for (k=0; k<n; k++) r[k] = z[2*k];
+  } /* npy_rfftb */
+
 #ifdef __cplusplus
 }
 #endif
@@ -23,6 +23,36 @@ extern void rfftf(int N, Treal data[], const Treal wrk[]);
 extern void rfftb(int N, Treal data[], const Treal wrk[]);
 extern void rffti(int N, Treal wrk[]);
 
+/*
+ * Transforms of any length, using Bluestein's algorithm when N has a
+ * large prime factor.  The work array, of npy_*_wsave_size(N) Treals, is
+ * set up by npy_cffti or npy_rffti, which return -1 if out of memory, and
+ * is only read by the transforms, so it can be shared between threads.
+ * Each call needs npy_*_scratch_size(N) Treals of scratch of its own.
+ */
+extern int npy_cfft_wsave_size(int N);
+extern int npy_cfft_scratch_size(int N);
+extern int npy_cffti(int N, Treal wrk[]);
+extern void npy_cfftf(int N, Treal data[], const Treal wrk[], Treal scratch[]);
+extern void npy_cfftb(int N, Treal data[], const Treal wrk[], Treal scratch[]);
+
+extern int npy_rfft_wsave_size(int N);
+extern int npy_rfft_scratch_size(int N);
+extern int npy_rffti(int N, Treal wrk[]);
+extern void npy_rfftf(int N, Treal data[], const Treal wrk[], Treal scratch[]);
+extern void npy_rfftb(int N, Treal data[], const Treal wrk[], Treal scratch[]);
+
+/*
+ * Single precision complex transforms, from fftpack_float.c.  The work
+ * array and scratch hold as many floats as npy_cfft_wsave_size(N) and
+ * npy_cfft_scratch_size(N) give.
+ */
+extern int npy_cffti_float(int N, float wrk[]);
+extern void npy_cfftf_float(int N, float data[], const float wrk[],
+                            float scratch[]);
+extern void npy_cfftb_float(int N, float data[], const float wrk[],
+                            float scratch[]);
+
 #ifdef __cplusplus
 }
 #endif
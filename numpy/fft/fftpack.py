@@ -29,34 +29,21 @@ behavior.)
 The underlying code for these functions is an f2c-translated and modified
 version of the FFTPACK routines.
 
+The complex transforms (fft, ifft, fftn, ifftn, fft2 and ifft2) of single
+precision input, float32 or complex64, are done in single precision and
+give complex64 results.
+
 """
 __all__ = ['fft','ifft', 'rfft', 'irfft', 'hfft', 'ihfft', 'rfftn',
            'irfftn', 'rfft2', 'irfft2', 'fft2', 'ifft2', 'fftn', 'ifftn',
            'refft', 'irefft','refftn','irefftn', 'refft2', 'irefft2']
 
 from numpy.core import asarray, zeros, swapaxes, shape, conjugate, \
-     take
+     take, product
 import fftpack_lite as fftpack
 
-_fft_cache = {}
-_real_fft_cache = {}
-
-def _raw_fft(a, n=None, axis=-1, init_function=fftpack.cffti,
-             work_function=fftpack.cfftf, fft_cache = _fft_cache ):
-    a = asarray(a)
-
-    if n is None:
-        n = a.shape[axis]
-
-    if n < 1:
-        raise ValueError("Invalid number of FFT data points (%d) specified." % n)
-
-    try:
-        wsave = fft_cache[n]
-    except(KeyError):
-        wsave = init_function(n)
-        fft_cache[n] = wsave
-
+def _fix_length(a, n, axis):
+    """Truncate or zero pad a to length n along axis."""
     if a.shape[axis] != n:
         s = list(a.shape)
         if s[axis] > n:
@@ -70,10 +57,23 @@ def _raw_fft(a, n=None, axis=-1, init_function=fftpack.cffti,
             z = zeros(s, a.dtype.char)
             z[index] = a
             a = z
+    return a
+
+# The work arrays for each length are cached by fftpack_lite.
+def _raw_fft(a, n=None, axis=-1, work_function=fftpack.cfftf):
+    a = asarray(a)
+
+    if n is None:
+        n = a.shape[axis]
+
+    if n < 1:
+        raise ValueError("Invalid number of FFT data points (%d) specified." % n)
+
+    a = _fix_length(a, n, axis)
 
     if axis != -1:
         a = swapaxes(a, axis, -1)
-    r = work_function(a, wsave)
+    r = work_function(a)
     if axis != -1:
         r = swapaxes(r, axis, -1)
     return r
@@ -162,7 +162,7 @@ def fft(a, n=None, axis=-1):
 
     """
 
-    return _raw_fft(a, n, axis, fftpack.cffti, fftpack.cfftf, _fft_cache)
+    return _raw_fft(a, n, axis, fftpack.cfftf)
 
 
 def ifft(a, n=None, axis=-1):
@@ -240,10 +240,10 @@ def ifft(a, n=None, axis=-1):
 
     """
 
-    a = asarray(a).astype(complex)
+    a = asarray(a)
     if n is None:
         n = shape(a)[axis]
-    return _raw_fft(a, n, axis, fftpack.cffti, fftpack.cfftb, _fft_cache) / n
+    return _raw_fft(a, n, axis, fftpack.cfftb) / n
 
 
 def rfft(a, n=None, axis=-1):
@@ -320,7 +320,7 @@ def rfft(a, n=None, axis=-1):
     """
 
     a = asarray(a).astype(float)
-    return _raw_fft(a, n, axis, fftpack.rffti, fftpack.rfftf, _real_fft_cache)
+    return _raw_fft(a, n, axis, fftpack.rfftf)
 
 
 def irfft(a, n=None, axis=-1):
@@ -403,8 +403,7 @@ def irfft(a, n=None, axis=-1):
     a = asarray(a).astype(complex)
     if n is None:
         n = (shape(a)[axis] - 1) * 2
-    return _raw_fft(a, n, axis, fftpack.rffti, fftpack.rfftb,
-                    _real_fft_cache) / n
+    return _raw_fft(a, n, axis, fftpack.rfftb) / n
 
 
 def hfft(a, n=None, axis=-1):
@@ -519,6 +518,17 @@ def _cook_nd_args(a, s=None, axes=None, invreal=0):
 def _raw_fftnd(a, s=None, axes=None, function=fft):
     a = asarray(a)
     s, axes = _cook_nd_args(a, s, axes)
+    distinct = len(set([ax % max(a.ndim, 1) for ax in axes])) == len(axes)
+    if (function is fft or function is ifft) and distinct:
+        # All the axes in one call to fftpack_lite.
+        for ii in range(len(axes)):
+            if s[ii] < 1:
+                raise ValueError("Invalid number of FFT data points (%d) "
+                                 "specified." % s[ii])
+            a = _fix_length(a, s[ii], axes[ii])
+        if function is fft:
+            return fftpack.cfftn(a, axes)
+        return fftpack.cfftn(a, axes, 1) / float(product(s))
     itl = range(len(axes))
     itl.reverse()
     for ii in itl:
@@ -958,8 +968,8 @@ def rfftn(a, s=None, axes=None):
     a = asarray(a).astype(float)
     s, axes = _cook_nd_args(a, s, axes)
     a = rfft(a, s[-1], axes[-1])
-    for ii in range(len(axes)-1):
-        a = fft(a, s[ii], axes[ii])
+    if len(axes) > 1:
+        a = _raw_fftnd(a, s[:-1], axes[:-1], fft)
     return a
 
 def rfft2(a, s=None, axes=(-2,-1)):
@@ -1078,8 +1088,8 @@ def irfftn(a, s=None, axes=None):
 
     a = asarray(a).astype(complex)
     s, axes = _cook_nd_args(a, s, axes, invreal=1)
-    for ii in range(len(axes)-1):
-        a = ifft(a, s[ii], axes[ii])
+    if len(axes) > 1:
+        a = _raw_fftnd(a, s[:-1], axes[:-1], ifft)
     a = irfft(a, s[-1], axes[-1])
     return a
 
@@ -0,0 +1,7 @@
+/*
+fftpack_float.c : fftpack.c in single precision.  The public functions
+get a _float suffix; see fftpack.h.
+*/
+
+#define FFTPACK_FLOAT
+#include "fftpack.c"
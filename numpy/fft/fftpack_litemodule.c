@@ -5,60 +5,341 @@
 #include "fftpack.h"
 #include "Python.h"
 #include "numpy/arrayobject.h"
+#include "numpy/npy_3kcompat.h"
 
 static PyObject *ErrorObject;
 
 /* ----------------------------------------------------- */
 
-static char fftpack_cfftf__doc__[] = "";
+/*
+ * Plan cache.
+ *
+ * The work arrays made by npy_cffti and npy_rffti depend only on the
+ * length, on whether the transform is real or complex and on the
+ * precision; forward and backward transforms share them.  The transforms
+ * only read them, so a plan can be used with the GIL released; each call
+ * brings nscratch doubles, or floats, of scratch of its own.  They are kept here, most recently used first,
+ * up to PLAN_CACHE_MAX_BYTES, so that transforms of lengths seen before
+ * skip the factorization and the trigonometric tables.  The cache is only
+ * touched with the GIL held.  Plans are reference counted, so one that is
+ * evicted while a transform uses it stays valid until released.
+ */
+#define PLAN_CACHE_MAX_BYTES (16*1024*1024)
+
+typedef struct fft_plan_ {
+    struct fft_plan_ *prev, *next;
+    int n;
+    int real;
+    int single;
+    int refcount;
+    int nscratch;
+    size_t nbytes;
+    void *wsave;
+} fft_plan;
+
+static fft_plan *plan_head = NULL, *plan_tail = NULL;
+static size_t plan_cache_bytes = 0;
+
+static void
+plan_release(fft_plan *plan)
+{
+    if (--plan->refcount == 0) {
+        free(plan->wsave);
+        free(plan);
+    }
+}
 
-PyObject *
-fftpack_cfftf(PyObject *NPY_UNUSED(self), PyObject *args)
+static void
+plan_unlink(fft_plan *plan)
+{
+    if (plan->prev != NULL) {
+        plan->prev->next = plan->next;
+    }
+    else {
+        plan_head = plan->next;
+    }
+    if (plan->next != NULL) {
+        plan->next->prev = plan->prev;
+    }
+    else {
+        plan_tail = plan->prev;
+    }
+}
+
+static void
+plan_push_front(fft_plan *plan)
+{
+    plan->prev = NULL;
+    plan->next = plan_head;
+    if (plan_head != NULL) {
+        plan_head->prev = plan;
+    }
+    else {
+        plan_tail = plan;
+    }
+    plan_head = plan;
+}
+
+/*
+ * Return a new reference to the plan for a real or complex transform of
+ * length n, or NULL with an exception set.  Single precision plans are
+ * for complex transforms only.
+ */
+static fft_plan *
+plan_get(int n, int real, int single)
+{
+    fft_plan *plan;
+
+    for (plan = plan_head; plan != NULL; plan = plan->next) {
+        if (plan->n == n && plan->real == real && plan->single == single) {
+            if (plan != plan_head) {
+                plan_unlink(plan);
+                plan_push_front(plan);
+            }
+            plan->refcount++;
+            return plan;
+        }
+    }
+
+    plan = (fft_plan *)malloc(sizeof(fft_plan));
+    if (plan == NULL) {
+        PyErr_NoMemory();
+        return NULL;
+    }
+    plan->nbytes = real ? npy_rfft_wsave_size(n) : npy_cfft_wsave_size(n);
+    plan->nbytes *= single ? sizeof(float) : sizeof(double);
+    plan->wsave = malloc(plan->nbytes);
+    if (plan->wsave == NULL) {
+        free(plan);
+        PyErr_NoMemory();
+        return NULL;
+    }
+    plan->n = n;
+    plan->real = real;
+    plan->single = single;
+    plan->nscratch = real ? npy_rfft_scratch_size(n)
+                          : npy_cfft_scratch_size(n);
+    if ((single ? npy_cffti_float(n, plan->wsave)
+                : real ? npy_rffti(n, plan->wsave)
+                       : npy_cffti(n, plan->wsave)) == -1) {
+        free(plan->wsave);
+        free(plan);
+        PyErr_NoMemory();
+        return NULL;
+    }
+
+    plan->refcount = 1;
+    if (plan->nbytes > PLAN_CACHE_MAX_BYTES) {
+        /* Too large to keep */
+        return plan;
+    }
+    plan->refcount++;
+    plan_push_front(plan);
+    plan_cache_bytes += plan->nbytes;
+    while (plan_cache_bytes > PLAN_CACHE_MAX_BYTES) {
+        fft_plan *old = plan_tail;
+
+        plan_unlink(old);
+        plan_cache_bytes -= old->nbytes;
+        plan_release(old);
+    }
+    return plan;
+}
+
+/*
+ * Get the work array for a transform of length npts: from *op2 if the
+ * caller passed one, else from the plan cache, in which case *plan is
+ * set and *scratch is allocated for it.  A work array from cffti or
+ * rffti is used by the original transforms, which keep their scratch in
+ * it, and *scratch is left NULL.  Returns NULL with an exception set on
+ * error.  Release with release_wsave.
+ */
+static double *
+get_wsave(PyObject **op2, int npts, int real, fft_plan **plan,
+          double **scratch)
 {
-    PyObject *op1, *op2;
-    PyArrayObject *data;
     PyArray_Descr *descr;
-    double *wsave, *dptr;
+    double *wsave;
     npy_intp nsave;
-    int npts, nrepeats, i;
 
-    if(!PyArg_ParseTuple(args, "OO", &op1, &op2)) {
+    *plan = NULL;
+    *scratch = NULL;
+    if (*op2 == NULL || *op2 == Py_None) {
+        *op2 = NULL;
+        *plan = plan_get(npts, real, 0);
+        if (*plan == NULL) {
+            return NULL;
+        }
+        *scratch = (double *)malloc((*plan)->nscratch*sizeof(double));
+        if (*scratch == NULL) {
+            plan_release(*plan);
+            PyErr_NoMemory();
+            return NULL;
+        }
+        return (*plan)->wsave;
+    }
+    descr = PyArray_DescrFromType(PyArray_DOUBLE);
+    if (PyArray_AsCArray(op2, (void *)&wsave, &nsave, 1, descr) == -1) {
+        return NULL;
+    }
+    if (nsave != (real ? npts*2 : npts*4) + 15) {
+        PyErr_SetString(ErrorObject, "invalid work array for fft size");
+        PyArray_Free(*op2, (char *)wsave);
         return NULL;
     }
+    return wsave;
+}
+
+static void
+release_wsave(PyObject *op2, double *wsave, fft_plan *plan, double *scratch)
+{
+    if (plan != NULL) {
+        free(scratch);
+        plan_release(plan);
+    }
+    else {
+        PyArray_Free(op2, (char *)wsave);
+    }
+}
+
+/* Complex transform of a line, in either precision, with a cached plan */
+static void
+plan_complex(const fft_plan *plan, void *c, void *scratch, int backward)
+{
+    if (plan->single) {
+        (backward ? npy_cfftb_float : npy_cfftf_float)(plan->n, (float *)c,
+                (const float *)plan->wsave, (float *)scratch);
+    }
+    else {
+        (backward ? npy_cfftb : npy_cfftf)(plan->n, (double *)c,
+                (const double *)plan->wsave, (double *)scratch);
+    }
+}
+
+/*
+ * Single precision input, float32 or complex64, is transformed in single
+ * precision; there is no work array argument for it.
+ */
+static int
+is_single(PyObject *op)
+{
+    return PyArray_Check(op) &&
+        (PyArray_TYPE(op) == PyArray_FLOAT ||
+         PyArray_TYPE(op) == PyArray_CFLOAT);
+}
+
+/* Transforms with a work array from get_wsave */
+static void
+complex_fft(int n, double *c, const double *wsave, double *scratch,
+            int backward)
+{
+    if (scratch == NULL) {
+        (backward ? cfftb : cfftf)(n, c, wsave);
+    }
+    else {
+        (backward ? npy_cfftb : npy_cfftf)(n, c, wsave, scratch);
+    }
+}
+
+static void
+real_fft(int n, double *r, const double *wsave, double *scratch,
+         int backward)
+{
+    if (scratch == NULL) {
+        (backward ? rfftb : rfftf)(n, r, wsave);
+    }
+    else {
+        (backward ? npy_rfftb : npy_rfftf)(n, r, wsave, scratch);
+    }
+}
+
+/* ----------------------------------------------------- */
+
+static PyObject *
+execute_complex_float(PyObject *op1, int backward)
+{
+    PyArrayObject *data;
+    fft_plan *plan;
+    float *scratch, *dptr;
+    int npts, nrepeats, i;
+
     data = (PyArrayObject *)PyArray_CopyFromObject(op1,
-            PyArray_CDOUBLE, 1, 0);
+            PyArray_CFLOAT, 1, 0);
     if (data == NULL) {
         return NULL;
     }
-    descr = PyArray_DescrFromType(PyArray_DOUBLE);
-    if (PyArray_AsCArray(&op2, (void *)&wsave, &nsave, 1, descr) == -1) {
-        goto fail;
+    npts = PyArray_DIM(data, PyArray_NDIM(data) - 1);
+    plan = plan_get(npts, 0, 1);
+    if (plan == NULL) {
+        Py_DECREF(data);
+        return NULL;
+    }
+    scratch = (float *)malloc(plan->nscratch*sizeof(float));
+    if (scratch == NULL) {
+        plan_release(plan);
+        Py_DECREF(data);
+        return PyErr_NoMemory();
+    }
+
+    nrepeats = PyArray_SIZE(data)/npts;
+    dptr = (float *)PyArray_BYTES(data);
+    NPY_SIGINT_ON;
+    for (i = 0; i < nrepeats; i++) {
+        plan_complex(plan, dptr, scratch, backward);
+        dptr += npts*2;
     }
+    NPY_SIGINT_OFF;
+    free(scratch);
+    plan_release(plan);
+    return (PyObject *)data;
+}
+
+static PyObject *
+execute_complex(PyObject *args, int backward)
+{
+    PyObject *op1, *op2 = NULL;
+    PyArrayObject *data;
+    fft_plan *plan;
+    double *wsave, *scratch, *dptr;
+    int npts, nrepeats, i;
+
+    if(!PyArg_ParseTuple(args, "O|O", &op1, &op2)) {
+        return NULL;
+    }
+    if ((op2 == NULL || op2 == Py_None) && is_single(op1)) {
+        return execute_complex_float(op1, backward);
+    }
+    data = (PyArrayObject *)PyArray_CopyFromObject(op1,
+            PyArray_CDOUBLE, 1, 0);
     if (data == NULL) {
-        goto fail;
+        return NULL;
     }
 
     npts = PyArray_DIM(data, PyArray_NDIM(data) - 1);
-    if (nsave != npts*4 + 15) {
-        PyErr_SetString(ErrorObject, "invalid work array for fft size");
-        goto fail;
+    wsave = get_wsave(&op2, npts, 0, &plan, &scratch);
+    if (wsave == NULL) {
+        Py_DECREF(data);
+        return NULL;
     }
 
     nrepeats = PyArray_SIZE(data)/npts;
     dptr = (double *)PyArray_BYTES(data);
     NPY_SIGINT_ON;
     for (i = 0; i < nrepeats; i++) {
-        cfftf(npts, dptr, wsave);
+        complex_fft(npts, dptr, wsave, scratch, backward);
         dptr += npts*2;
     }
     NPY_SIGINT_OFF;
-    PyArray_Free(op2, (char *)wsave);
+    release_wsave(op2, wsave, plan, scratch);
     return (PyObject *)data;
+}
 
-fail:
-    PyArray_Free(op2, (char *)wsave);
-    Py_DECREF(data);
-    return NULL;
+static char fftpack_cfftf__doc__[] = "";
+
+PyObject *
+fftpack_cfftf(PyObject *NPY_UNUSED(self), PyObject *args)
+{
+    return execute_complex(args, 0);
 }
 
 static char fftpack_cfftb__doc__[] = "";
@@ -66,48 +347,205 @@ static char fftpack_cfftb__doc__[] = "";
 PyObject *
 fftpack_cfftb(PyObject *NPY_UNUSED(self), PyObject *args)
 {
-    PyObject *op1, *op2;
-    PyArrayObject *data;
-    PyArray_Descr *descr;
-    double *wsave, *dptr;
-    npy_intp nsave;
-    int npts, nrepeats, i;
+    return execute_complex(args, 1);
+}
+
+/*
+ * Batched transforms along several axes.
+ *
+ * Each axis is done over the whole array in one pass.  Lines along the
+ * axis are copied FFT_BLOCK at a time to contiguous scratch, taking
+ * neighbouring lines along the innermost other axis, so that the copies
+ * read and write whole cache lines even when the axis has a large stride.
+ * Contiguous lines are transformed in place.  Besides the lines, scratch
+ * holds the transform's own scratch, of plan->nscratch doubles or floats.
+ */
+#define FFT_BLOCK 8
+
+static void
+copy_complex(char *dst, const char *src, int single)
+{
+    if (single) {
+        ((float *)dst)[0] = ((const float *)src)[0];
+        ((float *)dst)[1] = ((const float *)src)[1];
+    }
+    else {
+        ((double *)dst)[0] = ((const double *)src)[0];
+        ((double *)dst)[1] = ((const double *)src)[1];
+    }
+}
+
+static void
+transform_axis(char *data, int nd, const npy_intp *dims,
+               const npy_intp *strides, int axis, const fft_plan *plan,
+               int backward, char *scratch)
+{
+    const int single = plan->single;
+    const npy_intp elsize = single ? 2*sizeof(float) : 2*sizeof(double);
+    const int n = (int)dims[axis];
+    const npy_intp step = strides[axis];
+    char *work = scratch + FFT_BLOCK*n*elsize;
+    npy_intp counter[NPY_MAXDIMS];
+    npy_intp ninner = 1, instep = 0, nouter = 1, o, i, j, b, nb;
+    int inner = -1, k;
+    char *base = data;
+
+    for (k = nd - 1; k >= 0; k--) {
+        if (k != axis) {
+            inner = k;
+            break;
+        }
+    }
+    if (inner >= 0) {
+        ninner = dims[inner];
+        instep = strides[inner];
+    }
+    for (k = 0; k < nd; k++) {
+        counter[k] = 0;
+        if (k != axis && k != inner) {
+            nouter *= dims[k];
+        }
+    }
+
+    for (o = 0; o < nouter; o++) {
+        for (j = 0; j < ninner; j += nb) {
+            char *line = base + j*instep;
+
+            nb = ninner - j < FFT_BLOCK ? ninner - j : FFT_BLOCK;
+            if (step == elsize) {
+                for (b = 0; b < nb; b++) {
+                    plan_complex(plan, line + b*instep, work, backward);
+                }
+                continue;
+            }
+            for (i = 0; i < n; i++) {
+                const char *p = line + i*step;
+
+                for (b = 0; b < nb; b++) {
+                    copy_complex(scratch + (b*n + i)*elsize, p + b*instep,
+                                 single);
+                }
+            }
+            for (b = 0; b < nb; b++) {
+                plan_complex(plan, scratch + b*n*elsize, work, backward);
+            }
+            for (i = 0; i < n; i++) {
+                char *p = line + i*step;
+
+                for (b = 0; b < nb; b++) {
+                    copy_complex(p + b*instep, scratch + (b*n + i)*elsize,
+                                 single);
+                }
+            }
+        }
+        /* Next line along the remaining axes */
+        for (k = nd - 1; k >= 0; k--) {
+            if (k == axis || k == inner) {
+                continue;
+            }
+            base += strides[k];
+            if (++counter[k] < dims[k]) {
+                break;
+            }
+            base -= counter[k]*strides[k];
+            counter[k] = 0;
+        }
+    }
+}
+
+static char fftpack_cfftn__doc__[] =
+"cfftn(data, axes, backward=0)\n\n"
+"Unnormalized complex transforms of data along each of axes, in one call.";
 
-    if(!PyArg_ParseTuple(args, "OO", &op1, &op2)) {
+static PyObject *
+fftpack_cfftn(PyObject *NPY_UNUSED(self), PyObject *args)
+{
+    PyObject *op1, *op2, *seq = NULL;
+    PyArrayObject *data;
+    fft_plan *plans[NPY_MAXDIMS];
+    char *scratch = NULL;
+    int axes[NPY_MAXDIMS];
+    int backward = 0, single, nd, naxes = 0, i;
+    npy_intp maxscratch = 0, nscratch;
+    NPY_BEGIN_THREADS_DEF;
+
+    if (!PyArg_ParseTuple(args, "OO|i", &op1, &op2, &backward)) {
         return NULL;
     }
+    single = is_single(op1);
     data = (PyArrayObject *)PyArray_CopyFromObject(op1,
-            PyArray_CDOUBLE, 1, 0);
+            single ? PyArray_CFLOAT : PyArray_CDOUBLE, 0, 0);
     if (data == NULL) {
         return NULL;
     }
-    descr = PyArray_DescrFromType(PyArray_DOUBLE);
-    if (PyArray_AsCArray(&op2, (void *)&wsave, &nsave, 1, descr) == -1) {
+    nd = PyArray_NDIM(data);
+    seq = PySequence_Fast(op2, "axes must be a sequence");
+    if (seq == NULL) {
         goto fail;
     }
-    if (data == NULL) {
+    if (PySequence_Fast_GET_SIZE(seq) > NPY_MAXDIMS) {
+        PyErr_SetString(PyExc_ValueError, "too many axes");
         goto fail;
     }
-
-    npts = PyArray_DIM(data, PyArray_NDIM(data) - 1);
-    if (nsave != npts*4 + 15) {
-        PyErr_SetString(ErrorObject, "invalid work array for fft size");
-        goto fail;
+    for (i = 0; i < PySequence_Fast_GET_SIZE(seq); i++) {
+        long axis = PyInt_AsLong(PySequence_Fast_GET_ITEM(seq, i));
+        npy_intp n;
+
+        if (axis == -1 && PyErr_Occurred()) {
+            goto fail;
+        }
+        if (axis < 0) {
+            axis += nd;
+        }
+        if (axis < 0 || axis >= nd) {
+            PyErr_SetString(PyExc_ValueError, "invalid axis for fft");
+            goto fail;
+        }
+        n = PyArray_DIM(data, axis);
+        if (n < 1) {
+            PyErr_SetString(PyExc_ValueError,
+                            "Invalid number of FFT data points");
+            goto fail;
+        }
+        plans[naxes] = plan_get((int)n, 0, single);
+        if (plans[naxes] == NULL) {
+            goto fail;
+        }
+        nscratch = (2*FFT_BLOCK*n + plans[naxes]->nscratch)*
+                   (single ? sizeof(float) : sizeof(double));
+        axes[naxes++] = (int)axis;
+        if (nscratch > maxscratch) {
+            maxscratch = nscratch;
+        }
     }
-
-    nrepeats = PyArray_SIZE(data)/npts;
-    dptr = (double *)PyArray_BYTES(data);
-    NPY_SIGINT_ON;
-    for (i = 0; i < nrepeats; i++) {
-        cfftb(npts, dptr, wsave);
-        dptr += npts*2;
+    Py_DECREF(seq);
+    seq = NULL;
+
+    if (PyArray_SIZE(data) > 0 && naxes > 0) {
+        scratch = (char *)malloc(maxscratch);
+        if (scratch == NULL) {
+            PyErr_NoMemory();
+            goto fail;
+        }
+        NPY_BEGIN_THREADS;
+        for (i = naxes - 1; i >= 0; i--) {
+            transform_axis(PyArray_BYTES(data), nd, PyArray_DIMS(data),
+                           PyArray_STRIDES(data), axes[i], plans[i],
+                           backward, scratch);
+        }
+        NPY_END_THREADS;
+        free(scratch);
+    }
+    for (i = 0; i < naxes; i++) {
+        plan_release(plans[i]);
     }
-    NPY_SIGINT_OFF;
-    PyArray_Free(op2, (char *)wsave);
     return (PyObject *)data;
 
 fail:
-    PyArray_Free(op2, (char *)wsave);
+    for (i = 0; i < naxes; i++) {
+        plan_release(plans[i]);
+    }
+    Py_XDECREF(seq);
     Py_DECREF(data);
     return NULL;
 }
@@ -144,14 +582,13 @@ static char fftpack_rfftf__doc__[] ="";
 PyObject *
 fftpack_rfftf(PyObject *NPY_UNUSED(self), PyObject *args)
 {
-    PyObject *op1, *op2;
+    PyObject *op1, *op2 = NULL;
     PyArrayObject *data, *ret;
-    PyArray_Descr *descr;
-    double *wsave, *dptr, *rptr;
-    npy_intp nsave;
+    fft_plan *plan;
+    double *wsave, *scratch, *dptr, *rptr;
     int npts, nrepeats, i, rstep;
 
-    if(!PyArg_ParseTuple(args, "OO", &op1, &op2)) {
+    if(!PyArg_ParseTuple(args, "O|O", &op1, &op2)) {
         return NULL;
     }
     data = (PyArrayObject *)PyArray_ContiguousFromObject(op1,
@@ -164,18 +601,17 @@ fftpack_rfftf(PyObject *NPY_UNUSED(self), PyObject *args)
     ret = (PyArrayObject *)PyArray_Zeros(PyArray_NDIM(data), PyArray_DIMS(data),
             PyArray_DescrFromType(PyArray_CDOUBLE), 0);
     PyArray_DIM(data, PyArray_NDIM(data) - 1) = npts;
+    if (ret == NULL) {
+        Py_DECREF(data);
+        return NULL;
+    }
     rstep = (PyArray_DIM(ret, PyArray_NDIM(ret) - 1))*2;
 
-    descr = PyArray_DescrFromType(PyArray_DOUBLE);
-    if (PyArray_AsCArray(&op2, (void *)&wsave, &nsave, 1, descr) == -1) {
-        goto fail;
-    }
-    if (data == NULL || ret == NULL) {
-        goto fail;
-    }
-    if (nsave != npts*2+15) {
-        PyErr_SetString(ErrorObject, "invalid work array for fft size");
-        goto fail;
+    wsave = get_wsave(&op2, npts, 1, &plan, &scratch);
+    if (wsave == NULL) {
+        Py_DECREF(data);
+        Py_DECREF(ret);
+        return NULL;
     }
 
     nrepeats = PyArray_SIZE(data)/npts;
@@ -186,22 +622,16 @@ fftpack_rfftf(PyObject *NPY_UNUSED(self), PyObject *args)
     NPY_SIGINT_ON;
     for (i = 0; i < nrepeats; i++) {
         memcpy((char *)(rptr+1), dptr, npts*sizeof(double));
-        rfftf(npts, rptr+1, wsave);
+        real_fft(npts, rptr+1, wsave, scratch, 0);
         rptr[0] = rptr[1];
         rptr[1] = 0.0;
         rptr += rstep;
         dptr += npts;
     }
     NPY_SIGINT_OFF;
-    PyArray_Free(op2, (char *)wsave);
+    release_wsave(op2, wsave, plan, scratch);
     Py_DECREF(data);
     return (PyObject *)ret;
-
-fail:
-    PyArray_Free(op2, (char *)wsave);
-    Py_XDECREF(data);
-    Py_XDECREF(ret);
-    return NULL;
 }
 
 static char fftpack_rfftb__doc__[] ="";
@@ -210,14 +640,13 @@ static char fftpack_rfftb__doc__[] ="";
 PyObject *
 fftpack_rfftb(PyObject *NPY_UNUSED(self), PyObject *args)
 {
-    PyObject *op1, *op2;
+    PyObject *op1, *op2 = NULL;
     PyArrayObject *data, *ret;
-    PyArray_Descr *descr;
-    double *wsave, *dptr, *rptr;
-    npy_intp nsave;
+    fft_plan *plan;
+    double *wsave, *scratch, *dptr, *rptr;
     int npts, nrepeats, i;
 
-    if(!PyArg_ParseTuple(args, "OO", &op1, &op2)) {
+    if(!PyArg_ParseTuple(args, "O|O", &op1, &op2)) {
         return NULL;
     }
     data = (PyArrayObject *)PyArray_ContiguousFromObject(op1,
@@ -228,17 +657,16 @@ fftpack_rfftb(PyObject *NPY_UNUSED(self), PyObject *args)
     npts = PyArray_DIM(data, PyArray_NDIM(data) - 1);
     ret = (PyArrayObject *)PyArray_Zeros(PyArray_NDIM(data), PyArray_DIMS(data),
             PyArray_DescrFromType(PyArray_DOUBLE), 0);
-
-    descr = PyArray_DescrFromType(PyArray_DOUBLE);
-    if (PyArray_AsCArray(&op2, (void *)&wsave, &nsave, 1, descr) == -1) {
-        goto fail;
-    }
-    if (data == NULL || ret == NULL) {
-        goto fail;
+    if (ret == NULL) {
+        Py_DECREF(data);
+        return NULL;
     }
-    if (nsave != npts*2 + 15) {
-        PyErr_SetString(ErrorObject, "invalid work array for fft size");
-        goto fail;
+
+    wsave = get_wsave(&op2, npts, 1, &plan, &scratch);
+    if (wsave == NULL) {
+        Py_DECREF(data);
+        Py_DECREF(ret);
+        return NULL;
     }
 
     nrepeats = PyArray_SIZE(ret)/npts;
@@ -249,20 +677,14 @@ fftpack_rfftb(PyObject *NPY_UNUSED(self), PyObject *args)
     for (i = 0; i < nrepeats; i++) {
         memcpy((char *)(rptr + 1), (dptr + 2), (npts - 1)*sizeof(double));
         rptr[0] = dptr[0];
-        rfftb(npts, rptr, wsave);
+        real_fft(npts, rptr, wsave, scratch, 1);
         rptr += npts;
         dptr += npts*2;
     }
     NPY_SIGINT_OFF;
-    PyArray_Free(op2, (char *)wsave);
+    release_wsave(op2, wsave, plan, scratch);
     Py_DECREF(data);
     return (PyObject *)ret;
-
-fail:
-    PyArray_Free(op2, (char *)wsave);
-    Py_XDECREF(data);
-    Py_XDECREF(ret);
-    return NULL;
 }
 
 
@@ -299,6 +721,7 @@ static struct PyMethodDef fftpack_methods[] = {
     {"cfftf",   fftpack_cfftf,  1,      fftpack_cfftf__doc__},
     {"cfftb",   fftpack_cfftb,  1,      fftpack_cfftb__doc__},
     {"cffti",   fftpack_cffti,  1,      fftpack_cffti__doc__},
+    {"cfftn",   fftpack_cfftn,  1,      fftpack_cfftn__doc__},
     {"rfftf",   fftpack_rfftf,  1,      fftpack_rfftf__doc__},
     {"rfftb",   fftpack_rfftb,  1,      fftpack_rfftb__doc__},
     {"rffti",   fftpack_rffti,  1,      fftpack_rffti__doc__},
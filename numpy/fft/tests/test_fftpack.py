@@ -18,6 +18,52 @@ class TestFFT1D(TestCase):
         x = rand(30) + 1j*rand(30)
         assert_array_almost_equal(fft1(x), np.fft.fft(x))
 
+    def test_mixed_lengths(self):
+        # Transforms of alternating lengths reuse the cached work arrays.
+        rand = np.random.random
+        for n in [16, 30, 16, 7, 30, 7]:
+            x = rand(n) + 1j*rand(n)
+            assert_array_almost_equal(fft1(x), np.fft.fft(x))
+            assert_array_almost_equal(np.fft.ifft(np.fft.fft(x)), x)
+            assert_array_almost_equal(np.fft.irfft(np.fft.rfft(x.real), n),
+                                      x.real)
+
+    def test_prime_lengths(self):
+        # Lengths with a large prime factor use Bluestein's algorithm.
+        rand = np.random.random
+        for n in [101, 202, 211, 1009]:
+            x = rand(n) + 1j*rand(n)
+            assert_array_almost_equal(fft1(x), np.fft.fft(x))
+            assert_array_almost_equal(np.fft.ifft(np.fft.fft(x)), x)
+            assert_array_almost_equal(np.fft.rfft(x.real),
+                                      fft1(x.real)[:n//2 + 1])
+            assert_array_almost_equal(np.fft.irfft(np.fft.rfft(x.real), n),
+                                      x.real)
+
+    def test_single_precision(self):
+        rand = np.random.random
+        for n in [16, 30, 101]:
+            x = (rand(n) + 1j*rand(n)).astype(np.complex64)
+            y = np.fft.fft(x)
+            assert_equal(y.dtype, np.complex64)
+            assert_array_almost_equal(y, fft1(x.astype(complex)), 4)
+            assert_equal(np.fft.ifft(y).dtype, np.complex64)
+            assert_array_almost_equal(np.fft.ifft(y), x, 5)
+            assert_equal(np.fft.fft(x.real).dtype, np.complex64)
+
+
+class TestFFTND(TestCase):
+    def test_axes(self):
+        rand = np.random.rand
+        x = rand(3, 4, 5) + 1j*rand(3, 4, 5)
+        y = np.fft.fft(np.fft.fft(np.fft.fft(x, axis=2), axis=1), axis=0)
+        assert_array_almost_equal(np.fft.fftn(x), y)
+        assert_array_almost_equal(np.fft.ifftn(y), x)
+        y = np.fft.fft(np.fft.fft(x[:, ::2], 6, axis=0), axis=1)
+        assert_array_almost_equal(np.fft.fftn(x[:, ::2], (6, 2), (0, 1)), y)
+        assert_array_almost_equal(np.fft.irfftn(np.fft.rfftn(x.real), x.shape),
+                                  x.real)
+
 
 if __name__ == "__main__":
     run_module_suite()
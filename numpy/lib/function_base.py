@@ -29,6 +29,7 @@ from numpy.lib.twodim_base import diag
 if sys.platform != 'cli':
     from _compiled_base import _insert, add_docstring
     from _compiled_base import digitize, bincount, interp as compiled_interp
+    from _compiled_base import _fixed_histogram
 else:
     # TODO: Implement these
     def _insert(*args, **kw):
@@ -41,6 +42,7 @@ else:
         raise NotImplementedError()
     def compiled_interp(*args, **kw):
         raise NotImplementedError()
+    _fixed_histogram = None
 
 from arraysetops import setdiff1d
 from utils import deprecate
@@ -142,6 +144,7 @@ def histogram(a, bins=10, range=None, normed=False, weights=None):
             raise AttributeError(
                 'max must be larger than min in range parameter.')
 
+    uniform = False
     if not iterable(bins):
         if range is None:
             range = (a.min(), a.max())
@@ -149,6 +152,7 @@ def histogram(a, bins=10, range=None, normed=False, weights=None):
         if mn == mx:
             mn -= 0.5
             mx += 0.5
+        uniform = bins > 0 and np.isfinite(mn) and np.isfinite(mx)
         bins = linspace(mn, mx, bins+1, endpoint=True)
     else:
         bins = asarray(bins)
@@ -161,28 +165,34 @@ def histogram(a, bins=10, range=None, normed=False, weights=None):
         ntype = int
     else:
         ntype = weights.dtype
-    n = np.zeros(bins.shape, ntype)
-
-    block = 65536
-    if weights is None:
-        for i in arange(0, len(a), block):
-            sa = sort(a[i:i+block])
-            n += np.r_[sa.searchsorted(bins[:-1], 'left'), \
-                sa.searchsorted(bins[-1], 'right')]
+    if uniform and _fixed_histogram is not None and \
+            a.dtype.kind in 'biuf' and \
+            (weights is None or weights.dtype.kind == 'f'):
+        # Equal width bins: each value's bin is computed, not searched for.
+        n = _fixed_histogram(a, bins, weights).astype(ntype)
     else:
-        zero = array(0, dtype=ntype)
-        for i in arange(0, len(a), block):
-            tmp_a = a[i:i+block]
-            tmp_w = weights[i:i+block]
-            sorting_index = np.argsort(tmp_a)
-            sa = tmp_a[sorting_index]
-            sw = tmp_w[sorting_index]
-            cw = np.concatenate(([zero,], sw.cumsum()))
-            bin_index = np.r_[sa.searchsorted(bins[:-1], 'left'), \
-                sa.searchsorted(bins[-1], 'right')]
-            n += cw[bin_index]
-
-    n = np.diff(n)
+        n = np.zeros(bins.shape, ntype)
+
+        block = 65536
+        if weights is None:
+            for i in arange(0, len(a), block):
+                sa = sort(a[i:i+block])
+                n += np.r_[sa.searchsorted(bins[:-1], 'left'), \
+                    sa.searchsorted(bins[-1], 'right')]
+        else:
+            zero = array(0, dtype=ntype)
+            for i in arange(0, len(a), block):
+                tmp_a = a[i:i+block]
+                tmp_w = weights[i:i+block]
+                sorting_index = np.argsort(tmp_a)
+                sa = tmp_a[sorting_index]
+                sw = tmp_w[sorting_index]
+                cw = np.concatenate(([zero,], sw.cumsum()))
+                bin_index = np.r_[sa.searchsorted(bins[:-1], 'left'), \
+                    sa.searchsorted(bins[-1], 'right')]
+                n += cw[bin_index]
+
+        n = np.diff(n)
 
     if normed:
         db = array(np.diff(bins), float)
@@ -955,7 +965,9 @@ def interp(x, xp, fp, left=None, right=None):
     Returns
     -------
     y : {float, ndarray}
-        The interpolated values, same shape as `x`.
+        The interpolated values, same shape as `x`.  They are single
+        precision if `x`, `xp` and `fp` are all single precision arrays,
+        and double precision otherwise.
 
     Raises
     ------
@@ -970,6 +982,10 @@ def interp(x, xp, fp, left=None, right=None):
 
         np.all(np.diff(xp) > 0)
 
+    Each point is searched for starting from the interval of the one
+    before, so `x` in increasing order is interpolated in a single pass
+    over `xp`.
+
 
     Examples
     --------
@@ -4,6 +4,7 @@
 #include "numpy/npy_3kcompat.h"
 #include "npy_api.h"
 #include "npy_descriptor.h"
+#include "npy_math.h"
 #include "npy_config.h"
 
 
@@ -60,34 +61,142 @@ monotonic_(double * a, int lena)
 
 
 
-/* find the index of the maximum element of an integer array */
-static intp
-mxx (intp *i , intp len)
-{
-    intp mx = 0, max = i[0];
-    intp j;
+/*
+ * bincount kernels, one set for each integer type that converts safely to
+ * intp.  The list is read in place with its stride, so narrow codes need
+ * no conversion copy.
+ */
+typedef void (bincount_minmax_func)(char *, intp, intp, intp *, intp *);
+typedef void (bincount_count_func)(char *, intp, intp,
+                                   intp *, intp *, intp *, intp *);
+typedef void (bincount_weights_func)(char *, intp, intp, double *, double *);
 
-    for ( j = 1; j < len; j ++ ) {
-        if ( i [j] > max ) {
-            max = i [j];
-            mx = j;
-        }
-    }
-    return mx;
+/*
+ * The counts of runs of equal values are each a chain of dependent
+ * increments.  Up to this many bins, four histograms take every fourth
+ * value and are added together at the end.
+ */
+#define BINCOUNT_SPLIT 4096
+
+/* smallest and largest value of the list, in one pass */
+#define BINCOUNT_MINMAX(name, type)                                     \
+static void                                                             \
+name(char *ip, intp len, intp stride, intp *pmin, intp *pmax)           \
+{                                                                       \
+    type mn = *(type *)ip, mx = mn, v;                                  \
+    intp i;                                                             \
+                                                                        \
+    for (i = 1; i < len; i++) {                                         \
+        ip += stride;                                                   \
+        v = *(type *)ip;                                                \
+        if (v < mn) {                                                   \
+            mn = v;                                                     \
+        }                                                               \
+        else if (v > mx) {                                              \
+            mx = v;                                                     \
+        }                                                               \
+    }                                                                   \
+    *pmin = (intp)mn;                                                   \
+    *pmax = (intp)mx;                                                   \
 }
 
-/* find the index of the minimum element of an integer array */
-static intp
-mnx (intp *i , intp len)
+/* value i of the list is counted in h<i % 4>, which may all be the same */
+#define BINCOUNT_COUNT(name, type)                                      \
+static void                                                             \
+name(char *ip, intp len, intp stride,                                   \
+     intp *h0, intp *h1, intp *h2, intp *h3)                            \
+{                                                                       \
+    intp i;                                                             \
+                                                                        \
+    for (i = 0; i + 4 <= len; i += 4, ip += 4*stride) {                 \
+        h0[*(type *)ip]++;                                              \
+        h1[*(type *)(ip + stride)]++;                                   \
+        h2[*(type *)(ip + 2*stride)]++;                                 \
+        h3[*(type *)(ip + 3*stride)]++;                                 \
+    }                                                                   \
+    for (; i < len; i++, ip += stride) {                                \
+        h0[*(type *)ip]++;                                              \
+    }                                                                   \
+}
+
+#define BINCOUNT_WEIGHTS(name, type)                                    \
+static void                                                             \
+name(char *ip, intp len, intp stride, double *weights, double *dans)    \
+{                                                                       \
+    intp i;                                                             \
+                                                                        \
+    for (i = 0; i < len; i++, ip += stride) {                           \
+        dans[*(type *)ip] += weights[i];                                \
+    }                                                                   \
+}
+
+#define BINCOUNT_KERNELS(name, type)                                    \
+BINCOUNT_MINMAX(name##_minmax, type)                                    \
+BINCOUNT_COUNT(name##_count, type)                                      \
+BINCOUNT_WEIGHTS(name##_weights, type)
+
+BINCOUNT_KERNELS(bincount_byte, npy_byte)
+BINCOUNT_KERNELS(bincount_ubyte, npy_ubyte)
+BINCOUNT_KERNELS(bincount_short, npy_short)
+BINCOUNT_KERNELS(bincount_ushort, npy_ushort)
+BINCOUNT_KERNELS(bincount_int, npy_int)
+#if NPY_SIZEOF_INT < NPY_SIZEOF_PTR
+BINCOUNT_KERNELS(bincount_uint, npy_uint)
+#endif
+#if NPY_SIZEOF_LONG <= NPY_SIZEOF_PTR
+BINCOUNT_KERNELS(bincount_long, npy_long)
+#endif
+#if NPY_SIZEOF_LONGLONG <= NPY_SIZEOF_PTR
+BINCOUNT_KERNELS(bincount_longlong, npy_longlong)
+#endif
+
+#undef BINCOUNT_KERNELS
+#undef BINCOUNT_WEIGHTS
+#undef BINCOUNT_COUNT
+#undef BINCOUNT_MINMAX
+
+typedef struct {
+    int type;
+    bincount_minmax_func *minmax;
+    bincount_count_func *count;
+    bincount_weights_func *weights;
+} bincount_funcs;
+
+#define BINCOUNT_FUNCS(type, name) \
+    {type, &name##_minmax, &name##_count, &name##_weights}
+
+static const bincount_funcs bincount_table[] = {
+    BINCOUNT_FUNCS(PyArray_BOOL, bincount_ubyte),
+    BINCOUNT_FUNCS(PyArray_BYTE, bincount_byte),
+    BINCOUNT_FUNCS(PyArray_UBYTE, bincount_ubyte),
+    BINCOUNT_FUNCS(PyArray_SHORT, bincount_short),
+    BINCOUNT_FUNCS(PyArray_USHORT, bincount_ushort),
+    BINCOUNT_FUNCS(PyArray_INT, bincount_int),
+#if NPY_SIZEOF_INT < NPY_SIZEOF_PTR
+    BINCOUNT_FUNCS(PyArray_UINT, bincount_uint),
+#endif
+#if NPY_SIZEOF_LONG <= NPY_SIZEOF_PTR
+    BINCOUNT_FUNCS(PyArray_LONG, bincount_long),
+#endif
+#if NPY_SIZEOF_LONGLONG <= NPY_SIZEOF_PTR
+    BINCOUNT_FUNCS(PyArray_LONGLONG, bincount_longlong),
+#endif
+    {-1, NULL, NULL, NULL}
+};
+
+#undef BINCOUNT_FUNCS
+
+static const bincount_funcs *
+bincount_lookup(int type)
 {
-    intp mn = 0, min = i [0];
-    intp j;
-
-    for ( j = 1; j < len; j ++ )
-        if ( i [j] < min )
-            {min = i [j];
-                mn = j;}
-    return mn;
+    const bincount_funcs *f;
+
+    for (f = bincount_table; f->type >= 0; f++) {
+        if (f->type == type) {
+            return f;
+        }
+    }
+    return NULL;
 }
 
 
@@ -108,17 +217,31 @@ arr_bincount(PyObject *NPY_UNUSED(self), PyObject *args, PyObject *kwds)
     PyArray_Descr *type;
     PyObject *list = NULL, *weight=Py_None;
     PyObject *lst=NULL, *ans=NULL, *wts=NULL;
-    intp *numbers, *ians, len , mxi, mni, ans_size;
-    int i;
+    const bincount_funcs *f = NULL;
+    intp *ians, *split, len, mn, mx, i, stride, ans_size;
+    char *numbers;
     double *weights , *dans;
     static char *kwlist[] = {"list", "weights", NULL};
+    NPY_BEGIN_THREADS_DEF;
 
     if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|O",
                 kwlist, &list, &weight)) {
             goto fail;
     }
-    if (!(lst = PyArray_ContiguousFromAny(list, PyArray_INTP, 1, 1))) {
+    /* integer arrays are used as they are */
+    if (PyArray_Check(list) && PyArray_NDIM(list) == 1 &&
+            PyArray_ISALIGNED(list) && PyArray_ISNOTSWAPPED(list)) {
+        f = bincount_lookup(PyArray_TYPE(list));
+    }
+    if (f != NULL) {
+        Py_INCREF(list);
+        lst = list;
+    }
+    else {
+        if (!(lst = PyArray_ContiguousFromAny(list, PyArray_INTP, 1, 1))) {
             goto fail;
+        }
+        f = bincount_lookup(PyArray_INTP);
     }
     len = PyArray_SIZE(lst);
     if (len < 1) {
@@ -126,23 +249,46 @@ arr_bincount(PyObject *NPY_UNUSED(self), PyObject *args, PyObject *kwds)
                 "The first argument cannot be empty.");
         goto fail;
     }
-    numbers = (intp *) PyArray_DATA(lst);
-    mxi = mxx(numbers, len);
-    mni = mnx(numbers, len);
-    if (numbers[mni] < 0) {
+    numbers = PyArray_BYTES(lst);
+    stride = PyArray_STRIDES(lst)[0];
+    NPY_BEGIN_THREADS;
+    f->minmax(numbers, len, stride, &mn, &mx);
+    NPY_END_THREADS;
+    if (mn < 0) {
         PyErr_SetString(PyExc_ValueError,
                 "The first argument of bincount must be non-negative");
         goto fail;
     }
-    ans_size = numbers [mxi] + 1;
+    ans_size = mx + 1;
     if (weight == Py_None) {
         type = PyArray_DescrFromType(PyArray_INTP);
         if (!(ans = PyArray_Zeros(1, &ans_size, type, 0))) {
             goto fail;
         }
         ians = (intp *)(PyArray_DATA(ans));
-        for (i = 0; i < len; i++)
-            ians [numbers [i]] += 1;
+        split = NULL;
+        if (ans_size <= BINCOUNT_SPLIT && len >= 16*ans_size) {
+            split = (intp *)PyMem_Malloc(3*ans_size*sizeof(intp));
+            if (split == NULL) {
+                PyErr_NoMemory();
+                goto fail;
+            }
+            memset(split, 0, 3*ans_size*sizeof(intp));
+        }
+        NPY_BEGIN_THREADS;
+        if (split != NULL) {
+            f->count(numbers, len, stride,
+                     ians, split, split + ans_size, split + 2*ans_size);
+            for (i = 0; i < ans_size; i++) {
+                ians[i] += split[i] + split[ans_size + i] +
+                    split[2*ans_size + i];
+            }
+        }
+        else {
+            f->count(numbers, len, stride, ians, ians, ians, ians);
+        }
+        NPY_END_THREADS;
+        PyMem_Free(split);
         Py_DECREF(lst);
     }
     else {
@@ -160,9 +306,9 @@ arr_bincount(PyObject *NPY_UNUSED(self), PyObject *args, PyObject *kwds)
             goto fail;
         }
         dans = (double *)PyArray_DATA (ans);
-        for (i = 0; i < len; i++) {
-            dans[numbers[i]] += weights[i];
-        }
+        NPY_BEGIN_THREADS;
+        f->weights(numbers, len, stride, weights, dans);
+        NPY_END_THREADS;
         Py_DECREF(lst);
         Py_DECREF(wts);
     }
@@ -174,6 +320,7 @@ fail:
     Py_XDECREF(ans);
     return NULL;
 }
+#undef BINCOUNT_SPLIT
 
 
 /*
@@ -265,6 +412,140 @@ fail:
 
 
 
+/*
+ * Equal width histogram kernels.  A value's bin is found from its offset
+ * from the first edge and then checked against the edges themselves, so
+ * that it agrees with a search of bins.
+ */
+#define FIXED_HISTOGRAM(name, type)                                     \
+static void                                                             \
+name(char *ip, intp len, intp stride, double *bins, intp nbins,         \
+     double *weights, intp *counts, double *sums)                       \
+{                                                                       \
+    double first = bins[0], last = bins[nbins];                         \
+    double norm = nbins / (last - first), x;                            \
+    intp i, j;                                                          \
+                                                                        \
+    for (i = 0; i < len; i++, ip += stride) {                           \
+        x = (double)*(type *)ip;                                        \
+        /* also skips NaN */                                            \
+        if (!(x >= first && x <= last)) {                               \
+            continue;                                                   \
+        }                                                               \
+        j = (intp)((x - first) * norm);                                 \
+        if (j >= nbins) {                                               \
+            j = nbins - 1;                                              \
+        }                                                               \
+        while (j > 0 && x < bins[j]) {                                  \
+            j--;                                                        \
+        }                                                               \
+        while (j < nbins - 1 && x >= bins[j + 1]) {                     \
+            j++;                                                        \
+        }                                                               \
+        if (weights == NULL) {                                          \
+            counts[j]++;                                                \
+        }                                                               \
+        else {                                                          \
+            sums[j] += weights[i];                                      \
+        }                                                               \
+    }                                                                   \
+}
+
+FIXED_HISTOGRAM(fixed_histogram_float, float)
+FIXED_HISTOGRAM(fixed_histogram_double, double)
+#undef FIXED_HISTOGRAM
+
+/*
+ * _fixed_histogram(a, bins, weights=None) is histogram for the equal
+ * width bins made by linspace: bins[i] <= a < bins[i + 1], with the last
+ * bin closed, and values outside the bins left out.  Returns the counts,
+ * or the sums of the weights as doubles.  a must be one-dimensional; float
+ * and double arrays are used as they are.
+ */
+static PyObject *
+arr_fixed_histogram(PyObject *NPY_UNUSED(self), PyObject *args, PyObject *kwds)
+{
+    PyObject *oa, *obins, *oweights = Py_None;
+    PyObject *aa = NULL, *abins = NULL, *aw = NULL, *aret = NULL;
+    double *dbins, *weights = NULL;
+    intp nbins, len;
+    int typenum;
+    static char *kwlist[] = {"a", "bins", "weights", NULL};
+    NPY_BEGIN_THREADS_DEF;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "OO|O", kwlist,
+                &oa, &obins, &oweights)) {
+        return NULL;
+    }
+    if (PyArray_Check(oa) && PyArray_NDIM(oa) == 1 &&
+            (PyArray_TYPE(oa) == PyArray_FLOAT ||
+             PyArray_TYPE(oa) == PyArray_DOUBLE) &&
+            PyArray_ISALIGNED(oa) && PyArray_ISNOTSWAPPED(oa)) {
+        Py_INCREF(oa);
+        aa = oa;
+    }
+    else if (!(aa = PyArray_ContiguousFromAny(oa, PyArray_DOUBLE, 1, 1))) {
+        goto fail;
+    }
+    typenum = PyArray_TYPE(aa);
+    len = PyArray_SIZE(aa);
+    if (!(abins = PyArray_ContiguousFromAny(obins, PyArray_DOUBLE, 1, 1))) {
+        goto fail;
+    }
+    nbins = PyArray_SIZE(abins) - 1;
+    dbins = (double *)PyArray_DATA(abins);
+    if (nbins < 1 || !(dbins[0] < dbins[nbins]) ||
+            !npy_isfinite(nbins / (dbins[nbins] - dbins[0]))) {
+        PyErr_SetString(PyExc_ValueError,
+                "bins must be at least two finite, increasing edges");
+        goto fail;
+    }
+    if (oweights != Py_None) {
+        if (!(aw = PyArray_ContiguousFromAny(oweights, PyArray_DOUBLE, 1, 1))) {
+            goto fail;
+        }
+        if (PyArray_SIZE(aw) != len) {
+            PyErr_SetString(PyExc_ValueError,
+                    "The weights and a don't have the same length.");
+            goto fail;
+        }
+        weights = (double *)PyArray_DATA(aw);
+    }
+    if (!(aret = PyArray_Zeros(1, &nbins, PyArray_DescrFromType(
+                    weights == NULL ? PyArray_INTP : PyArray_DOUBLE), 0))) {
+        goto fail;
+    }
+
+    NPY_BEGIN_THREADS;
+    if (typenum == PyArray_FLOAT) {
+        fixed_histogram_float(PyArray_BYTES(aa), len, PyArray_STRIDES(aa)[0],
+                              dbins, nbins, weights,
+                              (intp *)PyArray_DATA(aret),
+                              (double *)PyArray_DATA(aret));
+    }
+    else {
+        fixed_histogram_double(PyArray_BYTES(aa), len, PyArray_STRIDES(aa)[0],
+                               dbins, nbins, weights,
+                               (intp *)PyArray_DATA(aret),
+                               (double *)PyArray_DATA(aret));
+    }
+    NPY_END_THREADS;
+
+    Py_DECREF(aa);
+    Py_DECREF(abins);
+    Py_XDECREF(aw);
+    return aret;
+
+fail:
+    Py_XDECREF(aa);
+    Py_XDECREF(abins);
+    Py_XDECREF(aw);
+    Py_XDECREF(aret);
+    return NULL;
+}
+
+
+
 static char arr_insert__doc__[] = "Insert vals sequentially into equivalent 1-d positions indicated by mask.";
 
 /*
@@ -412,41 +693,130 @@ fail:
     return NULL;
 }
 
-/** @brief Use bisection on a sorted array to find first entry > key.
+/** @brief Search a sorted array for key, starting from a guess.
  *
- * Use bisection to find an index i s.t. arr[i] <= key < arr[i + 1]. If there is
+ * Find an index i s.t. arr[i] <= key < arr[i + 1]. If there is
  * no such i the error returns are:
  *     key < arr[0] -- -1
  *     key == arr[len - 1] -- len - 1
  *     key > arr[len - 1] -- len
  * The array is assumed contiguous and sorted in ascending order.
  *
+ * The search gallops out from guess, so that a key near the last one
+ * costs a few comparisons and a sorted run of keys is found in one
+ * pass over arr, while any other key still costs O(log len).
+ *
  * @param key key value.
  * @param arr contiguous sorted array to be searched.
  * @param len length of the array.
+ * @param guess index to start from.
  * @return index
  */
-static npy_intp
-binary_search(double key, double arr [], npy_intp len)
-{
-    npy_intp imin = 0;
-    npy_intp imax = len;
+#define INTERP_SEARCH(name, type)                                       \
+static npy_intp                                                         \
+name(double key, const type *arr, npy_intp len, npy_intp guess)         \
+{                                                                       \
+    npy_intp imin, imax, step = 1;                                      \
+                                                                        \
+    if (key > arr[len - 1]) {                                           \
+        return len;                                                     \
+    }                                                                   \
+    /* also NaN */                                                      \
+    if (!(key >= arr[0])) {                                             \
+        return -1;                                                      \
+    }                                                                   \
+    if (guess < 0) {                                                    \
+        guess = 0;                                                      \
+    }                                                                   \
+    else if (guess > len - 1) {                                         \
+        guess = len - 1;                                                \
+    }                                                                   \
+    /* bracket key: arr[imin] <= key < arr[imax], or imax == len */     \
+    if (key >= arr[guess]) {                                            \
+        imin = guess;                                                   \
+        imax = guess + 1;                                               \
+        while (imax < len && key >= arr[imax]) {                        \
+            imin = imax;                                                \
+            step <<= 1;                                                 \
+            imax = imin + step;                                         \
+        }                                                               \
+        if (imax > len) {                                               \
+            imax = len;                                                 \
+        }                                                               \
+    }                                                                   \
+    else {                                                              \
+        imax = guess;                                                   \
+        imin = guess - 1;                                               \
+        while (imin > 0 && key < arr[imin]) {                           \
+            imax = imin;                                                \
+            step <<= 1;                                                 \
+            imin = imax - step;                                         \
+        }                                                               \
+        if (imin < 0) {                                                 \
+            imin = 0;                                                   \
+        }                                                               \
+    }                                                                   \
+    while (imax - imin > 1) {                                           \
+        npy_intp imid = imin + ((imax - imin) >> 1);                    \
+        if (key >= arr[imid]) {                                         \
+            imin = imid;                                                \
+        }                                                               \
+        else {                                                          \
+            imax = imid;                                                \
+        }                                                               \
+    }                                                                   \
+    return imin;                                                        \
+}
 
-    if (key > arr[len - 1]) {
-        return len;
-    }
-    while (imin < imax) {
-        npy_intp imid = imin + ((imax - imin) >> 1);
-        if (key >= arr[imid]) {
-            imin = imid + 1;
-        }
-        else {
-            imax = imid;
-        }
-    }
-    return imin - 1;
+/*
+ * Interpolate at the lenx points dz.  slopes may be NULL, when they are
+ * found as they are needed; the arithmetic is done in double either way.
+ */
+#define INTERP_KERNEL(name, search, type)                               \
+static void                                                             \
+name(const type *dz, npy_intp lenx, const type *dx, const type *dy,     \
+     npy_intp lenxp, double lval, double rval, const double *slopes,    \
+     type *dres)                                                        \
+{                                                                       \
+    npy_intp i, j = 0;                                                  \
+    double z, slope;                                                    \
+                                                                        \
+    for (i = 0; i < lenx; i++) {                                        \
+        z = dz[i];                                                      \
+        j = search(z, dx, lenxp, j);                                    \
+        if (j == -1) {                                                  \
+            dres[i] = (type)lval;                                       \
+        }                                                               \
+        else if (j == lenxp - 1) {                                      \
+            dres[i] = dy[j];                                            \
+        }                                                               \
+        else if (j == lenxp) {                                          \
+            dres[i] = (type)rval;                                       \
+        }                                                               \
+        else {                                                          \
+            if (slopes != NULL) {                                       \
+                slope = slopes[j];                                      \
+            }                                                           \
+            else {                                                      \
+                slope = ((double)dy[j + 1] - dy[j]) /                   \
+                        ((double)dx[j + 1] - dx[j]);                    \
+            }                                                           \
+            dres[i] = (type)(slope*(z - dx[j]) + dy[j]);                \
+        }                                                               \
+    }                                                                   \
 }
 
+INTERP_SEARCH(interp_search_float, float)
+INTERP_SEARCH(interp_search_double, double)
+INTERP_KERNEL(interp_float, interp_search_float, float)
+INTERP_KERNEL(interp_double, interp_search_double, double)
+#undef INTERP_KERNEL
+#undef INTERP_SEARCH
+
+/*
+ * interp(x, xp, fp, left=None, right=None) is done in float if x, xp and
+ * fp are all float arrays, and in double otherwise.
+ */
 static PyObject *
 arr_interp(PyObject *NPY_UNUSED(self), PyObject *args, PyObject *kwdict)
 {
@@ -454,9 +824,12 @@ arr_interp(PyObject *NPY_UNUSED(self), PyObject *args, PyObject *kwdict)
     PyObject *fp, *xp, *x;
     PyObject *left = NULL, *right = NULL;
     PyArrayObject *afp = NULL, *axp = NULL, *ax = NULL, *af = NULL;
-    npy_intp i, lenx, lenxp, indx;
+    npy_intp i, lenx, lenxp;
     double lval, rval;
-    double *dy, *dx, *dz, *dres, *slopes;
+    double *slopes = NULL;
+    char *dy, *dx;
+    int typenum = NPY_DOUBLE;
+    NPY_BEGIN_THREADS_DEF;
 
     static char *kwlist[] = {"x", "xp", "fp", "left", "right", NULL};
 
@@ -465,15 +838,20 @@ arr_interp(PyObject *NPY_UNUSED(self), PyObject *args, PyObject *kwdict)
         return NULL;
     }
 
-    afp = (NPY_AO*)PyArray_ContiguousFromAny(fp, NPY_DOUBLE, 1, 1);
+    if (PyArray_Check(x) && PyArray_TYPE(x) == NPY_FLOAT &&
+            PyArray_Check(xp) && PyArray_TYPE(xp) == NPY_FLOAT &&
+            PyArray_Check(fp) && PyArray_TYPE(fp) == NPY_FLOAT) {
+        typenum = NPY_FLOAT;
+    }
+    afp = (NPY_AO*)PyArray_ContiguousFromAny(fp, typenum, 1, 1);
     if (afp == NULL) {
         return NULL;
     }
-    axp = (NPY_AO*)PyArray_ContiguousFromAny(xp, NPY_DOUBLE, 1, 1);
+    axp = (NPY_AO*)PyArray_ContiguousFromAny(xp, typenum, 1, 1);
     if (axp == NULL) {
         goto fail;
     }
-    ax = (NPY_AO*)PyArray_ContiguousFromAny(x, NPY_DOUBLE, 1, 0);
+    ax = (NPY_AO*)PyArray_ContiguousFromAny(x, typenum, 1, 0);
     if (ax == NULL) {
         goto fail;
     }
@@ -490,20 +868,18 @@ arr_interp(PyObject *NPY_UNUSED(self), PyObject *args, PyObject *kwdict)
     }
 
     af = (NPY_AO*)PyArray_SimpleNew(PyArray_NDIM(ax), PyArray_DIMS(ax), 
-                                    NPY_DOUBLE);
+                                    typenum);
     if (af == NULL) {
         goto fail;
     }
     lenx = PyArray_SIZE(ax);
 
-    dy = (double *)PyArray_DATA(afp);
-    dx = (double *)PyArray_DATA(axp);
-    dz = (double *)PyArray_DATA(ax);
-    dres = (double *)PyArray_DATA(af);
+    dy = PyArray_BYTES(afp);
+    dx = PyArray_BYTES(axp);
 
     /* Get left and right fill values. */
     if ((left == NULL) || (left == Py_None)) {
-        lval = dy[0];
+        lval = (typenum == NPY_FLOAT ? ((float *)dy)[0] : ((double *)dy)[0]);
     }
     else {
         lval = PyFloat_AsDouble(left);
@@ -512,7 +888,8 @@ arr_interp(PyObject *NPY_UNUSED(self), PyObject *args, PyObject *kwdict)
         }
     }
     if ((right == NULL) || (right == Py_None)) {
-        rval = dy[lenxp-1];
+        rval = (typenum == NPY_FLOAT ? ((float *)dy)[lenxp - 1]
+                                     : ((double *)dy)[lenxp - 1]);
     }
     else {
         rval = PyFloat_AsDouble(right);
@@ -521,26 +898,43 @@ arr_interp(PyObject *NPY_UNUSED(self), PyObject *args, PyObject *kwdict)
         }
     }
 
-    slopes = (double *) PyDataMem_NEW((lenxp - 1)*sizeof(double));
-    for (i = 0; i < lenxp - 1; i++) {
-        slopes[i] = (dy[i + 1] - dy[i])/(dx[i + 1] - dx[i]);
-    }
-    for (i = 0; i < lenx; i++) {
-        indx = binary_search(dz[i], dx, lenxp);
-        if (indx == -1) {
-            dres[i] = lval;
-        }
-        else if (indx == lenxp - 1) {
-            dres[i] = dy[indx];
-        }
-        else if (indx == lenxp) {
-            dres[i] = rval;
+    /*
+     * Slopes are only worth computing up front for more points than xp,
+     * and there are none with a single point in xp
+     */
+    if (lenxp > 1 && lenx > lenxp) {
+        slopes = (double *) PyDataMem_NEW((lenxp - 1)*sizeof(double));
+        if (slopes == NULL) {
+            PyErr_NoMemory();
+            goto fail;
         }
-        else {
-            dres[i] = slopes[indx]*(dz[i] - dx[indx]) + dy[indx];
+        for (i = 0; i < lenxp - 1; i++) {
+            if (typenum == NPY_FLOAT) {
+                const float *fx = (const float *)dx, *fy = (const float *)dy;
+                slopes[i] = ((double)fy[i + 1] - fy[i]) /
+                            ((double)fx[i + 1] - fx[i]);
+            }
+            else {
+                const double *ddx = (const double *)dx;
+                const double *ddy = (const double *)dy;
+                slopes[i] = (ddy[i + 1] - ddy[i])/(ddx[i + 1] - ddx[i]);
+            }
         }
     }
 
+    NPY_BEGIN_THREADS;
+    if (typenum == NPY_FLOAT) {
+        interp_float((float *)PyArray_DATA(ax), lenx, (float *)dx,
+                     (float *)dy, lenxp, lval, rval, slopes,
+                     (float *)PyArray_DATA(af));
+    }
+    else {
+        interp_double((double *)PyArray_DATA(ax), lenx, (double *)dx,
+                      (double *)dy, lenxp, lval, rval, slopes,
+                      (double *)PyArray_DATA(af));
+    }
+    NPY_END_THREADS;
+
     PyDataMem_FREE(slopes);
     Py_DECREF(afp);
     Py_DECREF(axp);
@@ -548,6 +942,7 @@ arr_interp(PyObject *NPY_UNUSED(self), PyObject *args, PyObject *kwdict)
     return (PyObject *)af;
 
 fail:
+    PyDataMem_FREE(slopes);
     Py_XDECREF(afp);
     Py_XDECREF(axp);
     Py_XDECREF(ax);
@@ -650,10 +1045,46 @@ arr_add_docstring(PyObject *NPY_UNUSED(dummy), PyObject *args)
 /*  PACKBITS
  *
  *  This function packs binary (0 or 1) 1-bit per pixel arrays
- *  into contiguous bytes.
+ *  into contiguous bytes.  With little set the first element of each
+ *  byte is its least significant bit, otherwise its most significant.
  *
  */
 
+/*
+ * Multipliers gathering the low bits of the eight bytes of a word into
+ * its top byte, in big or little bit order for the order in which the
+ * bytes were loaded.
+ */
+#if NPY_BYTE_ORDER == NPY_BIG_ENDIAN
+#define PACK_MUL_BIG NPY_ULONGLONG_SUFFIX(0x0102040810204080)
+#define PACK_MUL_LITTLE NPY_ULONGLONG_SUFFIX(0x8040201008040201)
+#else
+#define PACK_MUL_BIG NPY_ULONGLONG_SUFFIX(0x8040201008040201)
+#define PACK_MUL_LITTLE NPY_ULONGLONG_SUFFIX(0x0102040810204080)
+#endif
+
+/* pack n groups of 8 contiguous bytes, a word at a time */
+static void
+_packbytes(char *inptr, npy_intp n, char *outptr, npy_intp out_stride,
+           int little)
+{
+    const npy_uint64 low7 = NPY_ULONGLONG_SUFFIX(0x7f7f7f7f7f7f7f7f);
+    const npy_uint64 high = NPY_ULONGLONG_SUFFIX(0x8080808080808080);
+    npy_uint64 mul = little ? PACK_MUL_LITTLE : PACK_MUL_BIG, w;
+    npy_intp index;
+
+    for (index = 0; index < n; index++) {
+        memcpy(&w, inptr, 8);
+        /* the high bit of each byte is set if the byte is nonzero */
+        w = (((w & low7) + low7) | w) & high;
+        *outptr = (char)(((w >> 7) * mul) >> 56);
+        inptr += 8;
+        outptr += out_stride;
+    }
+}
+#undef PACK_MUL_BIG
+#undef PACK_MUL_LITTLE
+
 static void
 _packbits( void *In,
            int element_size,  /* in bytes */
@@ -661,18 +1092,26 @@ _packbits( void *In,
            npy_intp in_stride,
            void *Out,
            npy_intp out_N,
-           npy_intp out_stride
+           npy_intp out_stride,
+           int little
 )
 {
-    char build;
-    int i, index;
-    npy_intp out_Nm1;
-    int maxi, remain, nonzero, j;
+    unsigned char build;
+    npy_intp index = 0;
+    int maxi, nonzero, i, j;
     char *outptr,*inptr;
 
     outptr = Out;    /* pointer to output buffer */
     inptr  = In;     /* pointer to input buffer */
 
+    /* Contiguous bytes, as for bool and uint8, are done 8 at a time */
+    if (element_size == 1 && in_stride == 1) {
+        index = in_N / 8;
+        _packbytes(inptr, index, outptr, out_stride, little);
+        inptr += 8 * index;
+        outptr += out_stride * index;
+    }
+
     /*
      * Loop through the elements of In
      * Determine whether or not it is nonzero.
@@ -680,33 +1119,52 @@ _packbits( void *In,
      *  No:  move on
      * Every 8th value, set the value of build and increment the outptr
      */
-
-    remain = in_N % 8;                      /* uneven bits */
-    if (remain == 0) {
-        remain = 8;
-    }
-    out_Nm1 = out_N - 1;
-    for (index = 0; index < out_N; index++) {
+    for (; index < out_N; index++) {
         build = 0;
-        maxi = (index != out_Nm1 ? 8 : remain);
+        maxi = (in_N - 8 * index < 8 ? (int)(in_N - 8 * index) : 8);
         for (i = 0; i < maxi; i++) {
-            build <<= 1;
             nonzero = 0;
             for (j = 0; j < element_size; j++) {
                 nonzero += (*(inptr++) != 0);
             }
             inptr += (in_stride - element_size);
-            build += (nonzero != 0);
+            if (nonzero) {
+                build |= (little ? 1 << i : 128 >> i);
+            }
         }
-        if (index == out_Nm1) build <<= (8-remain);
-        /* printf("Here: %d %d %d %d\n",build,slice,index,maxi); */
-        *outptr = build;
+        *outptr = (char)build;
         outptr += out_stride;
     }
     return;
 }
 
 
+/*
+ * The unpacked bytes of every byte value, for each bit order, as the
+ * eight bytes of a word so that a byte unpacks with one store.
+ */
+static npy_uint64 unpack_table[2][256];
+static int unpack_table_ready = 0;
+
+static void
+_unpack_table_init(void)
+{
+    unsigned char bytes[8];
+    int v, i;
+
+    for (v = 0; v < 256; v++) {
+        for (i = 0; i < 8; i++) {
+            bytes[i] = (v >> (7 - i)) & 1;
+        }
+        memcpy(&unpack_table[0][v], bytes, 8);
+        for (i = 0; i < 8; i++) {
+            bytes[i] = (v >> i) & 1;
+        }
+        memcpy(&unpack_table[1][v], bytes, 8);
+    }
+    unpack_table_ready = 1;
+}
+
 static void
 _unpackbits(void *In,
         int NPY_UNUSED(el_size),  /* unused */
@@ -714,21 +1172,32 @@ _unpackbits(void *In,
         npy_intp in_stride,
         void *Out,
         npy_intp NPY_UNUSED(out_N),
-        npy_intp out_stride
+        npy_intp out_stride,
+        int little
         )
 {
     unsigned char mask;
-    int i, index;
+    npy_intp index;
+    int i;
     char *inptr, *outptr;
+    const npy_uint64 *table = unpack_table[little != 0];
 
     outptr = Out;
     inptr  = In;
+    if (out_stride == 1) {
+        for (index = 0; index < in_N; index++) {
+            memcpy(outptr, &table[(unsigned char)*inptr], 8);
+            outptr += 8;
+            inptr += in_stride;
+        }
+        return;
+    }
     for (index = 0; index < in_N; index++) {
-        mask = 128;
+        mask = (little ? 1 : 128);
         for (i = 0; i < 8; i++) {
             *outptr = ((mask & (unsigned char)(*inptr)) != 0);
             outptr += out_stride;
-            mask >>= 1;
+            mask = (little ? mask << 1 : mask >> 1);
         }
         inptr += in_stride;
     }
@@ -737,15 +1206,17 @@ _unpackbits(void *In,
 
 /* Fixme -- pack and unpack should be separate routines */
 static PyObject *
-pack_or_unpack_bits(PyObject *input, int axis, int unpack)
+pack_or_unpack_bits(PyObject *input, int axis, int unpack, int little)
 {
     PyArrayObject *inp;
     PyObject *new = NULL;
     PyObject *out = NULL;
     npy_intp outdims[MAX_DIMS];
     int i;
-    void (*thefunc)(void *, int, npy_intp, npy_intp, void *, npy_intp, npy_intp);
+    void (*thefunc)(void *, int, npy_intp, npy_intp, void *, npy_intp, npy_intp,
+                    int);
     PyArrayIterObject *it, *ot;
+    NPY_BEGIN_THREADS_DEF;
 
     inp = (PyArrayObject *)PyArray_FROM_O(input);
 
@@ -759,9 +1230,9 @@ pack_or_unpack_bits(PyObject *input, int axis, int unpack)
             goto fail;
         }
     }
-    else if (!PyArray_ISINTEGER(inp)) {
+    else if (!PyArray_ISINTEGER(inp) && !PyArray_ISBOOL(inp)) {
         PyErr_SetString(PyExc_TypeError,
-                "Expected an input array of integer data type");
+                "Expected an input array of integer or boolean data type");
         goto fail;
     }
 
@@ -821,6 +1292,9 @@ pack_or_unpack_bits(PyObject *input, int axis, int unpack)
         /* Multiply axis dimension by 8 */
         outdims[axis] <<= 3;
         thefunc = _unpackbits;
+        if (!unpack_table_ready) {
+            _unpack_table_init();
+        }
     }
     else {
         /*
@@ -846,14 +1320,16 @@ pack_or_unpack_bits(PyObject *input, int axis, int unpack)
         goto fail;
     }
 
+    NPY_BEGIN_THREADS;
     while(PyArray_ITER_NOTDONE(it)) {
         thefunc(PyArray_ITER_DATA(it), PyArray_ITEMSIZE(new),
                 PyArray_DIM(new, axis), PyArray_STRIDE(new, axis),
                 PyArray_ITER_DATA(ot), PyArray_DIM(out, axis),
-                PyArray_STRIDE(out, axis));
+                PyArray_STRIDE(out, axis), little);
         PyArray_ITER_NEXT(it);
         PyArray_ITER_NEXT(ot);
     }
+    NPY_END_THREADS;
     Py_DECREF(it);
     Py_DECREF(ot);
 
@@ -868,32 +1344,55 @@ fail:
 }
 
 
+/* bitorder is "big" (the default) or "little"; -1 if it is neither */
+static int
+bitorder_little(const char *bitorder)
+{
+    if (bitorder == NULL || strcmp(bitorder, "big") == 0) {
+        return 0;
+    }
+    if (strcmp(bitorder, "little") == 0) {
+        return 1;
+    }
+    PyErr_SetString(PyExc_ValueError,
+            "bitorder must be either 'big' or 'little'");
+    return -1;
+}
+
 static PyObject *
 io_pack(PyObject *NPY_UNUSED(self), PyObject *args, PyObject *kwds)
 {
     PyObject *obj;
-    int axis = NPY_MAXDIMS;
-    static char *kwlist[] = {"in", "axis", NULL};
+    int axis = NPY_MAXDIMS, little;
+    char *bitorder = NULL;
+    static char *kwlist[] = {"in", "axis", "bitorder", NULL};
 
-    if (!PyArg_ParseTupleAndKeywords( args, kwds, "O|O&" , kwlist,
-                &obj, PyArray_AxisConverter, &axis)) {
+    if (!PyArg_ParseTupleAndKeywords( args, kwds, "O|O&s" , kwlist,
+                &obj, PyArray_AxisConverter, &axis, &bitorder)) {
         return NULL;
     }
-    return pack_or_unpack_bits(obj, axis, 0);
+    if ((little = bitorder_little(bitorder)) < 0) {
+        return NULL;
+    }
+    return pack_or_unpack_bits(obj, axis, 0, little);
 }
 
 static PyObject *
 io_unpack(PyObject *NPY_UNUSED(self), PyObject *args, PyObject *kwds)
 {
     PyObject *obj;
-    int axis = NPY_MAXDIMS;
-    static char *kwlist[] = {"in", "axis", NULL};
+    int axis = NPY_MAXDIMS, little;
+    char *bitorder = NULL;
+    static char *kwlist[] = {"in", "axis", "bitorder", NULL};
 
-    if (!PyArg_ParseTupleAndKeywords( args, kwds, "O|O&" , kwlist,
-                &obj, PyArray_AxisConverter, &axis)) {
+    if (!PyArg_ParseTupleAndKeywords( args, kwds, "O|O&s" , kwlist,
+                &obj, PyArray_AxisConverter, &axis, &bitorder)) {
         return NULL;
     }
-    return pack_or_unpack_bits(obj, axis, 1);
+    if ((little = bitorder_little(bitorder)) < 0) {
+        return NULL;
+    }
+    return pack_or_unpack_bits(obj, axis, 1, little);
 }
 
 static struct PyMethodDef methods[] = {
@@ -903,6 +1402,8 @@ static struct PyMethodDef methods[] = {
         METH_VARARGS | METH_KEYWORDS, NULL},
     {"digitize", (PyCFunction)arr_digitize,
         METH_VARARGS | METH_KEYWORDS, NULL},
+    {"_fixed_histogram", (PyCFunction)arr_fixed_histogram,
+        METH_VARARGS | METH_KEYWORDS, NULL},
     {"interp", (PyCFunction)arr_interp,
         METH_VARARGS | METH_KEYWORDS, NULL},
     {"add_docstring", (PyCFunction)arr_add_docstring,
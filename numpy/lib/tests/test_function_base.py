@@ -605,6 +605,18 @@ class TestHistogram(TestCase):
         wa, wb = histogram([1, 2, 2, 4], bins=4, weights=[4, 3, 2, 1], normed=True)
         assert_array_equal(wa, array([4, 5, 0, 1]) / 10. / 3. * 4)
 
+    def test_equal_width_bins(self):
+        # A bin count is searched like the explicit edges it makes
+        v = concatenate((rand(1000) * 1.4 - 0.2, linspace(0, 1, 11), [nan]))
+        for dt in [float, np.float32]:
+            a, b = histogram(v.astype(dt), bins=10, range=(0, 1))
+            ea, eb = histogram(v.astype(dt), bins=list(b))
+            assert_array_equal(a, ea)
+            w = rand(len(v))
+            wa, wb = histogram(v.astype(dt), bins=10, range=(0, 1), weights=w)
+            ewa, ewb = histogram(v.astype(dt), bins=list(b), weights=w)
+            assert_array_almost_equal(wa, ewa)
+
 
 class TestHistogramdd(TestCase):
     def test_simple(self):
@@ -970,6 +982,22 @@ class TestBincount(TestCase):
         y = np.bincount(x, w)
         assert_array_equal(y, np.array([0, 0.2, 0.5, 0, 0.5, 0.1]))
 
+    def test_types(self):
+        x = np.array([1, 5, 2, 4, 1, 0, 0, 3, 5, 5] * 10)
+        w = np.arange(len(x)) / 10.
+        y = np.bincount(x)
+        yw = np.bincount(x, w)
+        for t in [np.int8, np.uint8, np.int16, np.uint16, np.int32,
+                  np.uint32, np.int64]:
+            assert_array_equal(np.bincount(x.astype(t)), y)
+            assert_array_almost_equal(np.bincount(x.astype(t), w), yw)
+            assert_array_equal(np.bincount(x.astype(t)[::-3]),
+                               np.bincount(x[::-3]))
+        assert_array_equal(np.bincount(x > 2), [50, 50])
+
+    def test_negative(self):
+        assert_raises(ValueError, np.bincount, np.array([2, -1], np.int8))
+
 
 class TestInterp(TestCase):
     def test_exceptions(self):
@@ -982,6 +1010,24 @@ class TestInterp(TestCase):
         x0 = np.linspace(0, 1, 50)
         assert_almost_equal(np.interp(x0, x, y), x0)
 
+    def test_sorted_and_unsorted(self):
+        xp = np.array([0., 1., 1., 2., 4.])
+        fp = np.array([0., 1., 2., 3., 5.])
+        x = np.linspace(-1, 5, 25)
+        y = np.array([np.interp(v, xp, fp) for v in x])
+        assert_equal(np.interp(x, xp, fp), y)
+        assert_equal(np.interp(x[::-1], xp, fp), y[::-1])
+        p = np.random.permutation(len(x))
+        assert_equal(np.interp(x[p], xp, fp), y[p])
+
+    def test_single_precision(self):
+        x = np.linspace(0, 1, 50).astype(np.float32)
+        xp = np.linspace(0, 1, 5).astype(np.float32)
+        y = np.interp(x, xp, xp)
+        assert_equal(y.dtype, np.float32)
+        assert_almost_equal(y, x)
+        assert_equal(np.interp(x, xp, xp.astype(float)).dtype, np.float64)
+
     def test_right_left_behavior(self):
         assert_equal(interp([-1, 0, 1], [0], [1]), [1,1,1])
         assert_equal(interp([-1, 0, 1], [0], [1], left=0), [0,1,1])
@@ -1,7 +1,7 @@
 import numpy as np
 import numpy.ma as ma
 from numpy.ma.testutils import *
-from numpy.testing import assert_warns
+from numpy.testing import assert_warns, assert_raises
 
 import sys
 
@@ -1264,5 +1264,28 @@ def test_npzfile_dict():
 
     assert 'x' in list(z.iterkeys())
 
+class TestPackBits(TestCase):
+    def test_roundtrip(self):
+        # Lengths around a multiple of 8 use both the bytewise and the
+        # element loops
+        for n in [1, 7, 8, 9, 63, 64, 65]:
+            x = np.random.randint(0, 2, n).astype(np.uint8)
+            for a in [x, x.astype(bool), x * 7, x.astype(np.int32), x[::-1]]:
+                for order in ['big', 'little']:
+                    p = np.packbits(a, bitorder=order)
+                    assert_equal(len(p), (n + 7) // 8)
+                    u = np.unpackbits(p, bitorder=order)
+                    assert_equal(u[:n], a != 0)
+                    assert_equal(u[n:], 0)
+
+    def test_bitorder(self):
+        a = np.array([1, 0, 1, 1, 0, 0, 0, 0, 1], dtype=np.uint8)
+        assert_equal(np.packbits(a), [176, 128])
+        assert_equal(np.packbits(a, bitorder='little'), [13, 1])
+        b = np.array([[2], [7], [23]], dtype=np.uint8)
+        assert_equal(np.unpackbits(b, axis=1, bitorder='little')[2],
+                     [1, 1, 1, 0, 1, 0, 0, 0])
+        assert_raises(ValueError, np.packbits, a, bitorder='middle')
+
 if __name__ == "__main__":
     run_module_suite()
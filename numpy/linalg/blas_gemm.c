@@ -0,0 +1,672 @@
+/*
+ * dgemm, zgemm and dgemv for lapack_lite, replacing the reference BLAS
+ * versions, which are left out of blas_lite.c (see IGNORE in
+ * lapack_lite/wrapped_routines).  They check their arguments and treat
+ * the special values of alpha and beta as the reference versions do.
+ *
+ * The matrix products are cache blocked: op(B) is packed KC rows by NC
+ * columns at a time into panels NR columns wide, and op(A) MC rows by KC
+ * columns at a time into panels MR rows high, scaled by alpha, so that
+ * the kernel reads both with unit stride.  The kernel multiplies one A
+ * panel by one B panel into an MR by NR block of C held in registers.
+ * The packed A block is sized to stay in the L2 cache and the B block in
+ * the L3 cache.  Products smaller than GEMM_SMALL multiply-adds are not
+ * worth packing and use plain loops.
+ */
+#include <stdlib.h>
+#include <string.h>
+#include "f2c.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+        (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BLAS_GEMM_SSE2
+#include <emmintrin.h>
+#endif
+
+extern logical lsame_(char *, char *);
+extern /* Subroutine */ int xerbla_(char *, integer *);
+
+#define MR 4
+#define NR 4
+#define MC 128
+#define KC 256
+#define NC 2048
+#define GEMM_SMALL (32*32*32)
+
+#define MIN(a, b) ((a) < (b) ? (a) : (b))
+#define MAX(a, b) ((a) > (b) ? (a) : (b))
+
+/*
+ * Argument checks shared by dgemm and zgemm.  Sets the row and column
+ * strides of op(A) and op(B), and whether they are conjugated.
+ */
+static integer
+gemm_check(char *transa, char *transb, integer m, integer n, integer k,
+           integer lda, integer ldb, integer ldc, integer *rsa, integer *csa,
+           int *conja, integer *rsb, integer *csb, int *conjb)
+{
+    int nota = lsame_(transa, "N"), notb = lsame_(transb, "N");
+
+    *rsa = nota ? 1 : lda;
+    *csa = nota ? lda : 1;
+    *rsb = notb ? 1 : ldb;
+    *csb = notb ? ldb : 1;
+    *conja = lsame_(transa, "C");
+    *conjb = lsame_(transb, "C");
+    if (!nota && !*conja && !lsame_(transa, "T")) {
+        return 1;
+    }
+    if (!notb && !*conjb && !lsame_(transb, "T")) {
+        return 2;
+    }
+    if (m < 0) {
+        return 3;
+    }
+    if (n < 0) {
+        return 4;
+    }
+    if (k < 0) {
+        return 5;
+    }
+    if (lda < MAX(1, nota ? m : k)) {
+        return 8;
+    }
+    if (ldb < MAX(1, notb ? k : n)) {
+        return 10;
+    }
+    if (ldc < MAX(1, m)) {
+        return 13;
+    }
+    return 0;
+}
+
+
+/* ---------------------------------------------------------------------- */
+
+static void
+dscale_c(integer m, integer n, doublereal beta, doublereal *c, integer ldc)
+{
+    integer i, j;
+
+    if (beta == 1.) {
+        return;
+    }
+    for (j = 0; j < n; j++) {
+        doublereal *cj = c + j*ldc;
+
+        if (beta == 0.) {
+            for (i = 0; i < m; i++) {
+                cj[i] = 0.;
+            }
+        }
+        else {
+            for (i = 0; i < m; i++) {
+                cj[i] *= beta;
+            }
+        }
+    }
+}
+
+static void
+dpack_a(integer mc, integer kc, const doublereal *a, integer rs, integer cs,
+        doublereal alpha, doublereal *buf)
+{
+    integer i, p, ir, mr;
+
+    for (ir = 0; ir < mc; ir += MR) {
+        mr = MIN(MR, mc - ir);
+        for (p = 0; p < kc; p++) {
+            const doublereal *ap = a + ir*rs + p*cs;
+
+            for (i = 0; i < mr; i++) {
+                buf[i] = alpha*ap[i*rs];
+            }
+            for (; i < MR; i++) {
+                buf[i] = 0.;
+            }
+            buf += MR;
+        }
+    }
+}
+
+static void
+dpack_b(integer kc, integer nc, const doublereal *b, integer rs, integer cs,
+        doublereal *buf)
+{
+    integer j, p, jr, nr;
+
+    for (jr = 0; jr < nc; jr += NR) {
+        nr = MIN(NR, nc - jr);
+        for (p = 0; p < kc; p++) {
+            const doublereal *bp = b + p*rs + jr*cs;
+
+            for (j = 0; j < nr; j++) {
+                buf[j] = bp[j*cs];
+            }
+            for (; j < NR; j++) {
+                buf[j] = 0.;
+            }
+            buf += NR;
+        }
+    }
+}
+
+/* C[0:mr, 0:nr] += A panel times B panel */
+static void
+dgemm_kernel(integer kc, const doublereal *a, const doublereal *b,
+             doublereal *c, integer ldc, integer mr, integer nr)
+{
+    doublereal c00 = 0., c10 = 0., c20 = 0., c30 = 0.;
+    doublereal c01 = 0., c11 = 0., c21 = 0., c31 = 0.;
+    doublereal c02 = 0., c12 = 0., c22 = 0., c32 = 0.;
+    doublereal c03 = 0., c13 = 0., c23 = 0., c33 = 0.;
+    doublereal ab[MR*NR];
+    integer i, j, p;
+
+    for (p = 0; p < kc; p++) {
+        doublereal a0 = a[0], a1 = a[1], a2 = a[2], a3 = a[3];
+        doublereal b0 = b[0], b1 = b[1], b2 = b[2], b3 = b[3];
+
+        c00 += a0*b0; c10 += a1*b0; c20 += a2*b0; c30 += a3*b0;
+        c01 += a0*b1; c11 += a1*b1; c21 += a2*b1; c31 += a3*b1;
+        c02 += a0*b2; c12 += a1*b2; c22 += a2*b2; c32 += a3*b2;
+        c03 += a0*b3; c13 += a1*b3; c23 += a2*b3; c33 += a3*b3;
+        a += MR;
+        b += NR;
+    }
+    if (mr == MR && nr == NR) {
+        c[0] += c00; c[1] += c10; c[2] += c20; c[3] += c30;
+        c += ldc;
+        c[0] += c01; c[1] += c11; c[2] += c21; c[3] += c31;
+        c += ldc;
+        c[0] += c02; c[1] += c12; c[2] += c22; c[3] += c32;
+        c += ldc;
+        c[0] += c03; c[1] += c13; c[2] += c23; c[3] += c33;
+        return;
+    }
+    ab[0] = c00; ab[1] = c10; ab[2] = c20; ab[3] = c30;
+    ab[4] = c01; ab[5] = c11; ab[6] = c21; ab[7] = c31;
+    ab[8] = c02; ab[9] = c12; ab[10] = c22; ab[11] = c32;
+    ab[12] = c03; ab[13] = c13; ab[14] = c23; ab[15] = c33;
+    for (j = 0; j < nr; j++) {
+        for (i = 0; i < mr; i++) {
+            c[i + j*ldc] += ab[i + j*MR];
+        }
+    }
+}
+
+/* C += alpha*op(A)*op(B) without packing */
+static void
+dgemm_small(integer m, integer n, integer k, doublereal alpha,
+            const doublereal *a, integer rsa, integer csa,
+            const doublereal *b, integer rsb, integer csb,
+            doublereal *c, integer ldc)
+{
+    integer i, j, l;
+    doublereal temp;
+
+    if (rsa == 1) {
+        for (j = 0; j < n; j++) {
+            for (l = 0; l < k; l++) {
+                temp = alpha*b[l*rsb + j*csb];
+                if (temp != 0.) {
+                    for (i = 0; i < m; i++) {
+                        c[i + j*ldc] += temp*a[i + l*csa];
+                    }
+                }
+            }
+        }
+    }
+    else {
+        for (j = 0; j < n; j++) {
+            for (i = 0; i < m; i++) {
+                temp = 0.;
+                for (l = 0; l < k; l++) {
+                    temp += a[i*rsa + l]*b[l*rsb + j*csb];
+                }
+                c[i + j*ldc] += alpha*temp;
+            }
+        }
+    }
+}
+
+/* Subroutine */ int dgemm_(char *transa, char *transb, integer *m, integer *
+	n, integer *k, doublereal *alpha, doublereal *a, integer *lda,
+	doublereal *b, integer *ldb, doublereal *beta, doublereal *c__,
+	integer *ldc)
+{
+    integer info, rsa, csa, rsb, csb;
+    integer ic, jc, pc, ir, jr, mc, nc, kc;
+    int conja, conjb;
+    doublereal *abuf, *bbuf;
+
+    info = gemm_check(transa, transb, *m, *n, *k, *lda, *ldb, *ldc,
+                      &rsa, &csa, &conja, &rsb, &csb, &conjb);
+    if (info != 0) {
+        xerbla_("DGEMM ", &info);
+        return 0;
+    }
+    if (*m == 0 || *n == 0 || ((*alpha == 0. || *k == 0) && *beta == 1.)) {
+        return 0;
+    }
+    dscale_c(*m, *n, *beta, c__, *ldc);
+    if (*alpha == 0. || *k == 0) {
+        return 0;
+    }
+
+    abuf = bbuf = NULL;
+    if ((double)*m * *n * *k >= GEMM_SMALL) {
+        abuf = (doublereal *)malloc(MC*KC*sizeof(doublereal));
+        bbuf = (doublereal *)malloc(KC*NC*sizeof(doublereal));
+    }
+    if (abuf == NULL || bbuf == NULL) {
+        free(abuf);
+        free(bbuf);
+        dgemm_small(*m, *n, *k, *alpha, a, rsa, csa, b, rsb, csb,
+                    c__, *ldc);
+        return 0;
+    }
+    for (jc = 0; jc < *n; jc += NC) {
+        nc = MIN(NC, *n - jc);
+        for (pc = 0; pc < *k; pc += KC) {
+            kc = MIN(KC, *k - pc);
+            dpack_b(kc, nc, b + pc*rsb + jc*csb, rsb, csb, bbuf);
+            for (ic = 0; ic < *m; ic += MC) {
+                mc = MIN(MC, *m - ic);
+                dpack_a(mc, kc, a + ic*rsa + pc*csa, rsa, csa, *alpha, abuf);
+                for (jr = 0; jr < nc; jr += NR) {
+                    for (ir = 0; ir < mc; ir += MR) {
+                        dgemm_kernel(kc, abuf + ir*kc, bbuf + jr*kc,
+                                     c__ + (ic + ir) + (jc + jr) * *ldc,
+                                     *ldc, MIN(MR, mc - ir),
+                                     MIN(NR, nc - jr));
+                    }
+                }
+            }
+        }
+    }
+    free(abuf);
+    free(bbuf);
+    return 0;
+} /* dgemm_ */
+
+
+/* ---------------------------------------------------------------------- */
+
+/*
+ * zgemm works the same way on complex numbers, with 2 by 2 blocks of C
+ * in the kernel, and conjugates while packing.  The kernel uses SSE2
+ * where it is available; compilers already vectorize the real one.
+ */
+#define ZMR 2
+#define ZNR 2
+
+static void
+zpack_a(integer mc, integer kc, const doublecomplex *a, integer rs,
+        integer cs, int conj, doublecomplex alpha, doublecomplex *buf)
+{
+    integer i, p, ir, mr;
+    doublereal re, im;
+
+    for (ir = 0; ir < mc; ir += ZMR) {
+        mr = MIN(ZMR, mc - ir);
+        for (p = 0; p < kc; p++) {
+            const doublecomplex *ap = a + ir*rs + p*cs;
+
+            for (i = 0; i < mr; i++) {
+                re = ap[i*rs].r;
+                im = conj ? -ap[i*rs].i : ap[i*rs].i;
+                buf[i].r = alpha.r*re - alpha.i*im;
+                buf[i].i = alpha.r*im + alpha.i*re;
+            }
+            for (; i < ZMR; i++) {
+                buf[i].r = buf[i].i = 0.;
+            }
+            buf += ZMR;
+        }
+    }
+}
+
+static void
+zpack_b(integer kc, integer nc, const doublecomplex *b, integer rs,
+        integer cs, int conj, doublecomplex *buf)
+{
+    integer j, p, jr, nr;
+
+    for (jr = 0; jr < nc; jr += ZNR) {
+        nr = MIN(ZNR, nc - jr);
+        for (p = 0; p < kc; p++) {
+            const doublecomplex *bp = b + p*rs + jr*cs;
+
+            for (j = 0; j < nr; j++) {
+                buf[j].r = bp[j*cs].r;
+                buf[j].i = conj ? -bp[j*cs].i : bp[j*cs].i;
+            }
+            for (; j < ZNR; j++) {
+                buf[j].r = buf[j].i = 0.;
+            }
+            buf += ZNR;
+        }
+    }
+}
+
+#ifdef BLAS_GEMM_SSE2
+/*
+ * Each complex element of C is kept as two vectors, the A column times
+ * the real and the imaginary part of the B element, and combined when
+ * C is updated.
+ */
+#define ZGEMM_UPDATE(cr, ci, cp) do {                           \
+        __m128d t_ = _mm_shuffle_pd((ci), (ci), 1);             \
+        t_ = _mm_add_pd((cr), _mm_xor_pd(t_, sign));            \
+        _mm_storeu_pd(&(cp)->r, _mm_add_pd(_mm_loadu_pd(&(cp)->r), t_)); \
+    } while (0)
+
+static void
+zgemm_kernel(integer kc, const doublecomplex *a, const doublecomplex *b,
+             doublecomplex *c, integer ldc, integer mr, integer nr)
+{
+    __m128d r00 = _mm_setzero_pd(), i00 = r00, r10 = r00, i10 = r00;
+    __m128d r01 = r00, i01 = r00, r11 = r00, i11 = r00;
+    __m128d a0, a1, br, bi, sign = _mm_set_pd(0., -0.);
+    doublecomplex ab[ZMR*ZNR];
+    integer i, j, p;
+
+    for (p = 0; p < kc; p++) {
+        a0 = _mm_loadu_pd(&a[0].r);
+        a1 = _mm_loadu_pd(&a[1].r);
+        br = _mm_set1_pd(b[0].r);
+        bi = _mm_set1_pd(b[0].i);
+        r00 = _mm_add_pd(r00, _mm_mul_pd(a0, br));
+        i00 = _mm_add_pd(i00, _mm_mul_pd(a0, bi));
+        r10 = _mm_add_pd(r10, _mm_mul_pd(a1, br));
+        i10 = _mm_add_pd(i10, _mm_mul_pd(a1, bi));
+        br = _mm_set1_pd(b[1].r);
+        bi = _mm_set1_pd(b[1].i);
+        r01 = _mm_add_pd(r01, _mm_mul_pd(a0, br));
+        i01 = _mm_add_pd(i01, _mm_mul_pd(a0, bi));
+        r11 = _mm_add_pd(r11, _mm_mul_pd(a1, br));
+        i11 = _mm_add_pd(i11, _mm_mul_pd(a1, bi));
+        a += ZMR;
+        b += ZNR;
+    }
+    if (mr == ZMR && nr == ZNR) {
+        ZGEMM_UPDATE(r00, i00, c);
+        ZGEMM_UPDATE(r10, i10, c + 1);
+        ZGEMM_UPDATE(r01, i01, c + ldc);
+        ZGEMM_UPDATE(r11, i11, c + ldc + 1);
+        return;
+    }
+    memset(ab, 0, sizeof(ab));
+    ZGEMM_UPDATE(r00, i00, ab);
+    ZGEMM_UPDATE(r10, i10, ab + 1);
+    ZGEMM_UPDATE(r01, i01, ab + 2);
+    ZGEMM_UPDATE(r11, i11, ab + 3);
+    for (j = 0; j < nr; j++) {
+        for (i = 0; i < mr; i++) {
+            c[i + j*ldc].r += ab[i + j*ZMR].r;
+            c[i + j*ldc].i += ab[i + j*ZMR].i;
+        }
+    }
+}
+#undef ZGEMM_UPDATE
+
+#else
+
+static void
+zgemm_kernel(integer kc, const doublecomplex *a, const doublecomplex *b,
+             doublecomplex *c, integer ldc, integer mr, integer nr)
+{
+    doublereal r00 = 0., i00 = 0., r10 = 0., i10 = 0.;
+    doublereal r01 = 0., i01 = 0., r11 = 0., i11 = 0.;
+    doublereal ab[2*ZMR*ZNR];
+    integer i, j, p;
+
+    for (p = 0; p < kc; p++) {
+        doublereal ar0 = a[0].r, ai0 = a[0].i, ar1 = a[1].r, ai1 = a[1].i;
+        doublereal br0 = b[0].r, bi0 = b[0].i, br1 = b[1].r, bi1 = b[1].i;
+
+        r00 += ar0*br0 - ai0*bi0; i00 += ar0*bi0 + ai0*br0;
+        r10 += ar1*br0 - ai1*bi0; i10 += ar1*bi0 + ai1*br0;
+        r01 += ar0*br1 - ai0*bi1; i01 += ar0*bi1 + ai0*br1;
+        r11 += ar1*br1 - ai1*bi1; i11 += ar1*bi1 + ai1*br1;
+        a += ZMR;
+        b += ZNR;
+    }
+    ab[0] = r00; ab[1] = i00; ab[2] = r10; ab[3] = i10;
+    ab[4] = r01; ab[5] = i01; ab[6] = r11; ab[7] = i11;
+    for (j = 0; j < nr; j++) {
+        for (i = 0; i < mr; i++) {
+            c[i + j*ldc].r += ab[2*(i + j*ZMR)];
+            c[i + j*ldc].i += ab[2*(i + j*ZMR) + 1];
+        }
+    }
+}
+#endif
+
+static void
+zgemm_small(integer m, integer n, integer k, doublecomplex alpha,
+            const doublecomplex *a, integer rsa, integer csa, int conja,
+            const doublecomplex *b, integer rsb, integer csb, int conjb,
+            doublecomplex *c, integer ldc)
+{
+    integer i, j, l;
+    doublereal ar, ai, br, bi, sr, si;
+
+    for (j = 0; j < n; j++) {
+        for (i = 0; i < m; i++) {
+            sr = si = 0.;
+            for (l = 0; l < k; l++) {
+                ar = a[i*rsa + l*csa].r;
+                ai = conja ? -a[i*rsa + l*csa].i : a[i*rsa + l*csa].i;
+                br = b[l*rsb + j*csb].r;
+                bi = conjb ? -b[l*rsb + j*csb].i : b[l*rsb + j*csb].i;
+                sr += ar*br - ai*bi;
+                si += ar*bi + ai*br;
+            }
+            c[i + j*ldc].r += alpha.r*sr - alpha.i*si;
+            c[i + j*ldc].i += alpha.r*si + alpha.i*sr;
+        }
+    }
+}
+
+/* Subroutine */ int zgemm_(char *transa, char *transb, integer *m, integer *
+	n, integer *k, doublecomplex *alpha, doublecomplex *a, integer *lda,
+	doublecomplex *b, integer *ldb, doublecomplex *beta, doublecomplex *
+	c__, integer *ldc)
+{
+    integer info, rsa, csa, rsb, csb;
+    integer ic, jc, pc, ir, jr, mc, nc, kc, i, j;
+    int conja, conjb, alpha0, beta0, beta1;
+    doublecomplex *abuf, *bbuf;
+    doublereal re;
+
+    info = gemm_check(transa, transb, *m, *n, *k, *lda, *ldb, *ldc,
+                      &rsa, &csa, &conja, &rsb, &csb, &conjb);
+    if (info != 0) {
+        xerbla_("ZGEMM ", &info);
+        return 0;
+    }
+    alpha0 = alpha->r == 0. && alpha->i == 0.;
+    beta0 = beta->r == 0. && beta->i == 0.;
+    beta1 = beta->r == 1. && beta->i == 0.;
+    if (*m == 0 || *n == 0 || ((alpha0 || *k == 0) && beta1)) {
+        return 0;
+    }
+    if (!beta1) {
+        for (j = 0; j < *n; j++) {
+            doublecomplex *cj = c__ + j * *ldc;
+
+            for (i = 0; i < *m; i++) {
+                if (beta0) {
+                    cj[i].r = cj[i].i = 0.;
+                }
+                else {
+                    re = beta->r*cj[i].r - beta->i*cj[i].i;
+                    cj[i].i = beta->r*cj[i].i + beta->i*cj[i].r;
+                    cj[i].r = re;
+                }
+            }
+        }
+    }
+    if (alpha0 || *k == 0) {
+        return 0;
+    }
+
+    abuf = bbuf = NULL;
+    if ((double)*m * *n * *k >= GEMM_SMALL/4) {
+        abuf = (doublecomplex *)malloc(MC/2*KC*sizeof(doublecomplex));
+        bbuf = (doublecomplex *)malloc(KC*NC/2*sizeof(doublecomplex));
+    }
+    if (abuf == NULL || bbuf == NULL) {
+        free(abuf);
+        free(bbuf);
+        zgemm_small(*m, *n, *k, *alpha, a, rsa, csa, conja,
+                    b, rsb, csb, conjb, c__, *ldc);
+        return 0;
+    }
+    for (jc = 0; jc < *n; jc += NC/2) {
+        nc = MIN(NC/2, *n - jc);
+        for (pc = 0; pc < *k; pc += KC) {
+            kc = MIN(KC, *k - pc);
+            zpack_b(kc, nc, b + pc*rsb + jc*csb, rsb, csb, conjb, bbuf);
+            for (ic = 0; ic < *m; ic += MC/2) {
+                mc = MIN(MC/2, *m - ic);
+                zpack_a(mc, kc, a + ic*rsa + pc*csa, rsa, csa, conja,
+                        *alpha, abuf);
+                for (jr = 0; jr < nc; jr += ZNR) {
+                    for (ir = 0; ir < mc; ir += ZMR) {
+                        zgemm_kernel(kc, abuf + ir*kc, bbuf + jr*kc,
+                                     c__ + (ic + ir) + (jc + jr) * *ldc,
+                                     *ldc, MIN(ZMR, mc - ir),
+                                     MIN(ZNR, nc - jr));
+                    }
+                }
+            }
+        }
+    }
+    free(abuf);
+    free(bbuf);
+    return 0;
+} /* zgemm_ */
+
+
+/* ---------------------------------------------------------------------- */
+
+/*
+ * dgemv takes four columns of A at a time, so that y, for A*x, or x, for
+ * A'*x, is read once per four columns instead of once per column.
+ */
+/* Subroutine */ int dgemv_(char *trans, integer *m, integer *n, doublereal *
+	alpha, doublereal *a, integer *lda, doublereal *x, integer *incx,
+	doublereal *beta, doublereal *y, integer *incy)
+{
+    integer info, lenx, leny, kx, ky, i, j, iy, ix;
+    integer ld = *lda, ncx = *incx, ncy = *incy;
+    int notrans;
+    doublereal t0, t1, t2, t3;
+    const doublereal *a0, *a1, *a2, *a3;
+
+    info = 0;
+    notrans = lsame_(trans, "N");
+    if (!notrans && !lsame_(trans, "T") && !lsame_(trans, "C")) {
+        info = 1;
+    }
+    else if (*m < 0) {
+        info = 2;
+    }
+    else if (*n < 0) {
+        info = 3;
+    }
+    else if (ld < MAX(1, *m)) {
+        info = 6;
+    }
+    else if (ncx == 0) {
+        info = 8;
+    }
+    else if (ncy == 0) {
+        info = 11;
+    }
+    if (info != 0) {
+        xerbla_("DGEMV ", &info);
+        return 0;
+    }
+    if (*m == 0 || *n == 0 || (*alpha == 0. && *beta == 1.)) {
+        return 0;
+    }
+    lenx = notrans ? *n : *m;
+    leny = notrans ? *m : *n;
+    kx = ncx > 0 ? 0 : -(lenx - 1)*ncx;
+    ky = ncy > 0 ? 0 : -(leny - 1)*ncy;
+
+    if (*beta != 1.) {
+        for (i = 0, iy = ky; i < leny; i++, iy += ncy) {
+            y[iy] = *beta == 0. ? 0. : *beta * y[iy];
+        }
+    }
+    if (*alpha == 0.) {
+        return 0;
+    }
+
+    if (notrans) {
+        /* y := alpha*A*x + y */
+        for (j = 0; j + 4 <= *n; j += 4) {
+            ix = kx + j*ncx;
+            t0 = *alpha * x[ix];
+            t1 = *alpha * x[ix + ncx];
+            t2 = *alpha * x[ix + 2*ncx];
+            t3 = *alpha * x[ix + 3*ncx];
+            a0 = a + j*ld;
+            a1 = a0 + ld;
+            a2 = a1 + ld;
+            a3 = a2 + ld;
+            if (ncy == 1) {
+                for (i = 0; i < *m; i++) {
+                    y[i] += t0*a0[i] + t1*a1[i] + t2*a2[i] + t3*a3[i];
+                }
+            }
+            else {
+                for (i = 0, iy = ky; i < *m; i++, iy += ncy) {
+                    y[iy] += t0*a0[i] + t1*a1[i] + t2*a2[i] + t3*a3[i];
+                }
+            }
+        }
+        for (; j < *n; j++) {
+            t0 = *alpha * x[kx + j*ncx];
+            a0 = a + j*ld;
+            for (i = 0, iy = ky; i < *m; i++, iy += ncy) {
+                y[iy] += t0*a0[i];
+            }
+        }
+    }
+    else {
+        /* y := alpha*A'*x + y */
+        for (j = 0; j + 4 <= *n; j += 4) {
+            a0 = a + j*ld;
+            a1 = a0 + ld;
+            a2 = a1 + ld;
+            a3 = a2 + ld;
+            t0 = t1 = t2 = t3 = 0.;
+            for (i = 0, ix = kx; i < *m; i++, ix += ncx) {
+                t0 += a0[i]*x[ix];
+                t1 += a1[i]*x[ix];
+                t2 += a2[i]*x[ix];
+                t3 += a3[i]*x[ix];
+            }
+            iy = ky + j*ncy;
+            y[iy] += *alpha * t0;
+            y[iy + ncy] += *alpha * t1;
+            y[iy + 2*ncy] += *alpha * t2;
+            y[iy + 3*ncy] += *alpha * t3;
+        }
+        for (; j < *n; j++) {
+            a0 = a + j*ld;
+            t0 = 0.;
+            for (i = 0, ix = kx; i < *m; i++, ix += ncx) {
+                t0 += a0[i]*x[ix];
+            }
+            y[ky + j*ncy] += *alpha * t0;
+        }
+    }
+    return 0;
+} /* dgemv_ */
@@ -309,22 +309,16 @@ L60:
     return ret_val;
 } /* ddot_ */
 
-/* Subroutine */ int dgemm_(char *transa, char *transb, integer *m, integer *
-	n, integer *k, doublereal *alpha, doublereal *a, integer *lda,
-	doublereal *b, integer *ldb, doublereal *beta, doublereal *c__,
-	integer *ldc)
+/* Subroutine */ int dger_(integer *m, integer *n, doublereal *alpha,
+	doublereal *x, integer *incx, doublereal *y, integer *incy,
+	doublereal *a, integer *lda)
 {
     /* System generated locals */
-    integer a_dim1, a_offset, b_dim1, b_offset, c_dim1, c_offset, i__1, i__2,
-	    i__3;
+    integer a_dim1, a_offset, i__1, i__2;
 
     /* Local variables */
-    static integer i__, j, l, info;
-    static logical nota, notb;
+    static integer i__, j, ix, jy, kx, info;
     static doublereal temp;
-    static integer ncola;
-    extern logical lsame_(char *, char *);
-    static integer nrowa, nrowb;
     extern /* Subroutine */ int xerbla_(char *, integer *);
 
 
@@ -332,643 +326,480 @@ L60:
     Purpose
     =======
 
-    DGEMM  performs one of the matrix-matrix operations
-
-       C := alpha*op( A )*op( B ) + beta*C,
-
-    where  op( X ) is one of
+    DGER   performs the rank 1 operation
 
-       op( X ) = X   or   op( X ) = X',
+       A := alpha*x*y' + A,
 
-    alpha and beta are scalars, and A, B and C are matrices, with op( A )
-    an m by k matrix,  op( B )  a  k by n matrix and  C an m by n matrix.
+    where alpha is a scalar, x is an m element vector, y is an n element
+    vector and A is an m by n matrix.
 
     Parameters
     ==========
 
-    TRANSA - CHARACTER*1.
-             On entry, TRANSA specifies the form of op( A ) to be used in
-             the matrix multiplication as follows:
-
-                TRANSA = 'N' or 'n',  op( A ) = A.
-
-                TRANSA = 'T' or 't',  op( A ) = A'.
-
-                TRANSA = 'C' or 'c',  op( A ) = A'.
-
-             Unchanged on exit.
-
-    TRANSB - CHARACTER*1.
-             On entry, TRANSB specifies the form of op( B ) to be used in
-             the matrix multiplication as follows:
-
-                TRANSB = 'N' or 'n',  op( B ) = B.
-
-                TRANSB = 'T' or 't',  op( B ) = B'.
-
-                TRANSB = 'C' or 'c',  op( B ) = B'.
-
-             Unchanged on exit.
-
     M      - INTEGER.
-             On entry,  M  specifies  the number  of rows  of the  matrix
-             op( A )  and of the  matrix  C.  M  must  be at least  zero.
+             On entry, M specifies the number of rows of the matrix A.
+             M must be at least zero.
              Unchanged on exit.
 
     N      - INTEGER.
-             On entry,  N  specifies the number  of columns of the matrix
-             op( B ) and the number of columns of the matrix C. N must be
-             at least zero.
-             Unchanged on exit.
-
-    K      - INTEGER.
-             On entry,  K  specifies  the number of columns of the matrix
-             op( A ) and the number of rows of the matrix op( B ). K must
-             be at least  zero.
+             On entry, N specifies the number of columns of the matrix A.
+             N must be at least zero.
              Unchanged on exit.
 
     ALPHA  - DOUBLE PRECISION.
              On entry, ALPHA specifies the scalar alpha.
              Unchanged on exit.
 
-    A      - DOUBLE PRECISION array of DIMENSION ( LDA, ka ), where ka is
-             k  when  TRANSA = 'N' or 'n',  and is  m  otherwise.
-             Before entry with  TRANSA = 'N' or 'n',  the leading  m by k
-             part of the array  A  must contain the matrix  A,  otherwise
-             the leading  k by m  part of the array  A  must contain  the
-             matrix A.
-             Unchanged on exit.
-
-    LDA    - INTEGER.
-             On entry, LDA specifies the first dimension of A as declared
-             in the calling (sub) program. When  TRANSA = 'N' or 'n' then
-             LDA must be at least  max( 1, m ), otherwise  LDA must be at
-             least  max( 1, k ).
+    X      - DOUBLE PRECISION array of dimension at least
+             ( 1 + ( m - 1 )*abs( INCX ) ).
+             Before entry, the incremented array X must contain the m
+             element vector x.
              Unchanged on exit.
 
-    B      - DOUBLE PRECISION array of DIMENSION ( LDB, kb ), where kb is
-             n  when  TRANSB = 'N' or 'n',  and is  k  otherwise.
-             Before entry with  TRANSB = 'N' or 'n',  the leading  k by n
-             part of the array  B  must contain the matrix  B,  otherwise
-             the leading  n by k  part of the array  B  must contain  the
-             matrix B.
+    INCX   - INTEGER.
+             On entry, INCX specifies the increment for the elements of
+             X. INCX must not be zero.
              Unchanged on exit.
 
-    LDB    - INTEGER.
-             On entry, LDB specifies the first dimension of B as declared
-             in the calling (sub) program. When  TRANSB = 'N' or 'n' then
-             LDB must be at least  max( 1, k ), otherwise  LDB must be at
-             least  max( 1, n ).
+    Y      - DOUBLE PRECISION array of dimension at least
+             ( 1 + ( n - 1 )*abs( INCY ) ).
+             Before entry, the incremented array Y must contain the n
+             element vector y.
              Unchanged on exit.
 
-    BETA   - DOUBLE PRECISION.
-             On entry,  BETA  specifies the scalar  beta.  When  BETA  is
-             supplied as zero then C need not be set on input.
+    INCY   - INTEGER.
+             On entry, INCY specifies the increment for the elements of
+             Y. INCY must not be zero.
              Unchanged on exit.
 
-    C      - DOUBLE PRECISION array of DIMENSION ( LDC, n ).
-             Before entry, the leading  m by n  part of the array  C must
-             contain the matrix  C,  except when  beta  is zero, in which
-             case C need not be set on entry.
-             On exit, the array  C  is overwritten by the  m by n  matrix
-             ( alpha*op( A )*op( B ) + beta*C ).
+    A      - DOUBLE PRECISION array of DIMENSION ( LDA, n ).
+             Before entry, the leading m by n part of the array A must
+             contain the matrix of coefficients. On exit, A is
+             overwritten by the updated matrix.
 
-    LDC    - INTEGER.
-             On entry, LDC specifies the first dimension of C as declared
-             in  the  calling  (sub)  program.   LDC  must  be  at  least
+    LDA    - INTEGER.
+             On entry, LDA specifies the first dimension of A as declared
+             in the calling (sub) program. LDA must be at least
              max( 1, m ).
              Unchanged on exit.
 
 
-    Level 3 Blas routine.
+    Level 2 Blas routine.
 
-    -- Written on 8-February-1989.
-       Jack Dongarra, Argonne National Laboratory.
-       Iain Duff, AERE Harwell.
-       Jeremy Du Croz, Numerical Algorithms Group Ltd.
-       Sven Hammarling, Numerical Algorithms Group Ltd.
+    -- Written on 22-October-1986.
+       Jack Dongarra, Argonne National Lab.
+       Jeremy Du Croz, Nag Central Office.
+       Sven Hammarling, Nag Central Office.
+       Richard Hanson, Sandia National Labs.
 
 
-       Set  NOTA  and  NOTB  as  true if  A  and  B  respectively are not
-       transposed and set  NROWA, NCOLA and  NROWB  as the number of rows
-       and  columns of  A  and the  number of  rows  of  B  respectively.
+       Test the input parameters.
 */
 
     /* Parameter adjustments */
+    --x;
+    --y;
     a_dim1 = *lda;
     a_offset = 1 + a_dim1 * 1;
     a -= a_offset;
-    b_dim1 = *ldb;
-    b_offset = 1 + b_dim1 * 1;
-    b -= b_offset;
-    c_dim1 = *ldc;
-    c_offset = 1 + c_dim1 * 1;
-    c__ -= c_offset;
 
     /* Function Body */
-    nota = lsame_(transa, "N");
-    notb = lsame_(transb, "N");
-    if (nota) {
-	nrowa = *m;
-	ncola = *k;
-    } else {
-	nrowa = *k;
-	ncola = *m;
-    }
-    if (notb) {
-	nrowb = *k;
-    } else {
-	nrowb = *n;
-    }
-
-/*     Test the input parameters. */
-
     info = 0;
-    if (((! nota && ! lsame_(transa, "C")) && ! lsame_(
-	    transa, "T"))) {
+    if (*m < 0) {
 	info = 1;
-    } else if (((! notb && ! lsame_(transb, "C")) && !
-	    lsame_(transb, "T"))) {
-	info = 2;
-    } else if (*m < 0) {
-	info = 3;
     } else if (*n < 0) {
-	info = 4;
-    } else if (*k < 0) {
+	info = 2;
+    } else if (*incx == 0) {
 	info = 5;
-    } else if (*lda < max(1,nrowa)) {
-	info = 8;
-    } else if (*ldb < max(1,nrowb)) {
-	info = 10;
-    } else if (*ldc < max(1,*m)) {
-	info = 13;
+    } else if (*incy == 0) {
+	info = 7;
+    } else if (*lda < max(1,*m)) {
+	info = 9;
     }
     if (info != 0) {
-	xerbla_("DGEMM ", &info);
+	xerbla_("DGER  ", &info);
 	return 0;
     }
 
 /*     Quick return if possible. */
 
-    if (*m == 0 || *n == 0 || ((*alpha == 0. || *k == 0) && *beta == 1.)) {
+    if (*m == 0 || *n == 0 || *alpha == 0.) {
 	return 0;
     }
 
-/*     And if  alpha.eq.zero. */
+/*
+       Start the operations. In this version the elements of A are
+       accessed sequentially with one pass through A.
+*/
 
-    if (*alpha == 0.) {
-	if (*beta == 0.) {
-	    i__1 = *n;
-	    for (j = 1; j <= i__1; ++j) {
+    if (*incy > 0) {
+	jy = 1;
+    } else {
+	jy = 1 - (*n - 1) * *incy;
+    }
+    if (*incx == 1) {
+	i__1 = *n;
+	for (j = 1; j <= i__1; ++j) {
+	    if (y[jy] != 0.) {
+		temp = *alpha * y[jy];
 		i__2 = *m;
 		for (i__ = 1; i__ <= i__2; ++i__) {
-		    c__[i__ + j * c_dim1] = 0.;
+		    a[i__ + j * a_dim1] += x[i__] * temp;
 /* L10: */
 		}
-/* L20: */
 	    }
+	    jy += *incy;
+/* L20: */
+	}
+    } else {
+	if (*incx > 0) {
+	    kx = 1;
 	} else {
-	    i__1 = *n;
-	    for (j = 1; j <= i__1; ++j) {
+	    kx = 1 - (*m - 1) * *incx;
+	}
+	i__1 = *n;
+	for (j = 1; j <= i__1; ++j) {
+	    if (y[jy] != 0.) {
+		temp = *alpha * y[jy];
+		ix = kx;
 		i__2 = *m;
 		for (i__ = 1; i__ <= i__2; ++i__) {
-		    c__[i__ + j * c_dim1] = *beta * c__[i__ + j * c_dim1];
+		    a[i__ + j * a_dim1] += x[ix] * temp;
+		    ix += *incx;
 /* L30: */
 		}
-/* L40: */
 	    }
+	    jy += *incy;
+/* L40: */
 	}
-	return 0;
     }
 
-/*     Start the operations. */
+    return 0;
 
-    if (notb) {
-	if (nota) {
+/*     End of DGER  . */
 
-/*           Form  C := alpha*A*B + beta*C. */
+} /* dger_ */
 
-	    i__1 = *n;
-	    for (j = 1; j <= i__1; ++j) {
-		if (*beta == 0.) {
-		    i__2 = *m;
-		    for (i__ = 1; i__ <= i__2; ++i__) {
-			c__[i__ + j * c_dim1] = 0.;
-/* L50: */
-		    }
-		} else if (*beta != 1.) {
-		    i__2 = *m;
-		    for (i__ = 1; i__ <= i__2; ++i__) {
-			c__[i__ + j * c_dim1] = *beta * c__[i__ + j * c_dim1];
-/* L60: */
-		    }
-		}
-		i__2 = *k;
-		for (l = 1; l <= i__2; ++l) {
-		    if (b[l + j * b_dim1] != 0.) {
-			temp = *alpha * b[l + j * b_dim1];
-			i__3 = *m;
-			for (i__ = 1; i__ <= i__3; ++i__) {
-			    c__[i__ + j * c_dim1] += temp * a[i__ + l *
-				    a_dim1];
-/* L70: */
-			}
-		    }
-/* L80: */
-		}
-/* L90: */
-	    }
-	} else {
+doublereal dnrm2_(integer *n, doublereal *x, integer *incx)
+{
+    /* System generated locals */
+    integer i__1, i__2;
+    doublereal ret_val, d__1;
 
-/*           Form  C := alpha*A'*B + beta*C */
+    /* Builtin functions */
+    double sqrt(doublereal);
 
-	    i__1 = *n;
-	    for (j = 1; j <= i__1; ++j) {
-		i__2 = *m;
-		for (i__ = 1; i__ <= i__2; ++i__) {
-		    temp = 0.;
-		    i__3 = *k;
-		    for (l = 1; l <= i__3; ++l) {
-			temp += a[l + i__ * a_dim1] * b[l + j * b_dim1];
-/* L100: */
-		    }
-		    if (*beta == 0.) {
-			c__[i__ + j * c_dim1] = *alpha * temp;
-		    } else {
-			c__[i__ + j * c_dim1] = *alpha * temp + *beta * c__[
-				i__ + j * c_dim1];
-		    }
-/* L110: */
-		}
-/* L120: */
-	    }
-	}
-    } else {
-	if (nota) {
+    /* Local variables */
+    static integer ix;
+    static doublereal ssq, norm, scale, absxi;
 
-/*           Form  C := alpha*A*B' + beta*C */
 
-	    i__1 = *n;
-	    for (j = 1; j <= i__1; ++j) {
-		if (*beta == 0.) {
-		    i__2 = *m;
-		    for (i__ = 1; i__ <= i__2; ++i__) {
-			c__[i__ + j * c_dim1] = 0.;
-/* L130: */
-		    }
-		} else if (*beta != 1.) {
-		    i__2 = *m;
-		    for (i__ = 1; i__ <= i__2; ++i__) {
-			c__[i__ + j * c_dim1] = *beta * c__[i__ + j * c_dim1];
-/* L140: */
-		    }
-		}
-		i__2 = *k;
-		for (l = 1; l <= i__2; ++l) {
-		    if (b[j + l * b_dim1] != 0.) {
-			temp = *alpha * b[j + l * b_dim1];
-			i__3 = *m;
-			for (i__ = 1; i__ <= i__3; ++i__) {
-			    c__[i__ + j * c_dim1] += temp * a[i__ + l *
-				    a_dim1];
-/* L150: */
-			}
-		    }
-/* L160: */
-		}
-/* L170: */
-	    }
-	} else {
+/*
+    DNRM2 returns the euclidean norm of a vector via the function
+    name, so that
 
-/*           Form  C := alpha*A'*B' + beta*C */
+       DNRM2 := sqrt( x'*x )
 
-	    i__1 = *n;
-	    for (j = 1; j <= i__1; ++j) {
-		i__2 = *m;
-		for (i__ = 1; i__ <= i__2; ++i__) {
-		    temp = 0.;
-		    i__3 = *k;
-		    for (l = 1; l <= i__3; ++l) {
-			temp += a[l + i__ * a_dim1] * b[j + l * b_dim1];
-/* L180: */
-		    }
-		    if (*beta == 0.) {
-			c__[i__ + j * c_dim1] = *alpha * temp;
-		    } else {
-			c__[i__ + j * c_dim1] = *alpha * temp + *beta * c__[
-				i__ + j * c_dim1];
-		    }
-/* L190: */
+
+    -- This version written on 25-October-1982.
+       Modified on 14-October-1993 to inline the call to DLASSQ.
+       Sven Hammarling, Nag Ltd.
+*/
+
+
+    /* Parameter adjustments */
+    --x;
+
+    /* Function Body */
+    if (*n < 1 || *incx < 1) {
+	norm = 0.;
+    } else if (*n == 1) {
+	norm = abs(x[1]);
+    } else {
+	scale = 0.;
+	ssq = 1.;
+/*
+          The following loop is equivalent to this call to the LAPACK
+          auxiliary routine:
+          CALL DLASSQ( N, X, INCX, SCALE, SSQ )
+*/
+
+	i__1 = (*n - 1) * *incx + 1;
+	i__2 = *incx;
+	for (ix = 1; i__2 < 0 ? ix >= i__1 : ix <= i__1; ix += i__2) {
+	    if (x[ix] != 0.) {
+		absxi = (d__1 = x[ix], abs(d__1));
+		if (scale < absxi) {
+/* Computing 2nd power */
+		    d__1 = scale / absxi;
+		    ssq = ssq * (d__1 * d__1) + 1.;
+		    scale = absxi;
+		} else {
+/* Computing 2nd power */
+		    d__1 = absxi / scale;
+		    ssq += d__1 * d__1;
 		}
-/* L200: */
 	    }
+/* L10: */
 	}
+	norm = scale * sqrt(ssq);
     }
 
-    return 0;
+    ret_val = norm;
+    return ret_val;
 
-/*     End of DGEMM . */
+/*     End of DNRM2. */
 
-} /* dgemm_ */
+} /* dnrm2_ */
 
-/* Subroutine */ int dgemv_(char *trans, integer *m, integer *n, doublereal *
-	alpha, doublereal *a, integer *lda, doublereal *x, integer *incx,
-	doublereal *beta, doublereal *y, integer *incy)
+/* Subroutine */ int drot_(integer *n, doublereal *dx, integer *incx,
+	doublereal *dy, integer *incy, doublereal *c__, doublereal *s)
 {
     /* System generated locals */
-    integer a_dim1, a_offset, i__1, i__2;
+    integer i__1;
 
     /* Local variables */
-    static integer i__, j, ix, iy, jx, jy, kx, ky, info;
-    static doublereal temp;
-    static integer lenx, leny;
-    extern logical lsame_(char *, char *);
-    extern /* Subroutine */ int xerbla_(char *, integer *);
+    static integer i__, ix, iy;
+    static doublereal dtemp;
 
 
 /*
-    Purpose
-    =======
-
-    DGEMV  performs one of the matrix-vector operations
-
-       y := alpha*A*x + beta*y,   or   y := alpha*A'*x + beta*y,
-
-    where alpha and beta are scalars, x and y are vectors and A is an
-    m by n matrix.
-
-    Parameters
-    ==========
-
-    TRANS  - CHARACTER*1.
-             On entry, TRANS specifies the operation to be performed as
-             follows:
-
-                TRANS = 'N' or 'n'   y := alpha*A*x + beta*y.
-
-                TRANS = 'T' or 't'   y := alpha*A'*x + beta*y.
-
-                TRANS = 'C' or 'c'   y := alpha*A'*x + beta*y.
-
-             Unchanged on exit.
-
-    M      - INTEGER.
-             On entry, M specifies the number of rows of the matrix A.
-             M must be at least zero.
-             Unchanged on exit.
-
-    N      - INTEGER.
-             On entry, N specifies the number of columns of the matrix A.
-             N must be at least zero.
-             Unchanged on exit.
-
-    ALPHA  - DOUBLE PRECISION.
-             On entry, ALPHA specifies the scalar alpha.
-             Unchanged on exit.
-
-    A      - DOUBLE PRECISION array of DIMENSION ( LDA, n ).
-             Before entry, the leading m by n part of the array A must
-             contain the matrix of coefficients.
-             Unchanged on exit.
+       applies a plane rotation.
+       jack dongarra, linpack, 3/11/78.
+       modified 12/3/93, array(1) declarations changed to array(*)
+*/
 
-    LDA    - INTEGER.
-             On entry, LDA specifies the first dimension of A as declared
-             in the calling (sub) program. LDA must be at least
-             max( 1, m ).
-             Unchanged on exit.
 
-    X      - DOUBLE PRECISION array of DIMENSION at least
-             ( 1 + ( n - 1 )*abs( INCX ) ) when TRANS = 'N' or 'n'
-             and at least
-             ( 1 + ( m - 1 )*abs( INCX ) ) otherwise.
-             Before entry, the incremented array X must contain the
-             vector x.
-             Unchanged on exit.
+    /* Parameter adjustments */
+    --dy;
+    --dx;
 
-    INCX   - INTEGER.
-             On entry, INCX specifies the increment for the elements of
-             X. INCX must not be zero.
-             Unchanged on exit.
+    /* Function Body */
+    if (*n <= 0) {
+	return 0;
+    }
+    if ((*incx == 1 && *incy == 1)) {
+	goto L20;
+    }
 
-    BETA   - DOUBLE PRECISION.
-             On entry, BETA specifies the scalar beta. When BETA is
-             supplied as zero then Y need not be set on input.
-             Unchanged on exit.
+/*
+         code for unequal increments or equal increments not equal
+           to 1
+*/
 
-    Y      - DOUBLE PRECISION array of DIMENSION at least
-             ( 1 + ( m - 1 )*abs( INCY ) ) when TRANS = 'N' or 'n'
-             and at least
-             ( 1 + ( n - 1 )*abs( INCY ) ) otherwise.
-             Before entry with BETA non-zero, the incremented array Y
-             must contain the vector y. On exit, Y is overwritten by the
-             updated vector y.
+    ix = 1;
+    iy = 1;
+    if (*incx < 0) {
+	ix = (-(*n) + 1) * *incx + 1;
+    }
+    if (*incy < 0) {
+	iy = (-(*n) + 1) * *incy + 1;
+    }
+    i__1 = *n;
+    for (i__ = 1; i__ <= i__1; ++i__) {
+	dtemp = *c__ * dx[ix] + *s * dy[iy];
+	dy[iy] = *c__ * dy[iy] - *s * dx[ix];
+	dx[ix] = dtemp;
+	ix += *incx;
+	iy += *incy;
+/* L10: */
+    }
+    return 0;
 
-    INCY   - INTEGER.
-             On entry, INCY specifies the increment for the elements of
-             Y. INCY must not be zero.
-             Unchanged on exit.
+/*       code for both increments equal to 1 */
 
+L20:
+    i__1 = *n;
+    for (i__ = 1; i__ <= i__1; ++i__) {
+	dtemp = *c__ * dx[i__] + *s * dy[i__];
+	dy[i__] = *c__ * dy[i__] - *s * dx[i__];
+	dx[i__] = dtemp;
+/* L30: */
+    }
+    return 0;
+} /* drot_ */
 
-    Level 2 Blas routine.
+/* Subroutine */ int dscal_(integer *n, doublereal *da, doublereal *dx,
+	integer *incx)
+{
+    /* System generated locals */
+    integer i__1, i__2;
 
-    -- Written on 22-October-1986.
-       Jack Dongarra, Argonne National Lab.
-       Jeremy Du Croz, Nag Central Office.
-       Sven Hammarling, Nag Central Office.
-       Richard Hanson, Sandia National Labs.
+    /* Local variables */
+    static integer i__, m, mp1, nincx;
 
 
-       Test the input parameters.
+/*
+       scales a vector by a constant.
+       uses unrolled loops for increment equal to one.
+       jack dongarra, linpack, 3/11/78.
+       modified 3/93 to return if incx .le. 0.
+       modified 12/3/93, array(1) declarations changed to array(*)
 */
 
+
     /* Parameter adjustments */
-    a_dim1 = *lda;
-    a_offset = 1 + a_dim1 * 1;
-    a -= a_offset;
-    --x;
-    --y;
+    --dx;
 
     /* Function Body */
-    info = 0;
-    if (((! lsame_(trans, "N") && ! lsame_(trans, "T")) && ! lsame_(trans, "C"))) {
-	info = 1;
-    } else if (*m < 0) {
-	info = 2;
-    } else if (*n < 0) {
-	info = 3;
-    } else if (*lda < max(1,*m)) {
-	info = 6;
-    } else if (*incx == 0) {
-	info = 8;
-    } else if (*incy == 0) {
-	info = 11;
-    }
-    if (info != 0) {
-	xerbla_("DGEMV ", &info);
+    if (*n <= 0 || *incx <= 0) {
 	return 0;
     }
+    if (*incx == 1) {
+	goto L20;
+    }
 
-/*     Quick return if possible. */
+/*        code for increment not equal to 1 */
 
-    if (*m == 0 || *n == 0 || (*alpha == 0. && *beta == 1.)) {
-	return 0;
+    nincx = *n * *incx;
+    i__1 = nincx;
+    i__2 = *incx;
+    for (i__ = 1; i__2 < 0 ? i__ >= i__1 : i__ <= i__1; i__ += i__2) {
+	dx[i__] = *da * dx[i__];
+/* L10: */
     }
+    return 0;
 
 /*
-       Set  LENX  and  LENY, the lengths of the vectors x and y, and set
-       up the start points in  X  and  Y.
+          code for increment equal to 1
+
+
+          clean-up loop
 */
 
-    if (lsame_(trans, "N")) {
-	lenx = *n;
-	leny = *m;
-    } else {
-	lenx = *m;
-	leny = *n;
+L20:
+    m = *n % 5;
+    if (m == 0) {
+	goto L40;
     }
-    if (*incx > 0) {
-	kx = 1;
-    } else {
-	kx = 1 - (lenx - 1) * *incx;
+    i__2 = m;
+    for (i__ = 1; i__ <= i__2; ++i__) {
+	dx[i__] = *da * dx[i__];
+/* L30: */
     }
-    if (*incy > 0) {
-	ky = 1;
-    } else {
-	ky = 1 - (leny - 1) * *incy;
+    if (*n < 5) {
+	return 0;
+    }
+L40:
+    mp1 = m + 1;
+    i__2 = *n;
+    for (i__ = mp1; i__ <= i__2; i__ += 5) {
+	dx[i__] = *da * dx[i__];
+	dx[i__ + 1] = *da * dx[i__ + 1];
+	dx[i__ + 2] = *da * dx[i__ + 2];
+	dx[i__ + 3] = *da * dx[i__ + 3];
+	dx[i__ + 4] = *da * dx[i__ + 4];
+/* L50: */
     }
+    return 0;
+} /* dscal_ */
+
+/* Subroutine */ int dswap_(integer *n, doublereal *dx, integer *incx,
+	doublereal *dy, integer *incy)
+{
+    /* System generated locals */
+    integer i__1;
+
+    /* Local variables */
+    static integer i__, m, ix, iy, mp1;
+    static doublereal dtemp;
+
 
 /*
-       Start the operations. In this version the elements of A are
-       accessed sequentially with one pass through A.
+       interchanges two vectors.
+       uses unrolled loops for increments equal one.
+       jack dongarra, linpack, 3/11/78.
+       modified 12/3/93, array(1) declarations changed to array(*)
+*/
 
-       First form  y := beta*y.
+
+    /* Parameter adjustments */
+    --dy;
+    --dx;
+
+    /* Function Body */
+    if (*n <= 0) {
+	return 0;
+    }
+    if ((*incx == 1 && *incy == 1)) {
+	goto L20;
+    }
+
+/*
+         code for unequal increments or equal increments not equal
+           to 1
 */
 
-    if (*beta != 1.) {
-	if (*incy == 1) {
-	    if (*beta == 0.) {
-		i__1 = leny;
-		for (i__ = 1; i__ <= i__1; ++i__) {
-		    y[i__] = 0.;
-/* L10: */
-		}
-	    } else {
-		i__1 = leny;
-		for (i__ = 1; i__ <= i__1; ++i__) {
-		    y[i__] = *beta * y[i__];
-/* L20: */
-		}
-	    }
-	} else {
-	    iy = ky;
-	    if (*beta == 0.) {
-		i__1 = leny;
-		for (i__ = 1; i__ <= i__1; ++i__) {
-		    y[iy] = 0.;
-		    iy += *incy;
-/* L30: */
-		}
-	    } else {
-		i__1 = leny;
-		for (i__ = 1; i__ <= i__1; ++i__) {
-		    y[iy] = *beta * y[iy];
-		    iy += *incy;
-/* L40: */
-		}
-	    }
-	}
+    ix = 1;
+    iy = 1;
+    if (*incx < 0) {
+	ix = (-(*n) + 1) * *incx + 1;
     }
-    if (*alpha == 0.) {
-	return 0;
+    if (*incy < 0) {
+	iy = (-(*n) + 1) * *incy + 1;
     }
-    if (lsame_(trans, "N")) {
+    i__1 = *n;
+    for (i__ = 1; i__ <= i__1; ++i__) {
+	dtemp = dx[ix];
+	dx[ix] = dy[iy];
+	dy[iy] = dtemp;
+	ix += *incx;
+	iy += *incy;
+/* L10: */
+    }
+    return 0;
 
-/*        Form  y := alpha*A*x + y. */
+/*
+         code for both increments equal to 1
 
-	jx = kx;
-	if (*incy == 1) {
-	    i__1 = *n;
-	    for (j = 1; j <= i__1; ++j) {
-		if (x[jx] != 0.) {
-		    temp = *alpha * x[jx];
-		    i__2 = *m;
-		    for (i__ = 1; i__ <= i__2; ++i__) {
-			y[i__] += temp * a[i__ + j * a_dim1];
-/* L50: */
-		    }
-		}
-		jx += *incx;
-/* L60: */
-	    }
-	} else {
-	    i__1 = *n;
-	    for (j = 1; j <= i__1; ++j) {
-		if (x[jx] != 0.) {
-		    temp = *alpha * x[jx];
-		    iy = ky;
-		    i__2 = *m;
-		    for (i__ = 1; i__ <= i__2; ++i__) {
-			y[iy] += temp * a[i__ + j * a_dim1];
-			iy += *incy;
-/* L70: */
-		    }
-		}
-		jx += *incx;
-/* L80: */
-	    }
-	}
-    } else {
 
-/*        Form  y := alpha*A'*x + y. */
+         clean-up loop
+*/
 
-	jy = ky;
-	if (*incx == 1) {
-	    i__1 = *n;
-	    for (j = 1; j <= i__1; ++j) {
-		temp = 0.;
-		i__2 = *m;
-		for (i__ = 1; i__ <= i__2; ++i__) {
-		    temp += a[i__ + j * a_dim1] * x[i__];
-/* L90: */
-		}
-		y[jy] += *alpha * temp;
-		jy += *incy;
-/* L100: */
-	    }
-	} else {
-	    i__1 = *n;
-	    for (j = 1; j <= i__1; ++j) {
-		temp = 0.;
-		ix = kx;
-		i__2 = *m;
-		for (i__ = 1; i__ <= i__2; ++i__) {
-		    temp += a[i__ + j * a_dim1] * x[ix];
-		    ix += *incx;
-/* L110: */
-		}
-		y[jy] += *alpha * temp;
-		jy += *incy;
-/* L120: */
-	    }
-	}
+L20:
+    m = *n % 3;
+    if (m == 0) {
+	goto L40;
+    }
+    i__1 = m;
+    for (i__ = 1; i__ <= i__1; ++i__) {
+	dtemp = dx[i__];
+	dx[i__] = dy[i__];
+	dy[i__] = dtemp;
+/* L30: */
+    }
+    if (*n < 3) {
+	return 0;
+    }
+L40:
+    mp1 = m + 1;
+    i__1 = *n;
+    for (i__ = mp1; i__ <= i__1; i__ += 3) {
+	dtemp = dx[i__];
+	dx[i__] = dy[i__];
+	dy[i__] = dtemp;
+	dtemp = dx[i__ + 1];
+	dx[i__ + 1] = dy[i__ + 1];
+	dy[i__ + 1] = dtemp;
+	dtemp = dx[i__ + 2];
+	dx[i__ + 2] = dy[i__ + 2];
+	dy[i__ + 2] = dtemp;
+/* L50: */
     }
-
     return 0;
+} /* dswap_ */
 
-/*     End of DGEMV . */
-
-} /* dgemv_ */
-
-/* Subroutine */ int dger_(integer *m, integer *n, doublereal *alpha,
-	doublereal *x, integer *incx, doublereal *y, integer *incy,
-	doublereal *a, integer *lda)
+/* Subroutine */ int dsymv_(char *uplo, integer *n, doublereal *alpha,
+	doublereal *a, integer *lda, doublereal *x, integer *incx, doublereal
+	*beta, doublereal *y, integer *incy)
 {
     /* System generated locals */
     integer a_dim1, a_offset, i__1, i__2;
 
     /* Local variables */
-    static integer i__, j, ix, jy, kx, info;
-    static doublereal temp;
+    static integer i__, j, ix, iy, jx, jy, kx, ky, info;
+    static doublereal temp1, temp2;
+    extern logical lsame_(char *, char *);
     extern /* Subroutine */ int xerbla_(char *, integer *);
 
 
@@ -976,23 +807,31 @@ L60:
     Purpose
     =======
 
-    DGER   performs the rank 1 operation
+    DSYMV  performs the matrix-vector  operation
 
-       A := alpha*x*y' + A,
+       y := alpha*A*x + beta*y,
 
-    where alpha is a scalar, x is an m element vector, y is an n element
-    vector and A is an m by n matrix.
+    where alpha and beta are scalars, x and y are n element vectors and
+    A is an n by n symmetric matrix.
 
     Parameters
     ==========
 
-    M      - INTEGER.
-             On entry, M specifies the number of rows of the matrix A.
-             M must be at least zero.
+    UPLO   - CHARACTER*1.
+             On entry, UPLO specifies whether the upper or lower
+             triangular part of the array A is to be referenced as
+             follows:
+
+                UPLO = 'U' or 'u'   Only the upper triangular part of A
+                                    is to be referenced.
+
+                UPLO = 'L' or 'l'   Only the lower triangular part of A
+                                    is to be referenced.
+
              Unchanged on exit.
 
     N      - INTEGER.
-             On entry, N specifies the number of columns of the matrix A.
+             On entry, N specifies the order of the matrix A.
              N must be at least zero.
              Unchanged on exit.
 
@@ -1000,39 +839,50 @@ L60:
              On entry, ALPHA specifies the scalar alpha.
              Unchanged on exit.
 
-    X      - DOUBLE PRECISION array of dimension at least
-             ( 1 + ( m - 1 )*abs( INCX ) ).
-             Before entry, the incremented array X must contain the m
-             element vector x.
-             Unchanged on exit.
-
-    INCX   - INTEGER.
-             On entry, INCX specifies the increment for the elements of
-             X. INCX must not be zero.
+    A      - DOUBLE PRECISION array of DIMENSION ( LDA, n ).
+             Before entry with  UPLO = 'U' or 'u', the leading n by n
+             upper triangular part of the array A must contain the upper
+             triangular part of the symmetric matrix and the strictly
+             lower triangular part of A is not referenced.
+             Before entry with UPLO = 'L' or 'l', the leading n by n
+             lower triangular part of the array A must contain the lower
+             triangular part of the symmetric matrix and the strictly
+             upper triangular part of A is not referenced.
+             Unchanged on exit.
+
+    LDA    - INTEGER.
+             On entry, LDA specifies the first dimension of A as declared
+             in the calling (sub) program. LDA must be at least
+             max( 1, n ).
+             Unchanged on exit.
+
+    X      - DOUBLE PRECISION array of dimension at least
+             ( 1 + ( n - 1 )*abs( INCX ) ).
+             Before entry, the incremented array X must contain the n
+             element vector x.
+             Unchanged on exit.
+
+    INCX   - INTEGER.
+             On entry, INCX specifies the increment for the elements of
+             X. INCX must not be zero.
+             Unchanged on exit.
+
+    BETA   - DOUBLE PRECISION.
+             On entry, BETA specifies the scalar beta. When BETA is
+             supplied as zero then Y need not be set on input.
              Unchanged on exit.
 
     Y      - DOUBLE PRECISION array of dimension at least
              ( 1 + ( n - 1 )*abs( INCY ) ).
              Before entry, the incremented array Y must contain the n
-             element vector y.
-             Unchanged on exit.
+             element vector y. On exit, Y is overwritten by the updated
+             vector y.
 
     INCY   - INTEGER.
              On entry, INCY specifies the increment for the elements of
              Y. INCY must not be zero.
              Unchanged on exit.
 
-    A      - DOUBLE PRECISION array of DIMENSION ( LDA, n ).
-             Before entry, the leading m by n part of the array A must
-             contain the matrix of coefficients. On exit, A is
-             overwritten by the updated matrix.
-
-    LDA    - INTEGER.
-             On entry, LDA specifies the first dimension of A as declared
-             in the calling (sub) program. LDA must be at least
-             max( 1, m ).
-             Unchanged on exit.
-
 
     Level 2 Blas routine.
 
@@ -1047,409 +897,452 @@ L60:
 */
 
     /* Parameter adjustments */
-    --x;
-    --y;
     a_dim1 = *lda;
     a_offset = 1 + a_dim1 * 1;
     a -= a_offset;
+    --x;
+    --y;
 
     /* Function Body */
     info = 0;
-    if (*m < 0) {
+    if ((! lsame_(uplo, "U") && ! lsame_(uplo, "L"))) {
 	info = 1;
     } else if (*n < 0) {
 	info = 2;
-    } else if (*incx == 0) {
+    } else if (*lda < max(1,*n)) {
 	info = 5;
-    } else if (*incy == 0) {
+    } else if (*incx == 0) {
 	info = 7;
-    } else if (*lda < max(1,*m)) {
-	info = 9;
+    } else if (*incy == 0) {
+	info = 10;
     }
     if (info != 0) {
-	xerbla_("DGER  ", &info);
+	xerbla_("DSYMV ", &info);
 	return 0;
     }
 
 /*     Quick return if possible. */
 
-    if (*m == 0 || *n == 0 || *alpha == 0.) {
+    if (*n == 0 || (*alpha == 0. && *beta == 1.)) {
 	return 0;
     }
 
-/*
-       Start the operations. In this version the elements of A are
-       accessed sequentially with one pass through A.
-*/
+/*     Set up the start points in  X  and  Y. */
 
+    if (*incx > 0) {
+	kx = 1;
+    } else {
+	kx = 1 - (*n - 1) * *incx;
+    }
     if (*incy > 0) {
-	jy = 1;
+	ky = 1;
     } else {
-	jy = 1 - (*n - 1) * *incy;
+	ky = 1 - (*n - 1) * *incy;
     }
-    if (*incx == 1) {
-	i__1 = *n;
-	for (j = 1; j <= i__1; ++j) {
-	    if (y[jy] != 0.) {
-		temp = *alpha * y[jy];
-		i__2 = *m;
-		for (i__ = 1; i__ <= i__2; ++i__) {
-		    a[i__ + j * a_dim1] += x[i__] * temp;
+
+/*
+       Start the operations. In this version the elements of A are
+       accessed sequentially with one pass through the triangular part
+       of A.
+
+       First form  y := beta*y.
+*/
+
+    if (*beta != 1.) {
+	if (*incy == 1) {
+	    if (*beta == 0.) {
+		i__1 = *n;
+		for (i__ = 1; i__ <= i__1; ++i__) {
+		    y[i__] = 0.;
 /* L10: */
 		}
-	    }
-	    jy += *incy;
+	    } else {
+		i__1 = *n;
+		for (i__ = 1; i__ <= i__1; ++i__) {
+		    y[i__] = *beta * y[i__];
 /* L20: */
-	}
-    } else {
-	if (*incx > 0) {
-	    kx = 1;
+		}
+	    }
 	} else {
-	    kx = 1 - (*m - 1) * *incx;
+	    iy = ky;
+	    if (*beta == 0.) {
+		i__1 = *n;
+		for (i__ = 1; i__ <= i__1; ++i__) {
+		    y[iy] = 0.;
+		    iy += *incy;
+/* L30: */
+		}
+	    } else {
+		i__1 = *n;
+		for (i__ = 1; i__ <= i__1; ++i__) {
+		    y[iy] = *beta * y[iy];
+		    iy += *incy;
+/* L40: */
+		}
+	    }
 	}
-	i__1 = *n;
-	for (j = 1; j <= i__1; ++j) {
-	    if (y[jy] != 0.) {
-		temp = *alpha * y[jy];
+    }
+    if (*alpha == 0.) {
+	return 0;
+    }
+    if (lsame_(uplo, "U")) {
+
+/*        Form  y  when A is stored in upper triangle. */
+
+	if ((*incx == 1 && *incy == 1)) {
+	    i__1 = *n;
+	    for (j = 1; j <= i__1; ++j) {
+		temp1 = *alpha * x[j];
+		temp2 = 0.;
+		i__2 = j - 1;
+		for (i__ = 1; i__ <= i__2; ++i__) {
+		    y[i__] += temp1 * a[i__ + j * a_dim1];
+		    temp2 += a[i__ + j * a_dim1] * x[i__];
+/* L50: */
+		}
+		y[j] = y[j] + temp1 * a[j + j * a_dim1] + *alpha * temp2;
+/* L60: */
+	    }
+	} else {
+	    jx = kx;
+	    jy = ky;
+	    i__1 = *n;
+	    for (j = 1; j <= i__1; ++j) {
+		temp1 = *alpha * x[jx];
+		temp2 = 0.;
 		ix = kx;
-		i__2 = *m;
+		iy = ky;
+		i__2 = j - 1;
 		for (i__ = 1; i__ <= i__2; ++i__) {
-		    a[i__ + j * a_dim1] += x[ix] * temp;
+		    y[iy] += temp1 * a[i__ + j * a_dim1];
+		    temp2 += a[i__ + j * a_dim1] * x[ix];
 		    ix += *incx;
-/* L30: */
+		    iy += *incy;
+/* L70: */
 		}
+		y[jy] = y[jy] + temp1 * a[j + j * a_dim1] + *alpha * temp2;
+		jx += *incx;
+		jy += *incy;
+/* L80: */
+	    }
+	}
+    } else {
+
+/*        Form  y  when A is stored in lower triangle. */
+
+	if ((*incx == 1 && *incy == 1)) {
+	    i__1 = *n;
+	    for (j = 1; j <= i__1; ++j) {
+		temp1 = *alpha * x[j];
+		temp2 = 0.;
+		y[j] += temp1 * a[j + j * a_dim1];
+		i__2 = *n;
+		for (i__ = j + 1; i__ <= i__2; ++i__) {
+		    y[i__] += temp1 * a[i__ + j * a_dim1];
+		    temp2 += a[i__ + j * a_dim1] * x[i__];
+/* L90: */
+		}
+		y[j] += *alpha * temp2;
+/* L100: */
+	    }
+	} else {
+	    jx = kx;
+	    jy = ky;
+	    i__1 = *n;
+	    for (j = 1; j <= i__1; ++j) {
+		temp1 = *alpha * x[jx];
+		temp2 = 0.;
+		y[jy] += temp1 * a[j + j * a_dim1];
+		ix = jx;
+		iy = jy;
+		i__2 = *n;
+		for (i__ = j + 1; i__ <= i__2; ++i__) {
+		    ix += *incx;
+		    iy += *incy;
+		    y[iy] += temp1 * a[i__ + j * a_dim1];
+		    temp2 += a[i__ + j * a_dim1] * x[ix];
+/* L110: */
+		}
+		y[jy] += *alpha * temp2;
+		jx += *incx;
+		jy += *incy;
+/* L120: */
 	    }
-	    jy += *incy;
-/* L40: */
 	}
     }
 
     return 0;
 
-/*     End of DGER  . */
+/*     End of DSYMV . */
 
-} /* dger_ */
+} /* dsymv_ */
 
-doublereal dnrm2_(integer *n, doublereal *x, integer *incx)
+/* Subroutine */ int dsyr2_(char *uplo, integer *n, doublereal *alpha,
+	doublereal *x, integer *incx, doublereal *y, integer *incy,
+	doublereal *a, integer *lda)
 {
     /* System generated locals */
-    integer i__1, i__2;
-    doublereal ret_val, d__1;
-
-    /* Builtin functions */
-    double sqrt(doublereal);
+    integer a_dim1, a_offset, i__1, i__2;
 
     /* Local variables */
-    static integer ix;
-    static doublereal ssq, norm, scale, absxi;
+    static integer i__, j, ix, iy, jx, jy, kx, ky, info;
+    static doublereal temp1, temp2;
+    extern logical lsame_(char *, char *);
+    extern /* Subroutine */ int xerbla_(char *, integer *);
 
 
 /*
-    DNRM2 returns the euclidean norm of a vector via the function
-    name, so that
+    Purpose
+    =======
 
-       DNRM2 := sqrt( x'*x )
+    DSYR2  performs the symmetric rank 2 operation
 
+       A := alpha*x*y' + alpha*y*x' + A,
 
-    -- This version written on 25-October-1982.
-       Modified on 14-October-1993 to inline the call to DLASSQ.
-       Sven Hammarling, Nag Ltd.
-*/
+    where alpha is a scalar, x and y are n element vectors and A is an n
+    by n symmetric matrix.
 
+    Parameters
+    ==========
 
-    /* Parameter adjustments */
-    --x;
-
-    /* Function Body */
-    if (*n < 1 || *incx < 1) {
-	norm = 0.;
-    } else if (*n == 1) {
-	norm = abs(x[1]);
-    } else {
-	scale = 0.;
-	ssq = 1.;
-/*
-          The following loop is equivalent to this call to the LAPACK
-          auxiliary routine:
-          CALL DLASSQ( N, X, INCX, SCALE, SSQ )
-*/
-
-	i__1 = (*n - 1) * *incx + 1;
-	i__2 = *incx;
-	for (ix = 1; i__2 < 0 ? ix >= i__1 : ix <= i__1; ix += i__2) {
-	    if (x[ix] != 0.) {
-		absxi = (d__1 = x[ix], abs(d__1));
-		if (scale < absxi) {
-/* Computing 2nd power */
-		    d__1 = scale / absxi;
-		    ssq = ssq * (d__1 * d__1) + 1.;
-		    scale = absxi;
-		} else {
-/* Computing 2nd power */
-		    d__1 = absxi / scale;
-		    ssq += d__1 * d__1;
-		}
-	    }
-/* L10: */
-	}
-	norm = scale * sqrt(ssq);
-    }
-
-    ret_val = norm;
-    return ret_val;
-
-/*     End of DNRM2. */
+    UPLO   - CHARACTER*1.
+             On entry, UPLO specifies whether the upper or lower
+             triangular part of the array A is to be referenced as
+             follows:
 
-} /* dnrm2_ */
+                UPLO = 'U' or 'u'   Only the upper triangular part of A
+                                    is to be referenced.
 
-/* Subroutine */ int drot_(integer *n, doublereal *dx, integer *incx,
-	doublereal *dy, integer *incy, doublereal *c__, doublereal *s)
-{
-    /* System generated locals */
-    integer i__1;
+                UPLO = 'L' or 'l'   Only the lower triangular part of A
+                                    is to be referenced.
 
-    /* Local variables */
-    static integer i__, ix, iy;
-    static doublereal dtemp;
+             Unchanged on exit.
 
+    N      - INTEGER.
+             On entry, N specifies the order of the matrix A.
+             N must be at least zero.
+             Unchanged on exit.
 
-/*
-       applies a plane rotation.
-       jack dongarra, linpack, 3/11/78.
-       modified 12/3/93, array(1) declarations changed to array(*)
-*/
+    ALPHA  - DOUBLE PRECISION.
+             On entry, ALPHA specifies the scalar alpha.
+             Unchanged on exit.
 
+    X      - DOUBLE PRECISION array of dimension at least
+             ( 1 + ( n - 1 )*abs( INCX ) ).
+             Before entry, the incremented array X must contain the n
+             element vector x.
+             Unchanged on exit.
 
-    /* Parameter adjustments */
-    --dy;
-    --dx;
+    INCX   - INTEGER.
+             On entry, INCX specifies the increment for the elements of
+             X. INCX must not be zero.
+             Unchanged on exit.
 
-    /* Function Body */
-    if (*n <= 0) {
-	return 0;
-    }
-    if ((*incx == 1 && *incy == 1)) {
-	goto L20;
-    }
+    Y      - DOUBLE PRECISION array of dimension at least
+             ( 1 + ( n - 1 )*abs( INCY ) ).
+             Before entry, the incremented array Y must contain the n
+             element vector y.
+             Unchanged on exit.
 
-/*
-         code for unequal increments or equal increments not equal
-           to 1
-*/
+    INCY   - INTEGER.
+             On entry, INCY specifies the increment for the elements of
+             Y. INCY must not be zero.
+             Unchanged on exit.
 
-    ix = 1;
-    iy = 1;
-    if (*incx < 0) {
-	ix = (-(*n) + 1) * *incx + 1;
-    }
-    if (*incy < 0) {
-	iy = (-(*n) + 1) * *incy + 1;
-    }
-    i__1 = *n;
-    for (i__ = 1; i__ <= i__1; ++i__) {
-	dtemp = *c__ * dx[ix] + *s * dy[iy];
-	dy[iy] = *c__ * dy[iy] - *s * dx[ix];
-	dx[ix] = dtemp;
-	ix += *incx;
-	iy += *incy;
-/* L10: */
-    }
-    return 0;
+    A      - DOUBLE PRECISION array of DIMENSION ( LDA, n ).
+             Before entry with  UPLO = 'U' or 'u', the leading n by n
+             upper triangular part of the array A must contain the upper
+             triangular part of the symmetric matrix and the strictly
+             lower triangular part of A is not referenced. On exit, the
+             upper triangular part of the array A is overwritten by the
+             upper triangular part of the updated matrix.
+             Before entry with UPLO = 'L' or 'l', the leading n by n
+             lower triangular part of the array A must contain the lower
+             triangular part of the symmetric matrix and the strictly
+             upper triangular part of A is not referenced. On exit, the
+             lower triangular part of the array A is overwritten by the
+             lower triangular part of the updated matrix.
 
-/*       code for both increments equal to 1 */
+    LDA    - INTEGER.
+             On entry, LDA specifies the first dimension of A as declared
+             in the calling (sub) program. LDA must be at least
+             max( 1, n ).
+             Unchanged on exit.
 
-L20:
-    i__1 = *n;
-    for (i__ = 1; i__ <= i__1; ++i__) {
-	dtemp = *c__ * dx[i__] + *s * dy[i__];
-	dy[i__] = *c__ * dy[i__] - *s * dx[i__];
-	dx[i__] = dtemp;
-/* L30: */
-    }
-    return 0;
-} /* drot_ */
 
-/* Subroutine */ int dscal_(integer *n, doublereal *da, doublereal *dx,
-	integer *incx)
-{
-    /* System generated locals */
-    integer i__1, i__2;
+    Level 2 Blas routine.
 
-    /* Local variables */
-    static integer i__, m, mp1, nincx;
+    -- Written on 22-October-1986.
+       Jack Dongarra, Argonne National Lab.
+       Jeremy Du Croz, Nag Central Office.
+       Sven Hammarling, Nag Central Office.
+       Richard Hanson, Sandia National Labs.
 
 
-/*
-       scales a vector by a constant.
-       uses unrolled loops for increment equal to one.
-       jack dongarra, linpack, 3/11/78.
-       modified 3/93 to return if incx .le. 0.
-       modified 12/3/93, array(1) declarations changed to array(*)
+       Test the input parameters.
 */
 
-
     /* Parameter adjustments */
-    --dx;
+    --x;
+    --y;
+    a_dim1 = *lda;
+    a_offset = 1 + a_dim1 * 1;
+    a -= a_offset;
 
     /* Function Body */
-    if (*n <= 0 || *incx <= 0) {
-	return 0;
+    info = 0;
+    if ((! lsame_(uplo, "U") && ! lsame_(uplo, "L"))) {
+	info = 1;
+    } else if (*n < 0) {
+	info = 2;
+    } else if (*incx == 0) {
+	info = 5;
+    } else if (*incy == 0) {
+	info = 7;
+    } else if (*lda < max(1,*n)) {
+	info = 9;
     }
-    if (*incx == 1) {
-	goto L20;
+    if (info != 0) {
+	xerbla_("DSYR2 ", &info);
+	return 0;
     }
 
-/*        code for increment not equal to 1 */
+/*     Quick return if possible. */
 
-    nincx = *n * *incx;
-    i__1 = nincx;
-    i__2 = *incx;
-    for (i__ = 1; i__2 < 0 ? i__ >= i__1 : i__ <= i__1; i__ += i__2) {
-	dx[i__] = *da * dx[i__];
-/* L10: */
+    if (*n == 0 || *alpha == 0.) {
+	return 0;
     }
-    return 0;
 
 /*
-          code for increment equal to 1
-
-
-          clean-up loop
+       Set up the start points in X and Y if the increments are not both
+       unity.
 */
 
-L20:
-    m = *n % 5;
-    if (m == 0) {
-	goto L40;
-    }
-    i__2 = m;
-    for (i__ = 1; i__ <= i__2; ++i__) {
-	dx[i__] = *da * dx[i__];
-/* L30: */
-    }
-    if (*n < 5) {
-	return 0;
-    }
-L40:
-    mp1 = m + 1;
-    i__2 = *n;
-    for (i__ = mp1; i__ <= i__2; i__ += 5) {
-	dx[i__] = *da * dx[i__];
-	dx[i__ + 1] = *da * dx[i__ + 1];
-	dx[i__ + 2] = *da * dx[i__ + 2];
-	dx[i__ + 3] = *da * dx[i__ + 3];
-	dx[i__ + 4] = *da * dx[i__ + 4];
-/* L50: */
+    if (*incx != 1 || *incy != 1) {
+	if (*incx > 0) {
+	    kx = 1;
+	} else {
+	    kx = 1 - (*n - 1) * *incx;
+	}
+	if (*incy > 0) {
+	    ky = 1;
+	} else {
+	    ky = 1 - (*n - 1) * *incy;
+	}
+	jx = kx;
+	jy = ky;
     }
-    return 0;
-} /* dscal_ */
-
-/* Subroutine */ int dswap_(integer *n, doublereal *dx, integer *incx,
-	doublereal *dy, integer *incy)
-{
-    /* System generated locals */
-    integer i__1;
-
-    /* Local variables */
-    static integer i__, m, ix, iy, mp1;
-    static doublereal dtemp;
-
 
 /*
-       interchanges two vectors.
-       uses unrolled loops for increments equal one.
-       jack dongarra, linpack, 3/11/78.
-       modified 12/3/93, array(1) declarations changed to array(*)
+       Start the operations. In this version the elements of A are
+       accessed sequentially with one pass through the triangular part
+       of A.
 */
 
+    if (lsame_(uplo, "U")) {
 
-    /* Parameter adjustments */
-    --dy;
-    --dx;
-
-    /* Function Body */
-    if (*n <= 0) {
-	return 0;
-    }
-    if ((*incx == 1 && *incy == 1)) {
-	goto L20;
-    }
-
-/*
-         code for unequal increments or equal increments not equal
-           to 1
-*/
+/*        Form  A  when A is stored in the upper triangle. */
 
-    ix = 1;
-    iy = 1;
-    if (*incx < 0) {
-	ix = (-(*n) + 1) * *incx + 1;
-    }
-    if (*incy < 0) {
-	iy = (-(*n) + 1) * *incy + 1;
-    }
-    i__1 = *n;
-    for (i__ = 1; i__ <= i__1; ++i__) {
-	dtemp = dx[ix];
-	dx[ix] = dy[iy];
-	dy[iy] = dtemp;
-	ix += *incx;
-	iy += *incy;
+	if ((*incx == 1 && *incy == 1)) {
+	    i__1 = *n;
+	    for (j = 1; j <= i__1; ++j) {
+		if (x[j] != 0. || y[j] != 0.) {
+		    temp1 = *alpha * y[j];
+		    temp2 = *alpha * x[j];
+		    i__2 = j;
+		    for (i__ = 1; i__ <= i__2; ++i__) {
+			a[i__ + j * a_dim1] = a[i__ + j * a_dim1] + x[i__] *
+				temp1 + y[i__] * temp2;
 /* L10: */
-    }
-    return 0;
-
-/*
-         code for both increments equal to 1
-
+		    }
+		}
+/* L20: */
+	    }
+	} else {
+	    i__1 = *n;
+	    for (j = 1; j <= i__1; ++j) {
+		if (x[jx] != 0. || y[jy] != 0.) {
+		    temp1 = *alpha * y[jy];
+		    temp2 = *alpha * x[jx];
+		    ix = kx;
+		    iy = ky;
+		    i__2 = j;
+		    for (i__ = 1; i__ <= i__2; ++i__) {
+			a[i__ + j * a_dim1] = a[i__ + j * a_dim1] + x[ix] *
+				temp1 + y[iy] * temp2;
+			ix += *incx;
+			iy += *incy;
+/* L30: */
+		    }
+		}
+		jx += *incx;
+		jy += *incy;
+/* L40: */
+	    }
+	}
+    } else {
 
-         clean-up loop
-*/
+/*        Form  A  when A is stored in the lower triangle. */
 
-L20:
-    m = *n % 3;
-    if (m == 0) {
-	goto L40;
-    }
-    i__1 = m;
-    for (i__ = 1; i__ <= i__1; ++i__) {
-	dtemp = dx[i__];
-	dx[i__] = dy[i__];
-	dy[i__] = dtemp;
-/* L30: */
-    }
-    if (*n < 3) {
-	return 0;
-    }
-L40:
-    mp1 = m + 1;
-    i__1 = *n;
-    for (i__ = mp1; i__ <= i__1; i__ += 3) {
-	dtemp = dx[i__];
-	dx[i__] = dy[i__];
-	dy[i__] = dtemp;
-	dtemp = dx[i__ + 1];
-	dx[i__ + 1] = dy[i__ + 1];
-	dy[i__ + 1] = dtemp;
-	dtemp = dx[i__ + 2];
-	dx[i__ + 2] = dy[i__ + 2];
-	dy[i__ + 2] = dtemp;
+	if ((*incx == 1 && *incy == 1)) {
+	    i__1 = *n;
+	    for (j = 1; j <= i__1; ++j) {
+		if (x[j] != 0. || y[j] != 0.) {
+		    temp1 = *alpha * y[j];
+		    temp2 = *alpha * x[j];
+		    i__2 = *n;
+		    for (i__ = j; i__ <= i__2; ++i__) {
+			a[i__ + j * a_dim1] = a[i__ + j * a_dim1] + x[i__] *
+				temp1 + y[i__] * temp2;
 /* L50: */
+		    }
+		}
+/* L60: */
+	    }
+	} else {
+	    i__1 = *n;
+	    for (j = 1; j <= i__1; ++j) {
+		if (x[jx] != 0. || y[jy] != 0.) {
+		    temp1 = *alpha * y[jy];
+		    temp2 = *alpha * x[jx];
+		    ix = jx;
+		    iy = jy;
+		    i__2 = *n;
+		    for (i__ = j; i__ <= i__2; ++i__) {
+			a[i__ + j * a_dim1] = a[i__ + j * a_dim1] + x[ix] *
+				temp1 + y[iy] * temp2;
+			ix += *incx;
+			iy += *incy;
+/* L70: */
+		    }
+		}
+		jx += *incx;
+		jy += *incy;
+/* L80: */
+	    }
+	}
     }
+
     return 0;
-} /* dswap_ */
 
-/* Subroutine */ int dsymv_(char *uplo, integer *n, doublereal *alpha,
-	doublereal *a, integer *lda, doublereal *x, integer *incx, doublereal
-	*beta, doublereal *y, integer *incy)
+/*     End of DSYR2 . */
+
+} /* dsyr2_ */
+
+/* Subroutine */ int dsyr2k_(char *uplo, char *trans, integer *n, integer *k,
+	doublereal *alpha, doublereal *a, integer *lda, doublereal *b,
+	integer *ldb, doublereal *beta, doublereal *c__, integer *ldc)
 {
     /* System generated locals */
-    integer a_dim1, a_offset, i__1, i__2;
+    integer a_dim1, a_offset, b_dim1, b_offset, c_dim1, c_offset, i__1, i__2,
+	    i__3;
 
     /* Local variables */
-    static integer i__, j, ix, iy, jx, jy, kx, ky, info;
+    static integer i__, j, l, info;
     static doublereal temp1, temp2;
     extern logical lsame_(char *, char *);
+    static integer nrowa;
+    static logical upper;
     extern /* Subroutine */ int xerbla_(char *, integer *);
 
 
@@ -1457,90 +1350,128 @@ L40:
     Purpose
     =======
 
-    DSYMV  performs the matrix-vector  operation
+    DSYR2K  performs one of the symmetric rank 2k operations
 
-       y := alpha*A*x + beta*y,
+       C := alpha*A*B' + alpha*B*A' + beta*C,
 
-    where alpha and beta are scalars, x and y are n element vectors and
-    A is an n by n symmetric matrix.
+    or
+
+       C := alpha*A'*B + alpha*B'*A + beta*C,
+
+    where  alpha and beta  are scalars, C is an  n by n  symmetric matrix
+    and  A and B  are  n by k  matrices  in the  first  case  and  k by n
+    matrices in the second case.
 
     Parameters
     ==========
 
     UPLO   - CHARACTER*1.
-             On entry, UPLO specifies whether the upper or lower
-             triangular part of the array A is to be referenced as
+             On  entry,   UPLO  specifies  whether  the  upper  or  lower
+             triangular  part  of the  array  C  is to be  referenced  as
              follows:
 
-                UPLO = 'U' or 'u'   Only the upper triangular part of A
+                UPLO = 'U' or 'u'   Only the  upper triangular part of  C
                                     is to be referenced.
 
-                UPLO = 'L' or 'l'   Only the lower triangular part of A
+                UPLO = 'L' or 'l'   Only the  lower triangular part of  C
                                     is to be referenced.
 
              Unchanged on exit.
 
+    TRANS  - CHARACTER*1.
+             On entry,  TRANS  specifies the operation to be performed as
+             follows:
+
+                TRANS = 'N' or 'n'   C := alpha*A*B' + alpha*B*A' +
+                                          beta*C.
+
+                TRANS = 'T' or 't'   C := alpha*A'*B + alpha*B'*A +
+                                          beta*C.
+
+                TRANS = 'C' or 'c'   C := alpha*A'*B + alpha*B'*A +
+                                          beta*C.
+
+             Unchanged on exit.
+
     N      - INTEGER.
-             On entry, N specifies the order of the matrix A.
-             N must be at least zero.
+             On entry,  N specifies the order of the matrix C.  N must be
+             at least zero.
+             Unchanged on exit.
+
+    K      - INTEGER.
+             On entry with  TRANS = 'N' or 'n',  K  specifies  the number
+             of  columns  of the  matrices  A and B,  and on  entry  with
+             TRANS = 'T' or 't' or 'C' or 'c',  K  specifies  the  number
+             of rows of the matrices  A and B.  K must be at least  zero.
              Unchanged on exit.
 
     ALPHA  - DOUBLE PRECISION.
              On entry, ALPHA specifies the scalar alpha.
              Unchanged on exit.
 
-    A      - DOUBLE PRECISION array of DIMENSION ( LDA, n ).
-             Before entry with  UPLO = 'U' or 'u', the leading n by n
-             upper triangular part of the array A must contain the upper
-             triangular part of the symmetric matrix and the strictly
-             lower triangular part of A is not referenced.
-             Before entry with UPLO = 'L' or 'l', the leading n by n
-             lower triangular part of the array A must contain the lower
-             triangular part of the symmetric matrix and the strictly
-             upper triangular part of A is not referenced.
+    A      - DOUBLE PRECISION array of DIMENSION ( LDA, ka ), where ka is
+             k  when  TRANS = 'N' or 'n',  and is  n  otherwise.
+             Before entry with  TRANS = 'N' or 'n',  the  leading  n by k
+             part of the array  A  must contain the matrix  A,  otherwise
+             the leading  k by n  part of the array  A  must contain  the
+             matrix A.
              Unchanged on exit.
 
     LDA    - INTEGER.
              On entry, LDA specifies the first dimension of A as declared
-             in the calling (sub) program. LDA must be at least
-             max( 1, n ).
+             in  the  calling  (sub)  program.   When  TRANS = 'N' or 'n'
+             then  LDA must be at least  max( 1, n ), otherwise  LDA must
+             be at least  max( 1, k ).
              Unchanged on exit.
 
-    X      - DOUBLE PRECISION array of dimension at least
-             ( 1 + ( n - 1 )*abs( INCX ) ).
-             Before entry, the incremented array X must contain the n
-             element vector x.
+    B      - DOUBLE PRECISION array of DIMENSION ( LDB, kb ), where kb is
+             k  when  TRANS = 'N' or 'n',  and is  n  otherwise.
+             Before entry with  TRANS = 'N' or 'n',  the  leading  n by k
+             part of the array  B  must contain the matrix  B,  otherwise
+             the leading  k by n  part of the array  B  must contain  the
+             matrix B.
              Unchanged on exit.
 
-    INCX   - INTEGER.
-             On entry, INCX specifies the increment for the elements of
-             X. INCX must not be zero.
-             Unchanged on exit.
+    LDB    - INTEGER.
+             On entry, LDB specifies the first dimension of B as declared
+             in  the  calling  (sub)  program.   When  TRANS = 'N' or 'n'
+             then  LDB must be at least  max( 1, n ), otherwise  LDB must
+             be at least  max( 1, k ).
+             Unchanged on exit.
 
     BETA   - DOUBLE PRECISION.
-             On entry, BETA specifies the scalar beta. When BETA is
-             supplied as zero then Y need not be set on input.
+             On entry, BETA specifies the scalar beta.
              Unchanged on exit.
 
-    Y      - DOUBLE PRECISION array of dimension at least
-             ( 1 + ( n - 1 )*abs( INCY ) ).
-             Before entry, the incremented array Y must contain the n
-             element vector y. On exit, Y is overwritten by the updated
-             vector y.
+    C      - DOUBLE PRECISION array of DIMENSION ( LDC, n ).
+             Before entry  with  UPLO = 'U' or 'u',  the leading  n by n
+             upper triangular part of the array C must contain the upper
+             triangular part  of the  symmetric matrix  and the strictly
+             lower triangular part of C is not referenced.  On exit, the
+             upper triangular part of the array  C is overwritten by the
+             upper triangular part of the updated matrix.
+             Before entry  with  UPLO = 'L' or 'l',  the leading  n by n
+             lower triangular part of the array C must contain the lower
+             triangular part  of the  symmetric matrix  and the strictly
+             upper triangular part of C is not referenced.  On exit, the
+             lower triangular part of the array  C is overwritten by the
+             lower triangular part of the updated matrix.
 
-    INCY   - INTEGER.
-             On entry, INCY specifies the increment for the elements of
-             Y. INCY must not be zero.
+    LDC    - INTEGER.
+             On entry, LDC specifies the first dimension of C as declared
+             in  the  calling  (sub)  program.   LDC  must  be  at  least
+             max( 1, n ).
              Unchanged on exit.
 
 
-    Level 2 Blas routine.
+    Level 3 Blas routine.
 
-    -- Written on 22-October-1986.
-       Jack Dongarra, Argonne National Lab.
-       Jeremy Du Croz, Nag Central Office.
-       Sven Hammarling, Nag Central Office.
-       Richard Hanson, Sandia National Labs.
+
+    -- Written on 8-February-1989.
+       Jack Dongarra, Argonne National Laboratory.
+       Iain Duff, AERE Harwell.
+       Jeremy Du Croz, Numerical Algorithms Group Ltd.
+       Sven Hammarling, Numerical Algorithms Group Ltd.
 
 
        Test the input parameters.
@@ -1550,194 +1481,247 @@ L40:
     a_dim1 = *lda;
     a_offset = 1 + a_dim1 * 1;
     a -= a_offset;
-    --x;
-    --y;
+    b_dim1 = *ldb;
+    b_offset = 1 + b_dim1 * 1;
+    b -= b_offset;
+    c_dim1 = *ldc;
+    c_offset = 1 + c_dim1 * 1;
+    c__ -= c_offset;
 
     /* Function Body */
+    if (lsame_(trans, "N")) {
+	nrowa = *n;
+    } else {
+	nrowa = *k;
+    }
+    upper = lsame_(uplo, "U");
+
     info = 0;
-    if ((! lsame_(uplo, "U") && ! lsame_(uplo, "L"))) {
+    if ((! upper && ! lsame_(uplo, "L"))) {
 	info = 1;
-    } else if (*n < 0) {
+    } else if (((! lsame_(trans, "N") && ! lsame_(trans,
+	     "T")) && ! lsame_(trans, "C"))) {
 	info = 2;
-    } else if (*lda < max(1,*n)) {
-	info = 5;
-    } else if (*incx == 0) {
+    } else if (*n < 0) {
+	info = 3;
+    } else if (*k < 0) {
+	info = 4;
+    } else if (*lda < max(1,nrowa)) {
 	info = 7;
-    } else if (*incy == 0) {
-	info = 10;
+    } else if (*ldb < max(1,nrowa)) {
+	info = 9;
+    } else if (*ldc < max(1,*n)) {
+	info = 12;
     }
     if (info != 0) {
-	xerbla_("DSYMV ", &info);
+	xerbla_("DSYR2K", &info);
 	return 0;
     }
 
 /*     Quick return if possible. */
 
-    if (*n == 0 || (*alpha == 0. && *beta == 1.)) {
+    if (*n == 0 || ((*alpha == 0. || *k == 0) && *beta == 1.)) {
 	return 0;
     }
 
-/*     Set up the start points in  X  and  Y. */
-
-    if (*incx > 0) {
-	kx = 1;
-    } else {
-	kx = 1 - (*n - 1) * *incx;
-    }
-    if (*incy > 0) {
-	ky = 1;
-    } else {
-	ky = 1 - (*n - 1) * *incy;
-    }
-
-/*
-       Start the operations. In this version the elements of A are
-       accessed sequentially with one pass through the triangular part
-       of A.
-
-       First form  y := beta*y.
-*/
+/*     And when  alpha.eq.zero. */
 
-    if (*beta != 1.) {
-	if (*incy == 1) {
+    if (*alpha == 0.) {
+	if (upper) {
 	    if (*beta == 0.) {
 		i__1 = *n;
-		for (i__ = 1; i__ <= i__1; ++i__) {
-		    y[i__] = 0.;
+		for (j = 1; j <= i__1; ++j) {
+		    i__2 = j;
+		    for (i__ = 1; i__ <= i__2; ++i__) {
+			c__[i__ + j * c_dim1] = 0.;
 /* L10: */
+		    }
+/* L20: */
 		}
 	    } else {
 		i__1 = *n;
-		for (i__ = 1; i__ <= i__1; ++i__) {
-		    y[i__] = *beta * y[i__];
-/* L20: */
+		for (j = 1; j <= i__1; ++j) {
+		    i__2 = j;
+		    for (i__ = 1; i__ <= i__2; ++i__) {
+			c__[i__ + j * c_dim1] = *beta * c__[i__ + j * c_dim1];
+/* L30: */
+		    }
+/* L40: */
 		}
 	    }
 	} else {
-	    iy = ky;
 	    if (*beta == 0.) {
 		i__1 = *n;
-		for (i__ = 1; i__ <= i__1; ++i__) {
-		    y[iy] = 0.;
-		    iy += *incy;
-/* L30: */
+		for (j = 1; j <= i__1; ++j) {
+		    i__2 = *n;
+		    for (i__ = j; i__ <= i__2; ++i__) {
+			c__[i__ + j * c_dim1] = 0.;
+/* L50: */
+		    }
+/* L60: */
 		}
 	    } else {
 		i__1 = *n;
-		for (i__ = 1; i__ <= i__1; ++i__) {
-		    y[iy] = *beta * y[iy];
-		    iy += *incy;
-/* L40: */
+		for (j = 1; j <= i__1; ++j) {
+		    i__2 = *n;
+		    for (i__ = j; i__ <= i__2; ++i__) {
+			c__[i__ + j * c_dim1] = *beta * c__[i__ + j * c_dim1];
+/* L70: */
+		    }
+/* L80: */
 		}
 	    }
 	}
-    }
-    if (*alpha == 0.) {
 	return 0;
     }
-    if (lsame_(uplo, "U")) {
 
-/*        Form  y  when A is stored in upper triangle. */
+/*     Start the operations. */
 
-	if ((*incx == 1 && *incy == 1)) {
+    if (lsame_(trans, "N")) {
+
+/*        Form  C := alpha*A*B' + alpha*B*A' + C. */
+
+	if (upper) {
 	    i__1 = *n;
 	    for (j = 1; j <= i__1; ++j) {
-		temp1 = *alpha * x[j];
-		temp2 = 0.;
-		i__2 = j - 1;
-		for (i__ = 1; i__ <= i__2; ++i__) {
-		    y[i__] += temp1 * a[i__ + j * a_dim1];
-		    temp2 += a[i__ + j * a_dim1] * x[i__];
-/* L50: */
+		if (*beta == 0.) {
+		    i__2 = j;
+		    for (i__ = 1; i__ <= i__2; ++i__) {
+			c__[i__ + j * c_dim1] = 0.;
+/* L90: */
+		    }
+		} else if (*beta != 1.) {
+		    i__2 = j;
+		    for (i__ = 1; i__ <= i__2; ++i__) {
+			c__[i__ + j * c_dim1] = *beta * c__[i__ + j * c_dim1];
+/* L100: */
+		    }
 		}
-		y[j] = y[j] + temp1 * a[j + j * a_dim1] + *alpha * temp2;
-/* L60: */
+		i__2 = *k;
+		for (l = 1; l <= i__2; ++l) {
+		    if (a[j + l * a_dim1] != 0. || b[j + l * b_dim1] != 0.) {
+			temp1 = *alpha * b[j + l * b_dim1];
+			temp2 = *alpha * a[j + l * a_dim1];
+			i__3 = j;
+			for (i__ = 1; i__ <= i__3; ++i__) {
+			    c__[i__ + j * c_dim1] = c__[i__ + j * c_dim1] + a[
+				    i__ + l * a_dim1] * temp1 + b[i__ + l *
+				    b_dim1] * temp2;
+/* L110: */
+			}
+		    }
+/* L120: */
+		}
+/* L130: */
 	    }
 	} else {
-	    jx = kx;
-	    jy = ky;
 	    i__1 = *n;
 	    for (j = 1; j <= i__1; ++j) {
-		temp1 = *alpha * x[jx];
-		temp2 = 0.;
-		ix = kx;
-		iy = ky;
-		i__2 = j - 1;
-		for (i__ = 1; i__ <= i__2; ++i__) {
-		    y[iy] += temp1 * a[i__ + j * a_dim1];
-		    temp2 += a[i__ + j * a_dim1] * x[ix];
-		    ix += *incx;
-		    iy += *incy;
-/* L70: */
+		if (*beta == 0.) {
+		    i__2 = *n;
+		    for (i__ = j; i__ <= i__2; ++i__) {
+			c__[i__ + j * c_dim1] = 0.;
+/* L140: */
+		    }
+		} else if (*beta != 1.) {
+		    i__2 = *n;
+		    for (i__ = j; i__ <= i__2; ++i__) {
+			c__[i__ + j * c_dim1] = *beta * c__[i__ + j * c_dim1];
+/* L150: */
+		    }
 		}
-		y[jy] = y[jy] + temp1 * a[j + j * a_dim1] + *alpha * temp2;
-		jx += *incx;
-		jy += *incy;
-/* L80: */
+		i__2 = *k;
+		for (l = 1; l <= i__2; ++l) {
+		    if (a[j + l * a_dim1] != 0. || b[j + l * b_dim1] != 0.) {
+			temp1 = *alpha * b[j + l * b_dim1];
+			temp2 = *alpha * a[j + l * a_dim1];
+			i__3 = *n;
+			for (i__ = j; i__ <= i__3; ++i__) {
+			    c__[i__ + j * c_dim1] = c__[i__ + j * c_dim1] + a[
+				    i__ + l * a_dim1] * temp1 + b[i__ + l *
+				    b_dim1] * temp2;
+/* L160: */
+			}
+		    }
+/* L170: */
+		}
+/* L180: */
 	    }
 	}
     } else {
 
-/*        Form  y  when A is stored in lower triangle. */
+/*        Form  C := alpha*A'*B + alpha*B'*A + C. */
 
-	if ((*incx == 1 && *incy == 1)) {
+	if (upper) {
 	    i__1 = *n;
 	    for (j = 1; j <= i__1; ++j) {
-		temp1 = *alpha * x[j];
-		temp2 = 0.;
-		y[j] += temp1 * a[j + j * a_dim1];
-		i__2 = *n;
-		for (i__ = j + 1; i__ <= i__2; ++i__) {
-		    y[i__] += temp1 * a[i__ + j * a_dim1];
-		    temp2 += a[i__ + j * a_dim1] * x[i__];
-/* L90: */
+		i__2 = j;
+		for (i__ = 1; i__ <= i__2; ++i__) {
+		    temp1 = 0.;
+		    temp2 = 0.;
+		    i__3 = *k;
+		    for (l = 1; l <= i__3; ++l) {
+			temp1 += a[l + i__ * a_dim1] * b[l + j * b_dim1];
+			temp2 += b[l + i__ * b_dim1] * a[l + j * a_dim1];
+/* L190: */
+		    }
+		    if (*beta == 0.) {
+			c__[i__ + j * c_dim1] = *alpha * temp1 + *alpha *
+				temp2;
+		    } else {
+			c__[i__ + j * c_dim1] = *beta * c__[i__ + j * c_dim1]
+				+ *alpha * temp1 + *alpha * temp2;
+		    }
+/* L200: */
 		}
-		y[j] += *alpha * temp2;
-/* L100: */
+/* L210: */
 	    }
 	} else {
-	    jx = kx;
-	    jy = ky;
 	    i__1 = *n;
 	    for (j = 1; j <= i__1; ++j) {
-		temp1 = *alpha * x[jx];
-		temp2 = 0.;
-		y[jy] += temp1 * a[j + j * a_dim1];
-		ix = jx;
-		iy = jy;
 		i__2 = *n;
-		for (i__ = j + 1; i__ <= i__2; ++i__) {
-		    ix += *incx;
-		    iy += *incy;
-		    y[iy] += temp1 * a[i__ + j * a_dim1];
-		    temp2 += a[i__ + j * a_dim1] * x[ix];
-/* L110: */
+		for (i__ = j; i__ <= i__2; ++i__) {
+		    temp1 = 0.;
+		    temp2 = 0.;
+		    i__3 = *k;
+		    for (l = 1; l <= i__3; ++l) {
+			temp1 += a[l + i__ * a_dim1] * b[l + j * b_dim1];
+			temp2 += b[l + i__ * b_dim1] * a[l + j * a_dim1];
+/* L220: */
+		    }
+		    if (*beta == 0.) {
+			c__[i__ + j * c_dim1] = *alpha * temp1 + *alpha *
+				temp2;
+		    } else {
+			c__[i__ + j * c_dim1] = *beta * c__[i__ + j * c_dim1]
+				+ *alpha * temp1 + *alpha * temp2;
+		    }
+/* L230: */
 		}
-		y[jy] += *alpha * temp2;
-		jx += *incx;
-		jy += *incy;
-/* L120: */
+/* L240: */
 	    }
 	}
     }
 
     return 0;
 
-/*     End of DSYMV . */
+/*     End of DSYR2K. */
 
-} /* dsymv_ */
+} /* dsyr2k_ */
 
-/* Subroutine */ int dsyr2_(char *uplo, integer *n, doublereal *alpha,
-	doublereal *x, integer *incx, doublereal *y, integer *incy,
-	doublereal *a, integer *lda)
+/* Subroutine */ int dsyrk_(char *uplo, char *trans, integer *n, integer *k,
+	doublereal *alpha, doublereal *a, integer *lda, doublereal *beta,
+	doublereal *c__, integer *ldc)
 {
     /* System generated locals */
-    integer a_dim1, a_offset, i__1, i__2;
+    integer a_dim1, a_offset, c_dim1, c_offset, i__1, i__2, i__3;
 
     /* Local variables */
-    static integer i__, j, ix, iy, jx, jy, kx, ky, info;
-    static doublereal temp1, temp2;
+    static integer i__, j, l, info;
+    static doublereal temp;
     extern logical lsame_(char *, char *);
+    static integer nrowa;
+    static logical upper;
     extern /* Subroutine */ int xerbla_(char *, integer *);
 
 
@@ -1745,378 +1729,459 @@ L40:
     Purpose
     =======
 
-    DSYR2  performs the symmetric rank 2 operation
+    DSYRK  performs one of the symmetric rank k operations
 
-       A := alpha*x*y' + alpha*y*x' + A,
+       C := alpha*A*A' + beta*C,
 
-    where alpha is a scalar, x and y are n element vectors and A is an n
-    by n symmetric matrix.
+    or
+
+       C := alpha*A'*A + beta*C,
+
+    where  alpha and beta  are scalars, C is an  n by n  symmetric matrix
+    and  A  is an  n by k  matrix in the first case and a  k by n  matrix
+    in the second case.
 
     Parameters
     ==========
 
     UPLO   - CHARACTER*1.
-             On entry, UPLO specifies whether the upper or lower
-             triangular part of the array A is to be referenced as
+             On  entry,   UPLO  specifies  whether  the  upper  or  lower
+             triangular  part  of the  array  C  is to be  referenced  as
              follows:
 
-                UPLO = 'U' or 'u'   Only the upper triangular part of A
+                UPLO = 'U' or 'u'   Only the  upper triangular part of  C
                                     is to be referenced.
 
-                UPLO = 'L' or 'l'   Only the lower triangular part of A
+                UPLO = 'L' or 'l'   Only the  lower triangular part of  C
                                     is to be referenced.
 
              Unchanged on exit.
 
+    TRANS  - CHARACTER*1.
+             On entry,  TRANS  specifies the operation to be performed as
+             follows:
+
+                TRANS = 'N' or 'n'   C := alpha*A*A' + beta*C.
+
+                TRANS = 'T' or 't'   C := alpha*A'*A + beta*C.
+
+                TRANS = 'C' or 'c'   C := alpha*A'*A + beta*C.
+
+             Unchanged on exit.
+
     N      - INTEGER.
-             On entry, N specifies the order of the matrix A.
-             N must be at least zero.
+             On entry,  N specifies the order of the matrix C.  N must be
+             at least zero.
              Unchanged on exit.
 
-    ALPHA  - DOUBLE PRECISION.
-             On entry, ALPHA specifies the scalar alpha.
+    K      - INTEGER.
+             On entry with  TRANS = 'N' or 'n',  K  specifies  the number
+             of  columns   of  the   matrix   A,   and  on   entry   with
+             TRANS = 'T' or 't' or 'C' or 'c',  K  specifies  the  number
+             of rows of the matrix  A.  K must be at least zero.
              Unchanged on exit.
 
-    X      - DOUBLE PRECISION array of dimension at least
-             ( 1 + ( n - 1 )*abs( INCX ) ).
-             Before entry, the incremented array X must contain the n
-             element vector x.
+    ALPHA  - DOUBLE PRECISION.
+             On entry, ALPHA specifies the scalar alpha.
              Unchanged on exit.
 
-    INCX   - INTEGER.
-             On entry, INCX specifies the increment for the elements of
-             X. INCX must not be zero.
+    A      - DOUBLE PRECISION array of DIMENSION ( LDA, ka ), where ka is
+             k  when  TRANS = 'N' or 'n',  and is  n  otherwise.
+             Before entry with  TRANS = 'N' or 'n',  the  leading  n by k
+             part of the array  A  must contain the matrix  A,  otherwise
+             the leading  k by n  part of the array  A  must contain  the
+             matrix A.
              Unchanged on exit.
 
-    Y      - DOUBLE PRECISION array of dimension at least
-             ( 1 + ( n - 1 )*abs( INCY ) ).
-             Before entry, the incremented array Y must contain the n
-             element vector y.
+    LDA    - INTEGER.
+             On entry, LDA specifies the first dimension of A as declared
+             in  the  calling  (sub)  program.   When  TRANS = 'N' or 'n'
+             then  LDA must be at least  max( 1, n ), otherwise  LDA must
+             be at least  max( 1, k ).
              Unchanged on exit.
 
-    INCY   - INTEGER.
-             On entry, INCY specifies the increment for the elements of
-             Y. INCY must not be zero.
+    BETA   - DOUBLE PRECISION.
+             On entry, BETA specifies the scalar beta.
              Unchanged on exit.
 
-    A      - DOUBLE PRECISION array of DIMENSION ( LDA, n ).
-             Before entry with  UPLO = 'U' or 'u', the leading n by n
-             upper triangular part of the array A must contain the upper
-             triangular part of the symmetric matrix and the strictly
-             lower triangular part of A is not referenced. On exit, the
-             upper triangular part of the array A is overwritten by the
+    C      - DOUBLE PRECISION array of DIMENSION ( LDC, n ).
+             Before entry  with  UPLO = 'U' or 'u',  the leading  n by n
+             upper triangular part of the array C must contain the upper
+             triangular part  of the  symmetric matrix  and the strictly
+             lower triangular part of C is not referenced.  On exit, the
+             upper triangular part of the array  C is overwritten by the
              upper triangular part of the updated matrix.
-             Before entry with UPLO = 'L' or 'l', the leading n by n
-             lower triangular part of the array A must contain the lower
-             triangular part of the symmetric matrix and the strictly
-             upper triangular part of A is not referenced. On exit, the
-             lower triangular part of the array A is overwritten by the
+             Before entry  with  UPLO = 'L' or 'l',  the leading  n by n
+             lower triangular part of the array C must contain the lower
+             triangular part  of the  symmetric matrix  and the strictly
+             upper triangular part of C is not referenced.  On exit, the
+             lower triangular part of the array  C is overwritten by the
              lower triangular part of the updated matrix.
 
-    LDA    - INTEGER.
-             On entry, LDA specifies the first dimension of A as declared
-             in the calling (sub) program. LDA must be at least
+    LDC    - INTEGER.
+             On entry, LDC specifies the first dimension of C as declared
+             in  the  calling  (sub)  program.   LDC  must  be  at  least
              max( 1, n ).
              Unchanged on exit.
 
 
-    Level 2 Blas routine.
+    Level 3 Blas routine.
 
-    -- Written on 22-October-1986.
-       Jack Dongarra, Argonne National Lab.
-       Jeremy Du Croz, Nag Central Office.
-       Sven Hammarling, Nag Central Office.
-       Richard Hanson, Sandia National Labs.
+    -- Written on 8-February-1989.
+       Jack Dongarra, Argonne National Laboratory.
+       Iain Duff, AERE Harwell.
+       Jeremy Du Croz, Numerical Algorithms Group Ltd.
+       Sven Hammarling, Numerical Algorithms Group Ltd.
 
 
        Test the input parameters.
 */
 
     /* Parameter adjustments */
-    --x;
-    --y;
     a_dim1 = *lda;
     a_offset = 1 + a_dim1 * 1;
     a -= a_offset;
+    c_dim1 = *ldc;
+    c_offset = 1 + c_dim1 * 1;
+    c__ -= c_offset;
 
     /* Function Body */
+    if (lsame_(trans, "N")) {
+	nrowa = *n;
+    } else {
+	nrowa = *k;
+    }
+    upper = lsame_(uplo, "U");
+
     info = 0;
-    if ((! lsame_(uplo, "U") && ! lsame_(uplo, "L"))) {
+    if ((! upper && ! lsame_(uplo, "L"))) {
 	info = 1;
-    } else if (*n < 0) {
+    } else if (((! lsame_(trans, "N") && ! lsame_(trans,
+	     "T")) && ! lsame_(trans, "C"))) {
 	info = 2;
-    } else if (*incx == 0) {
-	info = 5;
-    } else if (*incy == 0) {
+    } else if (*n < 0) {
+	info = 3;
+    } else if (*k < 0) {
+	info = 4;
+    } else if (*lda < max(1,nrowa)) {
 	info = 7;
-    } else if (*lda < max(1,*n)) {
-	info = 9;
+    } else if (*ldc < max(1,*n)) {
+	info = 10;
     }
     if (info != 0) {
-	xerbla_("DSYR2 ", &info);
+	xerbla_("DSYRK ", &info);
 	return 0;
     }
 
 /*     Quick return if possible. */
 
-    if (*n == 0 || *alpha == 0.) {
+    if (*n == 0 || ((*alpha == 0. || *k == 0) && *beta == 1.)) {
 	return 0;
     }
 
-/*
-       Set up the start points in X and Y if the increments are not both
-       unity.
-*/
+/*     And when  alpha.eq.zero. */
 
-    if (*incx != 1 || *incy != 1) {
-	if (*incx > 0) {
-	    kx = 1;
-	} else {
-	    kx = 1 - (*n - 1) * *incx;
-	}
-	if (*incy > 0) {
-	    ky = 1;
+    if (*alpha == 0.) {
+	if (upper) {
+	    if (*beta == 0.) {
+		i__1 = *n;
+		for (j = 1; j <= i__1; ++j) {
+		    i__2 = j;
+		    for (i__ = 1; i__ <= i__2; ++i__) {
+			c__[i__ + j * c_dim1] = 0.;
+/* L10: */
+		    }
+/* L20: */
+		}
+	    } else {
+		i__1 = *n;
+		for (j = 1; j <= i__1; ++j) {
+		    i__2 = j;
+		    for (i__ = 1; i__ <= i__2; ++i__) {
+			c__[i__ + j * c_dim1] = *beta * c__[i__ + j * c_dim1];
+/* L30: */
+		    }
+/* L40: */
+		}
+	    }
 	} else {
-	    ky = 1 - (*n - 1) * *incy;
+	    if (*beta == 0.) {
+		i__1 = *n;
+		for (j = 1; j <= i__1; ++j) {
+		    i__2 = *n;
+		    for (i__ = j; i__ <= i__2; ++i__) {
+			c__[i__ + j * c_dim1] = 0.;
+/* L50: */
+		    }
+/* L60: */
+		}
+	    } else {
+		i__1 = *n;
+		for (j = 1; j <= i__1; ++j) {
+		    i__2 = *n;
+		    for (i__ = j; i__ <= i__2; ++i__) {
+			c__[i__ + j * c_dim1] = *beta * c__[i__ + j * c_dim1];
+/* L70: */
+		    }
+/* L80: */
+		}
+	    }
 	}
-	jx = kx;
-	jy = ky;
+	return 0;
     }
 
-/*
-       Start the operations. In this version the elements of A are
-       accessed sequentially with one pass through the triangular part
-       of A.
-*/
+/*     Start the operations. */
 
-    if (lsame_(uplo, "U")) {
+    if (lsame_(trans, "N")) {
 
-/*        Form  A  when A is stored in the upper triangle. */
+/*        Form  C := alpha*A*A' + beta*C. */
 
-	if ((*incx == 1 && *incy == 1)) {
+	if (upper) {
 	    i__1 = *n;
 	    for (j = 1; j <= i__1; ++j) {
-		if (x[j] != 0. || y[j] != 0.) {
-		    temp1 = *alpha * y[j];
-		    temp2 = *alpha * x[j];
+		if (*beta == 0.) {
 		    i__2 = j;
 		    for (i__ = 1; i__ <= i__2; ++i__) {
-			a[i__ + j * a_dim1] = a[i__ + j * a_dim1] + x[i__] *
-				temp1 + y[i__] * temp2;
-/* L10: */
+			c__[i__ + j * c_dim1] = 0.;
+/* L90: */
+		    }
+		} else if (*beta != 1.) {
+		    i__2 = j;
+		    for (i__ = 1; i__ <= i__2; ++i__) {
+			c__[i__ + j * c_dim1] = *beta * c__[i__ + j * c_dim1];
+/* L100: */
 		    }
 		}
-/* L20: */
+		i__2 = *k;
+		for (l = 1; l <= i__2; ++l) {
+		    if (a[j + l * a_dim1] != 0.) {
+			temp = *alpha * a[j + l * a_dim1];
+			i__3 = j;
+			for (i__ = 1; i__ <= i__3; ++i__) {
+			    c__[i__ + j * c_dim1] += temp * a[i__ + l *
+				    a_dim1];
+/* L110: */
+			}
+		    }
+/* L120: */
+		}
+/* L130: */
 	    }
 	} else {
 	    i__1 = *n;
 	    for (j = 1; j <= i__1; ++j) {
-		if (x[jx] != 0. || y[jy] != 0.) {
-		    temp1 = *alpha * y[jy];
-		    temp2 = *alpha * x[jx];
-		    ix = kx;
-		    iy = ky;
-		    i__2 = j;
-		    for (i__ = 1; i__ <= i__2; ++i__) {
-			a[i__ + j * a_dim1] = a[i__ + j * a_dim1] + x[ix] *
-				temp1 + y[iy] * temp2;
-			ix += *incx;
-			iy += *incy;
-/* L30: */
+		if (*beta == 0.) {
+		    i__2 = *n;
+		    for (i__ = j; i__ <= i__2; ++i__) {
+			c__[i__ + j * c_dim1] = 0.;
+/* L140: */
+		    }
+		} else if (*beta != 1.) {
+		    i__2 = *n;
+		    for (i__ = j; i__ <= i__2; ++i__) {
+			c__[i__ + j * c_dim1] = *beta * c__[i__ + j * c_dim1];
+/* L150: */
 		    }
 		}
-		jx += *incx;
-		jy += *incy;
-/* L40: */
+		i__2 = *k;
+		for (l = 1; l <= i__2; ++l) {
+		    if (a[j + l * a_dim1] != 0.) {
+			temp = *alpha * a[j + l * a_dim1];
+			i__3 = *n;
+			for (i__ = j; i__ <= i__3; ++i__) {
+			    c__[i__ + j * c_dim1] += temp * a[i__ + l *
+				    a_dim1];
+/* L160: */
+			}
+		    }
+/* L170: */
+		}
+/* L180: */
 	    }
 	}
     } else {
 
-/*        Form  A  when A is stored in the lower triangle. */
+/*        Form  C := alpha*A'*A + beta*C. */
 
-	if ((*incx == 1 && *incy == 1)) {
+	if (upper) {
 	    i__1 = *n;
 	    for (j = 1; j <= i__1; ++j) {
-		if (x[j] != 0. || y[j] != 0.) {
-		    temp1 = *alpha * y[j];
-		    temp2 = *alpha * x[j];
-		    i__2 = *n;
-		    for (i__ = j; i__ <= i__2; ++i__) {
-			a[i__ + j * a_dim1] = a[i__ + j * a_dim1] + x[i__] *
-				temp1 + y[i__] * temp2;
-/* L50: */
+		i__2 = j;
+		for (i__ = 1; i__ <= i__2; ++i__) {
+		    temp = 0.;
+		    i__3 = *k;
+		    for (l = 1; l <= i__3; ++l) {
+			temp += a[l + i__ * a_dim1] * a[l + j * a_dim1];
+/* L190: */
+		    }
+		    if (*beta == 0.) {
+			c__[i__ + j * c_dim1] = *alpha * temp;
+		    } else {
+			c__[i__ + j * c_dim1] = *alpha * temp + *beta * c__[
+				i__ + j * c_dim1];
 		    }
+/* L200: */
 		}
-/* L60: */
+/* L210: */
 	    }
 	} else {
 	    i__1 = *n;
 	    for (j = 1; j <= i__1; ++j) {
-		if (x[jx] != 0. || y[jy] != 0.) {
-		    temp1 = *alpha * y[jy];
-		    temp2 = *alpha * x[jx];
-		    ix = jx;
-		    iy = jy;
-		    i__2 = *n;
-		    for (i__ = j; i__ <= i__2; ++i__) {
-			a[i__ + j * a_dim1] = a[i__ + j * a_dim1] + x[ix] *
-				temp1 + y[iy] * temp2;
-			ix += *incx;
-			iy += *incy;
-/* L70: */
+		i__2 = *n;
+		for (i__ = j; i__ <= i__2; ++i__) {
+		    temp = 0.;
+		    i__3 = *k;
+		    for (l = 1; l <= i__3; ++l) {
+			temp += a[l + i__ * a_dim1] * a[l + j * a_dim1];
+/* L220: */
+		    }
+		    if (*beta == 0.) {
+			c__[i__ + j * c_dim1] = *alpha * temp;
+		    } else {
+			c__[i__ + j * c_dim1] = *alpha * temp + *beta * c__[
+				i__ + j * c_dim1];
 		    }
+/* L230: */
 		}
-		jx += *incx;
-		jy += *incy;
-/* L80: */
+/* L240: */
 	    }
 	}
     }
 
     return 0;
 
-/*     End of DSYR2 . */
+/*     End of DSYRK . */
 
-} /* dsyr2_ */
+} /* dsyrk_ */
 
-/* Subroutine */ int dsyr2k_(char *uplo, char *trans, integer *n, integer *k,
-	doublereal *alpha, doublereal *a, integer *lda, doublereal *b,
-	integer *ldb, doublereal *beta, doublereal *c__, integer *ldc)
+/* Subroutine */ int dtrmm_(char *side, char *uplo, char *transa, char *diag,
+	integer *m, integer *n, doublereal *alpha, doublereal *a, integer *
+	lda, doublereal *b, integer *ldb)
 {
     /* System generated locals */
-    integer a_dim1, a_offset, b_dim1, b_offset, c_dim1, c_offset, i__1, i__2,
-	    i__3;
+    integer a_dim1, a_offset, b_dim1, b_offset, i__1, i__2, i__3;
 
     /* Local variables */
-    static integer i__, j, l, info;
-    static doublereal temp1, temp2;
+    static integer i__, j, k, info;
+    static doublereal temp;
+    static logical lside;
     extern logical lsame_(char *, char *);
     static integer nrowa;
     static logical upper;
     extern /* Subroutine */ int xerbla_(char *, integer *);
+    static logical nounit;
 
 
 /*
     Purpose
     =======
 
-    DSYR2K  performs one of the symmetric rank 2k operations
-
-       C := alpha*A*B' + alpha*B*A' + beta*C,
+    DTRMM  performs one of the matrix-matrix operations
 
-    or
+       B := alpha*op( A )*B,   or   B := alpha*B*op( A ),
 
-       C := alpha*A'*B + alpha*B'*A + beta*C,
+    where  alpha  is a scalar,  B  is an m by n matrix,  A  is a unit, or
+    non-unit,  upper or lower triangular matrix  and  op( A )  is one  of
 
-    where  alpha and beta  are scalars, C is an  n by n  symmetric matrix
-    and  A and B  are  n by k  matrices  in the  first  case  and  k by n
-    matrices in the second case.
+       op( A ) = A   or   op( A ) = A'.
 
     Parameters
     ==========
 
+    SIDE   - CHARACTER*1.
+             On entry,  SIDE specifies whether  op( A ) multiplies B from
+             the left or right as follows:
+
+                SIDE = 'L' or 'l'   B := alpha*op( A )*B.
+
+                SIDE = 'R' or 'r'   B := alpha*B*op( A ).
+
+             Unchanged on exit.
+
     UPLO   - CHARACTER*1.
-             On  entry,   UPLO  specifies  whether  the  upper  or  lower
-             triangular  part  of the  array  C  is to be  referenced  as
-             follows:
+             On entry, UPLO specifies whether the matrix A is an upper or
+             lower triangular matrix as follows:
 
-                UPLO = 'U' or 'u'   Only the  upper triangular part of  C
-                                    is to be referenced.
+                UPLO = 'U' or 'u'   A is an upper triangular matrix.
 
-                UPLO = 'L' or 'l'   Only the  lower triangular part of  C
-                                    is to be referenced.
+                UPLO = 'L' or 'l'   A is a lower triangular matrix.
 
              Unchanged on exit.
 
-    TRANS  - CHARACTER*1.
-             On entry,  TRANS  specifies the operation to be performed as
-             follows:
+    TRANSA - CHARACTER*1.
+             On entry, TRANSA specifies the form of op( A ) to be used in
+             the matrix multiplication as follows:
 
-                TRANS = 'N' or 'n'   C := alpha*A*B' + alpha*B*A' +
-                                          beta*C.
+                TRANSA = 'N' or 'n'   op( A ) = A.
 
-                TRANS = 'T' or 't'   C := alpha*A'*B + alpha*B'*A +
-                                          beta*C.
+                TRANSA = 'T' or 't'   op( A ) = A'.
 
-                TRANS = 'C' or 'c'   C := alpha*A'*B + alpha*B'*A +
-                                          beta*C.
+                TRANSA = 'C' or 'c'   op( A ) = A'.
 
              Unchanged on exit.
 
-    N      - INTEGER.
-             On entry,  N specifies the order of the matrix C.  N must be
-             at least zero.
-             Unchanged on exit.
+    DIAG   - CHARACTER*1.
+             On entry, DIAG specifies whether or not A is unit triangular
+             as follows:
+
+                DIAG = 'U' or 'u'   A is assumed to be unit triangular.
+
+                DIAG = 'N' or 'n'   A is not assumed to be unit
+                                    triangular.
 
-    K      - INTEGER.
-             On entry with  TRANS = 'N' or 'n',  K  specifies  the number
-             of  columns  of the  matrices  A and B,  and on  entry  with
-             TRANS = 'T' or 't' or 'C' or 'c',  K  specifies  the  number
-             of rows of the matrices  A and B.  K must be at least  zero.
              Unchanged on exit.
 
-    ALPHA  - DOUBLE PRECISION.
-             On entry, ALPHA specifies the scalar alpha.
+    M      - INTEGER.
+             On entry, M specifies the number of rows of B. M must be at
+             least zero.
              Unchanged on exit.
 
-    A      - DOUBLE PRECISION array of DIMENSION ( LDA, ka ), where ka is
-             k  when  TRANS = 'N' or 'n',  and is  n  otherwise.
-             Before entry with  TRANS = 'N' or 'n',  the  leading  n by k
-             part of the array  A  must contain the matrix  A,  otherwise
-             the leading  k by n  part of the array  A  must contain  the
-             matrix A.
-             Unchanged on exit.
-
-    LDA    - INTEGER.
-             On entry, LDA specifies the first dimension of A as declared
-             in  the  calling  (sub)  program.   When  TRANS = 'N' or 'n'
-             then  LDA must be at least  max( 1, n ), otherwise  LDA must
-             be at least  max( 1, k ).
+    N      - INTEGER.
+             On entry, N specifies the number of columns of B.  N must be
+             at least zero.
              Unchanged on exit.
 
-    B      - DOUBLE PRECISION array of DIMENSION ( LDB, kb ), where kb is
-             k  when  TRANS = 'N' or 'n',  and is  n  otherwise.
-             Before entry with  TRANS = 'N' or 'n',  the  leading  n by k
-             part of the array  B  must contain the matrix  B,  otherwise
-             the leading  k by n  part of the array  B  must contain  the
-             matrix B.
+    ALPHA  - DOUBLE PRECISION.
+             On entry,  ALPHA specifies the scalar  alpha. When  alpha is
+             zero then  A is not referenced and  B need not be set before
+             entry.
              Unchanged on exit.
 
-    LDB    - INTEGER.
-             On entry, LDB specifies the first dimension of B as declared
-             in  the  calling  (sub)  program.   When  TRANS = 'N' or 'n'
-             then  LDB must be at least  max( 1, n ), otherwise  LDB must
-             be at least  max( 1, k ).
+    A      - DOUBLE PRECISION array of DIMENSION ( LDA, k ), where k is m
+             when  SIDE = 'L' or 'l'  and is  n  when  SIDE = 'R' or 'r'.
+             Before entry  with  UPLO = 'U' or 'u',  the  leading  k by k
+             upper triangular part of the array  A must contain the upper
+             triangular matrix  and the strictly lower triangular part of
+             A is not referenced.
+             Before entry  with  UPLO = 'L' or 'l',  the  leading  k by k
+             lower triangular part of the array  A must contain the lower
+             triangular matrix  and the strictly upper triangular part of
+             A is not referenced.
+             Note that when  DIAG = 'U' or 'u',  the diagonal elements of
+             A  are not referenced either,  but are assumed to be  unity.
              Unchanged on exit.
 
-    BETA   - DOUBLE PRECISION.
-             On entry, BETA specifies the scalar beta.
+    LDA    - INTEGER.
+             On entry, LDA specifies the first dimension of A as declared
+             in the calling (sub) program.  When  SIDE = 'L' or 'l'  then
+             LDA  must be at least  max( 1, m ),  when  SIDE = 'R' or 'r'
+             then LDA must be at least max( 1, n ).
              Unchanged on exit.
 
-    C      - DOUBLE PRECISION array of DIMENSION ( LDC, n ).
-             Before entry  with  UPLO = 'U' or 'u',  the leading  n by n
-             upper triangular part of the array C must contain the upper
-             triangular part  of the  symmetric matrix  and the strictly
-             lower triangular part of C is not referenced.  On exit, the
-             upper triangular part of the array  C is overwritten by the
-             upper triangular part of the updated matrix.
-             Before entry  with  UPLO = 'L' or 'l',  the leading  n by n
-             lower triangular part of the array C must contain the lower
-             triangular part  of the  symmetric matrix  and the strictly
-             upper triangular part of C is not referenced.  On exit, the
-             lower triangular part of the array  C is overwritten by the
-             lower triangular part of the updated matrix.
+    B      - DOUBLE PRECISION array of DIMENSION ( LDB, n ).
+             Before entry,  the leading  m by n part of the array  B must
+             contain the matrix  B,  and  on exit  is overwritten  by the
+             transformed matrix.
 
-    LDC    - INTEGER.
-             On entry, LDC specifies the first dimension of C as declared
-             in  the  calling  (sub)  program.   LDC  must  be  at  least
-             max( 1, n ).
+    LDB    - INTEGER.
+             On entry, LDB specifies the first dimension of B as declared
+             in  the  calling  (sub)  program.   LDB  must  be  at  least
+             max( 1, m ).
              Unchanged on exit.
 
 
     Level 3 Blas routine.
 
-
     -- Written on 8-February-1989.
        Jack Dongarra, Argonne National Laboratory.
        Iain Duff, AERE Harwell.
@@ -2134,354 +2199,391 @@ L40:
     b_dim1 = *ldb;
     b_offset = 1 + b_dim1 * 1;
     b -= b_offset;
-    c_dim1 = *ldc;
-    c_offset = 1 + c_dim1 * 1;
-    c__ -= c_offset;
 
     /* Function Body */
-    if (lsame_(trans, "N")) {
-	nrowa = *n;
+    lside = lsame_(side, "L");
+    if (lside) {
+	nrowa = *m;
     } else {
-	nrowa = *k;
+	nrowa = *n;
     }
+    nounit = lsame_(diag, "N");
     upper = lsame_(uplo, "U");
 
     info = 0;
-    if ((! upper && ! lsame_(uplo, "L"))) {
+    if ((! lside && ! lsame_(side, "R"))) {
 	info = 1;
-    } else if (((! lsame_(trans, "N") && ! lsame_(trans,
-	     "T")) && ! lsame_(trans, "C"))) {
+    } else if ((! upper && ! lsame_(uplo, "L"))) {
 	info = 2;
-    } else if (*n < 0) {
+    } else if (((! lsame_(transa, "N") && ! lsame_(
+	    transa, "T")) && ! lsame_(transa, "C"))) {
 	info = 3;
-    } else if (*k < 0) {
+    } else if ((! lsame_(diag, "U") && ! lsame_(diag,
+	    "N"))) {
 	info = 4;
+    } else if (*m < 0) {
+	info = 5;
+    } else if (*n < 0) {
+	info = 6;
     } else if (*lda < max(1,nrowa)) {
-	info = 7;
-    } else if (*ldb < max(1,nrowa)) {
 	info = 9;
-    } else if (*ldc < max(1,*n)) {
-	info = 12;
+    } else if (*ldb < max(1,*m)) {
+	info = 11;
     }
     if (info != 0) {
-	xerbla_("DSYR2K", &info);
+	xerbla_("DTRMM ", &info);
 	return 0;
     }
 
 /*     Quick return if possible. */
 
-    if (*n == 0 || ((*alpha == 0. || *k == 0) && *beta == 1.)) {
+    if (*n == 0) {
 	return 0;
     }
 
 /*     And when  alpha.eq.zero. */
 
     if (*alpha == 0.) {
-	if (upper) {
-	    if (*beta == 0.) {
-		i__1 = *n;
-		for (j = 1; j <= i__1; ++j) {
-		    i__2 = j;
-		    for (i__ = 1; i__ <= i__2; ++i__) {
-			c__[i__ + j * c_dim1] = 0.;
+	i__1 = *n;
+	for (j = 1; j <= i__1; ++j) {
+	    i__2 = *m;
+	    for (i__ = 1; i__ <= i__2; ++i__) {
+		b[i__ + j * b_dim1] = 0.;
 /* L10: */
-		    }
+	    }
 /* L20: */
-		}
-	    } else {
+	}
+	return 0;
+    }
+
+/*     Start the operations. */
+
+    if (lside) {
+	if (lsame_(transa, "N")) {
+
+/*           Form  B := alpha*A*B. */
+
+	    if (upper) {
 		i__1 = *n;
 		for (j = 1; j <= i__1; ++j) {
-		    i__2 = j;
-		    for (i__ = 1; i__ <= i__2; ++i__) {
-			c__[i__ + j * c_dim1] = *beta * c__[i__ + j * c_dim1];
+		    i__2 = *m;
+		    for (k = 1; k <= i__2; ++k) {
+			if (b[k + j * b_dim1] != 0.) {
+			    temp = *alpha * b[k + j * b_dim1];
+			    i__3 = k - 1;
+			    for (i__ = 1; i__ <= i__3; ++i__) {
+				b[i__ + j * b_dim1] += temp * a[i__ + k *
+					a_dim1];
 /* L30: */
-		    }
+			    }
+			    if (nounit) {
+				temp *= a[k + k * a_dim1];
+			    }
+			    b[k + j * b_dim1] = temp;
+			}
 /* L40: */
-		}
-	    }
-	} else {
-	    if (*beta == 0.) {
-		i__1 = *n;
-		for (j = 1; j <= i__1; ++j) {
-		    i__2 = *n;
-		    for (i__ = j; i__ <= i__2; ++i__) {
-			c__[i__ + j * c_dim1] = 0.;
-/* L50: */
 		    }
-/* L60: */
+/* L50: */
 		}
 	    } else {
 		i__1 = *n;
 		for (j = 1; j <= i__1; ++j) {
-		    i__2 = *n;
-		    for (i__ = j; i__ <= i__2; ++i__) {
-			c__[i__ + j * c_dim1] = *beta * c__[i__ + j * c_dim1];
+		    for (k = *m; k >= 1; --k) {
+			if (b[k + j * b_dim1] != 0.) {
+			    temp = *alpha * b[k + j * b_dim1];
+			    b[k + j * b_dim1] = temp;
+			    if (nounit) {
+				b[k + j * b_dim1] *= a[k + k * a_dim1];
+			    }
+			    i__2 = *m;
+			    for (i__ = k + 1; i__ <= i__2; ++i__) {
+				b[i__ + j * b_dim1] += temp * a[i__ + k *
+					a_dim1];
+/* L60: */
+			    }
+			}
 /* L70: */
 		    }
 /* L80: */
 		}
 	    }
-	}
-	return 0;
-    }
-
-/*     Start the operations. */
-
-    if (lsame_(trans, "N")) {
+	} else {
 
-/*        Form  C := alpha*A*B' + alpha*B*A' + C. */
+/*           Form  B := alpha*A'*B. */
 
-	if (upper) {
-	    i__1 = *n;
-	    for (j = 1; j <= i__1; ++j) {
-		if (*beta == 0.) {
-		    i__2 = j;
-		    for (i__ = 1; i__ <= i__2; ++i__) {
-			c__[i__ + j * c_dim1] = 0.;
+	    if (upper) {
+		i__1 = *n;
+		for (j = 1; j <= i__1; ++j) {
+		    for (i__ = *m; i__ >= 1; --i__) {
+			temp = b[i__ + j * b_dim1];
+			if (nounit) {
+			    temp *= a[i__ + i__ * a_dim1];
+			}
+			i__2 = i__ - 1;
+			for (k = 1; k <= i__2; ++k) {
+			    temp += a[k + i__ * a_dim1] * b[k + j * b_dim1];
 /* L90: */
-		    }
-		} else if (*beta != 1.) {
-		    i__2 = j;
-		    for (i__ = 1; i__ <= i__2; ++i__) {
-			c__[i__ + j * c_dim1] = *beta * c__[i__ + j * c_dim1];
+			}
+			b[i__ + j * b_dim1] = *alpha * temp;
 /* L100: */
 		    }
-		}
-		i__2 = *k;
-		for (l = 1; l <= i__2; ++l) {
-		    if (a[j + l * a_dim1] != 0. || b[j + l * b_dim1] != 0.) {
-			temp1 = *alpha * b[j + l * b_dim1];
-			temp2 = *alpha * a[j + l * a_dim1];
-			i__3 = j;
-			for (i__ = 1; i__ <= i__3; ++i__) {
-			    c__[i__ + j * c_dim1] = c__[i__ + j * c_dim1] + a[
-				    i__ + l * a_dim1] * temp1 + b[i__ + l *
-				    b_dim1] * temp2;
 /* L110: */
+		}
+	    } else {
+		i__1 = *n;
+		for (j = 1; j <= i__1; ++j) {
+		    i__2 = *m;
+		    for (i__ = 1; i__ <= i__2; ++i__) {
+			temp = b[i__ + j * b_dim1];
+			if (nounit) {
+			    temp *= a[i__ + i__ * a_dim1];
 			}
-		    }
+			i__3 = *m;
+			for (k = i__ + 1; k <= i__3; ++k) {
+			    temp += a[k + i__ * a_dim1] * b[k + j * b_dim1];
 /* L120: */
-		}
+			}
+			b[i__ + j * b_dim1] = *alpha * temp;
 /* L130: */
+		    }
+/* L140: */
+		}
 	    }
-	} else {
-	    i__1 = *n;
-	    for (j = 1; j <= i__1; ++j) {
-		if (*beta == 0.) {
-		    i__2 = *n;
-		    for (i__ = j; i__ <= i__2; ++i__) {
-			c__[i__ + j * c_dim1] = 0.;
-/* L140: */
+	}
+    } else {
+	if (lsame_(transa, "N")) {
+
+/*           Form  B := alpha*B*A. */
+
+	    if (upper) {
+		for (j = *n; j >= 1; --j) {
+		    temp = *alpha;
+		    if (nounit) {
+			temp *= a[j + j * a_dim1];
 		    }
-		} else if (*beta != 1.) {
-		    i__2 = *n;
-		    for (i__ = j; i__ <= i__2; ++i__) {
-			c__[i__ + j * c_dim1] = *beta * c__[i__ + j * c_dim1];
+		    i__1 = *m;
+		    for (i__ = 1; i__ <= i__1; ++i__) {
+			b[i__ + j * b_dim1] = temp * b[i__ + j * b_dim1];
 /* L150: */
 		    }
-		}
-		i__2 = *k;
-		for (l = 1; l <= i__2; ++l) {
-		    if (a[j + l * a_dim1] != 0. || b[j + l * b_dim1] != 0.) {
-			temp1 = *alpha * b[j + l * b_dim1];
-			temp2 = *alpha * a[j + l * a_dim1];
-			i__3 = *n;
-			for (i__ = j; i__ <= i__3; ++i__) {
-			    c__[i__ + j * c_dim1] = c__[i__ + j * c_dim1] + a[
-				    i__ + l * a_dim1] * temp1 + b[i__ + l *
-				    b_dim1] * temp2;
+		    i__1 = j - 1;
+		    for (k = 1; k <= i__1; ++k) {
+			if (a[k + j * a_dim1] != 0.) {
+			    temp = *alpha * a[k + j * a_dim1];
+			    i__2 = *m;
+			    for (i__ = 1; i__ <= i__2; ++i__) {
+				b[i__ + j * b_dim1] += temp * b[i__ + k *
+					b_dim1];
 /* L160: */
+			    }
 			}
-		    }
 /* L170: */
-		}
+		    }
 /* L180: */
-	    }
-	}
-    } else {
-
-/*        Form  C := alpha*A'*B + alpha*B'*A + C. */
-
-	if (upper) {
-	    i__1 = *n;
-	    for (j = 1; j <= i__1; ++j) {
-		i__2 = j;
-		for (i__ = 1; i__ <= i__2; ++i__) {
-		    temp1 = 0.;
-		    temp2 = 0.;
-		    i__3 = *k;
-		    for (l = 1; l <= i__3; ++l) {
-			temp1 += a[l + i__ * a_dim1] * b[l + j * b_dim1];
-			temp2 += b[l + i__ * b_dim1] * a[l + j * a_dim1];
-/* L190: */
+		}
+	    } else {
+		i__1 = *n;
+		for (j = 1; j <= i__1; ++j) {
+		    temp = *alpha;
+		    if (nounit) {
+			temp *= a[j + j * a_dim1];
 		    }
-		    if (*beta == 0.) {
-			c__[i__ + j * c_dim1] = *alpha * temp1 + *alpha *
-				temp2;
-		    } else {
-			c__[i__ + j * c_dim1] = *beta * c__[i__ + j * c_dim1]
-				+ *alpha * temp1 + *alpha * temp2;
+		    i__2 = *m;
+		    for (i__ = 1; i__ <= i__2; ++i__) {
+			b[i__ + j * b_dim1] = temp * b[i__ + j * b_dim1];
+/* L190: */
 		    }
+		    i__2 = *n;
+		    for (k = j + 1; k <= i__2; ++k) {
+			if (a[k + j * a_dim1] != 0.) {
+			    temp = *alpha * a[k + j * a_dim1];
+			    i__3 = *m;
+			    for (i__ = 1; i__ <= i__3; ++i__) {
+				b[i__ + j * b_dim1] += temp * b[i__ + k *
+					b_dim1];
 /* L200: */
-		}
+			    }
+			}
 /* L210: */
+		    }
+/* L220: */
+		}
 	    }
 	} else {
-	    i__1 = *n;
-	    for (j = 1; j <= i__1; ++j) {
-		i__2 = *n;
-		for (i__ = j; i__ <= i__2; ++i__) {
-		    temp1 = 0.;
-		    temp2 = 0.;
-		    i__3 = *k;
-		    for (l = 1; l <= i__3; ++l) {
-			temp1 += a[l + i__ * a_dim1] * b[l + j * b_dim1];
-			temp2 += b[l + i__ * b_dim1] * a[l + j * a_dim1];
-/* L220: */
+
+/*           Form  B := alpha*B*A'. */
+
+	    if (upper) {
+		i__1 = *n;
+		for (k = 1; k <= i__1; ++k) {
+		    i__2 = k - 1;
+		    for (j = 1; j <= i__2; ++j) {
+			if (a[j + k * a_dim1] != 0.) {
+			    temp = *alpha * a[j + k * a_dim1];
+			    i__3 = *m;
+			    for (i__ = 1; i__ <= i__3; ++i__) {
+				b[i__ + j * b_dim1] += temp * b[i__ + k *
+					b_dim1];
+/* L230: */
+			    }
+			}
+/* L240: */
 		    }
-		    if (*beta == 0.) {
-			c__[i__ + j * c_dim1] = *alpha * temp1 + *alpha *
-				temp2;
-		    } else {
-			c__[i__ + j * c_dim1] = *beta * c__[i__ + j * c_dim1]
-				+ *alpha * temp1 + *alpha * temp2;
+		    temp = *alpha;
+		    if (nounit) {
+			temp *= a[k + k * a_dim1];
 		    }
-/* L230: */
+		    if (temp != 1.) {
+			i__2 = *m;
+			for (i__ = 1; i__ <= i__2; ++i__) {
+			    b[i__ + k * b_dim1] = temp * b[i__ + k * b_dim1];
+/* L250: */
+			}
+		    }
+/* L260: */
+		}
+	    } else {
+		for (k = *n; k >= 1; --k) {
+		    i__1 = *n;
+		    for (j = k + 1; j <= i__1; ++j) {
+			if (a[j + k * a_dim1] != 0.) {
+			    temp = *alpha * a[j + k * a_dim1];
+			    i__2 = *m;
+			    for (i__ = 1; i__ <= i__2; ++i__) {
+				b[i__ + j * b_dim1] += temp * b[i__ + k *
+					b_dim1];
+/* L270: */
+			    }
+			}
+/* L280: */
+		    }
+		    temp = *alpha;
+		    if (nounit) {
+			temp *= a[k + k * a_dim1];
+		    }
+		    if (temp != 1.) {
+			i__1 = *m;
+			for (i__ = 1; i__ <= i__1; ++i__) {
+			    b[i__ + k * b_dim1] = temp * b[i__ + k * b_dim1];
+/* L290: */
+			}
+		    }
+/* L300: */
 		}
-/* L240: */
 	    }
 	}
     }
 
     return 0;
 
-/*     End of DSYR2K. */
+/*     End of DTRMM . */
 
-} /* dsyr2k_ */
+} /* dtrmm_ */
 
-/* Subroutine */ int dsyrk_(char *uplo, char *trans, integer *n, integer *k,
-	doublereal *alpha, doublereal *a, integer *lda, doublereal *beta,
-	doublereal *c__, integer *ldc)
+/* Subroutine */ int dtrmv_(char *uplo, char *trans, char *diag, integer *n,
+	doublereal *a, integer *lda, doublereal *x, integer *incx)
 {
     /* System generated locals */
-    integer a_dim1, a_offset, c_dim1, c_offset, i__1, i__2, i__3;
+    integer a_dim1, a_offset, i__1, i__2;
 
     /* Local variables */
-    static integer i__, j, l, info;
+    static integer i__, j, ix, jx, kx, info;
     static doublereal temp;
     extern logical lsame_(char *, char *);
-    static integer nrowa;
-    static logical upper;
     extern /* Subroutine */ int xerbla_(char *, integer *);
+    static logical nounit;
 
 
 /*
     Purpose
     =======
 
-    DSYRK  performs one of the symmetric rank k operations
-
-       C := alpha*A*A' + beta*C,
-
-    or
+    DTRMV  performs one of the matrix-vector operations
 
-       C := alpha*A'*A + beta*C,
+       x := A*x,   or   x := A'*x,
 
-    where  alpha and beta  are scalars, C is an  n by n  symmetric matrix
-    and  A  is an  n by k  matrix in the first case and a  k by n  matrix
-    in the second case.
+    where x is an n element vector and  A is an n by n unit, or non-unit,
+    upper or lower triangular matrix.
 
     Parameters
     ==========
 
     UPLO   - CHARACTER*1.
-             On  entry,   UPLO  specifies  whether  the  upper  or  lower
-             triangular  part  of the  array  C  is to be  referenced  as
-             follows:
+             On entry, UPLO specifies whether the matrix is an upper or
+             lower triangular matrix as follows:
 
-                UPLO = 'U' or 'u'   Only the  upper triangular part of  C
-                                    is to be referenced.
+                UPLO = 'U' or 'u'   A is an upper triangular matrix.
 
-                UPLO = 'L' or 'l'   Only the  lower triangular part of  C
-                                    is to be referenced.
+                UPLO = 'L' or 'l'   A is a lower triangular matrix.
 
              Unchanged on exit.
 
     TRANS  - CHARACTER*1.
-             On entry,  TRANS  specifies the operation to be performed as
+             On entry, TRANS specifies the operation to be performed as
              follows:
 
-                TRANS = 'N' or 'n'   C := alpha*A*A' + beta*C.
+                TRANS = 'N' or 'n'   x := A*x.
 
-                TRANS = 'T' or 't'   C := alpha*A'*A + beta*C.
+                TRANS = 'T' or 't'   x := A'*x.
 
-                TRANS = 'C' or 'c'   C := alpha*A'*A + beta*C.
+                TRANS = 'C' or 'c'   x := A'*x.
 
              Unchanged on exit.
 
-    N      - INTEGER.
-             On entry,  N specifies the order of the matrix C.  N must be
-             at least zero.
-             Unchanged on exit.
+    DIAG   - CHARACTER*1.
+             On entry, DIAG specifies whether or not A is unit
+             triangular as follows:
+
+                DIAG = 'U' or 'u'   A is assumed to be unit triangular.
+
+                DIAG = 'N' or 'n'   A is not assumed to be unit
+                                    triangular.
 
-    K      - INTEGER.
-             On entry with  TRANS = 'N' or 'n',  K  specifies  the number
-             of  columns   of  the   matrix   A,   and  on   entry   with
-             TRANS = 'T' or 't' or 'C' or 'c',  K  specifies  the  number
-             of rows of the matrix  A.  K must be at least zero.
              Unchanged on exit.
 
-    ALPHA  - DOUBLE PRECISION.
-             On entry, ALPHA specifies the scalar alpha.
+    N      - INTEGER.
+             On entry, N specifies the order of the matrix A.
+             N must be at least zero.
              Unchanged on exit.
 
-    A      - DOUBLE PRECISION array of DIMENSION ( LDA, ka ), where ka is
-             k  when  TRANS = 'N' or 'n',  and is  n  otherwise.
-             Before entry with  TRANS = 'N' or 'n',  the  leading  n by k
-             part of the array  A  must contain the matrix  A,  otherwise
-             the leading  k by n  part of the array  A  must contain  the
-             matrix A.
+    A      - DOUBLE PRECISION array of DIMENSION ( LDA, n ).
+             Before entry with  UPLO = 'U' or 'u', the leading n by n
+             upper triangular part of the array A must contain the upper
+             triangular matrix and the strictly lower triangular part of
+             A is not referenced.
+             Before entry with UPLO = 'L' or 'l', the leading n by n
+             lower triangular part of the array A must contain the lower
+             triangular matrix and the strictly upper triangular part of
+             A is not referenced.
+             Note that when  DIAG = 'U' or 'u', the diagonal elements of
+             A are not referenced either, but are assumed to be unity.
              Unchanged on exit.
 
     LDA    - INTEGER.
              On entry, LDA specifies the first dimension of A as declared
-             in  the  calling  (sub)  program.   When  TRANS = 'N' or 'n'
-             then  LDA must be at least  max( 1, n ), otherwise  LDA must
-             be at least  max( 1, k ).
-             Unchanged on exit.
-
-    BETA   - DOUBLE PRECISION.
-             On entry, BETA specifies the scalar beta.
+             in the calling (sub) program. LDA must be at least
+             max( 1, n ).
              Unchanged on exit.
 
-    C      - DOUBLE PRECISION array of DIMENSION ( LDC, n ).
-             Before entry  with  UPLO = 'U' or 'u',  the leading  n by n
-             upper triangular part of the array C must contain the upper
-             triangular part  of the  symmetric matrix  and the strictly
-             lower triangular part of C is not referenced.  On exit, the
-             upper triangular part of the array  C is overwritten by the
-             upper triangular part of the updated matrix.
-             Before entry  with  UPLO = 'L' or 'l',  the leading  n by n
-             lower triangular part of the array C must contain the lower
-             triangular part  of the  symmetric matrix  and the strictly
-             upper triangular part of C is not referenced.  On exit, the
-             lower triangular part of the array  C is overwritten by the
-             lower triangular part of the updated matrix.
+    X      - DOUBLE PRECISION array of dimension at least
+             ( 1 + ( n - 1 )*abs( INCX ) ).
+             Before entry, the incremented array X must contain the n
+             element vector x. On exit, X is overwritten with the
+             tranformed vector x.
 
-    LDC    - INTEGER.
-             On entry, LDC specifies the first dimension of C as declared
-             in  the  calling  (sub)  program.   LDC  must  be  at  least
-             max( 1, n ).
+    INCX   - INTEGER.
+             On entry, INCX specifies the increment for the elements of
+             X. INCX must not be zero.
              Unchanged on exit.
 
 
-    Level 3 Blas routine.
+    Level 2 Blas routine.
 
-    -- Written on 8-February-1989.
-       Jack Dongarra, Argonne National Laboratory.
-       Iain Duff, AERE Harwell.
-       Jeremy Du Croz, Numerical Algorithms Group Ltd.
-       Sven Hammarling, Numerical Algorithms Group Ltd.
+    -- Written on 22-October-1986.
+       Jack Dongarra, Argonne National Lab.
+       Jeremy Du Croz, Nag Central Office.
+       Sven Hammarling, Nag Central Office.
+       Richard Hanson, Sandia National Labs.
 
 
        Test the input parameters.
@@ -2491,220 +2593,216 @@ L40:
     a_dim1 = *lda;
     a_offset = 1 + a_dim1 * 1;
     a -= a_offset;
-    c_dim1 = *ldc;
-    c_offset = 1 + c_dim1 * 1;
-    c__ -= c_offset;
+    --x;
 
     /* Function Body */
-    if (lsame_(trans, "N")) {
-	nrowa = *n;
-    } else {
-	nrowa = *k;
-    }
-    upper = lsame_(uplo, "U");
-
     info = 0;
-    if ((! upper && ! lsame_(uplo, "L"))) {
+    if ((! lsame_(uplo, "U") && ! lsame_(uplo, "L"))) {
 	info = 1;
     } else if (((! lsame_(trans, "N") && ! lsame_(trans,
 	     "T")) && ! lsame_(trans, "C"))) {
 	info = 2;
-    } else if (*n < 0) {
+    } else if ((! lsame_(diag, "U") && ! lsame_(diag,
+	    "N"))) {
 	info = 3;
-    } else if (*k < 0) {
+    } else if (*n < 0) {
 	info = 4;
-    } else if (*lda < max(1,nrowa)) {
-	info = 7;
-    } else if (*ldc < max(1,*n)) {
-	info = 10;
+    } else if (*lda < max(1,*n)) {
+	info = 6;
+    } else if (*incx == 0) {
+	info = 8;
     }
     if (info != 0) {
-	xerbla_("DSYRK ", &info);
+	xerbla_("DTRMV ", &info);
 	return 0;
     }
 
 /*     Quick return if possible. */
 
-    if (*n == 0 || ((*alpha == 0. || *k == 0) && *beta == 1.)) {
+    if (*n == 0) {
 	return 0;
     }
 
-/*     And when  alpha.eq.zero. */
+    nounit = lsame_(diag, "N");
 
-    if (*alpha == 0.) {
-	if (upper) {
-	    if (*beta == 0.) {
+/*
+       Set up the start point in X if the increment is not unity. This
+       will be  ( N - 1 )*INCX  too small for descending loops.
+*/
+
+    if (*incx <= 0) {
+	kx = 1 - (*n - 1) * *incx;
+    } else if (*incx != 1) {
+	kx = 1;
+    }
+
+/*
+       Start the operations. In this version the elements of A are
+       accessed sequentially with one pass through A.
+*/
+
+    if (lsame_(trans, "N")) {
+
+/*        Form  x := A*x. */
+
+	if (lsame_(uplo, "U")) {
+	    if (*incx == 1) {
 		i__1 = *n;
 		for (j = 1; j <= i__1; ++j) {
-		    i__2 = j;
-		    for (i__ = 1; i__ <= i__2; ++i__) {
-			c__[i__ + j * c_dim1] = 0.;
+		    if (x[j] != 0.) {
+			temp = x[j];
+			i__2 = j - 1;
+			for (i__ = 1; i__ <= i__2; ++i__) {
+			    x[i__] += temp * a[i__ + j * a_dim1];
 /* L10: */
+			}
+			if (nounit) {
+			    x[j] *= a[j + j * a_dim1];
+			}
 		    }
 /* L20: */
 		}
 	    } else {
+		jx = kx;
 		i__1 = *n;
 		for (j = 1; j <= i__1; ++j) {
-		    i__2 = j;
-		    for (i__ = 1; i__ <= i__2; ++i__) {
-			c__[i__ + j * c_dim1] = *beta * c__[i__ + j * c_dim1];
+		    if (x[jx] != 0.) {
+			temp = x[jx];
+			ix = kx;
+			i__2 = j - 1;
+			for (i__ = 1; i__ <= i__2; ++i__) {
+			    x[ix] += temp * a[i__ + j * a_dim1];
+			    ix += *incx;
 /* L30: */
+			}
+			if (nounit) {
+			    x[jx] *= a[j + j * a_dim1];
+			}
 		    }
+		    jx += *incx;
 /* L40: */
 		}
 	    }
 	} else {
-	    if (*beta == 0.) {
-		i__1 = *n;
-		for (j = 1; j <= i__1; ++j) {
-		    i__2 = *n;
-		    for (i__ = j; i__ <= i__2; ++i__) {
-			c__[i__ + j * c_dim1] = 0.;
+	    if (*incx == 1) {
+		for (j = *n; j >= 1; --j) {
+		    if (x[j] != 0.) {
+			temp = x[j];
+			i__1 = j + 1;
+			for (i__ = *n; i__ >= i__1; --i__) {
+			    x[i__] += temp * a[i__ + j * a_dim1];
 /* L50: */
+			}
+			if (nounit) {
+			    x[j] *= a[j + j * a_dim1];
+			}
 		    }
 /* L60: */
 		}
 	    } else {
-		i__1 = *n;
-		for (j = 1; j <= i__1; ++j) {
-		    i__2 = *n;
-		    for (i__ = j; i__ <= i__2; ++i__) {
-			c__[i__ + j * c_dim1] = *beta * c__[i__ + j * c_dim1];
+		kx += (*n - 1) * *incx;
+		jx = kx;
+		for (j = *n; j >= 1; --j) {
+		    if (x[jx] != 0.) {
+			temp = x[jx];
+			ix = kx;
+			i__1 = j + 1;
+			for (i__ = *n; i__ >= i__1; --i__) {
+			    x[ix] += temp * a[i__ + j * a_dim1];
+			    ix -= *incx;
 /* L70: */
+			}
+			if (nounit) {
+			    x[jx] *= a[j + j * a_dim1];
+			}
 		    }
+		    jx -= *incx;
 /* L80: */
 		}
 	    }
 	}
-	return 0;
-    }
-
-/*     Start the operations. */
-
-    if (lsame_(trans, "N")) {
+    } else {
 
-/*        Form  C := alpha*A*A' + beta*C. */
+/*        Form  x := A'*x. */
 
-	if (upper) {
-	    i__1 = *n;
-	    for (j = 1; j <= i__1; ++j) {
-		if (*beta == 0.) {
-		    i__2 = j;
-		    for (i__ = 1; i__ <= i__2; ++i__) {
-			c__[i__ + j * c_dim1] = 0.;
+	if (lsame_(uplo, "U")) {
+	    if (*incx == 1) {
+		for (j = *n; j >= 1; --j) {
+		    temp = x[j];
+		    if (nounit) {
+			temp *= a[j + j * a_dim1];
+		    }
+		    for (i__ = j - 1; i__ >= 1; --i__) {
+			temp += a[i__ + j * a_dim1] * x[i__];
 /* L90: */
 		    }
-		} else if (*beta != 1.) {
-		    i__2 = j;
-		    for (i__ = 1; i__ <= i__2; ++i__) {
-			c__[i__ + j * c_dim1] = *beta * c__[i__ + j * c_dim1];
+		    x[j] = temp;
 /* L100: */
-		    }
 		}
-		i__2 = *k;
-		for (l = 1; l <= i__2; ++l) {
-		    if (a[j + l * a_dim1] != 0.) {
-			temp = *alpha * a[j + l * a_dim1];
-			i__3 = j;
-			for (i__ = 1; i__ <= i__3; ++i__) {
-			    c__[i__ + j * c_dim1] += temp * a[i__ + l *
-				    a_dim1];
+	    } else {
+		jx = kx + (*n - 1) * *incx;
+		for (j = *n; j >= 1; --j) {
+		    temp = x[jx];
+		    ix = jx;
+		    if (nounit) {
+			temp *= a[j + j * a_dim1];
+		    }
+		    for (i__ = j - 1; i__ >= 1; --i__) {
+			ix -= *incx;
+			temp += a[i__ + j * a_dim1] * x[ix];
 /* L110: */
-			}
 		    }
+		    x[jx] = temp;
+		    jx -= *incx;
 /* L120: */
 		}
-/* L130: */
 	    }
 	} else {
-	    i__1 = *n;
-	    for (j = 1; j <= i__1; ++j) {
-		if (*beta == 0.) {
+	    if (*incx == 1) {
+		i__1 = *n;
+		for (j = 1; j <= i__1; ++j) {
+		    temp = x[j];
+		    if (nounit) {
+			temp *= a[j + j * a_dim1];
+		    }
 		    i__2 = *n;
-		    for (i__ = j; i__ <= i__2; ++i__) {
-			c__[i__ + j * c_dim1] = 0.;
+		    for (i__ = j + 1; i__ <= i__2; ++i__) {
+			temp += a[i__ + j * a_dim1] * x[i__];
+/* L130: */
+		    }
+		    x[j] = temp;
 /* L140: */
+		}
+	    } else {
+		jx = kx;
+		i__1 = *n;
+		for (j = 1; j <= i__1; ++j) {
+		    temp = x[jx];
+		    ix = jx;
+		    if (nounit) {
+			temp *= a[j + j * a_dim1];
 		    }
-		} else if (*beta != 1.) {
 		    i__2 = *n;
-		    for (i__ = j; i__ <= i__2; ++i__) {
-			c__[i__ + j * c_dim1] = *beta * c__[i__ + j * c_dim1];
+		    for (i__ = j + 1; i__ <= i__2; ++i__) {
+			ix += *incx;
+			temp += a[i__ + j * a_dim1] * x[ix];
 /* L150: */
 		    }
-		}
-		i__2 = *k;
-		for (l = 1; l <= i__2; ++l) {
-		    if (a[j + l * a_dim1] != 0.) {
-			temp = *alpha * a[j + l * a_dim1];
-			i__3 = *n;
-			for (i__ = j; i__ <= i__3; ++i__) {
-			    c__[i__ + j * c_dim1] += temp * a[i__ + l *
-				    a_dim1];
+		    x[jx] = temp;
+		    jx += *incx;
 /* L160: */
-			}
-		    }
-/* L170: */
-		}
-/* L180: */
-	    }
-	}
-    } else {
-
-/*        Form  C := alpha*A'*A + beta*C. */
-
-	if (upper) {
-	    i__1 = *n;
-	    for (j = 1; j <= i__1; ++j) {
-		i__2 = j;
-		for (i__ = 1; i__ <= i__2; ++i__) {
-		    temp = 0.;
-		    i__3 = *k;
-		    for (l = 1; l <= i__3; ++l) {
-			temp += a[l + i__ * a_dim1] * a[l + j * a_dim1];
-/* L190: */
-		    }
-		    if (*beta == 0.) {
-			c__[i__ + j * c_dim1] = *alpha * temp;
-		    } else {
-			c__[i__ + j * c_dim1] = *alpha * temp + *beta * c__[
-				i__ + j * c_dim1];
-		    }
-/* L200: */
-		}
-/* L210: */
-	    }
-	} else {
-	    i__1 = *n;
-	    for (j = 1; j <= i__1; ++j) {
-		i__2 = *n;
-		for (i__ = j; i__ <= i__2; ++i__) {
-		    temp = 0.;
-		    i__3 = *k;
-		    for (l = 1; l <= i__3; ++l) {
-			temp += a[l + i__ * a_dim1] * a[l + j * a_dim1];
-/* L220: */
-		    }
-		    if (*beta == 0.) {
-			c__[i__ + j * c_dim1] = *alpha * temp;
-		    } else {
-			c__[i__ + j * c_dim1] = *alpha * temp + *beta * c__[
-				i__ + j * c_dim1];
-		    }
-/* L230: */
 		}
-/* L240: */
 	    }
 	}
     }
 
     return 0;
 
-/*     End of DSYRK . */
+/*     End of DTRMV . */
 
-} /* dsyrk_ */
+} /* dtrmv_ */
 
-/* Subroutine */ int dtrmm_(char *side, char *uplo, char *transa, char *diag,
+/* Subroutine */ int dtrsm_(char *side, char *uplo, char *transa, char *diag,
 	integer *m, integer *n, doublereal *alpha, doublereal *a, integer *
 	lda, doublereal *b, integer *ldb)
 {
@@ -2726,25 +2824,27 @@ L40:
     Purpose
     =======
 
-    DTRMM  performs one of the matrix-matrix operations
+    DTRSM  solves one of the matrix equations
 
-       B := alpha*op( A )*B,   or   B := alpha*B*op( A ),
+       op( A )*X = alpha*B,   or   X*op( A ) = alpha*B,
 
-    where  alpha  is a scalar,  B  is an m by n matrix,  A  is a unit, or
+    where alpha is a scalar, X and B are m by n matrices, A is a unit, or
     non-unit,  upper or lower triangular matrix  and  op( A )  is one  of
 
        op( A ) = A   or   op( A ) = A'.
 
+    The matrix X is overwritten on B.
+
     Parameters
     ==========
 
     SIDE   - CHARACTER*1.
-             On entry,  SIDE specifies whether  op( A ) multiplies B from
-             the left or right as follows:
+             On entry, SIDE specifies whether op( A ) appears on the left
+             or right of X as follows:
 
-                SIDE = 'L' or 'l'   B := alpha*op( A )*B.
+                SIDE = 'L' or 'l'   op( A )*X = alpha*B.
 
-                SIDE = 'R' or 'r'   B := alpha*B*op( A ).
+                SIDE = 'R' or 'r'   X*op( A ) = alpha*B.
 
              Unchanged on exit.
 
@@ -2820,8 +2920,8 @@ L40:
 
     B      - DOUBLE PRECISION array of DIMENSION ( LDB, n ).
              Before entry,  the leading  m by n part of the array  B must
-             contain the matrix  B,  and  on exit  is overwritten  by the
-             transformed matrix.
+             contain  the  right-hand  side  matrix  B,  and  on exit  is
+             overwritten by the solution matrix  X.
 
     LDB    - INTEGER.
              On entry, LDB specifies the first dimension of B as declared
@@ -2832,6 +2932,7 @@ L40:
 
     Level 3 Blas routine.
 
+
     -- Written on 8-February-1989.
        Jack Dongarra, Argonne National Laboratory.
        Iain Duff, AERE Harwell.
@@ -2881,7 +2982,7 @@ L40:
 	info = 11;
     }
     if (info != 0) {
-	xerbla_("DTRMM ", &info);
+	xerbla_("DTRSM ", &info);
 	return 0;
     }
 
@@ -2911,214 +3012,248 @@ L40:
     if (lside) {
 	if (lsame_(transa, "N")) {
 
-/*           Form  B := alpha*A*B. */
+/*           Form  B := alpha*inv( A )*B. */
 
 	    if (upper) {
 		i__1 = *n;
 		for (j = 1; j <= i__1; ++j) {
-		    i__2 = *m;
-		    for (k = 1; k <= i__2; ++k) {
-			if (b[k + j * b_dim1] != 0.) {
-			    temp = *alpha * b[k + j * b_dim1];
-			    i__3 = k - 1;
-			    for (i__ = 1; i__ <= i__3; ++i__) {
-				b[i__ + j * b_dim1] += temp * a[i__ + k *
-					a_dim1];
+		    if (*alpha != 1.) {
+			i__2 = *m;
+			for (i__ = 1; i__ <= i__2; ++i__) {
+			    b[i__ + j * b_dim1] = *alpha * b[i__ + j * b_dim1]
+				    ;
 /* L30: */
-			    }
+			}
+		    }
+		    for (k = *m; k >= 1; --k) {
+			if (b[k + j * b_dim1] != 0.) {
 			    if (nounit) {
-				temp *= a[k + k * a_dim1];
+				b[k + j * b_dim1] /= a[k + k * a_dim1];
 			    }
-			    b[k + j * b_dim1] = temp;
-			}
+			    i__2 = k - 1;
+			    for (i__ = 1; i__ <= i__2; ++i__) {
+				b[i__ + j * b_dim1] -= b[k + j * b_dim1] * a[
+					i__ + k * a_dim1];
 /* L40: */
-		    }
+			    }
+			}
 /* L50: */
+		    }
+/* L60: */
 		}
 	    } else {
 		i__1 = *n;
 		for (j = 1; j <= i__1; ++j) {
-		    for (k = *m; k >= 1; --k) {
+		    if (*alpha != 1.) {
+			i__2 = *m;
+			for (i__ = 1; i__ <= i__2; ++i__) {
+			    b[i__ + j * b_dim1] = *alpha * b[i__ + j * b_dim1]
+				    ;
+/* L70: */
+			}
+		    }
+		    i__2 = *m;
+		    for (k = 1; k <= i__2; ++k) {
 			if (b[k + j * b_dim1] != 0.) {
-			    temp = *alpha * b[k + j * b_dim1];
-			    b[k + j * b_dim1] = temp;
 			    if (nounit) {
-				b[k + j * b_dim1] *= a[k + k * a_dim1];
+				b[k + j * b_dim1] /= a[k + k * a_dim1];
 			    }
-			    i__2 = *m;
-			    for (i__ = k + 1; i__ <= i__2; ++i__) {
-				b[i__ + j * b_dim1] += temp * a[i__ + k *
-					a_dim1];
-/* L60: */
+			    i__3 = *m;
+			    for (i__ = k + 1; i__ <= i__3; ++i__) {
+				b[i__ + j * b_dim1] -= b[k + j * b_dim1] * a[
+					i__ + k * a_dim1];
+/* L80: */
 			    }
 			}
-/* L70: */
+/* L90: */
 		    }
-/* L80: */
+/* L100: */
 		}
 	    }
 	} else {
 
-/*           Form  B := alpha*A'*B. */
+/*           Form  B := alpha*inv( A' )*B. */
 
 	    if (upper) {
 		i__1 = *n;
 		for (j = 1; j <= i__1; ++j) {
-		    for (i__ = *m; i__ >= 1; --i__) {
-			temp = b[i__ + j * b_dim1];
-			if (nounit) {
-			    temp *= a[i__ + i__ * a_dim1];
+		    i__2 = *m;
+		    for (i__ = 1; i__ <= i__2; ++i__) {
+			temp = *alpha * b[i__ + j * b_dim1];
+			i__3 = i__ - 1;
+			for (k = 1; k <= i__3; ++k) {
+			    temp -= a[k + i__ * a_dim1] * b[k + j * b_dim1];
+/* L110: */
 			}
-			i__2 = i__ - 1;
-			for (k = 1; k <= i__2; ++k) {
-			    temp += a[k + i__ * a_dim1] * b[k + j * b_dim1];
-/* L90: */
+			if (nounit) {
+			    temp /= a[i__ + i__ * a_dim1];
 			}
-			b[i__ + j * b_dim1] = *alpha * temp;
-/* L100: */
+			b[i__ + j * b_dim1] = temp;
+/* L120: */
 		    }
-/* L110: */
+/* L130: */
 		}
 	    } else {
 		i__1 = *n;
 		for (j = 1; j <= i__1; ++j) {
-		    i__2 = *m;
-		    for (i__ = 1; i__ <= i__2; ++i__) {
-			temp = b[i__ + j * b_dim1];
-			if (nounit) {
-			    temp *= a[i__ + i__ * a_dim1];
+		    for (i__ = *m; i__ >= 1; --i__) {
+			temp = *alpha * b[i__ + j * b_dim1];
+			i__2 = *m;
+			for (k = i__ + 1; k <= i__2; ++k) {
+			    temp -= a[k + i__ * a_dim1] * b[k + j * b_dim1];
+/* L140: */
 			}
-			i__3 = *m;
-			for (k = i__ + 1; k <= i__3; ++k) {
-			    temp += a[k + i__ * a_dim1] * b[k + j * b_dim1];
-/* L120: */
+			if (nounit) {
+			    temp /= a[i__ + i__ * a_dim1];
 			}
-			b[i__ + j * b_dim1] = *alpha * temp;
-/* L130: */
+			b[i__ + j * b_dim1] = temp;
+/* L150: */
 		    }
-/* L140: */
+/* L160: */
 		}
 	    }
 	}
     } else {
 	if (lsame_(transa, "N")) {
 
-/*           Form  B := alpha*B*A. */
+/*           Form  B := alpha*B*inv( A ). */
 
 	    if (upper) {
-		for (j = *n; j >= 1; --j) {
-		    temp = *alpha;
-		    if (nounit) {
-			temp *= a[j + j * a_dim1];
-		    }
-		    i__1 = *m;
-		    for (i__ = 1; i__ <= i__1; ++i__) {
-			b[i__ + j * b_dim1] = temp * b[i__ + j * b_dim1];
-/* L150: */
-		    }
-		    i__1 = j - 1;
-		    for (k = 1; k <= i__1; ++k) {
-			if (a[k + j * a_dim1] != 0.) {
-			    temp = *alpha * a[k + j * a_dim1];
-			    i__2 = *m;
-			    for (i__ = 1; i__ <= i__2; ++i__) {
-				b[i__ + j * b_dim1] += temp * b[i__ + k *
-					b_dim1];
-/* L160: */
-			    }
-			}
-/* L170: */
-		    }
-/* L180: */
-		}
-	    } else {
 		i__1 = *n;
 		for (j = 1; j <= i__1; ++j) {
-		    temp = *alpha;
-		    if (nounit) {
-			temp *= a[j + j * a_dim1];
-		    }
-		    i__2 = *m;
-		    for (i__ = 1; i__ <= i__2; ++i__) {
-			b[i__ + j * b_dim1] = temp * b[i__ + j * b_dim1];
-/* L190: */
+		    if (*alpha != 1.) {
+			i__2 = *m;
+			for (i__ = 1; i__ <= i__2; ++i__) {
+			    b[i__ + j * b_dim1] = *alpha * b[i__ + j * b_dim1]
+				    ;
+/* L170: */
+			}
 		    }
-		    i__2 = *n;
-		    for (k = j + 1; k <= i__2; ++k) {
+		    i__2 = j - 1;
+		    for (k = 1; k <= i__2; ++k) {
 			if (a[k + j * a_dim1] != 0.) {
-			    temp = *alpha * a[k + j * a_dim1];
 			    i__3 = *m;
 			    for (i__ = 1; i__ <= i__3; ++i__) {
-				b[i__ + j * b_dim1] += temp * b[i__ + k *
-					b_dim1];
-/* L200: */
+				b[i__ + j * b_dim1] -= a[k + j * a_dim1] * b[
+					i__ + k * b_dim1];
+/* L180: */
 			    }
 			}
-/* L210: */
+/* L190: */
 		    }
-/* L220: */
+		    if (nounit) {
+			temp = 1. / a[j + j * a_dim1];
+			i__2 = *m;
+			for (i__ = 1; i__ <= i__2; ++i__) {
+			    b[i__ + j * b_dim1] = temp * b[i__ + j * b_dim1];
+/* L200: */
+			}
+		    }
+/* L210: */
 		}
-	    }
-	} else {
-
-/*           Form  B := alpha*B*A'. */
-
-	    if (upper) {
-		i__1 = *n;
-		for (k = 1; k <= i__1; ++k) {
-		    i__2 = k - 1;
-		    for (j = 1; j <= i__2; ++j) {
-			if (a[j + k * a_dim1] != 0.) {
-			    temp = *alpha * a[j + k * a_dim1];
-			    i__3 = *m;
-			    for (i__ = 1; i__ <= i__3; ++i__) {
-				b[i__ + j * b_dim1] += temp * b[i__ + k *
-					b_dim1];
+	    } else {
+		for (j = *n; j >= 1; --j) {
+		    if (*alpha != 1.) {
+			i__1 = *m;
+			for (i__ = 1; i__ <= i__1; ++i__) {
+			    b[i__ + j * b_dim1] = *alpha * b[i__ + j * b_dim1]
+				    ;
+/* L220: */
+			}
+		    }
+		    i__1 = *n;
+		    for (k = j + 1; k <= i__1; ++k) {
+			if (a[k + j * a_dim1] != 0.) {
+			    i__2 = *m;
+			    for (i__ = 1; i__ <= i__2; ++i__) {
+				b[i__ + j * b_dim1] -= a[k + j * a_dim1] * b[
+					i__ + k * b_dim1];
 /* L230: */
 			    }
 			}
 /* L240: */
 		    }
-		    temp = *alpha;
 		    if (nounit) {
-			temp *= a[k + k * a_dim1];
-		    }
-		    if (temp != 1.) {
-			i__2 = *m;
-			for (i__ = 1; i__ <= i__2; ++i__) {
-			    b[i__ + k * b_dim1] = temp * b[i__ + k * b_dim1];
+			temp = 1. / a[j + j * a_dim1];
+			i__1 = *m;
+			for (i__ = 1; i__ <= i__1; ++i__) {
+			    b[i__ + j * b_dim1] = temp * b[i__ + j * b_dim1];
 /* L250: */
 			}
 		    }
 /* L260: */
 		}
-	    } else {
+	    }
+	} else {
+
+/*           Form  B := alpha*B*inv( A' ). */
+
+	    if (upper) {
 		for (k = *n; k >= 1; --k) {
-		    i__1 = *n;
-		    for (j = k + 1; j <= i__1; ++j) {
+		    if (nounit) {
+			temp = 1. / a[k + k * a_dim1];
+			i__1 = *m;
+			for (i__ = 1; i__ <= i__1; ++i__) {
+			    b[i__ + k * b_dim1] = temp * b[i__ + k * b_dim1];
+/* L270: */
+			}
+		    }
+		    i__1 = k - 1;
+		    for (j = 1; j <= i__1; ++j) {
 			if (a[j + k * a_dim1] != 0.) {
-			    temp = *alpha * a[j + k * a_dim1];
+			    temp = a[j + k * a_dim1];
 			    i__2 = *m;
 			    for (i__ = 1; i__ <= i__2; ++i__) {
-				b[i__ + j * b_dim1] += temp * b[i__ + k *
+				b[i__ + j * b_dim1] -= temp * b[i__ + k *
 					b_dim1];
-/* L270: */
+/* L280: */
 			    }
 			}
-/* L280: */
-		    }
-		    temp = *alpha;
-		    if (nounit) {
-			temp *= a[k + k * a_dim1];
+/* L290: */
 		    }
-		    if (temp != 1.) {
+		    if (*alpha != 1.) {
 			i__1 = *m;
 			for (i__ = 1; i__ <= i__1; ++i__) {
+			    b[i__ + k * b_dim1] = *alpha * b[i__ + k * b_dim1]
+				    ;
+/* L300: */
+			}
+		    }
+/* L310: */
+		}
+	    } else {
+		i__1 = *n;
+		for (k = 1; k <= i__1; ++k) {
+		    if (nounit) {
+			temp = 1. / a[k + k * a_dim1];
+			i__2 = *m;
+			for (i__ = 1; i__ <= i__2; ++i__) {
 			    b[i__ + k * b_dim1] = temp * b[i__ + k * b_dim1];
-/* L290: */
+/* L320: */
 			}
 		    }
-/* L300: */
+		    i__2 = *n;
+		    for (j = k + 1; j <= i__2; ++j) {
+			if (a[j + k * a_dim1] != 0.) {
+			    temp = a[j + k * a_dim1];
+			    i__3 = *m;
+			    for (i__ = 1; i__ <= i__3; ++i__) {
+				b[i__ + j * b_dim1] -= temp * b[i__ + k *
+					b_dim1];
+/* L330: */
+			    }
+			}
+/* L340: */
+		    }
+		    if (*alpha != 1.) {
+			i__2 = *m;
+			for (i__ = 1; i__ <= i__2; ++i__) {
+			    b[i__ + k * b_dim1] = *alpha * b[i__ + k * b_dim1]
+				    ;
+/* L350: */
+			}
+		    }
+/* L360: */
 		}
 	    }
 	}
@@ -3126,2277 +3261,820 @@ L40:
 
     return 0;
 
-/*     End of DTRMM . */
+/*     End of DTRSM . */
 
-} /* dtrmm_ */
+} /* dtrsm_ */
 
-/* Subroutine */ int dtrmv_(char *uplo, char *trans, char *diag, integer *n,
-	doublereal *a, integer *lda, doublereal *x, integer *incx)
+doublereal dzasum_(integer *n, doublecomplex *zx, integer *incx)
 {
     /* System generated locals */
-    integer a_dim1, a_offset, i__1, i__2;
+    integer i__1;
+    doublereal ret_val;
 
     /* Local variables */
-    static integer i__, j, ix, jx, kx, info;
-    static doublereal temp;
-    extern logical lsame_(char *, char *);
-    extern /* Subroutine */ int xerbla_(char *, integer *);
-    static logical nounit;
+    static integer i__, ix;
+    static doublereal stemp;
+    extern doublereal dcabs1_(doublecomplex *);
 
 
 /*
-    Purpose
-    =======
-
-    DTRMV  performs one of the matrix-vector operations
+       takes the sum of the absolute values.
+       jack dongarra, 3/11/78.
+       modified 3/93 to return if incx .le. 0.
+       modified 12/3/93, array(1) declarations changed to array(*)
+*/
 
-       x := A*x,   or   x := A'*x,
 
-    where x is an n element vector and  A is an n by n unit, or non-unit,
-    upper or lower triangular matrix.
+    /* Parameter adjustments */
+    --zx;
 
-    Parameters
-    ==========
+    /* Function Body */
+    ret_val = 0.;
+    stemp = 0.;
+    if (*n <= 0 || *incx <= 0) {
+	return ret_val;
+    }
+    if (*incx == 1) {
+	goto L20;
+    }
 
-    UPLO   - CHARACTER*1.
-             On entry, UPLO specifies whether the matrix is an upper or
-             lower triangular matrix as follows:
+/*        code for increment not equal to 1 */
 
-                UPLO = 'U' or 'u'   A is an upper triangular matrix.
+    ix = 1;
+    i__1 = *n;
+    for (i__ = 1; i__ <= i__1; ++i__) {
+	stemp += dcabs1_(&zx[ix]);
+	ix += *incx;
+/* L10: */
+    }
+    ret_val = stemp;
+    return ret_val;
 
-                UPLO = 'L' or 'l'   A is a lower triangular matrix.
+/*        code for increment equal to 1 */
 
-             Unchanged on exit.
+L20:
+    i__1 = *n;
+    for (i__ = 1; i__ <= i__1; ++i__) {
+	stemp += dcabs1_(&zx[i__]);
+/* L30: */
+    }
+    ret_val = stemp;
+    return ret_val;
+} /* dzasum_ */
 
-    TRANS  - CHARACTER*1.
-             On entry, TRANS specifies the operation to be performed as
-             follows:
+doublereal dznrm2_(integer *n, doublecomplex *x, integer *incx)
+{
+    /* System generated locals */
+    integer i__1, i__2, i__3;
+    doublereal ret_val, d__1;
 
-                TRANS = 'N' or 'n'   x := A*x.
+    /* Builtin functions */
+    double d_imag(doublecomplex *), sqrt(doublereal);
 
-                TRANS = 'T' or 't'   x := A'*x.
+    /* Local variables */
+    static integer ix;
+    static doublereal ssq, temp, norm, scale;
 
-                TRANS = 'C' or 'c'   x := A'*x.
 
-             Unchanged on exit.
+/*
+    DZNRM2 returns the euclidean norm of a vector via the function
+    name, so that
 
-    DIAG   - CHARACTER*1.
-             On entry, DIAG specifies whether or not A is unit
-             triangular as follows:
+       DZNRM2 := sqrt( conjg( x' )*x )
 
-                DIAG = 'U' or 'u'   A is assumed to be unit triangular.
 
-                DIAG = 'N' or 'n'   A is not assumed to be unit
-                                    triangular.
+    -- This version written on 25-October-1982.
+       Modified on 14-October-1993 to inline the call to ZLASSQ.
+       Sven Hammarling, Nag Ltd.
+*/
 
-             Unchanged on exit.
 
-    N      - INTEGER.
-             On entry, N specifies the order of the matrix A.
-             N must be at least zero.
-             Unchanged on exit.
+    /* Parameter adjustments */
+    --x;
 
-    A      - DOUBLE PRECISION array of DIMENSION ( LDA, n ).
-             Before entry with  UPLO = 'U' or 'u', the leading n by n
-             upper triangular part of the array A must contain the upper
-             triangular matrix and the strictly lower triangular part of
-             A is not referenced.
-             Before entry with UPLO = 'L' or 'l', the leading n by n
-             lower triangular part of the array A must contain the lower
-             triangular matrix and the strictly upper triangular part of
-             A is not referenced.
-             Note that when  DIAG = 'U' or 'u', the diagonal elements of
-             A are not referenced either, but are assumed to be unity.
-             Unchanged on exit.
+    /* Function Body */
+    if (*n < 1 || *incx < 1) {
+	norm = 0.;
+    } else {
+	scale = 0.;
+	ssq = 1.;
+/*
+          The following loop is equivalent to this call to the LAPACK
+          auxiliary routine:
+          CALL ZLASSQ( N, X, INCX, SCALE, SSQ )
+*/
 
-    LDA    - INTEGER.
-             On entry, LDA specifies the first dimension of A as declared
-             in the calling (sub) program. LDA must be at least
-             max( 1, n ).
-             Unchanged on exit.
+	i__1 = (*n - 1) * *incx + 1;
+	i__2 = *incx;
+	for (ix = 1; i__2 < 0 ? ix >= i__1 : ix <= i__1; ix += i__2) {
+	    i__3 = ix;
+	    if (x[i__3].r != 0.) {
+		i__3 = ix;
+		temp = (d__1 = x[i__3].r, abs(d__1));
+		if (scale < temp) {
+/* Computing 2nd power */
+		    d__1 = scale / temp;
+		    ssq = ssq * (d__1 * d__1) + 1.;
+		    scale = temp;
+		} else {
+/* Computing 2nd power */
+		    d__1 = temp / scale;
+		    ssq += d__1 * d__1;
+		}
+	    }
+	    if (d_imag(&x[ix]) != 0.) {
+		temp = (d__1 = d_imag(&x[ix]), abs(d__1));
+		if (scale < temp) {
+/* Computing 2nd power */
+		    d__1 = scale / temp;
+		    ssq = ssq * (d__1 * d__1) + 1.;
+		    scale = temp;
+		} else {
+/* Computing 2nd power */
+		    d__1 = temp / scale;
+		    ssq += d__1 * d__1;
+		}
+	    }
+/* L10: */
+	}
+	norm = scale * sqrt(ssq);
+    }
 
-    X      - DOUBLE PRECISION array of dimension at least
-             ( 1 + ( n - 1 )*abs( INCX ) ).
-             Before entry, the incremented array X must contain the n
-             element vector x. On exit, X is overwritten with the
-             tranformed vector x.
+    ret_val = norm;
+    return ret_val;
 
-    INCX   - INTEGER.
-             On entry, INCX specifies the increment for the elements of
-             X. INCX must not be zero.
-             Unchanged on exit.
+/*     End of DZNRM2. */
 
+} /* dznrm2_ */
 
-    Level 2 Blas routine.
+integer idamax_(integer *n, doublereal *dx, integer *incx)
+{
+    /* System generated locals */
+    integer ret_val, i__1;
+    doublereal d__1;
 
-    -- Written on 22-October-1986.
-       Jack Dongarra, Argonne National Lab.
-       Jeremy Du Croz, Nag Central Office.
-       Sven Hammarling, Nag Central Office.
-       Richard Hanson, Sandia National Labs.
+    /* Local variables */
+    static integer i__, ix;
+    static doublereal dmax__;
 
 
-       Test the input parameters.
+/*
+       finds the index of element having max. absolute value.
+       jack dongarra, linpack, 3/11/78.
+       modified 3/93 to return if incx .le. 0.
+       modified 12/3/93, array(1) declarations changed to array(*)
 */
 
+
     /* Parameter adjustments */
-    a_dim1 = *lda;
-    a_offset = 1 + a_dim1 * 1;
-    a -= a_offset;
-    --x;
+    --dx;
 
     /* Function Body */
-    info = 0;
-    if ((! lsame_(uplo, "U") && ! lsame_(uplo, "L"))) {
-	info = 1;
-    } else if (((! lsame_(trans, "N") && ! lsame_(trans,
-	     "T")) && ! lsame_(trans, "C"))) {
-	info = 2;
-    } else if ((! lsame_(diag, "U") && ! lsame_(diag,
-	    "N"))) {
-	info = 3;
-    } else if (*n < 0) {
-	info = 4;
-    } else if (*lda < max(1,*n)) {
-	info = 6;
-    } else if (*incx == 0) {
-	info = 8;
+    ret_val = 0;
+    if (*n < 1 || *incx <= 0) {
+	return ret_val;
     }
-    if (info != 0) {
-	xerbla_("DTRMV ", &info);
-	return 0;
+    ret_val = 1;
+    if (*n == 1) {
+	return ret_val;
+    }
+    if (*incx == 1) {
+	goto L20;
     }
 
-/*     Quick return if possible. */
+/*        code for increment not equal to 1 */
 
-    if (*n == 0) {
-	return 0;
+    ix = 1;
+    dmax__ = abs(dx[1]);
+    ix += *incx;
+    i__1 = *n;
+    for (i__ = 2; i__ <= i__1; ++i__) {
+	if ((d__1 = dx[ix], abs(d__1)) <= dmax__) {
+	    goto L5;
+	}
+	ret_val = i__;
+	dmax__ = (d__1 = dx[ix], abs(d__1));
+L5:
+	ix += *incx;
+/* L10: */
     }
+    return ret_val;
+
+/*        code for increment equal to 1 */
+
+L20:
+    dmax__ = abs(dx[1]);
+    i__1 = *n;
+    for (i__ = 2; i__ <= i__1; ++i__) {
+	if ((d__1 = dx[i__], abs(d__1)) <= dmax__) {
+	    goto L30;
+	}
+	ret_val = i__;
+	dmax__ = (d__1 = dx[i__], abs(d__1));
+L30:
+	;
+    }
+    return ret_val;
+} /* idamax_ */
+
+integer izamax_(integer *n, doublecomplex *zx, integer *incx)
+{
+    /* System generated locals */
+    integer ret_val, i__1;
+
+    /* Local variables */
+    static integer i__, ix;
+    static doublereal smax;
+    extern doublereal dcabs1_(doublecomplex *);
 
-    nounit = lsame_(diag, "N");
 
 /*
-       Set up the start point in X if the increment is not unity. This
-       will be  ( N - 1 )*INCX  too small for descending loops.
+       finds the index of element having max. absolute value.
+       jack dongarra, 1/15/85.
+       modified 3/93 to return if incx .le. 0.
+       modified 12/3/93, array(1) declarations changed to array(*)
 */
 
-    if (*incx <= 0) {
-	kx = 1 - (*n - 1) * *incx;
-    } else if (*incx != 1) {
-	kx = 1;
+
+    /* Parameter adjustments */
+    --zx;
+
+    /* Function Body */
+    ret_val = 0;
+    if (*n < 1 || *incx <= 0) {
+	return ret_val;
+    }
+    ret_val = 1;
+    if (*n == 1) {
+	return ret_val;
+    }
+    if (*incx == 1) {
+	goto L20;
+    }
+
+/*        code for increment not equal to 1 */
+
+    ix = 1;
+    smax = dcabs1_(&zx[1]);
+    ix += *incx;
+    i__1 = *n;
+    for (i__ = 2; i__ <= i__1; ++i__) {
+	if (dcabs1_(&zx[ix]) <= smax) {
+	    goto L5;
+	}
+	ret_val = i__;
+	smax = dcabs1_(&zx[ix]);
+L5:
+	ix += *incx;
+/* L10: */
+    }
+    return ret_val;
+
+/*        code for increment equal to 1 */
+
+L20:
+    smax = dcabs1_(&zx[1]);
+    i__1 = *n;
+    for (i__ = 2; i__ <= i__1; ++i__) {
+	if (dcabs1_(&zx[i__]) <= smax) {
+	    goto L30;
+	}
+	ret_val = i__;
+	smax = dcabs1_(&zx[i__]);
+L30:
+	;
     }
+    return ret_val;
+} /* izamax_ */
+
+logical lsame_(char *ca, char *cb)
+{
+    /* System generated locals */
+    logical ret_val;
+
+    /* Local variables */
+    static integer inta, intb, zcode;
+
 
 /*
-       Start the operations. In this version the elements of A are
-       accessed sequentially with one pass through A.
+    -- LAPACK auxiliary routine (version 3.0) --
+       Univ. of Tennessee, Univ. of California Berkeley, NAG Ltd.,
+       Courant Institute, Argonne National Lab, and Rice University
+       September 30, 1994
+
+
+    Purpose
+    =======
+
+    LSAME returns .TRUE. if CA is the same letter as CB regardless of
+    case.
+
+    Arguments
+    =========
+
+    CA      (input) CHARACTER*1
+    CB      (input) CHARACTER*1
+            CA and CB specify the single characters to be compared.
+
+   =====================================================================
+
+
+       Test if the characters are equal
 */
 
-    if (lsame_(trans, "N")) {
+    ret_val = *(unsigned char *)ca == *(unsigned char *)cb;
+    if (ret_val) {
+	return ret_val;
+    }
 
-/*        Form  x := A*x. */
+/*     Now test for equivalence if both characters are alphabetic. */
 
-	if (lsame_(uplo, "U")) {
-	    if (*incx == 1) {
-		i__1 = *n;
-		for (j = 1; j <= i__1; ++j) {
-		    if (x[j] != 0.) {
-			temp = x[j];
-			i__2 = j - 1;
-			for (i__ = 1; i__ <= i__2; ++i__) {
-			    x[i__] += temp * a[i__ + j * a_dim1];
-/* L10: */
-			}
-			if (nounit) {
-			    x[j] *= a[j + j * a_dim1];
-			}
-		    }
-/* L20: */
-		}
-	    } else {
-		jx = kx;
-		i__1 = *n;
-		for (j = 1; j <= i__1; ++j) {
-		    if (x[jx] != 0.) {
-			temp = x[jx];
-			ix = kx;
-			i__2 = j - 1;
-			for (i__ = 1; i__ <= i__2; ++i__) {
-			    x[ix] += temp * a[i__ + j * a_dim1];
-			    ix += *incx;
-/* L30: */
-			}
-			if (nounit) {
-			    x[jx] *= a[j + j * a_dim1];
-			}
-		    }
-		    jx += *incx;
-/* L40: */
-		}
-	    }
-	} else {
-	    if (*incx == 1) {
-		for (j = *n; j >= 1; --j) {
-		    if (x[j] != 0.) {
-			temp = x[j];
-			i__1 = j + 1;
-			for (i__ = *n; i__ >= i__1; --i__) {
-			    x[i__] += temp * a[i__ + j * a_dim1];
-/* L50: */
-			}
-			if (nounit) {
-			    x[j] *= a[j + j * a_dim1];
-			}
-		    }
-/* L60: */
-		}
-	    } else {
-		kx += (*n - 1) * *incx;
-		jx = kx;
-		for (j = *n; j >= 1; --j) {
-		    if (x[jx] != 0.) {
-			temp = x[jx];
-			ix = kx;
-			i__1 = j + 1;
-			for (i__ = *n; i__ >= i__1; --i__) {
-			    x[ix] += temp * a[i__ + j * a_dim1];
-			    ix -= *incx;
-/* L70: */
-			}
-			if (nounit) {
-			    x[jx] *= a[j + j * a_dim1];
-			}
-		    }
-		    jx -= *incx;
-/* L80: */
-		}
-	    }
-	}
-    } else {
-
-/*        Form  x := A'*x. */
-
-	if (lsame_(uplo, "U")) {
-	    if (*incx == 1) {
-		for (j = *n; j >= 1; --j) {
-		    temp = x[j];
-		    if (nounit) {
-			temp *= a[j + j * a_dim1];
-		    }
-		    for (i__ = j - 1; i__ >= 1; --i__) {
-			temp += a[i__ + j * a_dim1] * x[i__];
-/* L90: */
-		    }
-		    x[j] = temp;
-/* L100: */
-		}
-	    } else {
-		jx = kx + (*n - 1) * *incx;
-		for (j = *n; j >= 1; --j) {
-		    temp = x[jx];
-		    ix = jx;
-		    if (nounit) {
-			temp *= a[j + j * a_dim1];
-		    }
-		    for (i__ = j - 1; i__ >= 1; --i__) {
-			ix -= *incx;
-			temp += a[i__ + j * a_dim1] * x[ix];
-/* L110: */
-		    }
-		    x[jx] = temp;
-		    jx -= *incx;
-/* L120: */
-		}
-	    }
-	} else {
-	    if (*incx == 1) {
-		i__1 = *n;
-		for (j = 1; j <= i__1; ++j) {
-		    temp = x[j];
-		    if (nounit) {
-			temp *= a[j + j * a_dim1];
-		    }
-		    i__2 = *n;
-		    for (i__ = j + 1; i__ <= i__2; ++i__) {
-			temp += a[i__ + j * a_dim1] * x[i__];
-/* L130: */
-		    }
-		    x[j] = temp;
-/* L140: */
-		}
-	    } else {
-		jx = kx;
-		i__1 = *n;
-		for (j = 1; j <= i__1; ++j) {
-		    temp = x[jx];
-		    ix = jx;
-		    if (nounit) {
-			temp *= a[j + j * a_dim1];
-		    }
-		    i__2 = *n;
-		    for (i__ = j + 1; i__ <= i__2; ++i__) {
-			ix += *incx;
-			temp += a[i__ + j * a_dim1] * x[ix];
-/* L150: */
-		    }
-		    x[jx] = temp;
-		    jx += *incx;
-/* L160: */
-		}
-	    }
-	}
-    }
+    zcode = 'Z';
 
-    return 0;
+/*
+       Use 'Z' rather than 'A' so that ASCII can be detected on Prime
+       machines, on which ICHAR returns a value with bit 8 set.
+       ICHAR('A') on Prime machines returns 193 which is the same as
+       ICHAR('A') on an EBCDIC machine.
+*/
 
-/*     End of DTRMV . */
+    inta = *(unsigned char *)ca;
+    intb = *(unsigned char *)cb;
 
-} /* dtrmv_ */
+    if (zcode == 90 || zcode == 122) {
 
-/* Subroutine */ int dtrsm_(char *side, char *uplo, char *transa, char *diag,
-	integer *m, integer *n, doublereal *alpha, doublereal *a, integer *
-	lda, doublereal *b, integer *ldb)
-{
-    /* System generated locals */
-    integer a_dim1, a_offset, b_dim1, b_offset, i__1, i__2, i__3;
+/*
+          ASCII is assumed - ZCODE is the ASCII code of either lower or
+          upper case 'Z'.
+*/
 
-    /* Local variables */
-    static integer i__, j, k, info;
-    static doublereal temp;
-    static logical lside;
-    extern logical lsame_(char *, char *);
-    static integer nrowa;
-    static logical upper;
-    extern /* Subroutine */ int xerbla_(char *, integer *);
-    static logical nounit;
+	if ((inta >= 97 && inta <= 122)) {
+	    inta += -32;
+	}
+	if ((intb >= 97 && intb <= 122)) {
+	    intb += -32;
+	}
 
+    } else if (zcode == 233 || zcode == 169) {
 
 /*
-    Purpose
-    =======
+          EBCDIC is assumed - ZCODE is the EBCDIC code of either lower or
+          upper case 'Z'.
+*/
 
-    DTRSM  solves one of the matrix equations
+	if ((inta >= 129 && inta <= 137) || (inta >= 145 && inta <= 153) || (
+		inta >= 162 && inta <= 169)) {
+	    inta += 64;
+	}
+	if ((intb >= 129 && intb <= 137) || (intb >= 145 && intb <= 153) || (
+		intb >= 162 && intb <= 169)) {
+	    intb += 64;
+	}
 
-       op( A )*X = alpha*B,   or   X*op( A ) = alpha*B,
+    } else if (zcode == 218 || zcode == 250) {
 
-    where alpha is a scalar, X and B are m by n matrices, A is a unit, or
-    non-unit,  upper or lower triangular matrix  and  op( A )  is one  of
+/*
+          ASCII is assumed, on Prime machines - ZCODE is the ASCII code
+          plus 128 of either lower or upper case 'Z'.
+*/
 
-       op( A ) = A   or   op( A ) = A'.
+	if ((inta >= 225 && inta <= 250)) {
+	    inta += -32;
+	}
+	if ((intb >= 225 && intb <= 250)) {
+	    intb += -32;
+	}
+    }
+    ret_val = inta == intb;
 
-    The matrix X is overwritten on B.
+/*
+       RETURN
 
-    Parameters
-    ==========
+       End of LSAME
+*/
 
-    SIDE   - CHARACTER*1.
-             On entry, SIDE specifies whether op( A ) appears on the left
-             or right of X as follows:
+    return ret_val;
+} /* lsame_ */
 
-                SIDE = 'L' or 'l'   op( A )*X = alpha*B.
+/* Using xerbla_ from pythonxerbla.c */
+/* Subroutine */ int xerbla_DISABLE(char *srname, integer *info)
+{
+    /* Format strings */
+    static char fmt_9999[] = "(\002 ** On entry to \002,a6,\002 parameter nu"
+	    "mber \002,i2,\002 had \002,\002an illegal value\002)";
 
-                SIDE = 'R' or 'r'   X*op( A ) = alpha*B.
+    /* Builtin functions */
+    integer s_wsfe(cilist *), do_fio(integer *, char *, ftnlen), e_wsfe(void);
+    /* Subroutine */ int s_stop(char *, ftnlen);
 
-             Unchanged on exit.
+    /* Fortran I/O blocks */
+    static cilist io___147 = { 0, 6, 0, fmt_9999, 0 };
 
-    UPLO   - CHARACTER*1.
-             On entry, UPLO specifies whether the matrix A is an upper or
-             lower triangular matrix as follows:
 
-                UPLO = 'U' or 'u'   A is an upper triangular matrix.
+/*
+    -- LAPACK auxiliary routine (preliminary version) --
+       Univ. of Tennessee, Univ. of California Berkeley, NAG Ltd.,
+       Courant Institute, Argonne National Lab, and Rice University
+       February 29, 1992
 
-                UPLO = 'L' or 'l'   A is a lower triangular matrix.
 
-             Unchanged on exit.
+    Purpose
+    =======
 
-    TRANSA - CHARACTER*1.
-             On entry, TRANSA specifies the form of op( A ) to be used in
-             the matrix multiplication as follows:
+    XERBLA  is an error handler for the LAPACK routines.
+    It is called by an LAPACK routine if an input parameter has an
+    invalid value.  A message is printed and execution stops.
 
-                TRANSA = 'N' or 'n'   op( A ) = A.
+    Installers may consider modifying the STOP statement in order to
+    call system-specific exception-handling facilities.
 
-                TRANSA = 'T' or 't'   op( A ) = A'.
+    Arguments
+    =========
 
-                TRANSA = 'C' or 'c'   op( A ) = A'.
+    SRNAME  (input) CHARACTER*6
+            The name of the routine which called XERBLA.
 
-             Unchanged on exit.
+    INFO    (input) INTEGER
+            The position of the invalid parameter in the parameter list
+            of the calling routine.
+*/
 
-    DIAG   - CHARACTER*1.
-             On entry, DIAG specifies whether or not A is unit triangular
-             as follows:
 
-                DIAG = 'U' or 'u'   A is assumed to be unit triangular.
+    s_wsfe(&io___147);
+    do_fio(&c__1, srname, (ftnlen)6);
+    do_fio(&c__1, (char *)&(*info), (ftnlen)sizeof(integer));
+    e_wsfe();
 
-                DIAG = 'N' or 'n'   A is not assumed to be unit
-                                    triangular.
+    s_stop("", (ftnlen)0);
 
-             Unchanged on exit.
 
-    M      - INTEGER.
-             On entry, M specifies the number of rows of B. M must be at
-             least zero.
-             Unchanged on exit.
+/*     End of XERBLA */
 
-    N      - INTEGER.
-             On entry, N specifies the number of columns of B.  N must be
-             at least zero.
-             Unchanged on exit.
+    return 0;
+} /* xerbla_ */
 
-    ALPHA  - DOUBLE PRECISION.
-             On entry,  ALPHA specifies the scalar  alpha. When  alpha is
-             zero then  A is not referenced and  B need not be set before
-             entry.
-             Unchanged on exit.
+/* Subroutine */ int zaxpy_(integer *n, doublecomplex *za, doublecomplex *zx,
+	integer *incx, doublecomplex *zy, integer *incy)
+{
+    /* System generated locals */
+    integer i__1, i__2, i__3, i__4;
+    doublecomplex z__1, z__2;
 
-    A      - DOUBLE PRECISION array of DIMENSION ( LDA, k ), where k is m
-             when  SIDE = 'L' or 'l'  and is  n  when  SIDE = 'R' or 'r'.
-             Before entry  with  UPLO = 'U' or 'u',  the  leading  k by k
-             upper triangular part of the array  A must contain the upper
-             triangular matrix  and the strictly lower triangular part of
-             A is not referenced.
-             Before entry  with  UPLO = 'L' or 'l',  the  leading  k by k
-             lower triangular part of the array  A must contain the lower
-             triangular matrix  and the strictly upper triangular part of
-             A is not referenced.
-             Note that when  DIAG = 'U' or 'u',  the diagonal elements of
-             A  are not referenced either,  but are assumed to be  unity.
-             Unchanged on exit.
+    /* Local variables */
+    static integer i__, ix, iy;
+    extern doublereal dcabs1_(doublecomplex *);
 
-    LDA    - INTEGER.
-             On entry, LDA specifies the first dimension of A as declared
-             in the calling (sub) program.  When  SIDE = 'L' or 'l'  then
-             LDA  must be at least  max( 1, m ),  when  SIDE = 'R' or 'r'
-             then LDA must be at least max( 1, n ).
-             Unchanged on exit.
 
-    B      - DOUBLE PRECISION array of DIMENSION ( LDB, n ).
-             Before entry,  the leading  m by n part of the array  B must
-             contain  the  right-hand  side  matrix  B,  and  on exit  is
-             overwritten by the solution matrix  X.
+/*
+       constant times a vector plus a vector.
+       jack dongarra, 3/11/78.
+       modified 12/3/93, array(1) declarations changed to array(*)
+*/
 
-    LDB    - INTEGER.
-             On entry, LDB specifies the first dimension of B as declared
-             in  the  calling  (sub)  program.   LDB  must  be  at  least
-             max( 1, m ).
-             Unchanged on exit.
+    /* Parameter adjustments */
+    --zy;
+    --zx;
+
+    /* Function Body */
+    if (*n <= 0) {
+	return 0;
+    }
+    if (dcabs1_(za) == 0.) {
+	return 0;
+    }
+    if ((*incx == 1 && *incy == 1)) {
+	goto L20;
+    }
 
+/*
+          code for unequal increments or equal increments
+            not equal to 1
+*/
 
-    Level 3 Blas routine.
+    ix = 1;
+    iy = 1;
+    if (*incx < 0) {
+	ix = (-(*n) + 1) * *incx + 1;
+    }
+    if (*incy < 0) {
+	iy = (-(*n) + 1) * *incy + 1;
+    }
+    i__1 = *n;
+    for (i__ = 1; i__ <= i__1; ++i__) {
+	i__2 = iy;
+	i__3 = iy;
+	i__4 = ix;
+	z__2.r = za->r * zx[i__4].r - za->i * zx[i__4].i, z__2.i = za->r * zx[
+		i__4].i + za->i * zx[i__4].r;
+	z__1.r = zy[i__3].r + z__2.r, z__1.i = zy[i__3].i + z__2.i;
+	zy[i__2].r = z__1.r, zy[i__2].i = z__1.i;
+	ix += *incx;
+	iy += *incy;
+/* L10: */
+    }
+    return 0;
 
+/*        code for both increments equal to 1 */
 
-    -- Written on 8-February-1989.
-       Jack Dongarra, Argonne National Laboratory.
-       Iain Duff, AERE Harwell.
-       Jeremy Du Croz, Numerical Algorithms Group Ltd.
-       Sven Hammarling, Numerical Algorithms Group Ltd.
+L20:
+    i__1 = *n;
+    for (i__ = 1; i__ <= i__1; ++i__) {
+	i__2 = i__;
+	i__3 = i__;
+	i__4 = i__;
+	z__2.r = za->r * zx[i__4].r - za->i * zx[i__4].i, z__2.i = za->r * zx[
+		i__4].i + za->i * zx[i__4].r;
+	z__1.r = zy[i__3].r + z__2.r, z__1.i = zy[i__3].i + z__2.i;
+	zy[i__2].r = z__1.r, zy[i__2].i = z__1.i;
+/* L30: */
+    }
+    return 0;
+} /* zaxpy_ */
+
+/* Subroutine */ int zcopy_(integer *n, doublecomplex *zx, integer *incx,
+	doublecomplex *zy, integer *incy)
+{
+    /* System generated locals */
+    integer i__1, i__2, i__3;
 
+    /* Local variables */
+    static integer i__, ix, iy;
 
-       Test the input parameters.
+
+/*
+       copies a vector, x, to a vector, y.
+       jack dongarra, linpack, 4/11/78.
+       modified 12/3/93, array(1) declarations changed to array(*)
 */
 
+
     /* Parameter adjustments */
-    a_dim1 = *lda;
-    a_offset = 1 + a_dim1 * 1;
-    a -= a_offset;
-    b_dim1 = *ldb;
-    b_offset = 1 + b_dim1 * 1;
-    b -= b_offset;
+    --zy;
+    --zx;
 
     /* Function Body */
-    lside = lsame_(side, "L");
-    if (lside) {
-	nrowa = *m;
-    } else {
-	nrowa = *n;
-    }
-    nounit = lsame_(diag, "N");
-    upper = lsame_(uplo, "U");
-
-    info = 0;
-    if ((! lside && ! lsame_(side, "R"))) {
-	info = 1;
-    } else if ((! upper && ! lsame_(uplo, "L"))) {
-	info = 2;
-    } else if (((! lsame_(transa, "N") && ! lsame_(
-	    transa, "T")) && ! lsame_(transa, "C"))) {
-	info = 3;
-    } else if ((! lsame_(diag, "U") && ! lsame_(diag,
-	    "N"))) {
-	info = 4;
-    } else if (*m < 0) {
-	info = 5;
-    } else if (*n < 0) {
-	info = 6;
-    } else if (*lda < max(1,nrowa)) {
-	info = 9;
-    } else if (*ldb < max(1,*m)) {
-	info = 11;
-    }
-    if (info != 0) {
-	xerbla_("DTRSM ", &info);
+    if (*n <= 0) {
 	return 0;
     }
-
-/*     Quick return if possible. */
-
-    if (*n == 0) {
-	return 0;
+    if ((*incx == 1 && *incy == 1)) {
+	goto L20;
     }
 
-/*     And when  alpha.eq.zero. */
+/*
+          code for unequal increments or equal increments
+            not equal to 1
+*/
 
-    if (*alpha == 0.) {
-	i__1 = *n;
-	for (j = 1; j <= i__1; ++j) {
-	    i__2 = *m;
-	    for (i__ = 1; i__ <= i__2; ++i__) {
-		b[i__ + j * b_dim1] = 0.;
+    ix = 1;
+    iy = 1;
+    if (*incx < 0) {
+	ix = (-(*n) + 1) * *incx + 1;
+    }
+    if (*incy < 0) {
+	iy = (-(*n) + 1) * *incy + 1;
+    }
+    i__1 = *n;
+    for (i__ = 1; i__ <= i__1; ++i__) {
+	i__2 = iy;
+	i__3 = ix;
+	zy[i__2].r = zx[i__3].r, zy[i__2].i = zx[i__3].i;
+	ix += *incx;
+	iy += *incy;
 /* L10: */
-	    }
-/* L20: */
-	}
-	return 0;
     }
+    return 0;
 
-/*     Start the operations. */
-
-    if (lside) {
-	if (lsame_(transa, "N")) {
-
-/*           Form  B := alpha*inv( A )*B. */
-
-	    if (upper) {
-		i__1 = *n;
-		for (j = 1; j <= i__1; ++j) {
-		    if (*alpha != 1.) {
-			i__2 = *m;
-			for (i__ = 1; i__ <= i__2; ++i__) {
-			    b[i__ + j * b_dim1] = *alpha * b[i__ + j * b_dim1]
-				    ;
-/* L30: */
-			}
-		    }
-		    for (k = *m; k >= 1; --k) {
-			if (b[k + j * b_dim1] != 0.) {
-			    if (nounit) {
-				b[k + j * b_dim1] /= a[k + k * a_dim1];
-			    }
-			    i__2 = k - 1;
-			    for (i__ = 1; i__ <= i__2; ++i__) {
-				b[i__ + j * b_dim1] -= b[k + j * b_dim1] * a[
-					i__ + k * a_dim1];
-/* L40: */
-			    }
-			}
-/* L50: */
-		    }
-/* L60: */
-		}
-	    } else {
-		i__1 = *n;
-		for (j = 1; j <= i__1; ++j) {
-		    if (*alpha != 1.) {
-			i__2 = *m;
-			for (i__ = 1; i__ <= i__2; ++i__) {
-			    b[i__ + j * b_dim1] = *alpha * b[i__ + j * b_dim1]
-				    ;
-/* L70: */
-			}
-		    }
-		    i__2 = *m;
-		    for (k = 1; k <= i__2; ++k) {
-			if (b[k + j * b_dim1] != 0.) {
-			    if (nounit) {
-				b[k + j * b_dim1] /= a[k + k * a_dim1];
-			    }
-			    i__3 = *m;
-			    for (i__ = k + 1; i__ <= i__3; ++i__) {
-				b[i__ + j * b_dim1] -= b[k + j * b_dim1] * a[
-					i__ + k * a_dim1];
-/* L80: */
-			    }
-			}
-/* L90: */
-		    }
-/* L100: */
-		}
-	    }
-	} else {
-
-/*           Form  B := alpha*inv( A' )*B. */
-
-	    if (upper) {
-		i__1 = *n;
-		for (j = 1; j <= i__1; ++j) {
-		    i__2 = *m;
-		    for (i__ = 1; i__ <= i__2; ++i__) {
-			temp = *alpha * b[i__ + j * b_dim1];
-			i__3 = i__ - 1;
-			for (k = 1; k <= i__3; ++k) {
-			    temp -= a[k + i__ * a_dim1] * b[k + j * b_dim1];
-/* L110: */
-			}
-			if (nounit) {
-			    temp /= a[i__ + i__ * a_dim1];
-			}
-			b[i__ + j * b_dim1] = temp;
-/* L120: */
-		    }
-/* L130: */
-		}
-	    } else {
-		i__1 = *n;
-		for (j = 1; j <= i__1; ++j) {
-		    for (i__ = *m; i__ >= 1; --i__) {
-			temp = *alpha * b[i__ + j * b_dim1];
-			i__2 = *m;
-			for (k = i__ + 1; k <= i__2; ++k) {
-			    temp -= a[k + i__ * a_dim1] * b[k + j * b_dim1];
-/* L140: */
-			}
-			if (nounit) {
-			    temp /= a[i__ + i__ * a_dim1];
-			}
-			b[i__ + j * b_dim1] = temp;
-/* L150: */
-		    }
-/* L160: */
-		}
-	    }
-	}
-    } else {
-	if (lsame_(transa, "N")) {
-
-/*           Form  B := alpha*B*inv( A ). */
-
-	    if (upper) {
-		i__1 = *n;
-		for (j = 1; j <= i__1; ++j) {
-		    if (*alpha != 1.) {
-			i__2 = *m;
-			for (i__ = 1; i__ <= i__2; ++i__) {
-			    b[i__ + j * b_dim1] = *alpha * b[i__ + j * b_dim1]
-				    ;
-/* L170: */
-			}
-		    }
-		    i__2 = j - 1;
-		    for (k = 1; k <= i__2; ++k) {
-			if (a[k + j * a_dim1] != 0.) {
-			    i__3 = *m;
-			    for (i__ = 1; i__ <= i__3; ++i__) {
-				b[i__ + j * b_dim1] -= a[k + j * a_dim1] * b[
-					i__ + k * b_dim1];
-/* L180: */
-			    }
-			}
-/* L190: */
-		    }
-		    if (nounit) {
-			temp = 1. / a[j + j * a_dim1];
-			i__2 = *m;
-			for (i__ = 1; i__ <= i__2; ++i__) {
-			    b[i__ + j * b_dim1] = temp * b[i__ + j * b_dim1];
-/* L200: */
-			}
-		    }
-/* L210: */
-		}
-	    } else {
-		for (j = *n; j >= 1; --j) {
-		    if (*alpha != 1.) {
-			i__1 = *m;
-			for (i__ = 1; i__ <= i__1; ++i__) {
-			    b[i__ + j * b_dim1] = *alpha * b[i__ + j * b_dim1]
-				    ;
-/* L220: */
-			}
-		    }
-		    i__1 = *n;
-		    for (k = j + 1; k <= i__1; ++k) {
-			if (a[k + j * a_dim1] != 0.) {
-			    i__2 = *m;
-			    for (i__ = 1; i__ <= i__2; ++i__) {
-				b[i__ + j * b_dim1] -= a[k + j * a_dim1] * b[
-					i__ + k * b_dim1];
-/* L230: */
-			    }
-			}
-/* L240: */
-		    }
-		    if (nounit) {
-			temp = 1. / a[j + j * a_dim1];
-			i__1 = *m;
-			for (i__ = 1; i__ <= i__1; ++i__) {
-			    b[i__ + j * b_dim1] = temp * b[i__ + j * b_dim1];
-/* L250: */
-			}
-		    }
-/* L260: */
-		}
-	    }
-	} else {
-
-/*           Form  B := alpha*B*inv( A' ). */
-
-	    if (upper) {
-		for (k = *n; k >= 1; --k) {
-		    if (nounit) {
-			temp = 1. / a[k + k * a_dim1];
-			i__1 = *m;
-			for (i__ = 1; i__ <= i__1; ++i__) {
-			    b[i__ + k * b_dim1] = temp * b[i__ + k * b_dim1];
-/* L270: */
-			}
-		    }
-		    i__1 = k - 1;
-		    for (j = 1; j <= i__1; ++j) {
-			if (a[j + k * a_dim1] != 0.) {
-			    temp = a[j + k * a_dim1];
-			    i__2 = *m;
-			    for (i__ = 1; i__ <= i__2; ++i__) {
-				b[i__ + j * b_dim1] -= temp * b[i__ + k *
-					b_dim1];
-/* L280: */
-			    }
-			}
-/* L290: */
-		    }
-		    if (*alpha != 1.) {
-			i__1 = *m;
-			for (i__ = 1; i__ <= i__1; ++i__) {
-			    b[i__ + k * b_dim1] = *alpha * b[i__ + k * b_dim1]
-				    ;
-/* L300: */
-			}
-		    }
-/* L310: */
-		}
-	    } else {
-		i__1 = *n;
-		for (k = 1; k <= i__1; ++k) {
-		    if (nounit) {
-			temp = 1. / a[k + k * a_dim1];
-			i__2 = *m;
-			for (i__ = 1; i__ <= i__2; ++i__) {
-			    b[i__ + k * b_dim1] = temp * b[i__ + k * b_dim1];
-/* L320: */
-			}
-		    }
-		    i__2 = *n;
-		    for (j = k + 1; j <= i__2; ++j) {
-			if (a[j + k * a_dim1] != 0.) {
-			    temp = a[j + k * a_dim1];
-			    i__3 = *m;
-			    for (i__ = 1; i__ <= i__3; ++i__) {
-				b[i__ + j * b_dim1] -= temp * b[i__ + k *
-					b_dim1];
-/* L330: */
-			    }
-			}
-/* L340: */
-		    }
-		    if (*alpha != 1.) {
-			i__2 = *m;
-			for (i__ = 1; i__ <= i__2; ++i__) {
-			    b[i__ + k * b_dim1] = *alpha * b[i__ + k * b_dim1]
-				    ;
-/* L350: */
-			}
-		    }
-/* L360: */
-		}
-	    }
-	}
-    }
-
-    return 0;
-
-/*     End of DTRSM . */
-
-} /* dtrsm_ */
-
-doublereal dzasum_(integer *n, doublecomplex *zx, integer *incx)
-{
-    /* System generated locals */
-    integer i__1;
-    doublereal ret_val;
-
-    /* Local variables */
-    static integer i__, ix;
-    static doublereal stemp;
-    extern doublereal dcabs1_(doublecomplex *);
-
-
-/*
-       takes the sum of the absolute values.
-       jack dongarra, 3/11/78.
-       modified 3/93 to return if incx .le. 0.
-       modified 12/3/93, array(1) declarations changed to array(*)
-*/
-
-
-    /* Parameter adjustments */
-    --zx;
-
-    /* Function Body */
-    ret_val = 0.;
-    stemp = 0.;
-    if (*n <= 0 || *incx <= 0) {
-	return ret_val;
-    }
-    if (*incx == 1) {
-	goto L20;
-    }
-
-/*        code for increment not equal to 1 */
-
-    ix = 1;
-    i__1 = *n;
-    for (i__ = 1; i__ <= i__1; ++i__) {
-	stemp += dcabs1_(&zx[ix]);
-	ix += *incx;
-/* L10: */
-    }
-    ret_val = stemp;
-    return ret_val;
-
-/*        code for increment equal to 1 */
-
-L20:
-    i__1 = *n;
-    for (i__ = 1; i__ <= i__1; ++i__) {
-	stemp += dcabs1_(&zx[i__]);
-/* L30: */
-    }
-    ret_val = stemp;
-    return ret_val;
-} /* dzasum_ */
-
-doublereal dznrm2_(integer *n, doublecomplex *x, integer *incx)
-{
-    /* System generated locals */
-    integer i__1, i__2, i__3;
-    doublereal ret_val, d__1;
-
-    /* Builtin functions */
-    double d_imag(doublecomplex *), sqrt(doublereal);
-
-    /* Local variables */
-    static integer ix;
-    static doublereal ssq, temp, norm, scale;
-
-
-/*
-    DZNRM2 returns the euclidean norm of a vector via the function
-    name, so that
-
-       DZNRM2 := sqrt( conjg( x' )*x )
-
-
-    -- This version written on 25-October-1982.
-       Modified on 14-October-1993 to inline the call to ZLASSQ.
-       Sven Hammarling, Nag Ltd.
-*/
-
-
-    /* Parameter adjustments */
-    --x;
-
-    /* Function Body */
-    if (*n < 1 || *incx < 1) {
-	norm = 0.;
-    } else {
-	scale = 0.;
-	ssq = 1.;
-/*
-          The following loop is equivalent to this call to the LAPACK
-          auxiliary routine:
-          CALL ZLASSQ( N, X, INCX, SCALE, SSQ )
-*/
-
-	i__1 = (*n - 1) * *incx + 1;
-	i__2 = *incx;
-	for (ix = 1; i__2 < 0 ? ix >= i__1 : ix <= i__1; ix += i__2) {
-	    i__3 = ix;
-	    if (x[i__3].r != 0.) {
-		i__3 = ix;
-		temp = (d__1 = x[i__3].r, abs(d__1));
-		if (scale < temp) {
-/* Computing 2nd power */
-		    d__1 = scale / temp;
-		    ssq = ssq * (d__1 * d__1) + 1.;
-		    scale = temp;
-		} else {
-/* Computing 2nd power */
-		    d__1 = temp / scale;
-		    ssq += d__1 * d__1;
-		}
-	    }
-	    if (d_imag(&x[ix]) != 0.) {
-		temp = (d__1 = d_imag(&x[ix]), abs(d__1));
-		if (scale < temp) {
-/* Computing 2nd power */
-		    d__1 = scale / temp;
-		    ssq = ssq * (d__1 * d__1) + 1.;
-		    scale = temp;
-		} else {
-/* Computing 2nd power */
-		    d__1 = temp / scale;
-		    ssq += d__1 * d__1;
-		}
-	    }
-/* L10: */
-	}
-	norm = scale * sqrt(ssq);
-    }
-
-    ret_val = norm;
-    return ret_val;
-
-/*     End of DZNRM2. */
-
-} /* dznrm2_ */
-
-integer idamax_(integer *n, doublereal *dx, integer *incx)
-{
-    /* System generated locals */
-    integer ret_val, i__1;
-    doublereal d__1;
-
-    /* Local variables */
-    static integer i__, ix;
-    static doublereal dmax__;
-
-
-/*
-       finds the index of element having max. absolute value.
-       jack dongarra, linpack, 3/11/78.
-       modified 3/93 to return if incx .le. 0.
-       modified 12/3/93, array(1) declarations changed to array(*)
-*/
-
-
-    /* Parameter adjustments */
-    --dx;
-
-    /* Function Body */
-    ret_val = 0;
-    if (*n < 1 || *incx <= 0) {
-	return ret_val;
-    }
-    ret_val = 1;
-    if (*n == 1) {
-	return ret_val;
-    }
-    if (*incx == 1) {
-	goto L20;
-    }
-
-/*        code for increment not equal to 1 */
-
-    ix = 1;
-    dmax__ = abs(dx[1]);
-    ix += *incx;
-    i__1 = *n;
-    for (i__ = 2; i__ <= i__1; ++i__) {
-	if ((d__1 = dx[ix], abs(d__1)) <= dmax__) {
-	    goto L5;
-	}
-	ret_val = i__;
-	dmax__ = (d__1 = dx[ix], abs(d__1));
-L5:
-	ix += *incx;
-/* L10: */
-    }
-    return ret_val;
-
-/*        code for increment equal to 1 */
-
-L20:
-    dmax__ = abs(dx[1]);
-    i__1 = *n;
-    for (i__ = 2; i__ <= i__1; ++i__) {
-	if ((d__1 = dx[i__], abs(d__1)) <= dmax__) {
-	    goto L30;
-	}
-	ret_val = i__;
-	dmax__ = (d__1 = dx[i__], abs(d__1));
-L30:
-	;
-    }
-    return ret_val;
-} /* idamax_ */
-
-integer izamax_(integer *n, doublecomplex *zx, integer *incx)
-{
-    /* System generated locals */
-    integer ret_val, i__1;
-
-    /* Local variables */
-    static integer i__, ix;
-    static doublereal smax;
-    extern doublereal dcabs1_(doublecomplex *);
-
-
-/*
-       finds the index of element having max. absolute value.
-       jack dongarra, 1/15/85.
-       modified 3/93 to return if incx .le. 0.
-       modified 12/3/93, array(1) declarations changed to array(*)
-*/
-
-
-    /* Parameter adjustments */
-    --zx;
-
-    /* Function Body */
-    ret_val = 0;
-    if (*n < 1 || *incx <= 0) {
-	return ret_val;
-    }
-    ret_val = 1;
-    if (*n == 1) {
-	return ret_val;
-    }
-    if (*incx == 1) {
-	goto L20;
-    }
-
-/*        code for increment not equal to 1 */
-
-    ix = 1;
-    smax = dcabs1_(&zx[1]);
-    ix += *incx;
-    i__1 = *n;
-    for (i__ = 2; i__ <= i__1; ++i__) {
-	if (dcabs1_(&zx[ix]) <= smax) {
-	    goto L5;
-	}
-	ret_val = i__;
-	smax = dcabs1_(&zx[ix]);
-L5:
-	ix += *incx;
-/* L10: */
-    }
-    return ret_val;
-
-/*        code for increment equal to 1 */
-
-L20:
-    smax = dcabs1_(&zx[1]);
-    i__1 = *n;
-    for (i__ = 2; i__ <= i__1; ++i__) {
-	if (dcabs1_(&zx[i__]) <= smax) {
-	    goto L30;
-	}
-	ret_val = i__;
-	smax = dcabs1_(&zx[i__]);
-L30:
-	;
-    }
-    return ret_val;
-} /* izamax_ */
-
-logical lsame_(char *ca, char *cb)
-{
-    /* System generated locals */
-    logical ret_val;
-
-    /* Local variables */
-    static integer inta, intb, zcode;
-
-
-/*
-    -- LAPACK auxiliary routine (version 3.0) --
-       Univ. of Tennessee, Univ. of California Berkeley, NAG Ltd.,
-       Courant Institute, Argonne National Lab, and Rice University
-       September 30, 1994
-
-
-    Purpose
-    =======
-
-    LSAME returns .TRUE. if CA is the same letter as CB regardless of
-    case.
-
-    Arguments
-    =========
-
-    CA      (input) CHARACTER*1
-    CB      (input) CHARACTER*1
-            CA and CB specify the single characters to be compared.
-
-   =====================================================================
-
-
-       Test if the characters are equal
-*/
-
-    ret_val = *(unsigned char *)ca == *(unsigned char *)cb;
-    if (ret_val) {
-	return ret_val;
-    }
-
-/*     Now test for equivalence if both characters are alphabetic. */
-
-    zcode = 'Z';
-
-/*
-       Use 'Z' rather than 'A' so that ASCII can be detected on Prime
-       machines, on which ICHAR returns a value with bit 8 set.
-       ICHAR('A') on Prime machines returns 193 which is the same as
-       ICHAR('A') on an EBCDIC machine.
-*/
-
-    inta = *(unsigned char *)ca;
-    intb = *(unsigned char *)cb;
-
-    if (zcode == 90 || zcode == 122) {
-
-/*
-          ASCII is assumed - ZCODE is the ASCII code of either lower or
-          upper case 'Z'.
-*/
-
-	if ((inta >= 97 && inta <= 122)) {
-	    inta += -32;
-	}
-	if ((intb >= 97 && intb <= 122)) {
-	    intb += -32;
-	}
-
-    } else if (zcode == 233 || zcode == 169) {
-
-/*
-          EBCDIC is assumed - ZCODE is the EBCDIC code of either lower or
-          upper case 'Z'.
-*/
-
-	if ((inta >= 129 && inta <= 137) || (inta >= 145 && inta <= 153) || (
-		inta >= 162 && inta <= 169)) {
-	    inta += 64;
-	}
-	if ((intb >= 129 && intb <= 137) || (intb >= 145 && intb <= 153) || (
-		intb >= 162 && intb <= 169)) {
-	    intb += 64;
-	}
-
-    } else if (zcode == 218 || zcode == 250) {
-
-/*
-          ASCII is assumed, on Prime machines - ZCODE is the ASCII code
-          plus 128 of either lower or upper case 'Z'.
-*/
-
-	if ((inta >= 225 && inta <= 250)) {
-	    inta += -32;
-	}
-	if ((intb >= 225 && intb <= 250)) {
-	    intb += -32;
-	}
-    }
-    ret_val = inta == intb;
-
-/*
-       RETURN
-
-       End of LSAME
-*/
-
-    return ret_val;
-} /* lsame_ */
-
-/* Using xerbla_ from pythonxerbla.c */
-/* Subroutine */ int xerbla_DISABLE(char *srname, integer *info)
-{
-    /* Format strings */
-    static char fmt_9999[] = "(\002 ** On entry to \002,a6,\002 parameter nu"
-	    "mber \002,i2,\002 had \002,\002an illegal value\002)";
-
-    /* Builtin functions */
-    integer s_wsfe(cilist *), do_fio(integer *, char *, ftnlen), e_wsfe(void);
-    /* Subroutine */ int s_stop(char *, ftnlen);
-
-    /* Fortran I/O blocks */
-    static cilist io___147 = { 0, 6, 0, fmt_9999, 0 };
-
-
-/*
-    -- LAPACK auxiliary routine (preliminary version) --
-       Univ. of Tennessee, Univ. of California Berkeley, NAG Ltd.,
-       Courant Institute, Argonne National Lab, and Rice University
-       February 29, 1992
-
-
-    Purpose
-    =======
-
-    XERBLA  is an error handler for the LAPACK routines.
-    It is called by an LAPACK routine if an input parameter has an
-    invalid value.  A message is printed and execution stops.
-
-    Installers may consider modifying the STOP statement in order to
-    call system-specific exception-handling facilities.
-
-    Arguments
-    =========
-
-    SRNAME  (input) CHARACTER*6
-            The name of the routine which called XERBLA.
-
-    INFO    (input) INTEGER
-            The position of the invalid parameter in the parameter list
-            of the calling routine.
-*/
-
-
-    s_wsfe(&io___147);
-    do_fio(&c__1, srname, (ftnlen)6);
-    do_fio(&c__1, (char *)&(*info), (ftnlen)sizeof(integer));
-    e_wsfe();
-
-    s_stop("", (ftnlen)0);
-
-
-/*     End of XERBLA */
-
-    return 0;
-} /* xerbla_ */
-
-/* Subroutine */ int zaxpy_(integer *n, doublecomplex *za, doublecomplex *zx,
-	integer *incx, doublecomplex *zy, integer *incy)
-{
-    /* System generated locals */
-    integer i__1, i__2, i__3, i__4;
-    doublecomplex z__1, z__2;
-
-    /* Local variables */
-    static integer i__, ix, iy;
-    extern doublereal dcabs1_(doublecomplex *);
-
-
-/*
-       constant times a vector plus a vector.
-       jack dongarra, 3/11/78.
-       modified 12/3/93, array(1) declarations changed to array(*)
-*/
-
-    /* Parameter adjustments */
-    --zy;
-    --zx;
-
-    /* Function Body */
-    if (*n <= 0) {
-	return 0;
-    }
-    if (dcabs1_(za) == 0.) {
-	return 0;
-    }
-    if ((*incx == 1 && *incy == 1)) {
-	goto L20;
-    }
-
-/*
-          code for unequal increments or equal increments
-            not equal to 1
-*/
-
-    ix = 1;
-    iy = 1;
-    if (*incx < 0) {
-	ix = (-(*n) + 1) * *incx + 1;
-    }
-    if (*incy < 0) {
-	iy = (-(*n) + 1) * *incy + 1;
-    }
-    i__1 = *n;
-    for (i__ = 1; i__ <= i__1; ++i__) {
-	i__2 = iy;
-	i__3 = iy;
-	i__4 = ix;
-	z__2.r = za->r * zx[i__4].r - za->i * zx[i__4].i, z__2.i = za->r * zx[
-		i__4].i + za->i * zx[i__4].r;
-	z__1.r = zy[i__3].r + z__2.r, z__1.i = zy[i__3].i + z__2.i;
-	zy[i__2].r = z__1.r, zy[i__2].i = z__1.i;
-	ix += *incx;
-	iy += *incy;
-/* L10: */
-    }
-    return 0;
-
-/*        code for both increments equal to 1 */
-
-L20:
-    i__1 = *n;
-    for (i__ = 1; i__ <= i__1; ++i__) {
-	i__2 = i__;
-	i__3 = i__;
-	i__4 = i__;
-	z__2.r = za->r * zx[i__4].r - za->i * zx[i__4].i, z__2.i = za->r * zx[
-		i__4].i + za->i * zx[i__4].r;
-	z__1.r = zy[i__3].r + z__2.r, z__1.i = zy[i__3].i + z__2.i;
-	zy[i__2].r = z__1.r, zy[i__2].i = z__1.i;
-/* L30: */
-    }
-    return 0;
-} /* zaxpy_ */
-
-/* Subroutine */ int zcopy_(integer *n, doublecomplex *zx, integer *incx,
-	doublecomplex *zy, integer *incy)
-{
-    /* System generated locals */
-    integer i__1, i__2, i__3;
-
-    /* Local variables */
-    static integer i__, ix, iy;
-
-
-/*
-       copies a vector, x, to a vector, y.
-       jack dongarra, linpack, 4/11/78.
-       modified 12/3/93, array(1) declarations changed to array(*)
-*/
-
-
-    /* Parameter adjustments */
-    --zy;
-    --zx;
-
-    /* Function Body */
-    if (*n <= 0) {
-	return 0;
-    }
-    if ((*incx == 1 && *incy == 1)) {
-	goto L20;
-    }
-
-/*
-          code for unequal increments or equal increments
-            not equal to 1
-*/
-
-    ix = 1;
-    iy = 1;
-    if (*incx < 0) {
-	ix = (-(*n) + 1) * *incx + 1;
-    }
-    if (*incy < 0) {
-	iy = (-(*n) + 1) * *incy + 1;
-    }
-    i__1 = *n;
-    for (i__ = 1; i__ <= i__1; ++i__) {
-	i__2 = iy;
-	i__3 = ix;
-	zy[i__2].r = zx[i__3].r, zy[i__2].i = zx[i__3].i;
-	ix += *incx;
-	iy += *incy;
-/* L10: */
-    }
-    return 0;
-
-/*        code for both increments equal to 1 */
-
-L20:
-    i__1 = *n;
-    for (i__ = 1; i__ <= i__1; ++i__) {
-	i__2 = i__;
-	i__3 = i__;
-	zy[i__2].r = zx[i__3].r, zy[i__2].i = zx[i__3].i;
-/* L30: */
-    }
-    return 0;
-} /* zcopy_ */
-
-/* Double Complex */ VOID zdotc_(doublecomplex * ret_val, integer *n,
-	doublecomplex *zx, integer *incx, doublecomplex *zy, integer *incy)
-{
-    /* System generated locals */
-    integer i__1, i__2;
-    doublecomplex z__1, z__2, z__3;
-
-    /* Builtin functions */
-    void d_cnjg(doublecomplex *, doublecomplex *);
-
-    /* Local variables */
-    static integer i__, ix, iy;
-    static doublecomplex ztemp;
-
-
-/*
-       forms the dot product of a vector.
-       jack dongarra, 3/11/78.
-       modified 12/3/93, array(1) declarations changed to array(*)
-*/
-
-    /* Parameter adjustments */
-    --zy;
-    --zx;
-
-    /* Function Body */
-    ztemp.r = 0., ztemp.i = 0.;
-     ret_val->r = 0.,  ret_val->i = 0.;
-    if (*n <= 0) {
-	return ;
-    }
-    if ((*incx == 1 && *incy == 1)) {
-	goto L20;
-    }
-
-/*
-          code for unequal increments or equal increments
-            not equal to 1
-*/
-
-    ix = 1;
-    iy = 1;
-    if (*incx < 0) {
-	ix = (-(*n) + 1) * *incx + 1;
-    }
-    if (*incy < 0) {
-	iy = (-(*n) + 1) * *incy + 1;
-    }
-    i__1 = *n;
-    for (i__ = 1; i__ <= i__1; ++i__) {
-	d_cnjg(&z__3, &zx[ix]);
-	i__2 = iy;
-	z__2.r = z__3.r * zy[i__2].r - z__3.i * zy[i__2].i, z__2.i = z__3.r *
-		zy[i__2].i + z__3.i * zy[i__2].r;
-	z__1.r = ztemp.r + z__2.r, z__1.i = ztemp.i + z__2.i;
-	ztemp.r = z__1.r, ztemp.i = z__1.i;
-	ix += *incx;
-	iy += *incy;
-/* L10: */
-    }
-     ret_val->r = ztemp.r,  ret_val->i = ztemp.i;
-    return ;
-
-/*        code for both increments equal to 1 */
-
-L20:
-    i__1 = *n;
-    for (i__ = 1; i__ <= i__1; ++i__) {
-	d_cnjg(&z__3, &zx[i__]);
-	i__2 = i__;
-	z__2.r = z__3.r * zy[i__2].r - z__3.i * zy[i__2].i, z__2.i = z__3.r *
-		zy[i__2].i + z__3.i * zy[i__2].r;
-	z__1.r = ztemp.r + z__2.r, z__1.i = ztemp.i + z__2.i;
-	ztemp.r = z__1.r, ztemp.i = z__1.i;
-/* L30: */
-    }
-     ret_val->r = ztemp.r,  ret_val->i = ztemp.i;
-    return ;
-} /* zdotc_ */
-
-/* Double Complex */ VOID zdotu_(doublecomplex * ret_val, integer *n,
-	doublecomplex *zx, integer *incx, doublecomplex *zy, integer *incy)
-{
-    /* System generated locals */
-    integer i__1, i__2, i__3;
-    doublecomplex z__1, z__2;
-
-    /* Local variables */
-    static integer i__, ix, iy;
-    static doublecomplex ztemp;
-
-
-/*
-       forms the dot product of two vectors.
-       jack dongarra, 3/11/78.
-       modified 12/3/93, array(1) declarations changed to array(*)
-*/
-
-    /* Parameter adjustments */
-    --zy;
-    --zx;
-
-    /* Function Body */
-    ztemp.r = 0., ztemp.i = 0.;
-     ret_val->r = 0.,  ret_val->i = 0.;
-    if (*n <= 0) {
-	return ;
-    }
-    if ((*incx == 1 && *incy == 1)) {
-	goto L20;
-    }
-
-/*
-          code for unequal increments or equal increments
-            not equal to 1
-*/
-
-    ix = 1;
-    iy = 1;
-    if (*incx < 0) {
-	ix = (-(*n) + 1) * *incx + 1;
-    }
-    if (*incy < 0) {
-	iy = (-(*n) + 1) * *incy + 1;
-    }
-    i__1 = *n;
-    for (i__ = 1; i__ <= i__1; ++i__) {
-	i__2 = ix;
-	i__3 = iy;
-	z__2.r = zx[i__2].r * zy[i__3].r - zx[i__2].i * zy[i__3].i, z__2.i =
-		zx[i__2].r * zy[i__3].i + zx[i__2].i * zy[i__3].r;
-	z__1.r = ztemp.r + z__2.r, z__1.i = ztemp.i + z__2.i;
-	ztemp.r = z__1.r, ztemp.i = z__1.i;
-	ix += *incx;
-	iy += *incy;
-/* L10: */
-    }
-     ret_val->r = ztemp.r,  ret_val->i = ztemp.i;
-    return ;
-
-/*        code for both increments equal to 1 */
-
-L20:
-    i__1 = *n;
-    for (i__ = 1; i__ <= i__1; ++i__) {
-	i__2 = i__;
-	i__3 = i__;
-	z__2.r = zx[i__2].r * zy[i__3].r - zx[i__2].i * zy[i__3].i, z__2.i =
-		zx[i__2].r * zy[i__3].i + zx[i__2].i * zy[i__3].r;
-	z__1.r = ztemp.r + z__2.r, z__1.i = ztemp.i + z__2.i;
-	ztemp.r = z__1.r, ztemp.i = z__1.i;
-/* L30: */
-    }
-     ret_val->r = ztemp.r,  ret_val->i = ztemp.i;
-    return ;
-} /* zdotu_ */
-
-/* Subroutine */ int zdscal_(integer *n, doublereal *da, doublecomplex *zx,
-	integer *incx)
-{
-    /* System generated locals */
-    integer i__1, i__2, i__3;
-    doublecomplex z__1, z__2;
-
-    /* Local variables */
-    static integer i__, ix;
-
-
-/*
-       scales a vector by a constant.
-       jack dongarra, 3/11/78.
-       modified 3/93 to return if incx .le. 0.
-       modified 12/3/93, array(1) declarations changed to array(*)
-*/
-
-
-    /* Parameter adjustments */
-    --zx;
-
-    /* Function Body */
-    if (*n <= 0 || *incx <= 0) {
-	return 0;
-    }
-    if (*incx == 1) {
-	goto L20;
-    }
-
-/*        code for increment not equal to 1 */
-
-    ix = 1;
-    i__1 = *n;
-    for (i__ = 1; i__ <= i__1; ++i__) {
-	i__2 = ix;
-	z__2.r = *da, z__2.i = 0.;
-	i__3 = ix;
-	z__1.r = z__2.r * zx[i__3].r - z__2.i * zx[i__3].i, z__1.i = z__2.r *
-		zx[i__3].i + z__2.i * zx[i__3].r;
-	zx[i__2].r = z__1.r, zx[i__2].i = z__1.i;
-	ix += *incx;
-/* L10: */
-    }
-    return 0;
-
-/*        code for increment equal to 1 */
+/*        code for both increments equal to 1 */
 
 L20:
     i__1 = *n;
     for (i__ = 1; i__ <= i__1; ++i__) {
 	i__2 = i__;
-	z__2.r = *da, z__2.i = 0.;
 	i__3 = i__;
-	z__1.r = z__2.r * zx[i__3].r - z__2.i * zx[i__3].i, z__1.i = z__2.r *
-		zx[i__3].i + z__2.i * zx[i__3].r;
-	zx[i__2].r = z__1.r, zx[i__2].i = z__1.i;
+	zy[i__2].r = zx[i__3].r, zy[i__2].i = zx[i__3].i;
 /* L30: */
     }
     return 0;
-} /* zdscal_ */
+} /* zcopy_ */
 
-/* Subroutine */ int zgemm_(char *transa, char *transb, integer *m, integer *
-	n, integer *k, doublecomplex *alpha, doublecomplex *a, integer *lda,
-	doublecomplex *b, integer *ldb, doublecomplex *beta, doublecomplex *
-	c__, integer *ldc)
+/* Double Complex */ VOID zdotc_(doublecomplex * ret_val, integer *n,
+	doublecomplex *zx, integer *incx, doublecomplex *zy, integer *incy)
 {
     /* System generated locals */
-    integer a_dim1, a_offset, b_dim1, b_offset, c_dim1, c_offset, i__1, i__2,
-	    i__3, i__4, i__5, i__6;
-    doublecomplex z__1, z__2, z__3, z__4;
+    integer i__1, i__2;
+    doublecomplex z__1, z__2, z__3;
 
     /* Builtin functions */
     void d_cnjg(doublecomplex *, doublecomplex *);
 
     /* Local variables */
-    static integer i__, j, l, info;
-    static logical nota, notb;
-    static doublecomplex temp;
-    static logical conja, conjb;
-    static integer ncola;
-    extern logical lsame_(char *, char *);
-    static integer nrowa, nrowb;
-    extern /* Subroutine */ int xerbla_(char *, integer *);
+    static integer i__, ix, iy;
+    static doublecomplex ztemp;
 
 
 /*
-    Purpose
-    =======
-
-    ZGEMM  performs one of the matrix-matrix operations
-
-       C := alpha*op( A )*op( B ) + beta*C,
-
-    where  op( X ) is one of
-
-       op( X ) = X   or   op( X ) = X'   or   op( X ) = conjg( X' ),
-
-    alpha and beta are scalars, and A, B and C are matrices, with op( A )
-    an m by k matrix,  op( B )  a  k by n matrix and  C an m by n matrix.
-
-    Parameters
-    ==========
-
-    TRANSA - CHARACTER*1.
-             On entry, TRANSA specifies the form of op( A ) to be used in
-             the matrix multiplication as follows:
-
-                TRANSA = 'N' or 'n',  op( A ) = A.
-
-                TRANSA = 'T' or 't',  op( A ) = A'.
-
-                TRANSA = 'C' or 'c',  op( A ) = conjg( A' ).
-
-             Unchanged on exit.
-
-    TRANSB - CHARACTER*1.
-             On entry, TRANSB specifies the form of op( B ) to be used in
-             the matrix multiplication as follows:
-
-                TRANSB = 'N' or 'n',  op( B ) = B.
-
-                TRANSB = 'T' or 't',  op( B ) = B'.
-
-                TRANSB = 'C' or 'c',  op( B ) = conjg( B' ).
-
-             Unchanged on exit.
-
-    M      - INTEGER.
-             On entry,  M  specifies  the number  of rows  of the  matrix
-             op( A )  and of the  matrix  C.  M  must  be at least  zero.
-             Unchanged on exit.
-
-    N      - INTEGER.
-             On entry,  N  specifies the number  of columns of the matrix
-             op( B ) and the number of columns of the matrix C. N must be
-             at least zero.
-             Unchanged on exit.
-
-    K      - INTEGER.
-             On entry,  K  specifies  the number of columns of the matrix
-             op( A ) and the number of rows of the matrix op( B ). K must
-             be at least  zero.
-             Unchanged on exit.
-
-    ALPHA  - COMPLEX*16      .
-             On entry, ALPHA specifies the scalar alpha.
-             Unchanged on exit.
-
-    A      - COMPLEX*16       array of DIMENSION ( LDA, ka ), where ka is
-             k  when  TRANSA = 'N' or 'n',  and is  m  otherwise.
-             Before entry with  TRANSA = 'N' or 'n',  the leading  m by k
-             part of the array  A  must contain the matrix  A,  otherwise
-             the leading  k by m  part of the array  A  must contain  the
-             matrix A.
-             Unchanged on exit.
-
-    LDA    - INTEGER.
-             On entry, LDA specifies the first dimension of A as declared
-             in the calling (sub) program. When  TRANSA = 'N' or 'n' then
-             LDA must be at least  max( 1, m ), otherwise  LDA must be at
-             least  max( 1, k ).
-             Unchanged on exit.
-
-    B      - COMPLEX*16       array of DIMENSION ( LDB, kb ), where kb is
-             n  when  TRANSB = 'N' or 'n',  and is  k  otherwise.
-             Before entry with  TRANSB = 'N' or 'n',  the leading  k by n
-             part of the array  B  must contain the matrix  B,  otherwise
-             the leading  n by k  part of the array  B  must contain  the
-             matrix B.
-             Unchanged on exit.
-
-    LDB    - INTEGER.
-             On entry, LDB specifies the first dimension of B as declared
-             in the calling (sub) program. When  TRANSB = 'N' or 'n' then
-             LDB must be at least  max( 1, k ), otherwise  LDB must be at
-             least  max( 1, n ).
-             Unchanged on exit.
-
-    BETA   - COMPLEX*16      .
-             On entry,  BETA  specifies the scalar  beta.  When  BETA  is
-             supplied as zero then C need not be set on input.
-             Unchanged on exit.
-
-    C      - COMPLEX*16       array of DIMENSION ( LDC, n ).
-             Before entry, the leading  m by n  part of the array  C must
-             contain the matrix  C,  except when  beta  is zero, in which
-             case C need not be set on entry.
-             On exit, the array  C  is overwritten by the  m by n  matrix
-             ( alpha*op( A )*op( B ) + beta*C ).
-
-    LDC    - INTEGER.
-             On entry, LDC specifies the first dimension of C as declared
-             in  the  calling  (sub)  program.   LDC  must  be  at  least
-             max( 1, m ).
-             Unchanged on exit.
-
-
-    Level 3 Blas routine.
-
-    -- Written on 8-February-1989.
-       Jack Dongarra, Argonne National Laboratory.
-       Iain Duff, AERE Harwell.
-       Jeremy Du Croz, Numerical Algorithms Group Ltd.
-       Sven Hammarling, Numerical Algorithms Group Ltd.
-
-
-       Set  NOTA  and  NOTB  as  true if  A  and  B  respectively are not
-       conjugated or transposed, set  CONJA and CONJB  as true if  A  and
-       B  respectively are to be  transposed but  not conjugated  and set
-       NROWA, NCOLA and  NROWB  as the number of rows and  columns  of  A
-       and the number of rows of  B  respectively.
+       forms the dot product of a vector.
+       jack dongarra, 3/11/78.
+       modified 12/3/93, array(1) declarations changed to array(*)
 */
 
-    /* Parameter adjustments */
-    a_dim1 = *lda;
-    a_offset = 1 + a_dim1 * 1;
-    a -= a_offset;
-    b_dim1 = *ldb;
-    b_offset = 1 + b_dim1 * 1;
-    b -= b_offset;
-    c_dim1 = *ldc;
-    c_offset = 1 + c_dim1 * 1;
-    c__ -= c_offset;
+    /* Parameter adjustments */
+    --zy;
+    --zx;
 
     /* Function Body */
-    nota = lsame_(transa, "N");
-    notb = lsame_(transb, "N");
-    conja = lsame_(transa, "C");
-    conjb = lsame_(transb, "C");
-    if (nota) {
-	nrowa = *m;
-	ncola = *k;
-    } else {
-	nrowa = *k;
-	ncola = *m;
+    ztemp.r = 0., ztemp.i = 0.;
+     ret_val->r = 0.,  ret_val->i = 0.;
+    if (*n <= 0) {
+	return ;
     }
-    if (notb) {
-	nrowb = *k;
-    } else {
-	nrowb = *n;
+    if ((*incx == 1 && *incy == 1)) {
+	goto L20;
     }
 
-/*     Test the input parameters. */
+/*
+          code for unequal increments or equal increments
+            not equal to 1
+*/
 
-    info = 0;
-    if (((! nota && ! conja) && ! lsame_(transa, "T")))
-	    {
-	info = 1;
-    } else if (((! notb && ! conjb) && ! lsame_(transb, "T"))) {
-	info = 2;
-    } else if (*m < 0) {
-	info = 3;
-    } else if (*n < 0) {
-	info = 4;
-    } else if (*k < 0) {
-	info = 5;
-    } else if (*lda < max(1,nrowa)) {
-	info = 8;
-    } else if (*ldb < max(1,nrowb)) {
-	info = 10;
-    } else if (*ldc < max(1,*m)) {
-	info = 13;
+    ix = 1;
+    iy = 1;
+    if (*incx < 0) {
+	ix = (-(*n) + 1) * *incx + 1;
     }
-    if (info != 0) {
-	xerbla_("ZGEMM ", &info);
-	return 0;
+    if (*incy < 0) {
+	iy = (-(*n) + 1) * *incy + 1;
     }
-
-/*     Quick return if possible. */
-
-    if (*m == 0 || *n == 0 || (((alpha->r == 0. && alpha->i == 0.) || *k == 0)
-	     && ((beta->r == 1. && beta->i == 0.)))) {
-	return 0;
+    i__1 = *n;
+    for (i__ = 1; i__ <= i__1; ++i__) {
+	d_cnjg(&z__3, &zx[ix]);
+	i__2 = iy;
+	z__2.r = z__3.r * zy[i__2].r - z__3.i * zy[i__2].i, z__2.i = z__3.r *
+		zy[i__2].i + z__3.i * zy[i__2].r;
+	z__1.r = ztemp.r + z__2.r, z__1.i = ztemp.i + z__2.i;
+	ztemp.r = z__1.r, ztemp.i = z__1.i;
+	ix += *incx;
+	iy += *incy;
+/* L10: */
     }
+     ret_val->r = ztemp.r,  ret_val->i = ztemp.i;
+    return ;
 
-/*     And when  alpha.eq.zero. */
+/*        code for both increments equal to 1 */
 
-    if ((alpha->r == 0. && alpha->i == 0.)) {
-	if ((beta->r == 0. && beta->i == 0.)) {
-	    i__1 = *n;
-	    for (j = 1; j <= i__1; ++j) {
-		i__2 = *m;
-		for (i__ = 1; i__ <= i__2; ++i__) {
-		    i__3 = i__ + j * c_dim1;
-		    c__[i__3].r = 0., c__[i__3].i = 0.;
-/* L10: */
-		}
-/* L20: */
-	    }
-	} else {
-	    i__1 = *n;
-	    for (j = 1; j <= i__1; ++j) {
-		i__2 = *m;
-		for (i__ = 1; i__ <= i__2; ++i__) {
-		    i__3 = i__ + j * c_dim1;
-		    i__4 = i__ + j * c_dim1;
-		    z__1.r = beta->r * c__[i__4].r - beta->i * c__[i__4].i,
-			    z__1.i = beta->r * c__[i__4].i + beta->i * c__[
-			    i__4].r;
-		    c__[i__3].r = z__1.r, c__[i__3].i = z__1.i;
+L20:
+    i__1 = *n;
+    for (i__ = 1; i__ <= i__1; ++i__) {
+	d_cnjg(&z__3, &zx[i__]);
+	i__2 = i__;
+	z__2.r = z__3.r * zy[i__2].r - z__3.i * zy[i__2].i, z__2.i = z__3.r *
+		zy[i__2].i + z__3.i * zy[i__2].r;
+	z__1.r = ztemp.r + z__2.r, z__1.i = ztemp.i + z__2.i;
+	ztemp.r = z__1.r, ztemp.i = z__1.i;
 /* L30: */
-		}
-/* L40: */
-	    }
-	}
-	return 0;
     }
+     ret_val->r = ztemp.r,  ret_val->i = ztemp.i;
+    return ;
+} /* zdotc_ */
 
-/*     Start the operations. */
-
-    if (notb) {
-	if (nota) {
-
-/*           Form  C := alpha*A*B + beta*C. */
-
-	    i__1 = *n;
-	    for (j = 1; j <= i__1; ++j) {
-		if ((beta->r == 0. && beta->i == 0.)) {
-		    i__2 = *m;
-		    for (i__ = 1; i__ <= i__2; ++i__) {
-			i__3 = i__ + j * c_dim1;
-			c__[i__3].r = 0., c__[i__3].i = 0.;
-/* L50: */
-		    }
-		} else if (beta->r != 1. || beta->i != 0.) {
-		    i__2 = *m;
-		    for (i__ = 1; i__ <= i__2; ++i__) {
-			i__3 = i__ + j * c_dim1;
-			i__4 = i__ + j * c_dim1;
-			z__1.r = beta->r * c__[i__4].r - beta->i * c__[i__4]
-				.i, z__1.i = beta->r * c__[i__4].i + beta->i *
-				 c__[i__4].r;
-			c__[i__3].r = z__1.r, c__[i__3].i = z__1.i;
-/* L60: */
-		    }
-		}
-		i__2 = *k;
-		for (l = 1; l <= i__2; ++l) {
-		    i__3 = l + j * b_dim1;
-		    if (b[i__3].r != 0. || b[i__3].i != 0.) {
-			i__3 = l + j * b_dim1;
-			z__1.r = alpha->r * b[i__3].r - alpha->i * b[i__3].i,
-				z__1.i = alpha->r * b[i__3].i + alpha->i * b[
-				i__3].r;
-			temp.r = z__1.r, temp.i = z__1.i;
-			i__3 = *m;
-			for (i__ = 1; i__ <= i__3; ++i__) {
-			    i__4 = i__ + j * c_dim1;
-			    i__5 = i__ + j * c_dim1;
-			    i__6 = i__ + l * a_dim1;
-			    z__2.r = temp.r * a[i__6].r - temp.i * a[i__6].i,
-				    z__2.i = temp.r * a[i__6].i + temp.i * a[
-				    i__6].r;
-			    z__1.r = c__[i__5].r + z__2.r, z__1.i = c__[i__5]
-				    .i + z__2.i;
-			    c__[i__4].r = z__1.r, c__[i__4].i = z__1.i;
-/* L70: */
-			}
-		    }
-/* L80: */
-		}
-/* L90: */
-	    }
-	} else if (conja) {
-
-/*           Form  C := alpha*conjg( A' )*B + beta*C. */
+/* Double Complex */ VOID zdotu_(doublecomplex * ret_val, integer *n,
+	doublecomplex *zx, integer *incx, doublecomplex *zy, integer *incy)
+{
+    /* System generated locals */
+    integer i__1, i__2, i__3;
+    doublecomplex z__1, z__2;
 
-	    i__1 = *n;
-	    for (j = 1; j <= i__1; ++j) {
-		i__2 = *m;
-		for (i__ = 1; i__ <= i__2; ++i__) {
-		    temp.r = 0., temp.i = 0.;
-		    i__3 = *k;
-		    for (l = 1; l <= i__3; ++l) {
-			d_cnjg(&z__3, &a[l + i__ * a_dim1]);
-			i__4 = l + j * b_dim1;
-			z__2.r = z__3.r * b[i__4].r - z__3.i * b[i__4].i,
-				z__2.i = z__3.r * b[i__4].i + z__3.i * b[i__4]
-				.r;
-			z__1.r = temp.r + z__2.r, z__1.i = temp.i + z__2.i;
-			temp.r = z__1.r, temp.i = z__1.i;
-/* L100: */
-		    }
-		    if ((beta->r == 0. && beta->i == 0.)) {
-			i__3 = i__ + j * c_dim1;
-			z__1.r = alpha->r * temp.r - alpha->i * temp.i,
-				z__1.i = alpha->r * temp.i + alpha->i *
-				temp.r;
-			c__[i__3].r = z__1.r, c__[i__3].i = z__1.i;
-		    } else {
-			i__3 = i__ + j * c_dim1;
-			z__2.r = alpha->r * temp.r - alpha->i * temp.i,
-				z__2.i = alpha->r * temp.i + alpha->i *
-				temp.r;
-			i__4 = i__ + j * c_dim1;
-			z__3.r = beta->r * c__[i__4].r - beta->i * c__[i__4]
-				.i, z__3.i = beta->r * c__[i__4].i + beta->i *
-				 c__[i__4].r;
-			z__1.r = z__2.r + z__3.r, z__1.i = z__2.i + z__3.i;
-			c__[i__3].r = z__1.r, c__[i__3].i = z__1.i;
-		    }
-/* L110: */
-		}
-/* L120: */
-	    }
-	} else {
+    /* Local variables */
+    static integer i__, ix, iy;
+    static doublecomplex ztemp;
 
-/*           Form  C := alpha*A'*B + beta*C */
 
-	    i__1 = *n;
-	    for (j = 1; j <= i__1; ++j) {
-		i__2 = *m;
-		for (i__ = 1; i__ <= i__2; ++i__) {
-		    temp.r = 0., temp.i = 0.;
-		    i__3 = *k;
-		    for (l = 1; l <= i__3; ++l) {
-			i__4 = l + i__ * a_dim1;
-			i__5 = l + j * b_dim1;
-			z__2.r = a[i__4].r * b[i__5].r - a[i__4].i * b[i__5]
-				.i, z__2.i = a[i__4].r * b[i__5].i + a[i__4]
-				.i * b[i__5].r;
-			z__1.r = temp.r + z__2.r, z__1.i = temp.i + z__2.i;
-			temp.r = z__1.r, temp.i = z__1.i;
-/* L130: */
-		    }
-		    if ((beta->r == 0. && beta->i == 0.)) {
-			i__3 = i__ + j * c_dim1;
-			z__1.r = alpha->r * temp.r - alpha->i * temp.i,
-				z__1.i = alpha->r * temp.i + alpha->i *
-				temp.r;
-			c__[i__3].r = z__1.r, c__[i__3].i = z__1.i;
-		    } else {
-			i__3 = i__ + j * c_dim1;
-			z__2.r = alpha->r * temp.r - alpha->i * temp.i,
-				z__2.i = alpha->r * temp.i + alpha->i *
-				temp.r;
-			i__4 = i__ + j * c_dim1;
-			z__3.r = beta->r * c__[i__4].r - beta->i * c__[i__4]
-				.i, z__3.i = beta->r * c__[i__4].i + beta->i *
-				 c__[i__4].r;
-			z__1.r = z__2.r + z__3.r, z__1.i = z__2.i + z__3.i;
-			c__[i__3].r = z__1.r, c__[i__3].i = z__1.i;
-		    }
-/* L140: */
-		}
-/* L150: */
-	    }
-	}
-    } else if (nota) {
-	if (conjb) {
+/*
+       forms the dot product of two vectors.
+       jack dongarra, 3/11/78.
+       modified 12/3/93, array(1) declarations changed to array(*)
+*/
 
-/*           Form  C := alpha*A*conjg( B' ) + beta*C. */
+    /* Parameter adjustments */
+    --zy;
+    --zx;
 
-	    i__1 = *n;
-	    for (j = 1; j <= i__1; ++j) {
-		if ((beta->r == 0. && beta->i == 0.)) {
-		    i__2 = *m;
-		    for (i__ = 1; i__ <= i__2; ++i__) {
-			i__3 = i__ + j * c_dim1;
-			c__[i__3].r = 0., c__[i__3].i = 0.;
-/* L160: */
-		    }
-		} else if (beta->r != 1. || beta->i != 0.) {
-		    i__2 = *m;
-		    for (i__ = 1; i__ <= i__2; ++i__) {
-			i__3 = i__ + j * c_dim1;
-			i__4 = i__ + j * c_dim1;
-			z__1.r = beta->r * c__[i__4].r - beta->i * c__[i__4]
-				.i, z__1.i = beta->r * c__[i__4].i + beta->i *
-				 c__[i__4].r;
-			c__[i__3].r = z__1.r, c__[i__3].i = z__1.i;
-/* L170: */
-		    }
-		}
-		i__2 = *k;
-		for (l = 1; l <= i__2; ++l) {
-		    i__3 = j + l * b_dim1;
-		    if (b[i__3].r != 0. || b[i__3].i != 0.) {
-			d_cnjg(&z__2, &b[j + l * b_dim1]);
-			z__1.r = alpha->r * z__2.r - alpha->i * z__2.i,
-				z__1.i = alpha->r * z__2.i + alpha->i *
-				z__2.r;
-			temp.r = z__1.r, temp.i = z__1.i;
-			i__3 = *m;
-			for (i__ = 1; i__ <= i__3; ++i__) {
-			    i__4 = i__ + j * c_dim1;
-			    i__5 = i__ + j * c_dim1;
-			    i__6 = i__ + l * a_dim1;
-			    z__2.r = temp.r * a[i__6].r - temp.i * a[i__6].i,
-				    z__2.i = temp.r * a[i__6].i + temp.i * a[
-				    i__6].r;
-			    z__1.r = c__[i__5].r + z__2.r, z__1.i = c__[i__5]
-				    .i + z__2.i;
-			    c__[i__4].r = z__1.r, c__[i__4].i = z__1.i;
-/* L180: */
-			}
-		    }
-/* L190: */
-		}
-/* L200: */
-	    }
-	} else {
+    /* Function Body */
+    ztemp.r = 0., ztemp.i = 0.;
+     ret_val->r = 0.,  ret_val->i = 0.;
+    if (*n <= 0) {
+	return ;
+    }
+    if ((*incx == 1 && *incy == 1)) {
+	goto L20;
+    }
 
-/*           Form  C := alpha*A*B'          + beta*C */
+/*
+          code for unequal increments or equal increments
+            not equal to 1
+*/
 
-	    i__1 = *n;
-	    for (j = 1; j <= i__1; ++j) {
-		if ((beta->r == 0. && beta->i == 0.)) {
-		    i__2 = *m;
-		    for (i__ = 1; i__ <= i__2; ++i__) {
-			i__3 = i__ + j * c_dim1;
-			c__[i__3].r = 0., c__[i__3].i = 0.;
-/* L210: */
-		    }
-		} else if (beta->r != 1. || beta->i != 0.) {
-		    i__2 = *m;
-		    for (i__ = 1; i__ <= i__2; ++i__) {
-			i__3 = i__ + j * c_dim1;
-			i__4 = i__ + j * c_dim1;
-			z__1.r = beta->r * c__[i__4].r - beta->i * c__[i__4]
-				.i, z__1.i = beta->r * c__[i__4].i + beta->i *
-				 c__[i__4].r;
-			c__[i__3].r = z__1.r, c__[i__3].i = z__1.i;
-/* L220: */
-		    }
-		}
-		i__2 = *k;
-		for (l = 1; l <= i__2; ++l) {
-		    i__3 = j + l * b_dim1;
-		    if (b[i__3].r != 0. || b[i__3].i != 0.) {
-			i__3 = j + l * b_dim1;
-			z__1.r = alpha->r * b[i__3].r - alpha->i * b[i__3].i,
-				z__1.i = alpha->r * b[i__3].i + alpha->i * b[
-				i__3].r;
-			temp.r = z__1.r, temp.i = z__1.i;
-			i__3 = *m;
-			for (i__ = 1; i__ <= i__3; ++i__) {
-			    i__4 = i__ + j * c_dim1;
-			    i__5 = i__ + j * c_dim1;
-			    i__6 = i__ + l * a_dim1;
-			    z__2.r = temp.r * a[i__6].r - temp.i * a[i__6].i,
-				    z__2.i = temp.r * a[i__6].i + temp.i * a[
-				    i__6].r;
-			    z__1.r = c__[i__5].r + z__2.r, z__1.i = c__[i__5]
-				    .i + z__2.i;
-			    c__[i__4].r = z__1.r, c__[i__4].i = z__1.i;
-/* L230: */
-			}
-		    }
-/* L240: */
-		}
-/* L250: */
-	    }
-	}
-    } else if (conja) {
-	if (conjb) {
+    ix = 1;
+    iy = 1;
+    if (*incx < 0) {
+	ix = (-(*n) + 1) * *incx + 1;
+    }
+    if (*incy < 0) {
+	iy = (-(*n) + 1) * *incy + 1;
+    }
+    i__1 = *n;
+    for (i__ = 1; i__ <= i__1; ++i__) {
+	i__2 = ix;
+	i__3 = iy;
+	z__2.r = zx[i__2].r * zy[i__3].r - zx[i__2].i * zy[i__3].i, z__2.i =
+		zx[i__2].r * zy[i__3].i + zx[i__2].i * zy[i__3].r;
+	z__1.r = ztemp.r + z__2.r, z__1.i = ztemp.i + z__2.i;
+	ztemp.r = z__1.r, ztemp.i = z__1.i;
+	ix += *incx;
+	iy += *incy;
+/* L10: */
+    }
+     ret_val->r = ztemp.r,  ret_val->i = ztemp.i;
+    return ;
 
-/*           Form  C := alpha*conjg( A' )*conjg( B' ) + beta*C. */
+/*        code for both increments equal to 1 */
 
-	    i__1 = *n;
-	    for (j = 1; j <= i__1; ++j) {
-		i__2 = *m;
-		for (i__ = 1; i__ <= i__2; ++i__) {
-		    temp.r = 0., temp.i = 0.;
-		    i__3 = *k;
-		    for (l = 1; l <= i__3; ++l) {
-			d_cnjg(&z__3, &a[l + i__ * a_dim1]);
-			d_cnjg(&z__4, &b[j + l * b_dim1]);
-			z__2.r = z__3.r * z__4.r - z__3.i * z__4.i, z__2.i =
-				z__3.r * z__4.i + z__3.i * z__4.r;
-			z__1.r = temp.r + z__2.r, z__1.i = temp.i + z__2.i;
-			temp.r = z__1.r, temp.i = z__1.i;
-/* L260: */
-		    }
-		    if ((beta->r == 0. && beta->i == 0.)) {
-			i__3 = i__ + j * c_dim1;
-			z__1.r = alpha->r * temp.r - alpha->i * temp.i,
-				z__1.i = alpha->r * temp.i + alpha->i *
-				temp.r;
-			c__[i__3].r = z__1.r, c__[i__3].i = z__1.i;
-		    } else {
-			i__3 = i__ + j * c_dim1;
-			z__2.r = alpha->r * temp.r - alpha->i * temp.i,
-				z__2.i = alpha->r * temp.i + alpha->i *
-				temp.r;
-			i__4 = i__ + j * c_dim1;
-			z__3.r = beta->r * c__[i__4].r - beta->i * c__[i__4]
-				.i, z__3.i = beta->r * c__[i__4].i + beta->i *
-				 c__[i__4].r;
-			z__1.r = z__2.r + z__3.r, z__1.i = z__2.i + z__3.i;
-			c__[i__3].r = z__1.r, c__[i__3].i = z__1.i;
-		    }
-/* L270: */
-		}
-/* L280: */
-	    }
-	} else {
+L20:
+    i__1 = *n;
+    for (i__ = 1; i__ <= i__1; ++i__) {
+	i__2 = i__;
+	i__3 = i__;
+	z__2.r = zx[i__2].r * zy[i__3].r - zx[i__2].i * zy[i__3].i, z__2.i =
+		zx[i__2].r * zy[i__3].i + zx[i__2].i * zy[i__3].r;
+	z__1.r = ztemp.r + z__2.r, z__1.i = ztemp.i + z__2.i;
+	ztemp.r = z__1.r, ztemp.i = z__1.i;
+/* L30: */
+    }
+     ret_val->r = ztemp.r,  ret_val->i = ztemp.i;
+    return ;
+} /* zdotu_ */
 
-/*           Form  C := alpha*conjg( A' )*B' + beta*C */
+/* Subroutine */ int zdscal_(integer *n, doublereal *da, doublecomplex *zx,
+	integer *incx)
+{
+    /* System generated locals */
+    integer i__1, i__2, i__3;
+    doublecomplex z__1, z__2;
 
-	    i__1 = *n;
-	    for (j = 1; j <= i__1; ++j) {
-		i__2 = *m;
-		for (i__ = 1; i__ <= i__2; ++i__) {
-		    temp.r = 0., temp.i = 0.;
-		    i__3 = *k;
-		    for (l = 1; l <= i__3; ++l) {
-			d_cnjg(&z__3, &a[l + i__ * a_dim1]);
-			i__4 = j + l * b_dim1;
-			z__2.r = z__3.r * b[i__4].r - z__3.i * b[i__4].i,
-				z__2.i = z__3.r * b[i__4].i + z__3.i * b[i__4]
-				.r;
-			z__1.r = temp.r + z__2.r, z__1.i = temp.i + z__2.i;
-			temp.r = z__1.r, temp.i = z__1.i;
-/* L290: */
-		    }
-		    if ((beta->r == 0. && beta->i == 0.)) {
-			i__3 = i__ + j * c_dim1;
-			z__1.r = alpha->r * temp.r - alpha->i * temp.i,
-				z__1.i = alpha->r * temp.i + alpha->i *
-				temp.r;
-			c__[i__3].r = z__1.r, c__[i__3].i = z__1.i;
-		    } else {
-			i__3 = i__ + j * c_dim1;
-			z__2.r = alpha->r * temp.r - alpha->i * temp.i,
-				z__2.i = alpha->r * temp.i + alpha->i *
-				temp.r;
-			i__4 = i__ + j * c_dim1;
-			z__3.r = beta->r * c__[i__4].r - beta->i * c__[i__4]
-				.i, z__3.i = beta->r * c__[i__4].i + beta->i *
-				 c__[i__4].r;
-			z__1.r = z__2.r + z__3.r, z__1.i = z__2.i + z__3.i;
-			c__[i__3].r = z__1.r, c__[i__3].i = z__1.i;
-		    }
-/* L300: */
-		}
-/* L310: */
-	    }
-	}
-    } else {
-	if (conjb) {
+    /* Local variables */
+    static integer i__, ix;
 
-/*           Form  C := alpha*A'*conjg( B' ) + beta*C */
 
-	    i__1 = *n;
-	    for (j = 1; j <= i__1; ++j) {
-		i__2 = *m;
-		for (i__ = 1; i__ <= i__2; ++i__) {
-		    temp.r = 0., temp.i = 0.;
-		    i__3 = *k;
-		    for (l = 1; l <= i__3; ++l) {
-			i__4 = l + i__ * a_dim1;
-			d_cnjg(&z__3, &b[j + l * b_dim1]);
-			z__2.r = a[i__4].r * z__3.r - a[i__4].i * z__3.i,
-				z__2.i = a[i__4].r * z__3.i + a[i__4].i *
-				z__3.r;
-			z__1.r = temp.r + z__2.r, z__1.i = temp.i + z__2.i;
-			temp.r = z__1.r, temp.i = z__1.i;
-/* L320: */
-		    }
-		    if ((beta->r == 0. && beta->i == 0.)) {
-			i__3 = i__ + j * c_dim1;
-			z__1.r = alpha->r * temp.r - alpha->i * temp.i,
-				z__1.i = alpha->r * temp.i + alpha->i *
-				temp.r;
-			c__[i__3].r = z__1.r, c__[i__3].i = z__1.i;
-		    } else {
-			i__3 = i__ + j * c_dim1;
-			z__2.r = alpha->r * temp.r - alpha->i * temp.i,
-				z__2.i = alpha->r * temp.i + alpha->i *
-				temp.r;
-			i__4 = i__ + j * c_dim1;
-			z__3.r = beta->r * c__[i__4].r - beta->i * c__[i__4]
-				.i, z__3.i = beta->r * c__[i__4].i + beta->i *
-				 c__[i__4].r;
-			z__1.r = z__2.r + z__3.r, z__1.i = z__2.i + z__3.i;
-			c__[i__3].r = z__1.r, c__[i__3].i = z__1.i;
-		    }
-/* L330: */
-		}
-/* L340: */
-	    }
-	} else {
+/*
+       scales a vector by a constant.
+       jack dongarra, 3/11/78.
+       modified 3/93 to return if incx .le. 0.
+       modified 12/3/93, array(1) declarations changed to array(*)
+*/
 
-/*           Form  C := alpha*A'*B' + beta*C */
 
-	    i__1 = *n;
-	    for (j = 1; j <= i__1; ++j) {
-		i__2 = *m;
-		for (i__ = 1; i__ <= i__2; ++i__) {
-		    temp.r = 0., temp.i = 0.;
-		    i__3 = *k;
-		    for (l = 1; l <= i__3; ++l) {
-			i__4 = l + i__ * a_dim1;
-			i__5 = j + l * b_dim1;
-			z__2.r = a[i__4].r * b[i__5].r - a[i__4].i * b[i__5]
-				.i, z__2.i = a[i__4].r * b[i__5].i + a[i__4]
-				.i * b[i__5].r;
-			z__1.r = temp.r + z__2.r, z__1.i = temp.i + z__2.i;
-			temp.r = z__1.r, temp.i = z__1.i;
-/* L350: */
-		    }
-		    if ((beta->r == 0. && beta->i == 0.)) {
-			i__3 = i__ + j * c_dim1;
-			z__1.r = alpha->r * temp.r - alpha->i * temp.i,
-				z__1.i = alpha->r * temp.i + alpha->i *
-				temp.r;
-			c__[i__3].r = z__1.r, c__[i__3].i = z__1.i;
-		    } else {
-			i__3 = i__ + j * c_dim1;
-			z__2.r = alpha->r * temp.r - alpha->i * temp.i,
-				z__2.i = alpha->r * temp.i + alpha->i *
-				temp.r;
-			i__4 = i__ + j * c_dim1;
-			z__3.r = beta->r * c__[i__4].r - beta->i * c__[i__4]
-				.i, z__3.i = beta->r * c__[i__4].i + beta->i *
-				 c__[i__4].r;
-			z__1.r = z__2.r + z__3.r, z__1.i = z__2.i + z__3.i;
-			c__[i__3].r = z__1.r, c__[i__3].i = z__1.i;
-		    }
-/* L360: */
-		}
-/* L370: */
-	    }
-	}
+    /* Parameter adjustments */
+    --zx;
+
+    /* Function Body */
+    if (*n <= 0 || *incx <= 0) {
+	return 0;
+    }
+    if (*incx == 1) {
+	goto L20;
     }
 
+/*        code for increment not equal to 1 */
+
+    ix = 1;
+    i__1 = *n;
+    for (i__ = 1; i__ <= i__1; ++i__) {
+	i__2 = ix;
+	z__2.r = *da, z__2.i = 0.;
+	i__3 = ix;
+	z__1.r = z__2.r * zx[i__3].r - z__2.i * zx[i__3].i, z__1.i = z__2.r *
+		zx[i__3].i + z__2.i * zx[i__3].r;
+	zx[i__2].r = z__1.r, zx[i__2].i = z__1.i;
+	ix += *incx;
+/* L10: */
+    }
     return 0;
 
-/*     End of ZGEMM . */
+/*        code for increment equal to 1 */
 
-} /* zgemm_ */
+L20:
+    i__1 = *n;
+    for (i__ = 1; i__ <= i__1; ++i__) {
+	i__2 = i__;
+	z__2.r = *da, z__2.i = 0.;
+	i__3 = i__;
+	z__1.r = z__2.r * zx[i__3].r - z__2.i * zx[i__3].i, z__1.i = z__2.r *
+		zx[i__3].i + z__2.i * zx[i__3].r;
+	zx[i__2].r = z__1.r, zx[i__2].i = z__1.i;
+/* L30: */
+    }
+    return 0;
+} /* zdscal_ */
 
 /* Subroutine */ int zgemv_(char *trans, integer *m, integer *n,
 	doublecomplex *alpha, doublecomplex *a, integer *lda, doublecomplex *
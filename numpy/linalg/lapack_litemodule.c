@@ -94,6 +94,19 @@ extern int FNAME(zungqr)(int *m, int *n, int *k, f2c_doublecomplex a[],
                           int *lda, f2c_doublecomplex tau[],
                           f2c_doublecomplex work[], int *lwork, int *info);
 
+extern int FNAME(dgemm)(char *transa, char *transb, int *m, int *n, int *k,
+                         double *alpha, double a[], int *lda,
+                         double b[], int *ldb, double *beta,
+                         double c[], int *ldc);
+extern int FNAME(zgemm)(char *transa, char *transb, int *m, int *n, int *k,
+                         f2c_doublecomplex *alpha, f2c_doublecomplex a[],
+                         int *lda, f2c_doublecomplex b[], int *ldb,
+                         f2c_doublecomplex *beta, f2c_doublecomplex c[],
+                         int *ldc);
+extern int FNAME(dgemv)(char *trans, int *m, int *n, double *alpha,
+                         double a[], int *lda, double x[], int *incx,
+                         double *beta, double y[], int *incy);
+
 static PyObject *LapackError;
 
 #define TRY(E) if (!(E)) return NULL
@@ -800,6 +813,621 @@ lapack_lite_zungqr(PyObject *NPY_UNUSED(self), PyObject *args)
                              "info",info);
 }
 
+/*
+ * The BLAS routines used by the LAPACK routines above, exposed so that
+ * the blocked dgemm, zgemm and dgemv can be tested directly.
+ */
+static PyObject *
+lapack_lite_dgemm(PyObject *NPY_UNUSED(self), PyObject *args)
+{
+    int  lapack_lite_status__;
+    char transa, transb;
+    int m, n, k;
+    double alpha, beta;
+    PyObject *a, *b, *c;
+    int lda, ldb, ldc;
+
+    TRY(PyArg_ParseTuple(args,"cciiidOiOidOi",&transa,&transb,&m,&n,&k,
+                         &alpha,&a,&lda,&b,&ldb,&beta,&c,&ldc));
+    TRY(check_object(a,PyArray_DOUBLE,"a","PyArray_DOUBLE","dgemm"));
+    TRY(check_object(b,PyArray_DOUBLE,"b","PyArray_DOUBLE","dgemm"));
+    TRY(check_object(c,PyArray_DOUBLE,"c","PyArray_DOUBLE","dgemm"));
+
+    lapack_lite_status__ = \
+    FNAME(dgemm)(&transa,&transb,&m,&n,&k,&alpha,DDATA(a),&lda,
+                 DDATA(b),&ldb,&beta,DDATA(c),&ldc);
+
+    return Py_BuildValue("{s:i}","dgemm_",lapack_lite_status__);
+}
+
+static PyObject *
+lapack_lite_zgemm(PyObject *NPY_UNUSED(self), PyObject *args)
+{
+    int  lapack_lite_status__;
+    char transa, transb;
+    int m, n, k;
+    Py_complex alpha, beta;
+    f2c_doublecomplex zalpha, zbeta;
+    PyObject *a, *b, *c;
+    int lda, ldb, ldc;
+
+    TRY(PyArg_ParseTuple(args,"cciiiDOiOiDOi",&transa,&transb,&m,&n,&k,
+                         &alpha,&a,&lda,&b,&ldb,&beta,&c,&ldc));
+    TRY(check_object(a,PyArray_CDOUBLE,"a","PyArray_CDOUBLE","zgemm"));
+    TRY(check_object(b,PyArray_CDOUBLE,"b","PyArray_CDOUBLE","zgemm"));
+    TRY(check_object(c,PyArray_CDOUBLE,"c","PyArray_CDOUBLE","zgemm"));
+
+    zalpha.r = alpha.real;
+    zalpha.i = alpha.imag;
+    zbeta.r = beta.real;
+    zbeta.i = beta.imag;
+    lapack_lite_status__ = \
+    FNAME(zgemm)(&transa,&transb,&m,&n,&k,&zalpha,ZDATA(a),&lda,
+                 ZDATA(b),&ldb,&zbeta,ZDATA(c),&ldc);
+
+    return Py_BuildValue("{s:i}","zgemm_",lapack_lite_status__);
+}
+
+static PyObject *
+lapack_lite_dgemv(PyObject *NPY_UNUSED(self), PyObject *args)
+{
+    int  lapack_lite_status__;
+    char trans;
+    int m, n;
+    double alpha, beta;
+    PyObject *a, *x, *y;
+    int lda, incx, incy;
+
+    TRY(PyArg_ParseTuple(args,"ciidOiOidOi",&trans,&m,&n,&alpha,&a,&lda,
+                         &x,&incx,&beta,&y,&incy));
+    TRY(check_object(a,PyArray_DOUBLE,"a","PyArray_DOUBLE","dgemv"));
+    TRY(check_object(x,PyArray_DOUBLE,"x","PyArray_DOUBLE","dgemv"));
+    TRY(check_object(y,PyArray_DOUBLE,"y","PyArray_DOUBLE","dgemv"));
+
+    lapack_lite_status__ = \
+    FNAME(dgemv)(&trans,&m,&n,&alpha,DDATA(a),&lda,DDATA(x),&incx,
+                 &beta,DDATA(y),&incy);
+
+    return Py_BuildValue("{s:i}","dgemv_",lapack_lite_status__);
+}
+
+
+/*
+ * Stacked versions.
+ *
+ * These take k problems of the same size in arrays whose first dimension
+ * is k, each problem laid out as for the functions above, with matrices
+ * in Fortran order, and loop over the stack in C.  Workspace is sized
+ * once per call and reused for every problem.  The info of each problem
+ * goes to the int array info, and the returned "info" counts the problems
+ * whose info is not 0.  Solves, inverses and determinants of 2x2, 3x3
+ * and 4x4 matrices use unrolled cofactor expansions instead of LAPACK;
+ * their info is 1 if the matrix is exactly singular.  dinv_stacked
+ * leaves a matrix it cannot invert as it was, whatever its size.
+ */
+
+static int
+check_stack(PyObject *ob, int nd, npy_intp k, npy_intp d1, npy_intp d2,
+            char *obname, char *funname)
+{
+    npy_intp dims[3];
+    int i;
+
+    dims[0] = k;
+    dims[1] = d1;
+    dims[2] = d2;
+    if (PyArray_NDIM(ob) == nd) {
+        for (i = 0; i < nd; i++) {
+            if ((dims[i] >= 0 && PyArray_DIM(ob, i) != dims[i]) ||
+                    (i > 0 && PyArray_DIM(ob, i) > INT_MAX)) {
+                break;
+            }
+        }
+        if (i == nd) {
+            return 1;
+        }
+    }
+    PyErr_Format(LapackError,
+                 "Parameter %s has the wrong shape in lapack_lite.%s",
+                 obname, funname);
+    return 0;
+}
+
+/*
+ * Determinant and inverse of a small matrix.  Both commute with
+ * transposition, so the order the matrix is stored in does not matter.
+ */
+static double
+det_small(int n, const double *a)
+{
+    double c0, c1, c2, c3, c4, c5;
+
+    switch (n) {
+    case 2:
+        return a[0]*a[3] - a[1]*a[2];
+    case 3:
+        return a[0]*(a[4]*a[8] - a[5]*a[7])
+             - a[1]*(a[3]*a[8] - a[5]*a[6])
+             + a[2]*(a[3]*a[7] - a[4]*a[6]);
+    default:
+        c0 = a[8]*a[13] - a[12]*a[9];
+        c1 = a[8]*a[14] - a[12]*a[10];
+        c2 = a[8]*a[15] - a[12]*a[11];
+        c3 = a[9]*a[14] - a[13]*a[10];
+        c4 = a[9]*a[15] - a[13]*a[11];
+        c5 = a[10]*a[15] - a[14]*a[11];
+        return (a[0]*a[5] - a[4]*a[1])*c5 - (a[0]*a[6] - a[4]*a[2])*c4
+             + (a[0]*a[7] - a[4]*a[3])*c3 + (a[1]*a[6] - a[5]*a[2])*c2
+             - (a[1]*a[7] - a[5]*a[3])*c1 + (a[2]*a[7] - a[6]*a[3])*c0;
+    }
+}
+
+/* Returns 1, leaving inv unset, if a is singular */
+static int
+inv_small(int n, const double *a, double *inv)
+{
+    double det, r, s0, s1, s2, s3, s4, s5, c0, c1, c2, c3, c4, c5;
+
+    switch (n) {
+    case 2:
+        det = a[0]*a[3] - a[1]*a[2];
+        if (det == 0) {
+            return 1;
+        }
+        r = 1/det;
+        inv[0] = a[3]*r;
+        inv[1] = -a[1]*r;
+        inv[2] = -a[2]*r;
+        inv[3] = a[0]*r;
+        return 0;
+    case 3:
+        c0 = a[4]*a[8] - a[5]*a[7];
+        c1 = a[5]*a[6] - a[3]*a[8];
+        c2 = a[3]*a[7] - a[4]*a[6];
+        det = a[0]*c0 + a[1]*c1 + a[2]*c2;
+        if (det == 0) {
+            return 1;
+        }
+        r = 1/det;
+        inv[0] = c0*r;
+        inv[1] = (a[2]*a[7] - a[1]*a[8])*r;
+        inv[2] = (a[1]*a[5] - a[2]*a[4])*r;
+        inv[3] = c1*r;
+        inv[4] = (a[0]*a[8] - a[2]*a[6])*r;
+        inv[5] = (a[2]*a[3] - a[0]*a[5])*r;
+        inv[6] = c2*r;
+        inv[7] = (a[1]*a[6] - a[0]*a[7])*r;
+        inv[8] = (a[0]*a[4] - a[1]*a[3])*r;
+        return 0;
+    default:
+        s0 = a[0]*a[5] - a[4]*a[1];
+        s1 = a[0]*a[6] - a[4]*a[2];
+        s2 = a[0]*a[7] - a[4]*a[3];
+        s3 = a[1]*a[6] - a[5]*a[2];
+        s4 = a[1]*a[7] - a[5]*a[3];
+        s5 = a[2]*a[7] - a[6]*a[3];
+        c0 = a[8]*a[13] - a[12]*a[9];
+        c1 = a[8]*a[14] - a[12]*a[10];
+        c2 = a[8]*a[15] - a[12]*a[11];
+        c3 = a[9]*a[14] - a[13]*a[10];
+        c4 = a[9]*a[15] - a[13]*a[11];
+        c5 = a[10]*a[15] - a[14]*a[11];
+        det = s0*c5 - s1*c4 + s2*c3 + s3*c2 - s4*c1 + s5*c0;
+        if (det == 0) {
+            return 1;
+        }
+        r = 1/det;
+        inv[0] = (a[5]*c5 - a[6]*c4 + a[7]*c3)*r;
+        inv[1] = (-a[1]*c5 + a[2]*c4 - a[3]*c3)*r;
+        inv[2] = (a[13]*s5 - a[14]*s4 + a[15]*s3)*r;
+        inv[3] = (-a[9]*s5 + a[10]*s4 - a[11]*s3)*r;
+        inv[4] = (-a[4]*c5 + a[6]*c2 - a[7]*c1)*r;
+        inv[5] = (a[0]*c5 - a[2]*c2 + a[3]*c1)*r;
+        inv[6] = (-a[12]*s5 + a[14]*s2 - a[15]*s1)*r;
+        inv[7] = (a[8]*s5 - a[10]*s2 + a[11]*s1)*r;
+        inv[8] = (a[4]*c4 - a[5]*c2 + a[7]*c0)*r;
+        inv[9] = (-a[0]*c4 + a[1]*c2 - a[3]*c0)*r;
+        inv[10] = (a[12]*s4 - a[13]*s2 + a[15]*s0)*r;
+        inv[11] = (-a[8]*s4 + a[9]*s2 - a[11]*s0)*r;
+        inv[12] = (-a[4]*c3 + a[5]*c1 - a[6]*c0)*r;
+        inv[13] = (a[0]*c3 - a[1]*c1 + a[2]*c0)*r;
+        inv[14] = (-a[12]*s3 + a[13]*s1 - a[14]*s0)*r;
+        inv[15] = (a[8]*s3 - a[9]*s1 + a[10]*s0)*r;
+        return 0;
+    }
+}
+
+static PyObject *
+lapack_lite_dgesv_stacked(PyObject *NPY_UNUSED(self), PyObject *args)
+{
+    PyObject *a, *b, *info;
+    double *ap, *bp, inv[16], x[4];
+    int *ipiv, *infop;
+    int n, ld, nrhs, i, j, l;
+    npy_intp k, p, nfail = 0;
+
+    TRY(PyArg_ParseTuple(args,"OOO",&a,&b,&info));
+
+    TRY(check_object(a,PyArray_DOUBLE,"a","PyArray_DOUBLE","dgesv_stacked"));
+    TRY(check_object(b,PyArray_DOUBLE,"b","PyArray_DOUBLE","dgesv_stacked"));
+    TRY(check_object(info,PyArray_INT,"info","PyArray_INT","dgesv_stacked"));
+    TRY(check_stack(a,3,-1,-1,-1,"a","dgesv_stacked"));
+    k = PyArray_DIM(a, 0);
+    n = (int)PyArray_DIM(a, 1);
+    TRY(check_stack(a,3,k,n,n,"a","dgesv_stacked"));
+    TRY(check_stack(b,3,k,-1,n,"b","dgesv_stacked"));
+    TRY(check_stack(info,1,k,-1,-1,"info","dgesv_stacked"));
+    nrhs = (int)PyArray_DIM(b, 1);
+    ld = n > 0 ? n : 1;
+
+    ipiv = (int *)malloc((n > 0 ? n : 1)*sizeof(int));
+    if (ipiv == NULL) {
+        return PyErr_NoMemory();
+    }
+    ap = DDATA(a);
+    bp = DDATA(b);
+    infop = IDATA(info);
+    for (p = 0; p < k; p++) {
+        if (n >= 2 && n <= 4) {
+            infop[p] = inv_small(n, ap, inv);
+            for (j = 0; infop[p] == 0 && j < nrhs; j++) {
+                double *col = bp + j*n;
+
+                for (i = 0; i < n; i++) {
+                    x[i] = 0;
+                    for (l = 0; l < n; l++) {
+                        x[i] += inv[i + l*n]*col[l];
+                    }
+                }
+                for (i = 0; i < n; i++) {
+                    col[i] = x[i];
+                }
+            }
+        }
+        else {
+            FNAME(dgesv)(&n,&nrhs,ap,&ld,ipiv,bp,&ld,&infop[p]);
+        }
+        if (infop[p] != 0) {
+            nfail++;
+        }
+        ap += (npy_intp)n*n;
+        bp += (npy_intp)n*nrhs;
+    }
+    free(ipiv);
+
+    return Py_BuildValue("{s:i,s:i,s:n}","n",n,"nrhs",nrhs,"info",nfail);
+}
+
+static PyObject *
+lapack_lite_dinv_stacked(PyObject *NPY_UNUSED(self), PyObject *args)
+{
+    PyObject *a, *info;
+    double *ap, *work;
+    int *ipiv, *infop;
+    int n, ld, i;
+    npy_intp k, p, nn, nfail = 0;
+
+    TRY(PyArg_ParseTuple(args,"OO",&a,&info));
+
+    TRY(check_object(a,PyArray_DOUBLE,"a","PyArray_DOUBLE","dinv_stacked"));
+    TRY(check_object(info,PyArray_INT,"info","PyArray_INT","dinv_stacked"));
+    TRY(check_stack(a,3,-1,-1,-1,"a","dinv_stacked"));
+    k = PyArray_DIM(a, 0);
+    n = (int)PyArray_DIM(a, 1);
+    TRY(check_stack(a,3,k,n,n,"a","dinv_stacked"));
+    TRY(check_stack(info,1,k,-1,-1,"info","dinv_stacked"));
+    nn = (npy_intp)n*n;
+    ld = n > 0 ? n : 1;
+
+    /*
+     * The LU factors and then the inverse, or the inverse of a small
+     * matrix, copied over the matrix only once it is known
+     */
+    work = (double *)malloc((nn > 8 ? 2*nn : 16)*sizeof(double));
+    ipiv = (int *)malloc((n > 0 ? n : 1)*sizeof(int));
+    if (work == NULL || ipiv == NULL) {
+        free(work);
+        free(ipiv);
+        return PyErr_NoMemory();
+    }
+    ap = DDATA(a);
+    infop = IDATA(info);
+    for (p = 0; p < k; p++) {
+        if (n >= 2 && n <= 4) {
+            infop[p] = inv_small(n, ap, work);
+            if (infop[p] == 0) {
+                memcpy(ap, work, nn*sizeof(double));
+            }
+        }
+        else {
+            memcpy(work, ap, nn*sizeof(double));
+            memset(work + nn, 0, nn*sizeof(double));
+            for (i = 0; i < n; i++) {
+                work[nn + i*(n + 1)] = 1;
+            }
+            FNAME(dgesv)(&n,&n,work,&ld,ipiv,work + nn,&ld,&infop[p]);
+            if (infop[p] == 0) {
+                memcpy(ap, work + nn, nn*sizeof(double));
+            }
+        }
+        if (infop[p] != 0) {
+            nfail++;
+        }
+        ap += nn;
+    }
+    free(work);
+    free(ipiv);
+
+    return Py_BuildValue("{s:i,s:n}","n",n,"info",nfail);
+}
+
+static PyObject *
+lapack_lite_ddet_stacked(PyObject *NPY_UNUSED(self), PyObject *args)
+{
+    PyObject *a, *det;
+    double *ap, *detp, d;
+    int *ipiv;
+    int n, ld, i, info;
+    npy_intp k, p;
+
+    TRY(PyArg_ParseTuple(args,"OO",&a,&det));
+
+    TRY(check_object(a,PyArray_DOUBLE,"a","PyArray_DOUBLE","ddet_stacked"));
+    TRY(check_object(det,PyArray_DOUBLE,"det","PyArray_DOUBLE","ddet_stacked"));
+    TRY(check_stack(a,3,-1,-1,-1,"a","ddet_stacked"));
+    k = PyArray_DIM(a, 0);
+    n = (int)PyArray_DIM(a, 1);
+    TRY(check_stack(a,3,k,n,n,"a","ddet_stacked"));
+    TRY(check_stack(det,1,k,-1,-1,"det","ddet_stacked"));
+    ld = n > 0 ? n : 1;
+
+    ipiv = (int *)malloc((n > 0 ? n : 1)*sizeof(int));
+    if (ipiv == NULL) {
+        return PyErr_NoMemory();
+    }
+    ap = DDATA(a);
+    detp = DDATA(det);
+    for (p = 0; p < k; p++) {
+        if (n >= 2 && n <= 4) {
+            d = det_small(n, ap);
+        }
+        else {
+            /* A singular matrix has a zero on the diagonal of U */
+            FNAME(dgetrf)(&n,&n,ap,&ld,ipiv,&info);
+            d = 1;
+            for (i = 0; i < n; i++) {
+                d *= ipiv[i] != i + 1 ? -ap[i*(n + 1)] : ap[i*(n + 1)];
+            }
+        }
+        detp[p] = d;
+        ap += (npy_intp)n*n;
+    }
+    free(ipiv);
+
+    return Py_BuildValue("{s:i}","n",n);
+}
+
+static PyObject *
+lapack_lite_dsyevd_stacked(PyObject *NPY_UNUSED(self), PyObject *args)
+{
+    PyObject *a, *w, *info;
+    char jobz, uplo;
+    double *ap, *wp, *work, query;
+    int *iwork, *infop;
+    int n, ld, lwork, liwork, iquery, qinfo;
+    npy_intp k, p, nfail = 0;
+
+    TRY(PyArg_ParseTuple(args,"ccOOO",&jobz,&uplo,&a,&w,&info));
+
+    TRY(check_object(a,PyArray_DOUBLE,"a","PyArray_DOUBLE","dsyevd_stacked"));
+    TRY(check_object(w,PyArray_DOUBLE,"w","PyArray_DOUBLE","dsyevd_stacked"));
+    TRY(check_object(info,PyArray_INT,"info","PyArray_INT","dsyevd_stacked"));
+    TRY(check_stack(a,3,-1,-1,-1,"a","dsyevd_stacked"));
+    k = PyArray_DIM(a, 0);
+    n = (int)PyArray_DIM(a, 1);
+    TRY(check_stack(a,3,k,n,n,"a","dsyevd_stacked"));
+    TRY(check_stack(w,2,k,n,-1,"w","dsyevd_stacked"));
+    TRY(check_stack(info,1,k,-1,-1,"info","dsyevd_stacked"));
+    ld = n > 0 ? n : 1;
+
+    lwork = -1;
+    liwork = 5*n + 3;
+    FNAME(dsyevd)(&jobz,&uplo,&n,&query,&ld,&query,&query,&lwork,
+                  &iquery,&liwork,&qinfo);
+    if (PyErr_Occurred()) {
+        return NULL;
+    }
+    lwork = query > 1 ? (int)query : 1;
+    work = (double *)malloc(lwork*sizeof(double));
+    iwork = (int *)malloc(liwork*sizeof(int));
+    if (work == NULL || iwork == NULL) {
+        free(work);
+        free(iwork);
+        return PyErr_NoMemory();
+    }
+    ap = DDATA(a);
+    wp = DDATA(w);
+    infop = IDATA(info);
+    for (p = 0; p < k; p++) {
+        FNAME(dsyevd)(&jobz,&uplo,&n,ap,&ld,wp,work,&lwork,
+                      iwork,&liwork,&infop[p]);
+        if (infop[p] != 0) {
+            nfail++;
+        }
+        ap += (npy_intp)n*n;
+        wp += n;
+    }
+    free(work);
+    free(iwork);
+
+    return Py_BuildValue("{s:c,s:c,s:i,s:i,s:i,s:n}","jobz",jobz,
+                         "uplo",uplo,"n",n,"lwork",lwork,"liwork",liwork,
+                         "info",nfail);
+}
+
+static PyObject *
+lapack_lite_dgeev_stacked(PyObject *NPY_UNUSED(self), PyObject *args)
+{
+    PyObject *a, *wr, *wi, *vl, *vr, *info;
+    char jobvl, jobvr;
+    double *ap, *wrp, *wip, *vlp, *vrp, *work, query;
+    int *infop;
+    int n, ld, ldvl, ldvr, lwork, qinfo;
+    npy_intp k, p, nfail = 0;
+
+    TRY(PyArg_ParseTuple(args,"ccOOOOOO",&jobvl,&jobvr,&a,&wr,&wi,
+                         &vl,&vr,&info));
+
+    TRY(check_object(a,PyArray_DOUBLE,"a","PyArray_DOUBLE","dgeev_stacked"));
+    TRY(check_object(wr,PyArray_DOUBLE,"wr","PyArray_DOUBLE","dgeev_stacked"));
+    TRY(check_object(wi,PyArray_DOUBLE,"wi","PyArray_DOUBLE","dgeev_stacked"));
+    TRY(check_object(vl,PyArray_DOUBLE,"vl","PyArray_DOUBLE","dgeev_stacked"));
+    TRY(check_object(vr,PyArray_DOUBLE,"vr","PyArray_DOUBLE","dgeev_stacked"));
+    TRY(check_object(info,PyArray_INT,"info","PyArray_INT","dgeev_stacked"));
+    TRY(check_stack(a,3,-1,-1,-1,"a","dgeev_stacked"));
+    k = PyArray_DIM(a, 0);
+    n = (int)PyArray_DIM(a, 1);
+    TRY(check_stack(a,3,k,n,n,"a","dgeev_stacked"));
+    TRY(check_stack(wr,2,k,n,-1,"wr","dgeev_stacked"));
+    TRY(check_stack(wi,2,k,n,-1,"wi","dgeev_stacked"));
+    /* vl and vr are only used if their eigenvectors are wanted */
+    if (jobvl == 'V') {
+        TRY(check_stack(vl,3,k,n,n,"vl","dgeev_stacked"));
+    }
+    if (jobvr == 'V') {
+        TRY(check_stack(vr,3,k,n,n,"vr","dgeev_stacked"));
+    }
+    TRY(check_stack(info,1,k,-1,-1,"info","dgeev_stacked"));
+    ld = n > 0 ? n : 1;
+    ldvl = jobvl == 'V' ? ld : 1;
+    ldvr = jobvr == 'V' ? ld : 1;
+
+    lwork = -1;
+    FNAME(dgeev)(&jobvl,&jobvr,&n,&query,&ld,&query,&query,&query,&ldvl,
+                 &query,&ldvr,&query,&lwork,&qinfo);
+    if (PyErr_Occurred()) {
+        return NULL;
+    }
+    lwork = query > 1 ? (int)query : 1;
+    work = (double *)malloc(lwork*sizeof(double));
+    if (work == NULL) {
+        return PyErr_NoMemory();
+    }
+    ap = DDATA(a);
+    wrp = DDATA(wr);
+    wip = DDATA(wi);
+    vlp = DDATA(vl);
+    vrp = DDATA(vr);
+    infop = IDATA(info);
+    for (p = 0; p < k; p++) {
+        FNAME(dgeev)(&jobvl,&jobvr,&n,ap,&ld,wrp,wip,vlp,&ldvl,vrp,&ldvr,
+                     work,&lwork,&infop[p]);
+        if (infop[p] != 0) {
+            nfail++;
+        }
+        ap += (npy_intp)n*n;
+        wrp += n;
+        wip += n;
+        if (jobvl == 'V') {
+            vlp += (npy_intp)n*n;
+        }
+        if (jobvr == 'V') {
+            vrp += (npy_intp)n*n;
+        }
+    }
+    free(work);
+
+    return Py_BuildValue("{s:c,s:c,s:i,s:i,s:n}","jobvl",jobvl,
+                         "jobvr",jobvr,"n",n,"lwork",lwork,"info",nfail);
+}
+
+static PyObject *
+lapack_lite_dgelsd_stacked(PyObject *NPY_UNUSED(self), PyObject *args)
+{
+    PyObject *a, *b, *s, *rank, *info;
+    double rcond, *ap, *bp, *sp, *work, query;
+    int *iwork, *rankp, *infop;
+    int m, n, nrhs, minmn, lda, ldb, nlvl, lwork, liwork, qrank, qinfo;
+    npy_intp k, p, nfail = 0;
+
+    TRY(PyArg_ParseTuple(args,"OOOdOO",&a,&b,&s,&rcond,&rank,&info));
+
+    TRY(check_object(a,PyArray_DOUBLE,"a","PyArray_DOUBLE","dgelsd_stacked"));
+    TRY(check_object(b,PyArray_DOUBLE,"b","PyArray_DOUBLE","dgelsd_stacked"));
+    TRY(check_object(s,PyArray_DOUBLE,"s","PyArray_DOUBLE","dgelsd_stacked"));
+    TRY(check_object(rank,PyArray_INT,"rank","PyArray_INT","dgelsd_stacked"));
+    TRY(check_object(info,PyArray_INT,"info","PyArray_INT","dgelsd_stacked"));
+    /* a holds k m by n matrices, b k ldb by nrhs ones */
+    TRY(check_stack(a,3,-1,-1,-1,"a","dgelsd_stacked"));
+    k = PyArray_DIM(a, 0);
+    n = (int)PyArray_DIM(a, 1);
+    m = (int)PyArray_DIM(a, 2);
+    minmn = m < n ? m : n;
+    TRY(check_stack(b,3,k,-1,-1,"b","dgelsd_stacked"));
+    nrhs = (int)PyArray_DIM(b, 1);
+    ldb = (int)PyArray_DIM(b, 2);
+    if (ldb < m || ldb < n || ldb < 1) {
+        PyErr_Format(LapackError,
+                     "Parameter b has the wrong shape in "
+                     "lapack_lite.dgelsd_stacked");
+        return NULL;
+    }
+    TRY(check_stack(s,2,k,minmn,-1,"s","dgelsd_stacked"));
+    TRY(check_stack(rank,1,k,-1,-1,"rank","dgelsd_stacked"));
+    TRY(check_stack(info,1,k,-1,-1,"info","dgelsd_stacked"));
+    lda = m > 0 ? m : 1;
+
+    /* The size of iwork, from the documentation of dgelsd */
+    nlvl = 0;
+    if (minmn > 0) {
+        nlvl = (int)(log((double)minmn/26)/log(2.)) + 1;
+        if (nlvl < 0) {
+            nlvl = 0;
+        }
+    }
+    liwork = 3*minmn*nlvl + 11*minmn;
+    if (liwork < 1) {
+        liwork = 1;
+    }
+    iwork = (int *)malloc(liwork*sizeof(int));
+    if (iwork == NULL) {
+        return PyErr_NoMemory();
+    }
+    lwork = -1;
+    FNAME(dgelsd)(&m,&n,&nrhs,&query,&lda,&query,&ldb,&query,&rcond,
+                  &qrank,&query,&lwork,iwork,&qinfo);
+    if (PyErr_Occurred()) {
+        free(iwork);
+        return NULL;
+    }
+    lwork = query > 1 ? (int)query : 1;
+    work = (double *)malloc(lwork*sizeof(double));
+    if (work == NULL) {
+        free(iwork);
+        return PyErr_NoMemory();
+    }
+    ap = DDATA(a);
+    bp = DDATA(b);
+    sp = DDATA(s);
+    rankp = IDATA(rank);
+    infop = IDATA(info);
+    for (p = 0; p < k; p++) {
+        FNAME(dgelsd)(&m,&n,&nrhs,ap,&lda,bp,&ldb,sp,&rcond,&rankp[p],
+                      work,&lwork,iwork,&infop[p]);
+        if (infop[p] != 0) {
+            nfail++;
+        }
+        ap += (npy_intp)m*n;
+        bp += (npy_intp)ldb*nrhs;
+        sp += minmn;
+    }
+    free(work);
+    free(iwork);
+
+    return Py_BuildValue("{s:i,s:i,s:i,s:i,s:d,s:i,s:n}","m",m,"n",n,
+                         "nrhs",nrhs,"ldb",ldb,"rcond",rcond,"lwork",lwork,
+                         "info",nfail);
+}
 
 
 #define STR(x) #x
@@ -823,6 +1451,15 @@ static struct PyMethodDef lapack_lite_module_methods[] = {
     lameth(zpotrf),
     lameth(zgeqrf),
     lameth(zungqr),
+    lameth(dgemm),
+    lameth(zgemm),
+    lameth(dgemv),
+    lameth(dgesv_stacked),
+    lameth(dinv_stacked),
+    lameth(ddet_stacked),
+    lameth(dsyevd_stacked),
+    lameth(dgeev_stacked),
+    lameth(dgelsd_stacked),
     { NULL,NULL,0, NULL}
 };
 
@@ -25,7 +25,7 @@ def configuration(parent_package='',top_path=None):
                          depends=  ['lapack_litemodule.c',
                                     'python_xerbla.c',
                                     'zlapack_lite.c', 'dlapack_lite.c',
-                                    'blas_lite.c', 'dlamch.c',
+                                    'blas_lite.c', 'blas_gemm.c', 'dlamch.c',
                                     'f2c_lite.c','f2c.h'],
                          extra_info = lapack_info
                          )
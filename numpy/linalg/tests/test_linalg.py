@@ -335,6 +335,176 @@ class TestNormSingle(_TestNorm):
     dec = 6
 
 
+class TestStacked(TestCase):
+    # The stacked lapack_lite functions take matrices in Fortran order,
+    # so the stacks passed in are transposed copies.
+    def setUp(self):
+        np.random.seed(1)
+
+    def test_solve_inv_det(self):
+        from numpy.linalg import lapack_lite
+        for n in range(1, 7):
+            a = np.random.rand(5, n, n) + n*identity(n)
+            b = np.random.rand(5, n, 2)
+            at = a.transpose(0, 2, 1).copy()
+            bt = b.transpose(0, 2, 1).copy()
+            info = np.zeros(5, np.intc)
+            r = lapack_lite.dgesv_stacked(at, bt, info)
+            assert_equal(r['info'], 0)
+            for i in range(5):
+                assert_almost_equal(bt[i].T, linalg.solve(a[i], b[i]))
+            at = a.transpose(0, 2, 1).copy()
+            lapack_lite.dinv_stacked(at, info)
+            for i in range(5):
+                assert_almost_equal(at[i].T, linalg.inv(a[i]))
+            d = np.zeros(5)
+            lapack_lite.ddet_stacked(a.copy(), d)
+            for i in range(5):
+                assert_approx_equal(d[i], linalg.det(a[i]), significant=12)
+
+    def test_singular(self):
+        # A singular matrix is left as it was, by both the unrolled and
+        # the LAPACK inverse
+        from numpy.linalg import lapack_lite
+        for n in [1, 2, 3, 4, 5, 6]:
+            a = np.zeros((2, n, n))
+            a[0, :, 1:] = np.arange(1, n*(n - 1) + 1).reshape(n, n - 1)
+            a[1] = 2*identity(n)
+            s = a[0].copy()
+            info = np.zeros(2, np.intc)
+            r = lapack_lite.dinv_stacked(a, info)
+            assert_equal(r['info'], 1)
+            assert_(info[0] > 0 and info[1] == 0)
+            assert_equal(a[0], s)
+            assert_equal(a[1], identity(n)/2)
+
+    def test_eig_lstsq(self):
+        from numpy.linalg import lapack_lite
+        a = np.random.rand(4, 5, 5)
+        s = a + a.transpose(0, 2, 1)
+        w = np.zeros((4, 5))
+        info = np.zeros(4, np.intc)
+        lapack_lite.dsyevd_stacked('N', 'L', s.copy(), w, info)
+        for i in range(4):
+            assert_almost_equal(w[i], linalg.eigvalsh(s[i]))
+        wr, wi = np.zeros((4, 5)), np.zeros((4, 5))
+        dummy = np.zeros(1)
+        lapack_lite.dgeev_stacked('N', 'N', a.transpose(0, 2, 1).copy(),
+                                  wr, wi, dummy, dummy, info)
+        for i in range(4):
+            assert_almost_equal(np.sort_complex(wr[i] + 1j*wi[i]),
+                                np.sort_complex(linalg.eigvals(a[i])))
+        a = np.random.rand(4, 6, 3)
+        b = np.random.rand(4, 6)
+        sv = np.zeros((4, 3))
+        rank = np.zeros(4, np.intc)
+        bt = b[:, np.newaxis, :].copy()
+        lapack_lite.dgelsd_stacked(a.transpose(0, 2, 1).copy(), bt, sv, -1.,
+                                   rank, info)
+        for i in range(4):
+            assert_almost_equal(bt[i, 0, :3], linalg.lstsq(a[i], b[i])[0])
+        assert_equal(rank, 3)
+
+
+class TestGemm(TestCase):
+    # dgemm, zgemm and dgemv are checked against dot.  Matrices are passed
+    # in Fortran order with a leading dimension of ld, as the rows of a
+    # C array of shape (columns, ld); the rows past the matrix are padding
+    # that must not be written.  The largest shapes take the blocked path.
+    shapes = [(1, 1, 1), (3, 5, 7), (7, 5, 3), (4, 4, 0), (37, 45, 29),
+              (70, 33, 65)]
+
+    def setUp(self):
+        np.random.seed(1)
+
+    def _rand(self, dtype, *shape):
+        if dtype == cdouble:
+            return np.random.rand(*shape) + 1j*np.random.rand(*shape)
+        return np.random.rand(*shape)
+
+    def _fortran(self, x, pad):
+        ld = max(x.shape[0], 1) + pad
+        buf = np.empty((x.shape[1], ld), x.dtype)
+        buf.fill(-7)
+        buf[:, :x.shape[0]] = x.T
+        return buf, ld
+
+    def _op(self, x, trans):
+        if trans == 'N':
+            return x
+        elif trans == 'T':
+            return x.T
+        return x.conj().T
+
+    def _check_gemm(self, dtype, gemm, transes):
+        for m, n, k in self.shapes:
+            for ta in transes:
+                for tb in transes:
+                    for alpha, beta in [(1.5, 0.), (0.5, 1.), (0., 2.),
+                                        (-1., 0.25)]:
+                        if dtype == cdouble:
+                            alpha = alpha*(1 - 0.5j)
+                            beta = beta*(1 + 0.5j)
+                        a = self._rand(dtype, *((m, k) if ta == 'N'
+                                                else (k, m)))
+                        b = self._rand(dtype, *((k, n) if tb == 'N'
+                                                else (n, k)))
+                        c = self._rand(dtype, m, n)
+                        if beta == 0:
+                            # beta == 0 must ignore what was in c
+                            c.fill(np.nan)
+                        fa, lda = self._fortran(a, 1)
+                        fb, ldb = self._fortran(b, 2)
+                        fc, ldc = self._fortran(c, 3)
+                        gemm(ta, tb, m, n, k, alpha, fa, lda, fb, ldb,
+                             beta, fc, ldc)
+                        expected = alpha*dot(self._op(a, ta),
+                                             self._op(b, tb))
+                        if beta != 0:
+                            expected = expected + beta*c
+                        assert_almost_equal(fc[:, :m].T, expected)
+                        assert_equal(fc[:, m:], -7)
+
+    def test_dgemm(self):
+        from numpy.linalg import lapack_lite
+        self._check_gemm(double, lapack_lite.dgemm, 'NTC')
+
+    def test_zgemm(self):
+        from numpy.linalg import lapack_lite
+        self._check_gemm(cdouble, lapack_lite.zgemm, 'NTC')
+
+    def test_dgemv(self):
+        from numpy.linalg import lapack_lite
+        for m, n, _ in self.shapes:
+            for trans in 'NTC':
+                for incx, incy in [(1, 1), (2, 3), (-1, 1), (1, -2)]:
+                    for alpha, beta in [(1.5, 0.), (0.5, 1.), (0., 2.)]:
+                        a = np.random.rand(m, n)
+                        lenx, leny = (n, m) if trans == 'N' else (m, n)
+                        x = np.random.rand(lenx)
+                        y = np.random.rand(leny)
+                        if beta == 0:
+                            y.fill(np.nan)
+                        fa, lda = self._fortran(a, 2)
+                        # A negative increment walks the vector backwards
+                        fx = np.zeros(max(1 + (lenx - 1)*abs(incx), 1))
+                        fx[::abs(incx)][:lenx] = x[::np.sign(incx)]
+                        fy = np.zeros(max(1 + (leny - 1)*abs(incy), 1))
+                        fy.fill(-7)
+                        fy[::abs(incy)][:leny] = y[::np.sign(incy)]
+                        lapack_lite.dgemv(trans, m, n, alpha, fa, lda,
+                                          fx, incx, beta, fy, incy)
+                        expected = alpha*dot(self._op(a, trans), x)
+                        if beta != 0:
+                            expected = expected + beta*y
+                        assert_almost_equal(
+                            fy[::abs(incy)][:leny][::np.sign(incy)],
+                            expected)
+                        mask = np.ones(len(fy), bool)
+                        mask[::abs(incy)][:leny] = False
+                        assert_equal(fy[mask], -7)
+
+
 def test_matrix_rank():
     # Full rank matrix
     yield assert_equal, 4, matrix_rank(np.eye(4))
@@ -110,6 +110,17 @@ double rk_standard_exponential(rk_state *state)
     return -log(1.0 - rk_double(state));
 }
 
+void rk_fill_standard_exponential(double *out, size_t n, rk_state *state)
+{
+    size_t i;
+
+    rk_fill_double(out, n, state);
+    for (i = 0; i < n; i++)
+    {
+        out[i] = -log(1.0 - out[i]);
+    }
+}
+
 double rk_exponential(rk_state *state, double scale)
 {
     return scale * rk_standard_exponential(state);
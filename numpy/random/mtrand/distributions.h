@@ -54,6 +54,11 @@ extern double rk_normal(rk_state *state, double loc, double scale);
  * CDF. */
 extern double rk_standard_exponential(rk_state *state);
 
+/* Fill out with n standard exponentials, the same as n calls to
+ * rk_standard_exponential. */
+extern void rk_fill_standard_exponential(double *out, size_t n,
+                                         rk_state *state);
+
 /* Exponential distribution with mean=scale. */
 extern double rk_exponential(rk_state *state, double scale);
 
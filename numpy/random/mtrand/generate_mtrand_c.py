@@ -1,6 +1,11 @@
 import re
 import subprocess
 
+# mtrand.c is checked in as generated by this version of Cython; use the
+# same one so that the diff against the previous mtrand.c is only the
+# change to mtrand.pyx.
+CYTHON_VERSION = '0.13'
+
 
 def remove_long_path():
     path = 'mtrand.c'
@@ -10,7 +15,17 @@ def remove_long_path():
     open(path, 'w').write(code)
 
 
+def check_cython_version():
+    p = subprocess.Popen(['cython', '--version'], stdout=subprocess.PIPE,
+                         stderr=subprocess.STDOUT)
+    version = p.communicate()[0].decode().split()[-1]
+    if version != CYTHON_VERSION:
+        raise SystemExit('mtrand.c is generated with Cython %s, not %s'
+                         % (CYTHON_VERSION, version))
+
+
 def main():
+    check_cython_version()
     assert subprocess.call(['cython', 'mtrand.pyx']) == 0
     remove_long_path()
 
@@ -149,4 +149,5 @@ init_by_array(rk_state *self, unsigned long init_key[],
     self->gauss = 0;
     self->has_gauss = 0;
     self->has_binomial = 0;
+    self->bitgen = NULL;
 }
@@ -57,16 +57,20 @@ cdef extern from "randomkit.h":
     unsigned long rk_ulong(rk_state *state)
     unsigned long rk_interval(unsigned long max, rk_state *state)
     double rk_double(rk_state *state)
+    void rk_fill_double(double *out, size_t n, rk_state *state)
     void rk_fill(void *buffer, size_t size, rk_state *state)
     rk_error rk_devfill(void *buffer, size_t size, int strong)
     rk_error rk_altfill(void *buffer, size_t size, int strong,
                         rk_state *state)
     double rk_gauss(rk_state *state)
+    void rk_fill_gauss(double *out, size_t n, rk_state *state)
 
 cdef extern from "distributions.h":
 
     double rk_normal(rk_state *state, double loc, double scale)
     double rk_standard_exponential(rk_state *state)
+    void rk_fill_standard_exponential(double *out, size_t n,
+                                      rk_state *state)
     double rk_exponential(rk_state *state, double scale)
     double rk_uniform(rk_state *state, double loc, double scale)
     double rk_standard_gamma(rk_state *state, double shape)
@@ -108,6 +112,7 @@ ctypedef double (* rk_cont0)(rk_state *state)
 ctypedef double (* rk_cont1)(rk_state *state, double a)
 ctypedef double (* rk_cont2)(rk_state *state, double a, double b)
 ctypedef double (* rk_cont3)(rk_state *state, double a, double b, double c)
+ctypedef void (* rk_fill0)(double *out, size_t n, rk_state *state)
 
 ctypedef long (* rk_disc0)(rk_state *state)
 ctypedef long (* rk_discnp)(rk_state *state, long n, double p)
@@ -146,6 +151,41 @@ cdef object cont0_array(rk_state *state, rk_cont0 func, object size):
         return arr
 
 
+cdef object fill0_array(rk_state *state, rk_cont0 func, rk_fill0 fill,
+                        object size):
+    # Same values as cont0_array(state, func, size) when fill(out, n, state)
+    # is n calls to func, but the whole array is generated in one call.
+    cdef double *data
+    cdef npy_intp length
+
+    if size is None:
+        return func(state)
+    else:
+        arr = np.empty(size, np.double)
+        length = arr.size
+        data = <double *>dataptr(arr)
+        fill(data, <size_t>length, state)
+        return arr
+
+
+cdef object fill0_array_affine(rk_state *state, rk_cont0 func, rk_fill0 fill,
+                               object size, double loc, double scale):
+    # loc + scale*fill0_array(state, func, fill, size)
+    cdef double *data
+    cdef npy_intp length, i
+
+    if size is None:
+        return loc + scale*func(state)
+    else:
+        arr = np.empty(size, np.double)
+        length = arr.size
+        data = <double *>dataptr(arr)
+        fill(data, <size_t>length, state)
+        for i from 0 <= i < length:
+            data[i] = loc + scale*data[i]
+        return arr
+
+
 cdef object cont1_array_sc(rk_state *state, rk_cont1 func, object size,
                            double a):
     cdef double *data
@@ -762,7 +802,7 @@ cdef class RandomState:
                [-1.23204345, -1.75224494]])
 
         """
-        return cont0_array(self.internal_state, rk_double, size)
+        return fill0_array(self.internal_state, rk_double, rk_fill_double, size)
 
     def tomaxint(self, size=None):
         """
@@ -978,8 +1018,9 @@ cdef class RandomState:
             pass
 
         if sc:
-            return cont2_array_sc(self.internal_state, rk_uniform, size,
-                                  flow, fhigh - flow)
+            return fill0_array_affine(self.internal_state, rk_double,
+                                      rk_fill_double, size, flow,
+                                      fhigh - flow)
 
         diff = np.array(high) - np.array(low)
         return cont2_array(self.internal_state, rk_uniform, size,
@@ -1193,7 +1234,7 @@ cdef class RandomState:
         (3, 4, 2)
 
         """
-        return cont0_array(self.internal_state, rk_gauss, size)
+        return fill0_array(self.internal_state, rk_gauss, rk_fill_gauss, size)
 
     def normal(self, loc=0.0, scale=1.0, size=None):
         """
@@ -1290,8 +1331,8 @@ cdef class RandomState:
         if sc:
             if fscale <= 0:
                 raise ValueError("scale <= 0")
-            return cont2_array_sc(self.internal_state, rk_normal, size, floc,
-                                  fscale)
+            return fill0_array_affine(self.internal_state, rk_gauss,
+                                      rk_fill_gauss, size, floc, fscale)
 
         if np.any(np.less_equal(scale, 0)):
             raise ValueError("scale <= 0")
@@ -1407,8 +1448,10 @@ cdef class RandomState:
         if sc:
             if fscale <= 0:
                 raise ValueError("scale <= 0")
-            return cont1_array_sc(self.internal_state, rk_exponential, size,
-                                  fscale)
+            return fill0_array_affine(self.internal_state,
+                                      rk_standard_exponential,
+                                      rk_fill_standard_exponential, size,
+                                      0.0, fscale)
 
         if np.any(np.less_equal(scale, 0.0)):
             raise ValueError("scale <= 0")
@@ -1440,7 +1483,8 @@ cdef class RandomState:
         >>> n = np.random.standard_exponential((3, 8000))
 
         """
-        return cont0_array(self.internal_state, rk_standard_exponential, size)
+        return fill0_array(self.internal_state, rk_standard_exponential,
+                           rk_fill_standard_exponential, size)
 
     def standard_gamma(self, shape, size=None):
         """
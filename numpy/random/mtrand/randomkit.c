@@ -70,6 +70,7 @@
 #include <errno.h>
 #include <limits.h>
 #include <math.h>
+#include <string.h>
 
 #ifdef _WIN32
 /*
@@ -149,6 +150,7 @@ rk_seed(unsigned long seed, rk_state *state)
     state->gauss = 0;
     state->has_gauss = 0;
     state->has_binomial = 0;
+    state->bitgen = NULL;
 }
 
 /* Thomas Wang 32 bits integer hash function */
@@ -181,6 +183,7 @@ rk_randomseed(rk_state *state)
         state->gauss = 0;
         state->has_gauss = 0;
         state->has_binomial = 0;
+        state->bitgen = NULL;
 
         for (i = 0; i < 624; i++) {
             state->key[i] &= 0xffffffffUL;
@@ -207,39 +210,851 @@ rk_randomseed(rk_state *state)
 #define UPPER_MASK 0x80000000UL
 #define LOWER_MASK 0x7fffffffUL
 
-/* Slightly optimised reference implementation of the Mersenne Twister */
-unsigned long
-rk_random(rk_state *state)
+/* Tempering of one word of the state */
+#define RK_TEMPER(y)                                                        \
+    do {                                                                    \
+        (y) ^= ((y) >> 11);                                                 \
+        (y) ^= ((y) << 7) & 0x9d2c5680UL;                                   \
+        (y) ^= ((y) << 15) & 0xefc60000UL;                                  \
+        (y) ^= ((y) >> 18);                                                 \
+    } while (0)
+
+/* Regenerate the N words of the state at once */
+static void
+rk_regenerate(rk_state *state)
+{
+    unsigned long y;
+    int i;
+
+    for (i = 0; i < N - M; i++) {
+        y = (state->key[i] & UPPER_MASK) | (state->key[i+1] & LOWER_MASK);
+        state->key[i] = state->key[i+M] ^ (y>>1) ^ (-(y & 1) & MATRIX_A);
+    }
+    for (; i < N - 1; i++) {
+        y = (state->key[i] & UPPER_MASK) | (state->key[i+1] & LOWER_MASK);
+        state->key[i] = state->key[i+(M-N)] ^ (y>>1) ^ (-(y & 1) & MATRIX_A);
+    }
+    y = (state->key[N - 1] & UPPER_MASK) | (state->key[0] & LOWER_MASK);
+    state->key[N - 1] = state->key[M - 1] ^ (y >> 1) ^ (-(y & 1) & MATRIX_A);
+
+    state->pos = 0;
+}
+
+/*
+ * Slightly optimised reference implementation of the Mersenne Twister,
+ * or the state's bit generator.  The static version can be inlined by the
+ * bulk generators below.
+ */
+static unsigned long
+next_word(rk_state *state)
 {
     unsigned long y;
 
+    if (state->bitgen != NULL) {
+        return state->bitgen->next(state);
+    }
     if (state->pos == RK_STATE_LEN) {
-        int i;
+        rk_regenerate(state);
+    }
+    y = state->key[state->pos++];
+    RK_TEMPER(y);
+
+    return y;
+}
+
+unsigned long
+rk_random(rk_state *state)
+{
+    return next_word(state);
+}
+
+/*
+ * Jumping ahead.
+ *
+ * The Mersenne Twister's transition is linear over GF(2): the state is
+ * the window of the last N words generated, and each step shifts in one
+ * new word.  Advancing by J steps therefore amounts to evaluating the
+ * polynomial x^J mod P(x) at the transition, where P is the
+ * characteristic polynomial of MT19937 (degree 19937), which takes
+ * about MT_DEGREE window steps and additions instead of J steps.
+ *
+ * P is recovered once from an output sequence using the
+ * Berlekamp-Massey algorithm.  Polynomials over GF(2) are stored as
+ * little-endian bit arrays of unsigned longs.
+ */
+#define MT_DEGREE 19937
+#define RK_WORD_BITS (sizeof(unsigned long) * CHAR_BIT)
+/* Words in a polynomial of degree MT_DEGREE */
+#define MT_POLY_WORDS (MT_DEGREE / RK_WORD_BITS + 1)
+
+static unsigned long mt_charpoly[MT_DEGREE / 32 + 1];
+static int mt_charpoly_ready = 0;
+
+#define POLY_BIT(p, i) (((p)[(i) / RK_WORD_BITS] >> ((i) % RK_WORD_BITS)) & 1)
+#define POLY_FLIP(p, i) ((p)[(i) / RK_WORD_BITS] ^= 1UL << ((i) % RK_WORD_BITS))
+
+/* Returns RK_WORD_BITS bits of p starting at bit off; p has n words */
+static unsigned long
+poly_window(const unsigned long *p, size_t n, size_t off)
+{
+    size_t w = off / RK_WORD_BITS, b = off % RK_WORD_BITS;
+    unsigned long lo = (w < n) ? p[w] : 0;
+
+    if (b == 0) {
+        return lo;
+    }
+    return (lo >> b) | ((w + 1 < n) ? p[w + 1] << (RK_WORD_BITS - b) : 0);
+}
+
+/* dst ^= src << shift, for the first nsrc words of src */
+static void
+poly_xor_shifted(unsigned long *dst, size_t ndst, const unsigned long *src,
+                 size_t nsrc, size_t shift)
+{
+    size_t w = shift / RK_WORD_BITS, b = shift % RK_WORD_BITS, i;
+
+    for (i = 0; i < nsrc && i + w < ndst; i++) {
+        dst[i + w] ^= src[i] << b;
+        if (b != 0 && i + w + 1 < ndst) {
+            dst[i + w + 1] ^= src[i] >> (RK_WORD_BITS - b);
+        }
+    }
+}
+
+static int
+word_parity(unsigned long x)
+{
+    size_t s;
+
+    for (s = RK_WORD_BITS / 2; s > 0; s >>= 1) {
+        x ^= x >> s;
+    }
+    return (int)(x & 1);
+}
+
+/* Computes mt_charpoly with the Berlekamp-Massey algorithm. */
+static void
+mt_init_charpoly(void)
+{
+    /* Polynomials of degree up to 2 * MT_DEGREE during the iteration */
+    enum { NBITS = 2 * MT_DEGREE, NW = NBITS / 32 + 2 };
+    unsigned long seq[NW], c[NW], b[NW], t[NW];
+    size_t nw = NBITS / RK_WORD_BITS + 2;
+    size_t n, i, L = 0, m = 1;
+    rk_state state;
+
+    memset(seq, 0, sizeof(seq));
+    memset(c, 0, sizeof(c));
+    memset(b, 0, sizeof(b));
+
+    /* The sequence is stored reversed so the discrepancy is a dot product
+       of c with a window of seq. */
+    rk_seed(5489UL, &state);
+    for (n = 0; n < NBITS; n++) {
+        if (rk_random(&state) & 1) {
+            POLY_FLIP(seq, NBITS - 1 - n);
+        }
+    }
+    c[0] = b[0] = 1;
+    for (n = 0; n < NBITS; n++) {
+        size_t base = NBITS - 1 - n;
+        unsigned long d = 0;
+
+        for (i = 0; i <= L / RK_WORD_BITS; i++) {
+            d ^= c[i] & poly_window(seq, nw, base + i * RK_WORD_BITS);
+        }
+        if (!word_parity(d)) {
+            m++;
+        }
+        else if (2 * L <= n) {
+            memcpy(t, c, sizeof(c));
+            poly_xor_shifted(c, nw, b, nw, m);
+            L = n + 1 - L;
+            memcpy(b, t, sizeof(b));
+            m = 1;
+        }
+        else {
+            poly_xor_shifted(c, nw, b, nw, m);
+            m++;
+        }
+    }
+    /* c is the connection polynomial; P is its reciprocal. */
+    memset(mt_charpoly, 0, sizeof(mt_charpoly));
+    for (i = 0; i <= L; i++) {
+        if (POLY_BIT(c, L - i)) {
+            POLY_FLIP(mt_charpoly, i);
+        }
+    }
+    mt_charpoly_ready = 1;
+}
+
+/* Reduces p (2 * MT_POLY_WORDS words) modulo the characteristic polynomial */
+static void
+poly_reduce(unsigned long *p)
+{
+    size_t d;
+
+    for (d = 2 * MT_POLY_WORDS * RK_WORD_BITS - 1; d >= MT_DEGREE; d--) {
+        if (POLY_BIT(p, d)) {
+            poly_xor_shifted(p, 2 * MT_POLY_WORDS, mt_charpoly,
+                             MT_POLY_WORDS, d - MT_DEGREE);
+        }
+    }
+}
+
+/* p = p^2 mod P */
+static void
+poly_square(unsigned long *p)
+{
+    unsigned long sq[2 * MT_DEGREE / 32 + 2];
+    size_t i;
+
+    memset(sq, 0, sizeof(sq));
+    for (i = 0; i < MT_DEGREE; i++) {
+        if (POLY_BIT(p, i)) {
+            POLY_FLIP(sq, 2 * i);
+        }
+    }
+    poly_reduce(sq);
+    memcpy(p, sq, MT_POLY_WORDS * sizeof(unsigned long));
+}
+
+/* p = p * x mod P */
+static void
+poly_mulx(unsigned long *p)
+{
+    size_t i;
+
+    for (i = MT_POLY_WORDS - 1; i > 0; i--) {
+        p[i] = (p[i] << 1) | (p[i - 1] >> (RK_WORD_BITS - 1));
+    }
+    p[0] <<= 1;
+    if (POLY_BIT(p, MT_DEGREE)) {
+        for (i = 0; i < MT_POLY_WORDS; i++) {
+            p[i] ^= mt_charpoly[i];
+        }
+    }
+}
+
+/* p = x^(steps * 2^log2_mul) mod P */
+static void
+poly_jump(unsigned long *p, unsigned long steps, unsigned int log2_mul)
+{
+    int bit;
+
+    if (!mt_charpoly_ready) {
+        mt_init_charpoly();
+    }
+    memset(p, 0, MT_POLY_WORDS * sizeof(unsigned long));
+    p[0] = 1;
+    /* Square and multiply, skipping the leading zero bits of steps */
+    bit = (int)RK_WORD_BITS - 1;
+    while (bit > 0 && !((steps >> bit) & 1)) {
+        bit--;
+    }
+    for (; bit >= 0; bit--) {
+        poly_square(p);
+        if ((steps >> bit) & 1) {
+            poly_mulx(p);
+        }
+    }
+    while (log2_mul--) {
+        poly_square(p);
+    }
+}
+
+/* One step of the recurrence on a window of N words starting at *start */
+#define MT_WINDOW_STEP(key, start)                                          \
+    do {                                                                    \
+        int i_ = (start);                                                   \
+        unsigned long y_ = ((key)[i_] & UPPER_MASK) |                       \
+                           ((key)[(i_ + 1) % N] & LOWER_MASK);              \
+        (key)[i_] = (key)[(i_ + M) % N] ^ (y_ >> 1) ^                       \
+                    (-(y_ & 1) & MATRIX_A);                                 \
+        (start) = (i_ + 1) % N;                                             \
+    } while (0)
+
+/*
+ * Advances the window of state by the polynomial p = x^J mod P (J >= 1).
+ *
+ * The oldest word of the window only contributes its top bit, so the
+ * window space is larger than the space on which the transition has
+ * minimal polynomial P.  Stepping once first lands in the latter, after
+ * which x^(J-1) = p / x mod P is applied with Horner's rule.
+ */
+static void
+mt_apply_jump(rk_state *state, const unsigned long *p)
+{
+    unsigned long h[MT_DEGREE / 32 + 1], base[N], acc[N];
+    int bstart = 0, astart = 0, i, j;
+
+    memcpy(h, p, MT_POLY_WORDS * sizeof(unsigned long));
+    if (h[0] & 1) {
+        for (i = 0; i < (int)MT_POLY_WORDS; i++) {
+            h[i] ^= mt_charpoly[i];
+        }
+    }
+    for (i = 0; i < (int)MT_POLY_WORDS - 1; i++) {
+        h[i] = (h[i] >> 1) | (h[i + 1] << (RK_WORD_BITS - 1));
+    }
+    h[MT_POLY_WORDS - 1] >>= 1;
+
+    memcpy(base, state->key, sizeof(base));
+    MT_WINDOW_STEP(base, bstart);
+
+    /* Rotate base so its window starts at 0; then only acc wraps. */
+    memcpy(acc, base + bstart, (N - bstart) * sizeof(unsigned long));
+    memcpy(acc + N - bstart, base, bstart * sizeof(unsigned long));
+    memcpy(base, acc, sizeof(base));
+
+    memset(acc, 0, sizeof(acc));
+    for (i = MT_DEGREE - 1; i >= 0; i--) {
+        MT_WINDOW_STEP(acc, astart);
+        if (POLY_BIT(h, i)) {
+            for (j = 0; j < N - astart; j++) {
+                acc[astart + j] ^= base[j];
+            }
+            for (; j < N; j++) {
+                acc[astart + j - N] ^= base[j];
+            }
+        }
+    }
+    for (j = 0; j < N; j++) {
+        state->key[j] = acc[(astart + j) % N];
+    }
+    state->gauss = 0;
+    state->has_gauss = 0;
+}
+
+void
+rk_jump(unsigned int log2_steps, rk_state *state)
+{
+    unsigned long p[MT_DEGREE / 32 + 1];
+
+    if (state->bitgen != NULL) {
+        state->bitgen->jump(log2_steps, state);
+        state->has_gauss = 0;
+        return;
+    }
+    poly_jump(p, 1, log2_steps);
+    mt_apply_jump(state, p);
+}
+
+void
+rk_advance(unsigned long steps, rk_state *state)
+{
+    unsigned long p[MT_DEGREE / 32 + 1];
+
+    if (steps == 0) {
+        return;
+    }
+    if (state->bitgen != NULL) {
+        state->bitgen->advance(steps, state);
+        state->has_gauss = 0;
+        return;
+    }
+    poly_jump(p, steps, 0);
+    mt_apply_jump(state, p);
+}
+
+void
+rk_split(rk_state *state, rk_state *streams, int nstreams)
+{
+    /* Computing the jump polynomial takes longer than applying it */
+    static unsigned long p[MT_DEGREE / 32 + 1];
+    static int p_ready = 0;
+    int i;
+
+    if (nstreams <= 0) {
+        return;
+    }
+    if (state->bitgen != NULL) {
+        streams[0] = *state;
+        streams[0].gauss = 0;
+        streams[0].has_gauss = 0;
+        for (i = 1; i < nstreams; i++) {
+            streams[i] = streams[i - 1];
+            rk_jump(state->bitgen->stream_log2, &streams[i]);
+        }
+        return;
+    }
+    if (!p_ready) {
+        poly_jump(p, 1, RK_STREAM_LOG2);
+        p_ready = 1;
+    }
+    streams[0] = *state;
+    streams[0].gauss = 0;
+    streams[0].has_gauss = 0;
+    for (i = 1; i < nstreams; i++) {
+        streams[i] = streams[i - 1];
+        mt_apply_jump(&streams[i], p);
+    }
+}
+
+void
+rk_fill_range(void *buffer, size_t offset, size_t size, rk_state *state)
+{
+    rk_state sub = *state;
+    unsigned char *buf = buffer;
+    unsigned long r;
+    size_t skip = offset % 4;
+
+    rk_advance((unsigned long)(offset / 4), &sub);
+    if (skip) {
+        r = rk_random(&sub) >> (8 * skip);
+        for (; skip < 4 && size; skip++, size--, r >>= 8) {
+            *(buf++) = (unsigned char)(r & 0xFF);
+        }
+    }
+    rk_fill(buf, size, &sub);
+}
+
+void
+rk_double_range(double *out, size_t offset, size_t n, rk_state *state)
+{
+    rk_state sub = *state;
+
+    rk_advance((unsigned long)(2 * offset), &sub);
+    rk_fill_double(out, n, &sub);
+}
+
+/*
+ * Alternative bit generators.
+ *
+ * They keep their state in the first words of key, with one 32 bit value
+ * per word as for the Mersenne Twister, and use only 32 bit arithmetic.
+ */
+#define M32 0xffffffffUL
+#define ROTL32(x, k) ((((x) << (k)) | ((x) >> (32 - (k)))) & M32)
+
+/* Weyl sequence and murmur3 finalizer to expand a seed into words */
+static unsigned long
+seed_mix(unsigned long *x)
+{
+    unsigned long z;
+
+    z = *x = (*x + 0x9e3779b9UL) & M32;
+    z = ((z ^ (z >> 16)) * 0x85ebca6bUL) & M32;
+    z = ((z ^ (z >> 13)) * 0xc2b2ae35UL) & M32;
+    return z ^ (z >> 16);
+}
+
+/* xoshiro128** */
+
+static void
+xoshiro_step(unsigned long *s)
+{
+    const unsigned long t = (s[1] << 9) & M32;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = ROTL32(s[3], 11);
+}
+
+static unsigned long
+xoshiro_next(rk_state *state)
+{
+    unsigned long *s = state->key;
+    const unsigned long r = ROTL32((s[1] * 5) & M32, 7) * 9 & M32;
+
+    xoshiro_step(s);
+    return r;
+}
+
+static void
+xoshiro_seed(const unsigned long *seed, rk_state *state)
+{
+    int i;
+
+    for (i = 0; i < 4; i++) {
+        state->key[i] = seed[i] & M32;
+    }
+    if ((state->key[0] | state->key[1] | state->key[2] | state->key[3])
+            == 0) {
+        /* The all zero state is a fixed point */
+        state->key[0] = 1;
+    }
+    state->pos = 0;
+}
+
+/*
+ * Jumps use the same method as for the Mersenne Twister, on 128 bits:
+ * h = x^J mod P, with P the characteristic polynomial of the transition
+ * T, and the new state h(T) s.  Polynomials of degree < 128 are arrays of
+ * coefficients here, as these are small enough.
+ */
+#define XS_DEGREE 128
 
-        for (i = 0; i < N - M; i++) {
-            y = (state->key[i] & UPPER_MASK) | (state->key[i+1] & LOWER_MASK);
-            state->key[i] = state->key[i+M] ^ (y>>1) ^ (-(y & 1) & MATRIX_A);
+static unsigned char xs_charpoly[XS_DEGREE + 1];
+static int xs_charpoly_ready = 0;
+
+static void
+xs_init_charpoly(void)
+{
+    unsigned char seq[2 * XS_DEGREE], c[2 * XS_DEGREE + 1];
+    unsigned char b[2 * XS_DEGREE + 1], t[2 * XS_DEGREE + 1];
+    unsigned long s[4] = {1, 2, 3, 4};
+    int n = 2 * XS_DEGREE, L = 0, m = -1, i, j, d;
+
+    for (i = 0; i < n; i++) {
+        seq[i] = (unsigned char)(s[0] & 1);
+        xoshiro_step(s);
+    }
+    /* Berlekamp-Massey, as in mt_init_charpoly */
+    memset(c, 0, sizeof(c));
+    memset(b, 0, sizeof(b));
+    c[0] = b[0] = 1;
+    for (i = 0; i < n; i++) {
+        d = seq[i];
+        for (j = 1; j <= L; j++) {
+            d ^= c[j] & seq[i - j];
+        }
+        if (d) {
+            memcpy(t, c, sizeof(c));
+            for (j = 0; j + i - m <= n; j++) {
+                c[j + i - m] ^= b[j];
+            }
+            if (2 * L <= i) {
+                L = i + 1 - L;
+                m = i;
+                memcpy(b, t, sizeof(b));
+            }
+        }
+    }
+    /* The charpoly is primitive, so L == XS_DEGREE */
+    for (i = 0; i <= XS_DEGREE; i++) {
+        xs_charpoly[i] = c[XS_DEGREE - i];
+    }
+    xs_charpoly_ready = 1;
+}
+
+/* a = a * b mod P */
+static void
+xs_mulmod(unsigned char *a, const unsigned char *b)
+{
+    unsigned char prod[2 * XS_DEGREE - 1];
+    int i, j;
+
+    memset(prod, 0, sizeof(prod));
+    for (i = 0; i < XS_DEGREE; i++) {
+        if (a[i]) {
+            for (j = 0; j < XS_DEGREE; j++) {
+                prod[i + j] ^= b[j];
+            }
+        }
+    }
+    for (i = 2 * XS_DEGREE - 2; i >= XS_DEGREE; i--) {
+        if (prod[i]) {
+            for (j = 0; j <= XS_DEGREE; j++) {
+                prod[i - XS_DEGREE + j] ^= xs_charpoly[j];
+            }
         }
-        for (; i < N - 1; i++) {
-            y = (state->key[i] & UPPER_MASK) | (state->key[i+1] & LOWER_MASK);
-            state->key[i] = state->key[i+(M-N)] ^ (y>>1) ^ (-(y & 1) & MATRIX_A);
+    }
+    memcpy(a, prod, XS_DEGREE);
+}
+
+/* a = a * x mod P */
+static void
+xs_mulx(unsigned char *a)
+{
+    const unsigned char top = a[XS_DEGREE - 1];
+    int j;
+
+    memmove(a + 1, a, XS_DEGREE - 1);
+    a[0] = 0;
+    if (top) {
+        for (j = 0; j < XS_DEGREE; j++) {
+            a[j] ^= xs_charpoly[j];
         }
-        y = (state->key[N - 1] & UPPER_MASK) | (state->key[0] & LOWER_MASK);
-        state->key[N - 1] = state->key[M - 1] ^ (y >> 1) ^ (-(y & 1) & MATRIX_A);
+    }
+}
+
+/* s = h(T) s */
+static void
+xs_apply(unsigned long *s, const unsigned char *h)
+{
+    unsigned long acc[4] = {0, 0, 0, 0};
+    int i, j;
 
+    for (i = XS_DEGREE - 1; i >= 0; i--) {
+        xoshiro_step(acc);
+        if (h[i]) {
+            for (j = 0; j < 4; j++) {
+                acc[j] ^= s[j];
+            }
+        }
+    }
+    memcpy(s, acc, sizeof(acc));
+}
+
+/* Advance by steps * 2**log2_mul */
+static void
+xoshiro_jump_by(unsigned long steps, unsigned int log2_mul, rk_state *state)
+{
+    unsigned char h[XS_DEGREE];
+    int i, started = 0;
+
+    if (!xs_charpoly_ready) {
+        xs_init_charpoly();
+    }
+    memset(h, 0, sizeof(h));
+    h[0] = 1;
+    for (i = (int)(sizeof(steps) * CHAR_BIT) - 1; i >= 0; i--) {
+        if (started) {
+            xs_mulmod(h, h);
+        }
+        if ((steps >> i) & 1) {
+            xs_mulx(h);
+            started = 1;
+        }
+    }
+    /* The period divides 2**128 - 1, so only log2_mul mod 128 matters */
+    for (i = 0; i < (int)(log2_mul % XS_DEGREE); i++) {
+        xs_mulmod(h, h);
+    }
+    xs_apply(state->key, h);
+}
+
+static void
+xoshiro_jump(unsigned int log2_steps, rk_state *state)
+{
+    xoshiro_jump_by(1, log2_steps, state);
+}
+
+static void
+xoshiro_advance(unsigned long steps, rk_state *state)
+{
+    xoshiro_jump_by(steps, 0, state);
+}
+
+const rk_bitgen rk_xoshiro128 = {
+    "xoshiro128**",
+    xoshiro_seed,
+    xoshiro_next,
+    xoshiro_jump,
+    xoshiro_advance,
+    64
+};
+
+/*
+ * Philox4x32-10.  key[0..3] is the 128 bit counter of the next block,
+ * least significant word first, key[4..5] the key and key[6..9] the
+ * current block, of which pos words have been used.
+ */
+#define PHILOX_CTR 0
+#define PHILOX_KEY 4
+#define PHILOX_BUF 6
+
+/* 32 x 32 -> 64 bit product, in 16 bit halves for 32 bit longs */
+static void
+philox_mulhilo(unsigned long a, unsigned long b,
+               unsigned long *hi, unsigned long *lo)
+{
+#if ULONG_MAX > 0xffffffffUL
+    const unsigned long p = a * b;
+
+    *lo = p & M32;
+    *hi = p >> 32;
+#else
+    const unsigned long a0 = a & 0xffff, a1 = a >> 16;
+    const unsigned long b0 = b & 0xffff, b1 = b >> 16;
+    const unsigned long p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0;
+    const unsigned long mid = (p00 >> 16) + (p01 & 0xffff) + (p10 & 0xffff);
+
+    *lo = ((mid << 16) | (p00 & 0xffff)) & M32;
+    *hi = (a1 * b1 + (p01 >> 16) + (p10 >> 16) + (mid >> 16)) & M32;
+#endif
+}
+
+static void
+philox_block(const unsigned long *ctr, const unsigned long *key,
+             unsigned long *out)
+{
+    unsigned long c0 = ctr[0], c1 = ctr[1], c2 = ctr[2], c3 = ctr[3];
+    unsigned long k0 = key[0], k1 = key[1];
+    unsigned long hi0, lo0, hi1, lo1;
+    int r;
+
+    for (r = 0; r < 10; r++) {
+        if (r > 0) {
+            k0 = (k0 + 0x9e3779b9UL) & M32;
+            k1 = (k1 + 0xbb67ae85UL) & M32;
+        }
+        philox_mulhilo(0xd2511f53UL, c0, &hi0, &lo0);
+        philox_mulhilo(0xcd9e8d57UL, c2, &hi1, &lo1);
+        c0 = hi1 ^ c1 ^ k0;
+        c1 = lo1;
+        c2 = hi0 ^ c3 ^ k1;
+        c3 = lo0;
+    }
+    out[0] = c0;
+    out[1] = c1;
+    out[2] = c2;
+    out[3] = c3;
+}
+
+/*
+ * ctr += inc, both 128 bit.  The carries come from comparisons, as the
+ * sums do not fit in a 32 bit unsigned long.
+ */
+static void
+philox_add(unsigned long *ctr, const unsigned long *inc)
+{
+    unsigned long carry = 0, t, c;
+    int i;
+
+    for (i = 0; i < 4; i++) {
+        t = (ctr[i] + inc[i]) & M32;
+        c = t < inc[i];
+        t = (t + carry) & M32;
+        carry = c | (t < carry);
+        ctr[i] = t;
+    }
+}
+
+static unsigned long
+philox_next(rk_state *state)
+{
+    static const unsigned long one[4] = {1, 0, 0, 0};
+    unsigned long *k = state->key;
+
+    if (state->pos >= 4) {
+        philox_block(k + PHILOX_CTR, k + PHILOX_KEY, k + PHILOX_BUF);
+        philox_add(k + PHILOX_CTR, one);
         state->pos = 0;
     }
-    y = state->key[state->pos++];
+    return k[PHILOX_BUF + state->pos++];
+}
 
-    /* Tempering */
-    y ^= (y >> 11);
-    y ^= (y << 7) & 0x9d2c5680UL;
-    y ^= (y << 15) & 0xefc60000UL;
-    y ^= (y >> 18);
+static void
+philox_seed(const unsigned long *seed, rk_state *state)
+{
+    unsigned long *k = state->key;
 
-    return y;
+    k[PHILOX_CTR] = k[PHILOX_CTR + 1] = 0;
+    k[PHILOX_CTR + 2] = k[PHILOX_CTR + 3] = 0;
+    k[PHILOX_KEY] = seed[0] & M32;
+    k[PHILOX_KEY + 1] = seed[1] & M32;
+    state->pos = 4;
+}
+
+/*
+ * Move forward by steps words plus big[] blocks, big[] being a 128 bit
+ * number.
+ */
+static void
+philox_move(const unsigned long *big, unsigned long steps, rk_state *state)
+{
+    static const unsigned long minus_one[4] = {M32, M32, M32, M32};
+    unsigned long *ctr = state->key + PHILOX_CTR;
+    unsigned long blocks[4];
+    int offset = 0;
+
+    /* Make ctr the block of the next word, and offset its index in it */
+    if (state->pos < 4) {
+        philox_add(ctr, minus_one);
+        offset = state->pos;
+    }
+    offset += (int)(steps % 4);
+    steps = steps / 4 + (unsigned long)(offset / 4);
+    offset %= 4;
+    blocks[0] = steps & M32;
+    blocks[1] = (steps >> 16 >> 16) & M32;
+    blocks[2] = blocks[3] = 0;
+    philox_add(ctr, blocks);
+    philox_add(ctr, big);
+
+    state->pos = 4;
+    if (offset) {
+        philox_next(state);
+        state->pos = offset;
+    }
+}
+
+static void
+philox_jump(unsigned int log2_steps, rk_state *state)
+{
+    unsigned long big[4] = {0, 0, 0, 0};
+
+    if (log2_steps < 2) {
+        philox_move(big, 1UL << log2_steps, state);
+    }
+    else if (log2_steps - 2 < 128) {
+        big[(log2_steps - 2) / 32] = 1UL << ((log2_steps - 2) % 32);
+        philox_move(big, 0, state);
+    }
+}
+
+static void
+philox_advance(unsigned long steps, rk_state *state)
+{
+    static const unsigned long zero[4] = {0, 0, 0, 0};
+
+    philox_move(zero, steps, state);
+}
+
+const rk_bitgen rk_philox4x32 = {
+    "philox4x32",
+    philox_seed,
+    philox_next,
+    philox_jump,
+    philox_advance,
+    98
+};
+
+void
+rk_bitgen_seed_words(const rk_bitgen *bitgen, const unsigned long *seed,
+                     rk_state *state)
+{
+    if (bitgen == NULL) {
+        rk_seed(seed[0], state);
+        return;
+    }
+    bitgen->seed(seed, state);
+    state->bitgen = bitgen;
+    state->gauss = 0;
+    state->has_gauss = 0;
+    state->has_binomial = 0;
+}
+
+void
+rk_bitgen_seed(const rk_bitgen *bitgen, unsigned long seed, rk_state *state)
+{
+    unsigned long words[RK_BITGEN_SEED_WORDS];
+    int i;
+
+    seed &= M32;
+    for (i = 0; i < RK_BITGEN_SEED_WORDS; i++) {
+        words[i] = seed_mix(&seed);
+    }
+    rk_bitgen_seed_words(bitgen, words, state);
+}
+
+rk_error
+rk_bitgen_randomseed(const rk_bitgen *bitgen, rk_state *state)
+{
+    unsigned long words[RK_BITGEN_SEED_WORDS];
+    rk_error err;
+
+    if (bitgen == NULL) {
+        return rk_randomseed(state);
+    }
+    err = rk_devfill(words, sizeof(words), 0);
+    if (err != RK_NOERR) {
+        /* Same fallback as rk_randomseed */
+        rk_randomseed(state);
+        rk_fill(words, sizeof(words), state);
+    }
+    rk_bitgen_seed_words(bitgen, words, state);
+    return err;
 }
 
+#undef ROTL32
+#undef M32
+
 long
 rk_long(rk_state *state)
 {
@@ -288,14 +1103,64 @@ rk_interval(unsigned long max, rk_state *state)
     return value;
 }
 
-double
-rk_double(rk_state *state)
+static double
+next_double(rk_state *state)
 {
     /* shifts : 67108864 = 0x4000000, 9007199254740992 = 0x20000000000000 */
-    long a = rk_random(state) >> 5, b = rk_random(state) >> 6;
+    long a = next_word(state) >> 5, b = next_word(state) >> 6;
     return (a * 67108864.0 + b) / 9007199254740992.0;
 }
 
+double
+rk_double(rk_state *state)
+{
+    return next_double(state);
+}
+
+/*
+ * Works on the state words directly, a block of up to N/2 doubles at a
+ * time.  The loop body has no calls or branches so that the compiler can
+ * vectorize the tempering and the conversion.
+ */
+void
+rk_fill_double(double *out, size_t n, rk_state *state)
+{
+    const unsigned long *key;
+    unsigned long a, b;
+    size_t i, k;
+
+    if (state->bitgen != NULL) {
+        for (i = 0; i < n; i++) {
+            out[i] = next_double(state);
+        }
+        return;
+    }
+    while (n > 0) {
+        if (state->pos >= RK_STATE_LEN - 1) {
+            /* The two words of this double straddle a regeneration */
+            *(out++) = next_double(state);
+            n--;
+            continue;
+        }
+        k = (RK_STATE_LEN - state->pos) / 2;
+        if (k > n) {
+            k = n;
+        }
+        key = state->key + state->pos;
+        for (i = 0; i < k; i++) {
+            a = key[2*i];
+            b = key[2*i + 1];
+            RK_TEMPER(a);
+            RK_TEMPER(b);
+            out[i] = ((long)(a >> 5) * 67108864.0 + (long)(b >> 6))
+                    / 9007199254740992.0;
+        }
+        state->pos += (int)(2*k);
+        out += k;
+        n -= k;
+    }
+}
+
 void
 rk_fill(void *buffer, size_t size, rk_state *state)
 {
@@ -386,8 +1251,8 @@ rk_gauss(rk_state *state)
         double f, x1, x2, r2;
 
         do {
-            x1 = 2.0*rk_double(state) - 1.0;
-            x2 = 2.0*rk_double(state) - 1.0;
+            x1 = 2.0*next_double(state) - 1.0;
+            x2 = 2.0*next_double(state) - 1.0;
             r2 = x1*x1 + x2*x2;
         }
         while (r2 >= 1.0 || r2 == 0.0);
@@ -400,3 +1265,231 @@ rk_gauss(rk_state *state)
         return f*x2;
     }
 }
+
+void
+rk_fill_gauss(double *out, size_t n, rk_state *state)
+{
+    double f, x1, x2, r2;
+    size_t i = 0;
+
+    if (n == 0) {
+        return;
+    }
+    if (state->has_gauss) {
+        out[i++] = state->gauss;
+        state->gauss = 0;
+        state->has_gauss = 0;
+    }
+    while (i < n) {
+        do {
+            x1 = 2.0*next_double(state) - 1.0;
+            x2 = 2.0*next_double(state) - 1.0;
+            r2 = x1*x1 + x2*x2;
+        }
+        while (r2 >= 1.0 || r2 == 0.0);
+
+        f = sqrt(-2.0*log(r2)/r2);
+        out[i++] = f*x2;
+        if (i < n) {
+            out[i++] = f*x1;
+        }
+        else {
+            state->gauss = f*x1;
+            state->has_gauss = 1;
+        }
+    }
+}
+
+/*
+ * Ziggurat method of Marsaglia and Tsang (2000), with 256 layers and
+ * 53 bit uniforms.  The area under the density is covered by 256 layers
+ * of equal area RK_ZIG_V: the base layer 0 is the strip below f(r) plus
+ * the tail beyond r, and layer i > 0 spans [0, x[i]] between f(x[i]) and
+ * f(x[i+1]).  About 99% of the samples need one multiplication and one
+ * comparison; the others fall in a wedge or in the tail.
+ */
+#define RK_ZIG_LAYERS 256
+#define RK_ZIG_NORM_R 3.6541528853610088
+#define RK_ZIG_NORM_V 4.928673233974658e-3
+#define RK_ZIG_EXP_R 7.6971174701310497
+#define RK_ZIG_EXP_V 3.949659822581556e-3
+
+typedef struct {
+    double x[RK_ZIG_LAYERS + 1];  /* right edge of each layer */
+    double k[RK_ZIG_LAYERS];      /* x[i+1] / x[i] */
+    double f[RK_ZIG_LAYERS + 1];  /* density at x[i] */
+} rk_zig_table;
+
+static rk_zig_table zig_norm, zig_exp;
+static int zig_norm_ready = 0, zig_exp_ready = 0;
+
+/*
+ * Fill table for the density f normalised to f(0) = 1, given the start
+ * r of the tail, the layer area v and finv(y), the inverse of f.
+ */
+static void
+zig_init(rk_zig_table *t, double (*f)(double), double (*finv)(double),
+         double r, double v)
+{
+    int i;
+
+    t->x[0] = v / f(r);
+    t->x[1] = r;
+    for (i = 1; i < RK_ZIG_LAYERS - 1; i++) {
+        t->x[i+1] = finv(f(t->x[i]) + v / t->x[i]);
+    }
+    t->x[RK_ZIG_LAYERS] = 0.0;
+    for (i = 0; i < RK_ZIG_LAYERS; i++) {
+        t->k[i] = t->x[i+1] / t->x[i];
+        t->f[i] = f(t->x[i]);
+    }
+    t->f[RK_ZIG_LAYERS] = 1.0;
+}
+
+static double
+zig_norm_f(double x)
+{
+    return exp(-0.5*x*x);
+}
+
+static double
+zig_norm_finv(double y)
+{
+    return sqrt(-2.0*log(y));
+}
+
+static double
+zig_exp_f(double x)
+{
+    return exp(-x);
+}
+
+static double
+zig_exp_finv(double y)
+{
+    return -log(y);
+}
+
+/*
+ * Draw two words w1 and w2 and a uniform u in [0, 1) from the top 21 bits
+ * of w1 and all of w2.  The low 8 bits of w1 select the layer, leaving
+ * bits 8-10 free for the caller.
+ */
+#define ZIG_DRAW(state, w1, u)                                              \
+    do {                                                                    \
+        unsigned long w2_;                                                  \
+        (w1) = next_word(state);                                            \
+        w2_ = next_word(state);                                             \
+        (u) = ((double)((w1) >> 11) * 4294967296.0 + (double)w2_)           \
+              / 9007199254740992.0;                                         \
+    } while (0)
+
+static void
+zig_setup(void)
+{
+    if (!zig_norm_ready) {
+        zig_init(&zig_norm, zig_norm_f, zig_norm_finv,
+                 RK_ZIG_NORM_R, RK_ZIG_NORM_V);
+        zig_norm_ready = 1;
+    }
+    if (!zig_exp_ready) {
+        zig_init(&zig_exp, zig_exp_f, zig_exp_finv,
+                 RK_ZIG_EXP_R, RK_ZIG_EXP_V);
+        zig_exp_ready = 1;
+    }
+}
+
+static double
+zig_gauss(rk_state *state)
+{
+    const rk_zig_table *t = &zig_norm;
+    unsigned long w;
+    double u, x, xx, yy;
+    double sign;
+    int idx;
+
+    for (;;) {
+        ZIG_DRAW(state, w, u);
+        idx = (int)(w & 0xff);
+        /* Bit 8 gives the sign, without a branch that would mispredict */
+        sign = 1.0 - (double)((w >> 7) & 2);
+        x = sign * u * t->x[idx];
+        if (u < t->k[idx]) {
+            return x;
+        }
+        if (idx == 0) {
+            /* Tail beyond r (Marsaglia 1964) */
+            do {
+                xx = -log(1.0 - next_double(state)) / RK_ZIG_NORM_R;
+                yy = -log(1.0 - next_double(state));
+            } while (yy + yy < xx*xx);
+            return sign * (RK_ZIG_NORM_R + xx);
+        }
+        if (t->f[idx] + next_double(state) * (t->f[idx+1] - t->f[idx])
+                < exp(-0.5*x*x)) {
+            return x;
+        }
+    }
+}
+
+static double
+zig_exponential(rk_state *state)
+{
+    const rk_zig_table *t = &zig_exp;
+    unsigned long w;
+    double u, x;
+    int idx;
+
+    for (;;) {
+        ZIG_DRAW(state, w, u);
+        idx = (int)(w & 0xff);
+        x = u * t->x[idx];
+        if (u < t->k[idx]) {
+            return x;
+        }
+        if (idx == 0) {
+            /* The tail is memoryless */
+            return RK_ZIG_EXP_R - log(1.0 - next_double(state));
+        }
+        if (t->f[idx] + next_double(state) * (t->f[idx+1] - t->f[idx])
+                < exp(-x)) {
+            return x;
+        }
+    }
+}
+
+double
+rk_gauss_zig(rk_state *state)
+{
+    zig_setup();
+    return zig_gauss(state);
+}
+
+void
+rk_fill_gauss_zig(double *out, size_t n, rk_state *state)
+{
+    size_t i;
+
+    zig_setup();
+    for (i = 0; i < n; i++) {
+        out[i] = zig_gauss(state);
+    }
+}
+
+double
+rk_standard_exponential_zig(rk_state *state)
+{
+    zig_setup();
+    return zig_exponential(state);
+}
+
+void
+rk_fill_standard_exponential_zig(double *out, size_t n, rk_state *state)
+{
+    size_t i;
+
+    zig_setup();
+    for (i = 0; i < n; i++) {
+        out[i] = zig_exponential(state);
+    }
+}
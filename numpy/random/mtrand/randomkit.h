@@ -63,6 +63,8 @@
 
 #define RK_STATE_LEN 624
 
+struct rk_bitgen_;
+
 typedef struct rk_state_
 {
     unsigned long key[RK_STATE_LEN];
@@ -94,9 +96,56 @@ typedef struct rk_state_
     double p3;
     double p4;
 
+    /* Generator of the words returned by rk_random: NULL for the Mersenne
+     * Twister, or one of the generators below, whose state is then kept
+     * in the first words of key. */
+    const struct rk_bitgen_ *bitgen;
 }
 rk_state;
 
+/* Number of 32 bit words a bit generator is seeded from */
+#define RK_BITGEN_SEED_WORDS 4
+
+/*
+ * A bit generator other than the Mersenne Twister.  All the rk_* and
+ * distribution functions work with any of them.
+ */
+typedef struct rk_bitgen_
+{
+    const char *name;
+
+    /* Initialize the words of key used by the generator and pos */
+    void (*seed)(const unsigned long *seed, rk_state *state);
+
+    /* Return the next 32 random bits */
+    unsigned long (*next)(rk_state *state);
+
+    /* Advance as if next had been called 2**log2_steps times */
+    void (*jump)(unsigned int log2_steps, rk_state *state);
+
+    /* Advance as if next had been called steps times */
+    void (*advance)(unsigned long steps, rk_state *state);
+
+    /* log2 of the distance between the streams made by rk_split */
+    unsigned int stream_log2;
+}
+rk_bitgen;
+
+/*
+ * xoshiro128** of Blackman and Vigna: 128 bits of state, period 2**128-1.
+ * Seeding is a few operations instead of the 624 words of the Mersenne
+ * Twister.  Streams are 2**64 apart.
+ */
+extern const rk_bitgen rk_xoshiro128;
+
+/*
+ * Philox4x32-10 of Salmon et al.: counter based, the n-th word is a
+ * function of n and of the 64 bit key only.  Jumping is an addition, so
+ * any number of threads can each generate a part of one sequence.
+ * Streams are 2**98 apart, in the top word of the counter.
+ */
+extern const rk_bitgen rk_philox4x32;
+
 typedef enum {
     RK_NOERR = 0, /* no error */
     RK_ENODEV = 1, /* no RK_DEV_RANDOM device */
@@ -118,6 +167,16 @@ extern "C" {
  */
 extern void rk_seed(unsigned long seed, rk_state *state);
 
+/*
+ * Initialize the state to use the bit generator bitgen, seeded from the
+ * given seed or from seed[0..RK_BITGEN_SEED_WORDS-1].  bitgen may be NULL
+ * for the Mersenne Twister.
+ */
+extern void rk_bitgen_seed(const rk_bitgen *bitgen, unsigned long seed,
+                           rk_state *state);
+extern void rk_bitgen_seed_words(const rk_bitgen *bitgen,
+                                 const unsigned long *seed, rk_state *state);
+
 /*
  * Initialize the RNG state using a random seed.
  * Uses /dev/random or, when unavailable, the clock (see randomkit.c).
@@ -128,6 +187,13 @@ extern void rk_seed(unsigned long seed, rk_state *state);
  */
 extern rk_error rk_randomseed(rk_state *state);
 
+/*
+ * Same as rk_randomseed for the bit generator bitgen.  Only
+ * RK_BITGEN_SEED_WORDS words are read from the random device.
+ */
+extern rk_error rk_bitgen_randomseed(const rk_bitgen *bitgen,
+                                     rk_state *state);
+
 /*
  * Returns a random unsigned long between 0 and RK_MAX inclusive
  */
@@ -153,6 +219,11 @@ extern unsigned long rk_interval(unsigned long max, rk_state *state);
  */
 extern double rk_double(rk_state *state);
 
+/*
+ * Fill out with n doubles, the same as n calls to rk_double but faster.
+ */
+extern void rk_fill_double(double *out, size_t n, rk_state *state);
+
 /*
  * fill the buffer with size random bytes
  */
@@ -182,6 +253,75 @@ extern rk_error rk_altfill(void *buffer, size_t size, int strong,
  */
 extern double rk_gauss(rk_state *state);
 
+/*
+ * Fill out with n gaussian deviates, the same as n calls to rk_gauss.
+ */
+extern void rk_fill_gauss(double *out, size_t n, rk_state *state);
+
+/*
+ * Gaussian and standard exponential deviates by the ziggurat method.
+ * These are several times faster than rk_gauss and
+ * rk_standard_exponential but give a different sequence for the same
+ * state.  The first call computes tables shared by all states, so make it
+ * before starting any threads.
+ */
+extern double rk_gauss_zig(rk_state *state);
+extern void rk_fill_gauss_zig(double *out, size_t n, rk_state *state);
+extern double rk_standard_exponential_zig(rk_state *state);
+extern void rk_fill_standard_exponential_zig(double *out, size_t n,
+                                             rk_state *state);
+
+/*
+ * Jumping ahead and independent streams.
+ *
+ * These functions move a state forward without generating the values in
+ * between, so that a sequence can be generated in pieces, e.g. by
+ * several threads, with results that do not depend on how it was split.
+ * A Mersenne Twister jump costs a few milliseconds, a xoshiro128** jump
+ * under a millisecond and a Philox jump nothing.  The first call also
+ * computes tables shared by all states, so make it before starting any
+ * threads.
+ */
+
+/*
+ * Distance between the streams made by rk_split for the Mersenne Twister:
+ * 2**RK_STREAM_LOG2.  Other generators use their stream_log2.
+ */
+#define RK_STREAM_LOG2 128
+
+/*
+ * Advance the state as if rk_random had been called 2**log2_steps times.
+ */
+extern void rk_jump(unsigned int log2_steps, rk_state *state);
+
+/*
+ * Advance the state as if rk_random had been called steps times.
+ */
+extern void rk_advance(unsigned long steps, rk_state *state);
+
+/*
+ * Initialize streams[0..nstreams-1] to non-overlapping substreams of state:
+ * streams[i] is state advanced by i * 2**RK_STREAM_LOG2 steps (the
+ * generator's stream_log2 for other bit generators).  state itself is not
+ * modified.
+ */
+extern void rk_split(rk_state *state, rk_state *streams, int nstreams);
+
+/*
+ * Fill the buffer with bytes offset..offset+size-1 of the sequence that
+ * rk_fill would produce from state, without modifying state.  Filling an
+ * array in any number of pieces gives the same result as one rk_fill.
+ */
+extern void rk_fill_range(void *buffer, size_t offset, size_t size,
+                          rk_state *state);
+
+/*
+ * Same as rk_fill_range for the doubles returned by successive calls to
+ * rk_double: out[i] is the value of call offset + i.
+ */
+extern void rk_double_range(double *out, size_t offset, size_t n,
+                            rk_state *state);
+
 #ifdef __cplusplus
 }
 #endif
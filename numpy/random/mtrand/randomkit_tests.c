@@ -0,0 +1,338 @@
+/*
+ * Hooks to test the randomkit functions that mtrand does not call.
+ *
+ * Every function seeds a fresh state from (generator name, seed), so
+ * the tests can compare the words produced along different paths.
+ */
+
+#include <Python.h>
+#include <string.h>
+
+#include "randomkit.h"
+
+#if PY_VERSION_HEX >= 0x03000000
+#define RKT_PY3K
+#endif
+
+static int
+seed_state(const char *gen, unsigned long seed, rk_state *state)
+{
+    if (strcmp(gen, "mt19937") == 0) {
+        rk_seed(seed, state);
+        return 0;
+    }
+    if (strcmp(gen, "xoshiro128") == 0) {
+        rk_bitgen_seed(&rk_xoshiro128, seed, state);
+        return 0;
+    }
+    if (strcmp(gen, "philox4x32") == 0) {
+        rk_bitgen_seed(&rk_philox4x32, seed, state);
+        return 0;
+    }
+    PyErr_Format(PyExc_ValueError, "unknown generator '%s'", gen);
+    return -1;
+}
+
+static PyObject *
+words_list(rk_state *state, Py_ssize_t n)
+{
+    PyObject *ret, *w;
+    Py_ssize_t i;
+
+    if (n < 0) {
+        PyErr_SetString(PyExc_ValueError, "negative count");
+        return NULL;
+    }
+    ret = PyList_New(n);
+    if (ret == NULL) {
+        return NULL;
+    }
+    for (i = 0; i < n; i++) {
+        w = PyLong_FromUnsignedLong(rk_random(state));
+        if (w == NULL) {
+            Py_DECREF(ret);
+            return NULL;
+        }
+        PyList_SET_ITEM(ret, i, w);
+    }
+    return ret;
+}
+
+static PyObject *
+RK_Tests_words(PyObject *self, PyObject *args)
+{
+    const char *gen;
+    unsigned long seed;
+    Py_ssize_t n;
+    rk_state state;
+
+    if (!PyArg_ParseTuple(args, "skn", &gen, &seed, &n)) {
+        return NULL;
+    }
+    if (seed_state(gen, seed, &state) < 0) {
+        return NULL;
+    }
+    return words_list(&state, n);
+}
+
+static PyObject *
+RK_Tests_jump(PyObject *self, PyObject *args)
+{
+    const char *gen;
+    unsigned long seed;
+    unsigned int log2_steps;
+    Py_ssize_t n, skip = 0;
+    rk_state state;
+
+    if (!PyArg_ParseTuple(args, "skIn|n", &gen, &seed, &log2_steps, &n,
+                          &skip)) {
+        return NULL;
+    }
+    if (seed_state(gen, seed, &state) < 0) {
+        return NULL;
+    }
+    for (; skip > 0; skip--) {
+        rk_random(&state);
+    }
+    rk_jump(log2_steps, &state);
+    return words_list(&state, n);
+}
+
+static PyObject *
+RK_Tests_advance(PyObject *self, PyObject *args)
+{
+    const char *gen;
+    unsigned long seed, steps;
+    Py_ssize_t n, skip = 0;
+    rk_state state;
+
+    if (!PyArg_ParseTuple(args, "skkn|n", &gen, &seed, &steps, &n, &skip)) {
+        return NULL;
+    }
+    if (seed_state(gen, seed, &state) < 0) {
+        return NULL;
+    }
+    for (; skip > 0; skip--) {
+        rk_random(&state);
+    }
+    rk_advance(steps, &state);
+    return words_list(&state, n);
+}
+
+static PyObject *
+RK_Tests_split(PyObject *self, PyObject *args)
+{
+    const char *gen;
+    unsigned long seed;
+    int nstreams, i;
+    Py_ssize_t n;
+    rk_state state, *streams;
+    PyObject *ret, *w;
+
+    if (!PyArg_ParseTuple(args, "skin", &gen, &seed, &nstreams, &n)) {
+        return NULL;
+    }
+    if (nstreams < 0) {
+        PyErr_SetString(PyExc_ValueError, "negative number of streams");
+        return NULL;
+    }
+    if (seed_state(gen, seed, &state) < 0) {
+        return NULL;
+    }
+    streams = PyMem_Malloc((nstreams + 1) * sizeof(rk_state));
+    if (streams == NULL) {
+        return PyErr_NoMemory();
+    }
+    rk_split(&state, streams, nstreams);
+    ret = PyList_New(nstreams + 1);
+    if (ret == NULL) {
+        PyMem_Free(streams);
+        return NULL;
+    }
+    /* The last entry checks that state itself was left alone */
+    streams[nstreams] = state;
+    for (i = 0; i <= nstreams; i++) {
+        w = words_list(&streams[i], n);
+        if (w == NULL) {
+            Py_DECREF(ret);
+            PyMem_Free(streams);
+            return NULL;
+        }
+        PyList_SET_ITEM(ret, i, w);
+    }
+    PyMem_Free(streams);
+    return ret;
+}
+
+/*
+ * Returns size + 2*pad bytes: pad guard bytes of 0xAA on each side of
+ * what rk_fill_range (or rk_fill, if offset is None) wrote.
+ */
+static PyObject *
+RK_Tests_fill_range(PyObject *self, PyObject *args)
+{
+    const char *gen;
+    unsigned long seed;
+    PyObject *offset;
+    Py_ssize_t size, pad;
+    rk_state state, orig;
+    unsigned char *buf;
+    PyObject *ret;
+
+    if (!PyArg_ParseTuple(args, "skOnn", &gen, &seed, &offset, &size, &pad)) {
+        return NULL;
+    }
+    if (size < 0 || pad < 0) {
+        PyErr_SetString(PyExc_ValueError, "negative size");
+        return NULL;
+    }
+    if (seed_state(gen, seed, &state) < 0) {
+        return NULL;
+    }
+    buf = PyMem_Malloc(size + 2*pad + 1);
+    if (buf == NULL) {
+        return PyErr_NoMemory();
+    }
+    memset(buf, 0xAA, size + 2*pad);
+    if (offset == Py_None) {
+        rk_fill(buf + pad, size, &state);
+    }
+    else {
+        Py_ssize_t off = PyNumber_AsSsize_t(offset, PyExc_OverflowError);
+
+        if (off == -1 && PyErr_Occurred()) {
+            PyMem_Free(buf);
+            return NULL;
+        }
+        orig = state;
+        rk_fill_range(buf + pad, (size_t)off, size, &state);
+        if (memcmp(orig.key, state.key, sizeof(state.key)) != 0 ||
+                orig.pos != state.pos) {
+            PyMem_Free(buf);
+            PyErr_SetString(PyExc_AssertionError,
+                            "rk_fill_range modified the state");
+            return NULL;
+        }
+    }
+    ret = PyBytes_FromStringAndSize((char *)buf, size + 2*pad);
+    PyMem_Free(buf);
+    return ret;
+}
+
+static PyObject *
+RK_Tests_double_range(PyObject *self, PyObject *args)
+{
+    const char *gen;
+    unsigned long seed;
+    Py_ssize_t offset, n, i;
+    rk_state state;
+    double *out;
+    PyObject *ret, *v;
+
+    if (!PyArg_ParseTuple(args, "sknn", &gen, &seed, &offset, &n)) {
+        return NULL;
+    }
+    if (offset < 0 || n < 0) {
+        PyErr_SetString(PyExc_ValueError, "negative offset or count");
+        return NULL;
+    }
+    if (seed_state(gen, seed, &state) < 0) {
+        return NULL;
+    }
+    out = PyMem_Malloc((n + 1) * sizeof(double));
+    if (out == NULL) {
+        return PyErr_NoMemory();
+    }
+    rk_double_range(out, (size_t)offset, (size_t)n, &state);
+    ret = PyList_New(n);
+    for (i = 0; ret != NULL && i < n; i++) {
+        v = PyFloat_FromDouble(out[i]);
+        if (v == NULL) {
+            Py_CLEAR(ret);
+            break;
+        }
+        PyList_SET_ITEM(ret, i, v);
+    }
+    PyMem_Free(out);
+    return ret;
+}
+
+static PyObject *
+RK_Tests_doubles(PyObject *self, PyObject *args)
+{
+    const char *gen;
+    unsigned long seed;
+    Py_ssize_t n, i;
+    rk_state state;
+    PyObject *ret, *v;
+
+    if (!PyArg_ParseTuple(args, "skn", &gen, &seed, &n)) {
+        return NULL;
+    }
+    if (n < 0) {
+        PyErr_SetString(PyExc_ValueError, "negative count");
+        return NULL;
+    }
+    if (seed_state(gen, seed, &state) < 0) {
+        return NULL;
+    }
+    ret = PyList_New(n);
+    for (i = 0; ret != NULL && i < n; i++) {
+        v = PyFloat_FromDouble(rk_double(&state));
+        if (v == NULL) {
+            Py_CLEAR(ret);
+            break;
+        }
+        PyList_SET_ITEM(ret, i, v);
+    }
+    return ret;
+}
+
+static PyMethodDef RK_TestsMethods[] = {
+    {"words", RK_Tests_words, METH_VARARGS,
+     "words(gen, seed, n): the first n words of rk_random."},
+    {"jump", RK_Tests_jump, METH_VARARGS,
+     "jump(gen, seed, log2_steps, n[, skip]): n words after skip words "
+     "and rk_jump."},
+    {"advance", RK_Tests_advance, METH_VARARGS,
+     "advance(gen, seed, steps, n[, skip]): n words after skip words and "
+     "rk_advance."},
+    {"split", RK_Tests_split, METH_VARARGS,
+     "split(gen, seed, nstreams, n): n words of each stream made by "
+     "rk_split, then n words of the state that was split."},
+    {"fill_range", RK_Tests_fill_range, METH_VARARGS,
+     "fill_range(gen, seed, offset, size, pad): the bytes written by "
+     "rk_fill_range, or rk_fill if offset is None, with pad guard bytes "
+     "of 0xAA on each side."},
+    {"double_range", RK_Tests_double_range, METH_VARARGS,
+     "double_range(gen, seed, offset, n): the doubles of rk_double_range."},
+    {"doubles", RK_Tests_doubles, METH_VARARGS,
+     "doubles(gen, seed, n): the first n values of rk_double."},
+    {NULL, NULL, 0, NULL}        /* Sentinel */
+};
+
+#if defined(RKT_PY3K)
+static struct PyModuleDef moduledef = {
+        PyModuleDef_HEAD_INIT,
+        "randomkit_tests",
+        NULL,
+        -1,
+        RK_TestsMethods,
+        NULL,
+        NULL,
+        NULL,
+        NULL
+};
+
+PyObject *
+PyInit_randomkit_tests(void)
+{
+    return PyModule_Create(&moduledef);
+}
+#else
+PyMODINIT_FUNC
+initrandomkit_tests(void)
+{
+    Py_InitModule("randomkit_tests", RK_TestsMethods);
+}
+#endif
@@ -43,6 +43,12 @@ def configuration(parent_package='',top_path=None):
                                     ],
                          **get_info('ndarray'))
 
+    config.add_extension('randomkit_tests',
+                         sources=[join('mtrand', x) for x in
+                                  ['randomkit_tests.c', 'randomkit.c']
+                                  ] + [generate_libraries],
+                         depends = [join('mtrand','randomkit.h')])
+
     config.add_data_files(('.', join('mtrand', 'randomkit.h')))
     config.add_data_dir('tests')
 
@@ -179,5 +179,272 @@ class Test_MTRand(TestCase):
         self.assertEqual(a.shape, (100, 2))
 
 
+class TestFill(TestCase):
+    # random_sample, standard_normal and standard_exponential, and the
+    # scalar-parameter uniform, normal and exponential, generate a whole
+    # array in one call.  They must give the same values as drawing one
+    # at a time, whatever the size and wherever the state is.
+    sizes = [0, 1, 2, 5, 311, 624, 625, 1251, 2000]
+
+    def check_fill(self, method, args=()):
+        for skip in [0, 1, 7, 400]:
+            for n in self.sizes:
+                prng = random.RandomState(1234)
+                for k in xrange(skip):
+                    getattr(prng, method)(*args)
+                a = getattr(prng, method)(*(args + (n,)))
+                prng = random.RandomState(1234)
+                for k in xrange(skip):
+                    getattr(prng, method)(*args)
+                b = [getattr(prng, method)(*args) for k in xrange(n)]
+                assert_equal(a.shape, (n,))
+                assert_array_equal(a, b, err_msg="%s %d %d" % (method, skip, n))
+
+    def test_random_sample(self):
+        self.check_fill('random_sample')
+
+    def test_standard_normal(self):
+        self.check_fill('standard_normal')
+
+    def test_standard_exponential(self):
+        self.check_fill('standard_exponential')
+
+    def test_uniform(self):
+        self.check_fill('uniform', (-2.0, 3.0))
+
+    def test_normal(self):
+        self.check_fill('normal', (1.0, 3.0))
+
+    def test_exponential(self):
+        self.check_fill('exponential', (2.0,))
+
+    def test_affine(self):
+        prng = random.RandomState(5)
+        u = prng.random_sample(1000)
+        prng = random.RandomState(5)
+        assert_array_equal(prng.uniform(-2.0, 3.0, 1000), -2.0 + 5.0*u)
+        prng = random.RandomState(5)
+        g = prng.standard_normal(1001)
+        prng = random.RandomState(5)
+        assert_array_equal(prng.normal(1.0, 3.0, 1001), 1.0 + 3.0*g)
+        prng = random.RandomState(5)
+        e = prng.standard_exponential(1000)
+        prng = random.RandomState(5)
+        assert_array_equal(prng.exponential(2.0, 1000), 2.0*e)
+
+    def test_shape(self):
+        prng = random.RandomState(9)
+        a = prng.standard_normal((3, 4, 5))
+        prng = random.RandomState(9)
+        assert_array_equal(a, prng.standard_normal(60).reshape(3, 4, 5))
+
+    def test_known_values(self):
+        prng = random.RandomState(0)
+        assert_array_almost_equal(prng.random_sample(3),
+                                  [0.5488135, 0.71518937, 0.60276338])
+        prng = random.RandomState(0)
+        assert_array_almost_equal(prng.standard_exponential(3),
+                                  [0.79587451, 1.25593076, 0.92322315])
+
+
+class TestJump(TestCase):
+    # rk_jump, rk_advance, rk_split and rk_fill_range are not used by
+    # RandomState; randomkit_tests calls them on a state made by rk_seed.
+    gen = 'mt19937'
+    seed = 7
+
+    def setUp(self):
+        from numpy.random import randomkit_tests
+        self.rkt = randomkit_tests
+        self.ref = randomkit_tests.words(self.gen, self.seed, 5000)
+
+    def test_advance(self):
+        for steps in [0, 1, 2, 311, 623, 624, 625, 1247, 1248, 1249, 4000]:
+            assert_equal(self.rkt.advance(self.gen, self.seed, steps, 50),
+                         self.ref[steps:steps + 50], err_msg=str(steps))
+
+    def test_jump(self):
+        for k in range(13):
+            n = 2**k
+            assert_equal(self.rkt.jump(self.gen, self.seed, k, 20),
+                         self.ref[n:n + 20], err_msg=str(k))
+        assert_equal(self.rkt.jump(self.gen, self.seed, 31, 20),
+                     self.rkt.advance(self.gen, self.seed, 2**31, 20))
+
+    def test_split(self):
+        n = 1000
+        streams = self.rkt.split(self.gen, self.seed, 4, n)
+        assert_equal(len(streams), 5)
+        assert_equal(streams[0], self.ref[:n])
+        # The state that was split is left alone
+        assert_equal(streams[4], self.ref[:n])
+        assert_equal(streams[1], self.rkt.jump(self.gen, self.seed, 128, n))
+        # No word is shared between the streams for this seed
+        seen = set()
+        for s in streams[:4]:
+            seen.update(s)
+        assert_equal(len(seen), 4*n)
+
+    def test_fill_range(self):
+        pad = 16
+        full = self.rkt.fill_range(self.gen, self.seed, None, 3000, 0)
+        for offset, size in [(0, 0), (0, 1), (0, 7), (1, 1), (3, 5),
+                             (5, 2), (2495, 505), (1000, 999), (2999, 1)]:
+            b = self.rkt.fill_range(self.gen, self.seed, offset, size, pad)
+            assert_equal(len(b), size + 2*pad)
+            # Nothing is written outside the requested range
+            assert_equal(b[:pad], b'\xaa' * pad)
+            assert_equal(b[pad + size:], b'\xaa' * pad)
+            assert_equal(b[pad:pad + size], full[offset:offset + size],
+                         err_msg="%d %d" % (offset, size))
+
+    def test_double_range(self):
+        full = self.rkt.doubles(self.gen, self.seed, 2000)
+        for offset, n in [(0, 0), (0, 5), (1, 3), (311, 700), (1500, 500)]:
+            assert_equal(self.rkt.double_range(self.gen, self.seed, offset, n),
+                         full[offset:offset + n])
+
+
+M32 = 0xffffffff
+
+
+def seed_words(seed):
+    # rk_bitgen_seed: a Weyl sequence through the murmur3 finalizer
+    x, words = seed & M32, []
+    for i in range(4):
+        x = (x + 0x9e3779b9) & M32
+        z = ((x ^ (x >> 16)) * 0x85ebca6b) & M32
+        z = ((z ^ (z >> 13)) * 0xc2b2ae35) & M32
+        words.append(z ^ (z >> 16))
+    return words
+
+
+def philox_block(ctr, key):
+    # Philox4x32-10 on a 128 bit counter and a 64 bit key
+    c = [(ctr >> (32*i)) & M32 for i in range(4)]
+    k0, k1 = key & M32, key >> 32
+    for r in range(10):
+        if r > 0:
+            k0 = (k0 + 0x9e3779b9) & M32
+            k1 = (k1 + 0xbb67ae85) & M32
+        p0 = 0xd2511f53 * c[0]
+        p1 = 0xcd9e8d57 * c[2]
+        c = [(p1 >> 32) ^ c[1] ^ k0, p1 & M32,
+             (p0 >> 32) ^ c[3] ^ k1, p0 & M32]
+    return c
+
+
+def philox_words(seed, start, n):
+    w = seed_words(seed)
+    key = w[0] | (w[1] << 32)
+    out = []
+    for i in range(start, start + n):
+        out.append(philox_block((i // 4) % 2**128, key)[i % 4])
+    return out
+
+
+def rotl32(x, k):
+    return ((x << k) | (x >> (32 - k))) & M32
+
+
+def xoshiro_next(s):
+    r = (rotl32((s[1] * 5) & M32, 7) * 9) & M32
+    t = (s[1] << 9) & M32
+    s[2] ^= s[0]
+    s[3] ^= s[1]
+    s[1] ^= s[2]
+    s[0] ^= s[3]
+    s[2] ^= t
+    s[3] = rotl32(s[3], 11)
+    return r
+
+
+def xoshiro_jump(s, poly):
+    # The reference jump() and long_jump() of xoshiro128**
+    acc = [0, 0, 0, 0]
+    for word in poly:
+        for b in range(32):
+            if word & (1 << b):
+                acc = [a ^ x for a, x in zip(acc, s)]
+            xoshiro_next(s)
+    s[:] = acc
+
+
+class TestBitGenerators(TestCase):
+    # Known answers for the xoshiro128** and Philox4x32 generators of
+    # randomkit, from the reference algorithms above.
+    ulong_bits = 8 * np.dtype('L').itemsize
+
+    def setUp(self):
+        from numpy.random import randomkit_tests
+        self.rkt = randomkit_tests
+
+    def test_philox_block(self):
+        # Random123 known-answer vectors
+        assert_equal(philox_block(0, 0),
+                     [0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8])
+        assert_equal(philox_block(2**128 - 1, 2**64 - 1),
+                     [0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd])
+        ctr = (0x243f6a88 | (0x85a308d3 << 32) | (0x13198a2e << 64) |
+               (0x03707344 << 96))
+        assert_equal(philox_block(ctr, 0xa4093822 | (0x299f31d0 << 32)),
+                     [0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1])
+
+    def test_philox(self):
+        for seed in [0, 12345]:
+            assert_equal(self.rkt.words('philox4x32', seed, 50),
+                         philox_words(seed, 0, 50))
+
+    def test_philox_advance(self):
+        steps = [0, 1, 3, 4, 5, 1001, 2**32 - 1, 2**32, 4*2**32 + 3]
+        if self.ulong_bits > 32:
+            steps += [2**34 - 1, 2**34 + 2, 2**62 + 5, 2**64 - 1]
+        for skip in [0, 1, 3, 4, 6]:
+            for n in steps:
+                assert_equal(
+                    self.rkt.advance('philox4x32', 3, n, 9, skip),
+                    philox_words(3, skip + n, 9), err_msg="%d %d" % (skip, n))
+
+    def test_philox_jump(self):
+        # Jumps of 2**34 and up carry from one counter word to the next
+        for skip in [0, 1, 5]:
+            for k in [0, 1, 2, 3, 31, 33, 34, 35, 65, 66, 97, 98, 129, 130]:
+                assert_equal(
+                    self.rkt.jump('philox4x32', 3, k, 9, skip),
+                    philox_words(3, (skip + 2**k) % 2**130, 9),
+                    err_msg="%d %d" % (skip, k))
+
+    def test_xoshiro(self):
+        s = seed_words(42)
+        ref = [xoshiro_next(s) for i in range(2000)]
+        assert_equal(self.rkt.words('xoshiro128', 42, 2000), ref)
+        for skip in [0, 3]:
+            for n in [0, 1, 2, 127, 128, 129, 1000]:
+                assert_equal(self.rkt.advance('xoshiro128', 42, n, 20, skip),
+                             ref[skip + n:skip + n + 20])
+        for k in range(10):
+            assert_equal(self.rkt.jump('xoshiro128', 42, k, 20),
+                         ref[2**k:2**k + 20])
+
+    def test_xoshiro_long_jumps(self):
+        # jump() advances by 2**64 and long_jump() by 2**96
+        for k, poly in [(64, [0x8764000b, 0xf542d2d3,
+                              0x6fa035c3, 0x77f2db5b]),
+                        (96, [0xb523952e, 0x0b6f099f,
+                              0xccf5a0ef, 0x1c580662])]:
+            s = seed_words(42)
+            xoshiro_jump(s, poly)
+            ref = [xoshiro_next(s) for i in range(20)]
+            assert_equal(self.rkt.jump('xoshiro128', 42, k, 20), ref)
+
+    def test_split(self):
+        for gen, log2 in [('xoshiro128', 64), ('philox4x32', 98)]:
+            streams = self.rkt.split(gen, 8, 3, 100)
+            assert_equal(streams[0], self.rkt.words(gen, 8, 100))
+            assert_equal(streams[3], streams[0])
+            assert_equal(streams[1], self.rkt.jump(gen, 8, log2, 100))
+        assert_equal(streams[2], philox_words(8, 2 * 2**98, 100))
+
+
 if __name__ == "__main__":
     run_module_suite()